@@ -0,0 +1,9 @@
+HAS_PKG_CONFIG = true
+ HAS_SYSTEM_OPENSSL_ALPN = true
+ HAS_SYSTEM_OPENSSL_NPN = true
+ HAS_SYSTEM_ZLIB = true
+ HAS_SYSTEM_PROTOBUF = true
+ HAS_SYSTEM_CARES = true
+ HAS_PROTOC = true
+ HAS_VALID_PROTOC = true
+
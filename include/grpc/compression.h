@@ -44,6 +44,8 @@ GRPCAPI int grpc_compression_algorithm_name(
 
 /** Returns the compression algorithm corresponding to \a level for the
  * compression algorithms encoded in the \a accepted_encodings bitset.
+ * Levels only map to GRPC_COMPRESS_GZIP and GRPC_COMPRESS_DEFLATE:
+ * GRPC_COMPRESS_LZ4 has to be set explicitly.
  *
  * It abort()s for unknown levels . */
 GRPCAPI grpc_compression_algorithm grpc_compression_algorithm_for_level(
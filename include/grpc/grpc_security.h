@@ -131,6 +131,31 @@ typedef grpc_ssl_roots_override_result (*grpc_ssl_roots_override_callback)(
 GRPCAPI void grpc_set_ssl_roots_override_callback(
     grpc_ssl_roots_override_callback cb);
 
+/** --- grpc_ssl_session_cache object. ---
+
+   A SSL session cache object lets SSL channels resume the sessions they
+   established with a server when they reconnect to it, which spares most of
+   the cost of the handshake. Only the channels using the same root
+   certificates should share a cache, as the server certificate is not checked
+   again when a session is resumed.  */
+
+typedef struct grpc_ssl_session_cache grpc_ssl_session_cache;
+
+/** Creates a cache holding the sessions of at most capacity servers, which
+   evicts the least recently used ones. */
+GRPCAPI grpc_ssl_session_cache *grpc_ssl_session_cache_create_lru(
+    size_t capacity);
+
+/** Destroys a cache. The channels it was passed to keep it alive as long as
+   they need it. */
+GRPCAPI void grpc_ssl_session_cache_destroy(grpc_ssl_session_cache *cache);
+
+/** Creates a channel argument making the channels created with it use cache.
+   The argument does not own the cache, which must outlive it, but the
+   channels created with it take their own reference to the cache. */
+GRPCAPI grpc_arg
+grpc_ssl_session_cache_create_channel_arg(grpc_ssl_session_cache *cache);
+
 /** Object that holds a private key / certificate chain pair in PEM format. */
 typedef struct {
   /** private_key is the NULL-terminated string containing the PEM encoding of
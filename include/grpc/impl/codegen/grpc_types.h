@@ -239,6 +239,26 @@ typedef struct {
 /** The time between the first and second connection attempts, in ms */
 #define GRPC_ARG_INITIAL_RECONNECT_BACKOFF_MS \
   "grpc.initial_reconnect_backoff_ms"
+/** Channel arg (integer): maximum number of connections a subchannel may open
+    to its address. Once every connection of a subchannel carries at least
+    GRPC_ARG_SUBCHANNEL_CONNECTION_STREAM_THRESHOLD calls, another one is
+    opened and new calls go to the least loaded connection. Defaults to 1 (a
+    single connection per subchannel). */
+#define GRPC_ARG_MAX_CONNECTIONS_PER_SUBCHANNEL \
+  "grpc.max_connections_per_subchannel"
+/** Channel arg (integer): number of active calls on each connection of a
+    subchannel beyond which, if GRPC_ARG_MAX_CONNECTIONS_PER_SUBCHANNEL allows,
+    another connection is opened. Setting it to the server's
+    MAX_CONCURRENT_STREAMS keeps calls from queueing for a stream. Defaults to
+    100. */
+#define GRPC_ARG_SUBCHANNEL_CONNECTION_STREAM_THRESHOLD \
+  "grpc.subchannel_connection_stream_threshold"
+/** Channel arg (integer): time in ms that pick_first waits for a connection
+    attempt before also starting one to the next address, in the manner of
+    "Happy Eyeballs" (RFC 8305). The first address to connect is picked and
+    the other attempts are cancelled. 0 tries the addresses one at a time.
+    Defaults to 250. */
+#define GRPC_ARG_CONNECTION_ATTEMPT_DELAY_MS "grpc.connection_attempt_delay_ms"
 /** This *should* be used for testing only.
     The caller of the secure_channel_create functions may override the target
     name used for SSL host name checking using this channel argument which is of
@@ -247,6 +267,11 @@ typedef struct {
     secure channel is an SSL channel). If this parameter is specified and the
     underlying is not an SSL channel, it will just be ignored. */
 #define GRPC_SSL_TARGET_NAME_OVERRIDE_ARG "grpc.ssl_target_name_override"
+/** If set, a pointer to a session cache (a pointer of type
+    grpc_ssl_session_cache*, see grpc_ssl_session_cache_create_channel_arg) in
+    which SSL channels store the sessions they establish, and from which they
+    resume them when they reconnect. */
+#define GRPC_SSL_SESSION_CACHE_ARG "grpc.ssl_session_cache"
 /** Maximum metadata size, in bytes. Note this limit applies to the max sum of
     all metadata key-value entries in a batch of headers. */
 #define GRPC_ARG_MAX_METADATA_SIZE "grpc.max_metadata_size"
@@ -281,9 +306,45 @@ typedef struct {
   "grpc.experimental.tcp_min_read_chunk_size"
 #define GRPC_ARG_TCP_MAX_READ_CHUNK_SIZE \
   "grpc.experimental.tcp_max_read_chunk_size"
+/** Channel arg (integer): if non-zero, each read from the wire keeps calling
+    recvmsg (or equivalent) until the socket is drained or this many bytes have
+    been gathered, so that a single readiness notification can deliver many
+    frames at once. Defaults to 0 (one recvmsg per read). */
+#define GRPC_ARG_TCP_READ_DRAIN_BUDGET \
+  "grpc.experimental.tcp_read_drain_budget"
+/** Channel arg (integer, boolean): if non-zero and the platform supports it
+    (Linux MSG_ZEROCOPY), large writes are sent without copying them into the
+    kernel; their slices are kept alive until the kernel reports the send
+    complete. Defaults to 0. */
+#define GRPC_ARG_TCP_TX_ZEROCOPY_ENABLED \
+  "grpc.experimental.tcp_tx_zerocopy_enabled"
+/** Channel arg (integer): the smallest sendmsg, in bytes, that is sent zero
+    copy when GRPC_ARG_TCP_TX_ZEROCOPY_ENABLED is set. Smaller writes are
+    cheaper to copy than to pin. Defaults to 16KiB. */
+#define GRPC_ARG_TCP_TX_ZEROCOPY_SEND_BYTES_THRESHOLD \
+  "grpc.experimental.tcp_tx_zerocopy_send_bytes_threshold"
+/** Channel arg (integer, boolean): if non-zero and the platform supports it
+    (Linux kernel TLS), SSL connections that negotiate TLS 1.2 with AES-GCM
+    have their keys installed into the socket once the handshake is done:
+    the kernel then encrypts and decrypts records, and the transport reads
+    and writes plain TCP. Connections that cannot be offloaded keep
+    encrypting in user space. Ignored when GRPC_ARG_TCP_TX_ZEROCOPY_ENABLED is
+    set. Defaults to 0. */
+#define GRPC_ARG_TLS_KERNEL_OFFLOAD_ENABLED \
+  "grpc.experimental.tls_kernel_offload_enabled"
 /* Timeout in milliseconds to use for calls to the grpclb load balancer.
    If 0 or unset, the balancer calls will have no deadline. */
 #define GRPC_ARG_GRPCLB_CALL_TIMEOUT_MS "grpc.grpclb_timeout_ms"
+/** Channel arg (string): initial metadata key whose value the ring_hash LB
+    policy hashes to choose the backend of a call, so that calls with the same
+    value go to the same backend. Calls without that key, or all calls if
+    unset, hash their :path instead. */
+#define GRPC_ARG_RING_HASH_LB_HASH_KEY "grpc.ring_hash_lb_hash_key"
+/** Channel arg (integer): number of points each backend gets on the ring of
+    the ring_hash LB policy. More points spread the keys more evenly over the
+    backends, at the cost of a larger ring. Defaults to 100. */
+#define GRPC_ARG_RING_HASH_LB_POINTS_PER_BACKEND \
+  "grpc.ring_hash_lb_points_per_backend"
 /** If non-zero, grpc server's cronet compression workaround will be enabled */
 #define GRPC_ARG_WORKAROUND_CRONET_COMPRESSION \
   "grpc.workaround.cronet_compression"
@@ -293,7 +354,10 @@ typedef struct {
             "throughput" - attempt to maximize throughput at the expense of
                            latency
     Defaults to "blend". In the current implementation "blend" is equivalent to
-    "latency". */
+    "latency", except that HTTP/2 transports asked for "latency" explicitly
+    size each write from the observed link bandwidth, so that small RPCs are
+    not queued behind large write bursts. Otherwise up to 1MB is batched per
+    write. */
 #define GRPC_ARG_OPTIMIZATION_TARGET "grpc.optimization_target"
 /** \} */
 
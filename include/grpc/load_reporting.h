@@ -41,6 +41,14 @@ extern "C" {
  * call. */
 #define GRPC_LB_COST_MD_KEY "lb-cost-bin"
 
+/** Metadata key for per-call backend cost reporting.
+ *
+ * The value corresponding to this key is a non-negative decimal number a
+ * backend may add to its trailing metadata to tell clients how costly the call
+ * was for it. The weighted_round_robin LB policy sends each backend a share of
+ * the calls inversely proportional to the average of these costs. */
+#define GRPC_LB_BACKEND_COST_MD_KEY "lb-backend-cost"
+
 #ifdef __cplusplus
 }
 #endif
@@ -40,6 +40,7 @@
 #include "src/core/lib/iomgr/combiner.h"
 #include "src/core/lib/iomgr/iomgr.h"
 #include "src/core/lib/iomgr/polling_entity.h"
+#include "src/core/lib/iomgr/timer.h"
 #include "src/core/lib/profiling/timers.h"
 #include "src/core/lib/slice/slice_internal.h"
 #include "src/core/lib/support/string.h"
@@ -66,10 +67,17 @@ typedef enum {
   WAIT_FOR_READY_TRUE
 } wait_for_ready_value;
 
+/** Upper bound on the hedgingPolicy's maxAttempts */
+#define MAX_HEDGED_ATTEMPTS 5
+
 typedef struct {
   gpr_refcount refs;
   gpr_timespec timeout;
   wait_for_ready_value wait_for_ready;
+  /** total number of copies a hedged call may send (0 if not hedged) */
+  int hedging_max_attempts;
+  /** how long to wait for a response before sending the next copy */
+  gpr_timespec hedging_delay;
 } method_parameters;
 
 static method_parameters *method_parameters_ref(
@@ -135,9 +143,41 @@ static bool parse_timeout(grpc_json *field, gpr_timespec *timeout) {
   return true;
 }
 
+static bool parse_hedging_policy(grpc_json *field, int *max_attempts,
+                                 gpr_timespec *delay) {
+  if (field->type != GRPC_JSON_OBJECT) return false;
+  bool delay_set = false;
+  for (grpc_json *sub_field = field->child; sub_field != NULL;
+       sub_field = sub_field->next) {
+    if (sub_field->key == NULL) return false;
+    if (strcmp(sub_field->key, "maxAttempts") == 0) {
+      if (*max_attempts != 0) return false;  // Duplicate.
+      if (sub_field->type != GRPC_JSON_NUMBER) return false;
+      *max_attempts = gpr_parse_nonnegative_int(sub_field->value);
+      // A single attempt is not hedging.
+      if (*max_attempts < 2) return false;
+      if (*max_attempts > MAX_HEDGED_ATTEMPTS) {
+        gpr_log(GPR_ERROR,
+                "hedgingPolicy maxAttempts %d capped to %d", *max_attempts,
+                MAX_HEDGED_ATTEMPTS);
+        *max_attempts = MAX_HEDGED_ATTEMPTS;
+      }
+    } else if (strcmp(sub_field->key, "hedgingDelay") == 0) {
+      if (delay_set) return false;  // Duplicate.
+      if (!parse_timeout(sub_field, delay)) return false;
+      delay_set = true;
+    }
+  }
+  // maxAttempts is required; hedgingDelay defaults to sending all the
+  // attempts at once.
+  return *max_attempts != 0;
+}
+
 static void *method_parameters_create_from_json(const grpc_json *json) {
   wait_for_ready_value wait_for_ready = WAIT_FOR_READY_UNSET;
   gpr_timespec timeout = {0, 0, GPR_TIMESPAN};
+  int hedging_max_attempts = 0;
+  gpr_timespec hedging_delay = {0, 0, GPR_TIMESPAN};
   for (grpc_json *field = json->child; field != NULL; field = field->next) {
     if (field->key == NULL) continue;
     if (strcmp(field->key, "waitForReady") == 0) {
@@ -146,12 +186,20 @@ static void *method_parameters_create_from_json(const grpc_json *json) {
     } else if (strcmp(field->key, "timeout") == 0) {
       if (timeout.tv_sec > 0 || timeout.tv_nsec > 0) return NULL;  // Duplicate.
       if (!parse_timeout(field, &timeout)) return NULL;
+    } else if (strcmp(field->key, "hedgingPolicy") == 0) {
+      if (hedging_max_attempts != 0) return NULL;  // Duplicate.
+      if (!parse_hedging_policy(field, &hedging_max_attempts,
+                                &hedging_delay)) {
+        return NULL;
+      }
     }
   }
   method_parameters *value = gpr_malloc(sizeof(method_parameters));
   gpr_ref_init(&value->refs, 1);
   value->timeout = timeout;
   value->wait_for_ready = wait_for_ready;
+  value->hedging_max_attempts = hedging_max_attempts;
+  value->hedging_delay = hedging_delay;
   return value;
 }
 
@@ -161,6 +209,30 @@ struct external_connectivity_watcher;
  * CHANNEL-WIDE FUNCTIONS
  */
 
+/** What a call needs from the channel to pick a subchannel without entering
+    the combiner: an immutable copy of the LB policy's picker and of the
+    service config, rebuilt (under the combiner) whenever either changes */
+typedef struct {
+  gpr_refcount refs;
+  grpc_lb_picker *picker;
+  grpc_server_retry_throttle_data *retry_throttle_data;
+  grpc_slice_hash_table *method_params_table;
+} pick_snapshot;
+
+static void pick_snapshot_unref(grpc_exec_ctx *exec_ctx,
+                                pick_snapshot *snapshot) {
+  if (gpr_unref(&snapshot->refs)) {
+    grpc_lb_picker_unref(exec_ctx, snapshot->picker);
+    if (snapshot->retry_throttle_data != NULL) {
+      grpc_server_retry_throttle_data_unref(snapshot->retry_throttle_data);
+    }
+    if (snapshot->method_params_table != NULL) {
+      grpc_slice_hash_table_unref(exec_ctx, snapshot->method_params_table);
+    }
+    gpr_free(snapshot);
+  }
+}
+
 typedef struct client_channel_channel_data {
   /** resolver for this channel */
   grpc_resolver *resolver;
@@ -205,6 +277,18 @@ typedef struct client_channel_channel_data {
   char *info_lb_policy_name;
   /** service config in JSON form */
   char *info_service_config_json;
+
+  /* pick_snapshot is read by calls outside of the combiner without a lock:
+     it's only written under the combiner, though. See
+     acquire_pick_snapshot() for how a replaced snapshot is kept alive until
+     the calls that may have loaded it have taken their ref */
+  /** (pick_snapshot *), NULL while calls must go through the combiner for
+      their picks */
+  gpr_atm pick_snapshot;
+  /** parity of the current pick_snapshot generation */
+  gpr_atm pick_snapshot_epoch;
+  /** calls in the middle of acquire_pick_snapshot(), per epoch parity */
+  gpr_atm pick_snapshot_readers[2];
 } channel_data;
 
 /** We create one watcher for each new lb_policy that is returned from a
@@ -221,6 +305,97 @@ static void watch_lb_policy_locked(grpc_exec_ctx *exec_ctx, channel_data *chand,
                                    grpc_lb_policy *lb_policy,
                                    grpc_connectivity_state current_state);
 
+/** Replaces chand->pick_snapshot after a change of LB policy, picker or
+    service config */
+static void update_pick_snapshot_locked(grpc_exec_ctx *exec_ctx,
+                                        channel_data *chand) {
+  pick_snapshot *snapshot = NULL;
+  grpc_lb_picker *picker = chand->lb_policy == NULL
+                               ? NULL
+                               : grpc_lb_policy_ref_picker_locked(chand->lb_policy);
+  if (picker != NULL) {
+    snapshot = gpr_malloc(sizeof(*snapshot));
+    gpr_ref_init(&snapshot->refs, 1);
+    snapshot->picker = picker;
+    snapshot->retry_throttle_data =
+        chand->retry_throttle_data == NULL
+            ? NULL
+            : grpc_server_retry_throttle_data_ref(chand->retry_throttle_data);
+    snapshot->method_params_table =
+        chand->method_params_table == NULL
+            ? NULL
+            : grpc_slice_hash_table_ref(chand->method_params_table);
+  }
+  if (GRPC_TRACER_ON(grpc_client_channel_trace)) {
+    gpr_log(GPR_DEBUG, "chand=%p: updating pick snapshot to %p (picker=%p)",
+            chand, snapshot, picker);
+  }
+  pick_snapshot *old_snapshot = (pick_snapshot *)gpr_atm_full_xchg(
+      &chand->pick_snapshot, (gpr_atm)snapshot);
+  if (old_snapshot == NULL) return;
+  /* Calls that loaded the old epoch may still be about to ref old_snapshot:
+     start a new epoch and wait for them. Calls that come in now count against
+     the new epoch, so this only waits for a bounded number of calls, each a
+     few instructions away from dropping its count. */
+  gpr_atm epoch = gpr_atm_no_barrier_load(&chand->pick_snapshot_epoch);
+  gpr_atm_full_xchg(&chand->pick_snapshot_epoch, !epoch);
+  gpr_atm_full_barrier();
+  while (gpr_atm_acq_load(&chand->pick_snapshot_readers[epoch]) != 0) {
+  }
+  pick_snapshot_unref(exec_ctx, old_snapshot);
+}
+
+/** Returns a ref to chand->pick_snapshot, or NULL if there is none. Never
+    blocks: update_pick_snapshot_locked() defers dropping a replaced snapshot
+    until no call of its epoch is still between loading and reffing it. */
+static pick_snapshot *acquire_pick_snapshot(channel_data *chand) {
+  gpr_atm epoch = gpr_atm_acq_load(&chand->pick_snapshot_epoch);
+  gpr_atm_full_fetch_add(&chand->pick_snapshot_readers[epoch], 1);
+  pick_snapshot *snapshot =
+      (pick_snapshot *)gpr_atm_acq_load(&chand->pick_snapshot);
+  if (snapshot != NULL) gpr_ref_non_zero(&snapshot->refs);
+  gpr_atm_full_fetch_add(&chand->pick_snapshot_readers[epoch], -1);
+  return snapshot;
+}
+
+/** Watches a new lb_policy for the pickers it publishes, like
+    lb_policy_connectivity_watcher does for its connectivity */
+typedef struct {
+  channel_data *chand;
+  grpc_closure on_changed;
+  grpc_lb_policy *lb_policy;
+} lb_policy_picker_watcher;
+
+static void watch_lb_policy_picker_locked(grpc_exec_ctx *exec_ctx,
+                                          channel_data *chand,
+                                          grpc_lb_policy *lb_policy);
+
+static void on_lb_policy_picker_changed_locked(grpc_exec_ctx *exec_ctx,
+                                               void *arg, grpc_error *error) {
+  lb_policy_picker_watcher *w = arg;
+  /* check if the notification is for the latest policy */
+  if (w->lb_policy == w->chand->lb_policy) {
+    update_pick_snapshot_locked(exec_ctx, w->chand);
+    watch_lb_policy_picker_locked(exec_ctx, w->chand, w->lb_policy);
+  }
+  GRPC_CHANNEL_STACK_UNREF(exec_ctx, w->chand->owning_stack,
+                           "watch_lb_policy_picker");
+  gpr_free(w);
+}
+
+static void watch_lb_policy_picker_locked(grpc_exec_ctx *exec_ctx,
+                                          channel_data *chand,
+                                          grpc_lb_policy *lb_policy) {
+  lb_policy_picker_watcher *w = gpr_malloc(sizeof(*w));
+  GRPC_CHANNEL_STACK_REF(chand->owning_stack, "watch_lb_policy_picker");
+  w->chand = chand;
+  GRPC_CLOSURE_INIT(&w->on_changed, on_lb_policy_picker_changed_locked, w,
+                    grpc_combiner_scheduler(chand->combiner));
+  w->lb_policy = lb_policy;
+  grpc_lb_policy_notify_on_picker_change_locked(exec_ctx, lb_policy,
+                                                &w->on_changed);
+}
+
 static void set_channel_connectivity_state_locked(grpc_exec_ctx *exec_ctx,
                                                   channel_data *chand,
                                                   grpc_connectivity_state state,
@@ -267,6 +442,7 @@ static void on_lb_policy_state_changed_locked(grpc_exec_ctx *exec_ctx,
       grpc_resolver_channel_saw_error_locked(exec_ctx, w->chand->resolver);
       GRPC_LB_POLICY_UNREF(exec_ctx, w->chand->lb_policy, "channel");
       w->chand->lb_policy = NULL;
+      update_pick_snapshot_locked(exec_ctx, w->chand);
     }
     set_channel_connectivity_state_locked(exec_ctx, w->chand, publish_state,
                                           GRPC_ERROR_REF(error), "lb_changed");
@@ -379,12 +555,45 @@ static void on_resolver_result_changed_locked(grpc_exec_ctx *exec_ctx,
   grpc_server_retry_throttle_data *retry_throttle_data = NULL;
   grpc_slice_hash_table *method_params_table = NULL;
   if (chand->resolver_result != NULL) {
-    // Find LB policy name.
+    // Find service config.
+    grpc_service_config *service_config = NULL;
     const grpc_arg *channel_arg =
+        grpc_channel_args_find(chand->resolver_result, GRPC_ARG_SERVICE_CONFIG);
+    if (channel_arg != NULL) {
+      GPR_ASSERT(channel_arg->type == GRPC_ARG_STRING);
+      service_config_json = gpr_strdup(channel_arg->value.string);
+      service_config = grpc_service_config_create(service_config_json);
+      if (service_config != NULL) {
+        channel_arg =
+            grpc_channel_args_find(chand->resolver_result, GRPC_ARG_SERVER_URI);
+        GPR_ASSERT(channel_arg != NULL);
+        GPR_ASSERT(channel_arg->type == GRPC_ARG_STRING);
+        grpc_uri *uri =
+            grpc_uri_parse(exec_ctx, channel_arg->value.string, true);
+        GPR_ASSERT(uri->path[0] != '\0');
+        service_config_parsing_state parsing_state;
+        memset(&parsing_state, 0, sizeof(parsing_state));
+        parsing_state.server_name =
+            uri->path[0] == '/' ? uri->path + 1 : uri->path;
+        grpc_service_config_parse_global_params(
+            service_config, parse_retry_throttle_params, &parsing_state);
+        grpc_uri_destroy(uri);
+        retry_throttle_data = parsing_state.retry_throttle_data;
+        method_params_table = grpc_service_config_create_method_config_table(
+            exec_ctx, service_config, method_parameters_create_from_json,
+            method_parameters_free);
+      }
+    }
+    // Find LB policy name: the channel arg takes precedence over the service
+    // config's choice.
+    channel_arg =
         grpc_channel_args_find(chand->resolver_result, GRPC_ARG_LB_POLICY_NAME);
     if (channel_arg != NULL) {
       GPR_ASSERT(channel_arg->type == GRPC_ARG_STRING);
       lb_policy_name = channel_arg->value.string;
+    } else if (service_config != NULL) {
+      lb_policy_name =
+          (char *)grpc_service_config_get_lb_policy_name(service_config);
     }
     // Special case: If at least one balancer address is present, we use
     // the grpclb policy, regardless of what the resolver actually specified.
@@ -436,40 +645,11 @@ static void on_resolver_result_changed_locked(grpc_exec_ctx *exec_ctx,
         gpr_log(GPR_ERROR, "could not create LB policy \"%s\"", lb_policy_name);
       }
     }
-    // Find service config.
-    channel_arg =
-        grpc_channel_args_find(chand->resolver_result, GRPC_ARG_SERVICE_CONFIG);
-    if (channel_arg != NULL) {
-      GPR_ASSERT(channel_arg->type == GRPC_ARG_STRING);
-      service_config_json = gpr_strdup(channel_arg->value.string);
-      grpc_service_config *service_config =
-          grpc_service_config_create(service_config_json);
-      if (service_config != NULL) {
-        channel_arg =
-            grpc_channel_args_find(chand->resolver_result, GRPC_ARG_SERVER_URI);
-        GPR_ASSERT(channel_arg != NULL);
-        GPR_ASSERT(channel_arg->type == GRPC_ARG_STRING);
-        grpc_uri *uri =
-            grpc_uri_parse(exec_ctx, channel_arg->value.string, true);
-        GPR_ASSERT(uri->path[0] != '\0');
-        service_config_parsing_state parsing_state;
-        memset(&parsing_state, 0, sizeof(parsing_state));
-        parsing_state.server_name =
-            uri->path[0] == '/' ? uri->path + 1 : uri->path;
-        grpc_service_config_parse_global_params(
-            service_config, parse_retry_throttle_params, &parsing_state);
-        grpc_uri_destroy(uri);
-        retry_throttle_data = parsing_state.retry_throttle_data;
-        method_params_table = grpc_service_config_create_method_config_table(
-            exec_ctx, service_config, method_parameters_create_from_json,
-            method_parameters_free);
-        grpc_service_config_destroy(service_config);
-      }
-    }
     // Before we clean up, save a copy of lb_policy_name, since it might
-    // be pointing to data inside chand->resolver_result.
+    // be pointing to data inside chand->resolver_result or service_config.
     // The copy will be saved in chand->lb_policy_name below.
     lb_policy_name = gpr_strdup(lb_policy_name);
+    if (service_config != NULL) grpc_service_config_destroy(service_config);
     grpc_channel_args_destroy(exec_ctx, chand->resolver_result);
     chand->resolver_result = NULL;
   }
@@ -525,6 +705,7 @@ static void on_resolver_result_changed_locked(grpc_exec_ctx *exec_ctx,
     }
     chand->lb_policy = new_lb_policy;
   }
+  update_pick_snapshot_locked(exec_ctx, chand);
   // Now that we've swapped out the relevant fields of chand, check for
   // error or shutdown.
   if (error != GRPC_ERROR_NONE || chand->resolver == NULL) {
@@ -571,6 +752,7 @@ static void on_resolver_result_changed_locked(grpc_exec_ctx *exec_ctx,
         chand->exit_idle_when_lb_policy_arrives = false;
       }
       watch_lb_policy_locked(exec_ctx, chand, new_lb_policy, state);
+      watch_lb_policy_picker_locked(exec_ctx, chand, new_lb_policy);
     }
     if (!lb_policy_updated) {
       set_channel_connectivity_state_locked(exec_ctx, chand, state,
@@ -630,6 +812,7 @@ static void start_transport_op_locked(grpc_exec_ctx *exec_ctx, void *arg,
                                          chand->interested_parties);
         GRPC_LB_POLICY_UNREF(exec_ctx, chand->lb_policy, "channel");
         chand->lb_policy = NULL;
+        update_pick_snapshot_locked(exec_ctx, chand);
       }
     }
     GRPC_ERROR_UNREF(op->disconnect_with_error);
@@ -688,6 +871,10 @@ static grpc_error *cc_init_channel_elem(grpc_exec_ctx *exec_ctx,
   // Initialize data members.
   chand->combiner = grpc_combiner_create();
   gpr_mu_init(&chand->info_mu);
+  gpr_atm_no_barrier_store(&chand->pick_snapshot, (gpr_atm)NULL);
+  gpr_atm_no_barrier_store(&chand->pick_snapshot_epoch, 0);
+  gpr_atm_no_barrier_store(&chand->pick_snapshot_readers[0], 0);
+  gpr_atm_no_barrier_store(&chand->pick_snapshot_readers[1], 0);
   gpr_mu_init(&chand->external_connectivity_watcher_list_mu);
 
   gpr_mu_lock(&chand->external_connectivity_watcher_list_mu);
@@ -779,6 +966,11 @@ static void cc_destroy_channel_elem(grpc_exec_ctx *exec_ctx,
   }
   grpc_connectivity_state_destroy(exec_ctx, &chand->state_tracker);
   grpc_pollset_set_destroy(exec_ctx, chand->interested_parties);
+  pick_snapshot *snapshot =
+      (pick_snapshot *)gpr_atm_no_barrier_load(&chand->pick_snapshot);
+  if (snapshot != NULL) {
+    pick_snapshot_unref(exec_ctx, snapshot);
+  }
   GRPC_COMBINER_UNREF(exec_ctx, chand->combiner, "client_channel");
   gpr_mu_destroy(&chand->info_mu);
   gpr_mu_destroy(&chand->external_connectivity_watcher_list_mu);
@@ -841,6 +1033,15 @@ typedef struct client_channel_call_data {
 
   grpc_closure on_complete;
   grpc_closure *original_on_complete;
+
+  /** how many batches were sent through the combiner: a subchannel call
+      created outside of it (see pick_subchannel_from_snapshot()) then has to
+      resume the batches waiting for it there */
+  gpr_atm combiner_batches;
+  grpc_closure resume_batches_closure;
+
+  /** set while the call's batch is hedged (see hedging_start_locked()) */
+  struct hedging_state *hedging;
 } call_data;
 
 typedef struct {
@@ -930,45 +1131,720 @@ static void waiting_for_pick_batches_resume_locked(grpc_exec_ctx *exec_ctx,
   calld->waiting_for_pick_batches_count = 0;
 }
 
+// Applies the service config given by retry_throttle_data and
+// method_params (the call's entry in the method params table) to the call.
+static void apply_service_config_to_call(
+    grpc_exec_ctx *exec_ctx, grpc_call_element *elem,
+    grpc_server_retry_throttle_data *retry_throttle_data,
+    method_parameters *method_params) {
+  channel_data *chand = elem->channel_data;
+  call_data *calld = elem->call_data;
+  if (GRPC_TRACER_ON(grpc_client_channel_trace)) {
+    gpr_log(GPR_DEBUG, "chand=%p calld=%p: applying service config to call",
+            chand, calld);
+  }
+  if (retry_throttle_data != NULL) {
+    calld->retry_throttle_data =
+        grpc_server_retry_throttle_data_ref(retry_throttle_data);
+  }
+  if (method_params != NULL) {
+    calld->method_params = method_parameters_ref(method_params);
+    // If the deadline from the service config is shorter than the one
+    // from the client API, reset the deadline timer.
+    if (chand->deadline_checking_enabled &&
+        gpr_time_cmp(calld->method_params->timeout,
+                     gpr_time_0(GPR_TIMESPAN)) != 0) {
+      const gpr_timespec per_method_deadline =
+          gpr_time_add(calld->call_start_time, calld->method_params->timeout);
+      if (gpr_time_cmp(per_method_deadline, calld->deadline) < 0) {
+        calld->deadline = per_method_deadline;
+        grpc_deadline_state_reset(exec_ctx, elem, calld->deadline);
+      }
+    }
+  }
+}
+
 // Applies service config to the call.  Must be invoked once we know
 // that the resolver has returned results to the channel.
 static void apply_service_config_to_call_locked(grpc_exec_ctx *exec_ctx,
                                                 grpc_call_element *elem) {
   channel_data *chand = elem->channel_data;
   call_data *calld = elem->call_data;
+  method_parameters *method_params =
+      chand->method_params_table == NULL
+          ? NULL
+          : grpc_method_config_table_get(exec_ctx, chand->method_params_table,
+                                         calld->path);
+  apply_service_config_to_call(exec_ctx, elem, chand->retry_throttle_data,
+                               method_params);
+}
+
+/*************************************************************************
+ * HEDGING
+ */
+
+/* A hedged call sends up to hedging_max_attempts copies of its request, each
+   on its own subchannel call and hedging_delay apart, until one of them gets
+   a response: that attempt gets committed (it answers the surface batch and
+   becomes the call's subchannel call), and the others get cancelled.
+
+   Only calls that send their whole request and ask for their whole response
+   in a single batch (ie. unary calls) are hedged, so that a single surface
+   batch has to be answered. Every response is final (nonFatalStatusCodes are
+   not supported): only attempts failing at the transport level (eg. because
+   their connection broke) let the others, or the next hedge, answer instead.
+
+   Hedges are picked from the LB policy's picker, preferring subchannels that
+   no live attempt uses, and are subject to the retry throttle. */
+
+typedef enum {
+  HEDGED_ATTEMPT_RECV_INITIAL_METADATA,
+  HEDGED_ATTEMPT_RECV_MESSAGE,
+  HEDGED_ATTEMPT_ON_COMPLETE,
+  HEDGED_ATTEMPT_NUM_CLOSURES
+} hedged_attempt_closure;
+
+typedef struct hedged_attempt {
+  grpc_call_element *elem;
+
+  /** calld's own pick for the first attempt, owned by the attempt otherwise */
+  grpc_connected_subchannel *connected_subchannel;
+  grpc_call_context_element *context;
+  grpc_call_context_element hedge_context[GRPC_CONTEXT_COUNT];
+  grpc_linked_mdelem lb_token_mdelem;
+
+  grpc_subchannel_call *subchannel_call;
+  /** false once subchannel_call got handed over to calld at commit time */
+  bool owns_subchannel_call;
+  /** whether the attempt's batch reached subchannel_call */
+  bool sent;
+  /** cancelled, because the attempt either failed or lost */
+  bool abandoned;
+
+  grpc_transport_stream_op_batch batch;
+  grpc_transport_stream_op_batch_payload payload;
+  /** copies of the request for the hedges: the first attempt sends the
+      surface batch's metadata */
+  grpc_metadata_batch send_initial_metadata;
+  grpc_metadata_batch send_trailing_metadata;
+  grpc_slice_buffer_stream send_message;
+  /** the response, moved to the surface batch if the attempt gets committed */
+  grpc_metadata_batch recv_initial_metadata;
+  uint32_t recv_flags;
+  bool trailing_metadata_available;
+  grpc_byte_stream *recv_message;
+  grpc_metadata_batch recv_trailing_metadata;
+  grpc_transport_stream_stats collect_stats;
+
+  grpc_closure closures[HEDGED_ATTEMPT_NUM_CLOSURES];
+  bool closure_done[HEDGED_ATTEMPT_NUM_CLOSURES];
+  grpc_error *closure_error[HEDGED_ATTEMPT_NUM_CLOSURES];
+  /** closures yet to run: the attempt holds a call stack ref until then */
+  int pending_closures;
+
+  grpc_closure cleanup_closure;
+} hedged_attempt;
+
+typedef struct hedging_state {
+  /** the surface batch being hedged */
+  grpc_transport_stream_op_batch *batch;
+  int max_attempts;
+  gpr_timespec delay;
+
+  /** the request, as the hedges send it */
+  grpc_metadata_batch send_initial_metadata;
+  grpc_metadata_batch send_trailing_metadata;
+  grpc_slice_buffer send_message;
+  uint32_t send_message_flags;
+
+  hedged_attempt *attempts[MAX_HEDGED_ATTEMPTS];
+  size_t num_attempts;
+  /** the attempt answering the surface batch, once one got a response */
+  hedged_attempt *committed;
+  /** set if the surface batch got cancelled before any commit */
+  bool cancelled;
+
+  grpc_timer hedge_timer;
+  bool hedge_timer_pending;
+  grpc_closure on_hedge_timer;
+
+  /** the attempts' subchannel calls must be gone before cc_destroy_call_elem()
+      lets the call's arena go: see hedging_destroy() */
+  gpr_refcount cleanup_refs;
+  grpc_closure cleanup_closure;
+  grpc_closure *then_schedule_closure;
+} hedging_state;
+
+static bool batch_can_hedge(grpc_transport_stream_op_batch *batch) {
+  return batch->send_initial_metadata && batch->send_message &&
+         batch->send_trailing_metadata && batch->recv_initial_metadata &&
+         batch->recv_message && batch->recv_trailing_metadata &&
+         !batch->cancel_stream;
+}
+
+/* Makes dst a copy of src, minus the element stored in skip (if any). */
+static void copy_metadata_batch(grpc_exec_ctx *exec_ctx, gpr_arena *arena,
+                                grpc_metadata_batch *dst,
+                                grpc_metadata_batch *src,
+                                grpc_linked_mdelem *skip) {
+  grpc_metadata_batch_init(dst);
+  dst->deadline = src->deadline;
+  if (src->list.count == 0) return;
+  grpc_linked_mdelem *storage =
+      gpr_arena_alloc(arena, sizeof(*storage) * src->list.count);
+  for (grpc_linked_mdelem *l = src->list.head; l != NULL; l = l->next) {
+    if (l == skip) continue;
+    GRPC_LOG_IF_ERROR("copy_metadata_batch",
+                      grpc_metadata_batch_add_tail(exec_ctx, dst, storage++,
+                                                   GRPC_MDELEM_REF(l->md)));
+  }
+}
+
+static bool hedging_subchannel_in_use(hedging_state *hs,
+                                      grpc_connected_subchannel *subchannel) {
+  for (size_t i = 0; i < hs->num_attempts; ++i) {
+    if (!hs->attempts[i]->abandoned &&
+        hs->attempts[i]->connected_subchannel == subchannel) {
+      return true;
+    }
+  }
+  return false;
+}
+
+static bool hedging_has_live_attempts(hedging_state *hs) {
+  for (size_t i = 0; i < hs->num_attempts; ++i) {
+    if (!hs->attempts[i]->abandoned) return true;
+  }
+  return false;
+}
+
+/* Undoes a hedge's pick, so that it can pick again. */
+static void hedged_attempt_drop_pick(grpc_exec_ctx *exec_ctx,
+                                     hedged_attempt *attempt) {
+  if (attempt->connected_subchannel != NULL) {
+    GRPC_CONNECTED_SUBCHANNEL_UNREF(exec_ctx, attempt->connected_subchannel,
+                                    "hedge_picked");
+    attempt->connected_subchannel = NULL;
+  }
+  for (size_t i = 0; i < GRPC_CONTEXT_COUNT; ++i) {
+    if (attempt->context[i].value != NULL) {
+      attempt->context[i].destroy(attempt->context[i].value);
+      attempt->context[i].value = NULL;
+    }
+  }
+  for (grpc_linked_mdelem *l = attempt->send_initial_metadata.list.head;
+       l != NULL; l = l->next) {
+    if (l == &attempt->lb_token_mdelem) {
+      grpc_metadata_batch_remove(exec_ctx, &attempt->send_initial_metadata, l);
+      break;
+    }
+  }
+}
+
+static void hedged_attempt_cancel_locked(grpc_exec_ctx *exec_ctx,
+                                         hedged_attempt *attempt,
+                                         grpc_error *error) {
+  attempt->abandoned = true;
+  if (!attempt->sent) {
+    GRPC_ERROR_UNREF(error);
+    return;
+  }
+  grpc_transport_stream_op_batch *batch = grpc_make_transport_stream_op(NULL);
+  batch->cancel_stream = true;
+  batch->payload->cancel_stream.cancel_error = error;
+  grpc_subchannel_call_process_op(exec_ctx, attempt->subchannel_call, batch);
+}
+
+/* Hands the response of the committed attempt, as far as it got, over to the
+   surface batch. */
+static void hedged_attempt_deliver_locked(grpc_exec_ctx *exec_ctx,
+                                          hedged_attempt *attempt,
+                                          hedged_attempt_closure which) {
+  call_data *calld = attempt->elem->call_data;
+  grpc_transport_stream_op_batch *batch = calld->hedging->batch;
+  grpc_transport_stream_op_batch_payload *payload = batch->payload;
+  grpc_error *error = GRPC_ERROR_REF(attempt->closure_error[which]);
+  switch (which) {
+    case HEDGED_ATTEMPT_RECV_INITIAL_METADATA:
+      *payload->recv_initial_metadata.recv_initial_metadata =
+          attempt->recv_initial_metadata;
+      if (payload->recv_initial_metadata.recv_flags != NULL) {
+        *payload->recv_initial_metadata.recv_flags = attempt->recv_flags;
+      }
+      if (payload->recv_initial_metadata.trailing_metadata_available != NULL) {
+        *payload->recv_initial_metadata.trailing_metadata_available =
+            attempt->trailing_metadata_available;
+      }
+      GRPC_CLOSURE_SCHED(
+          exec_ctx, payload->recv_initial_metadata.recv_initial_metadata_ready,
+          error);
+      break;
+    case HEDGED_ATTEMPT_RECV_MESSAGE:
+      *payload->recv_message.recv_message = attempt->recv_message;
+      GRPC_CLOSURE_SCHED(exec_ctx, payload->recv_message.recv_message_ready,
+                         error);
+      break;
+    case HEDGED_ATTEMPT_ON_COMPLETE:
+      *payload->recv_trailing_metadata.recv_trailing_metadata =
+          attempt->recv_trailing_metadata;
+      if (batch->collect_stats) {
+        grpc_transport_move_stats(&attempt->collect_stats,
+                                  payload->collect_stats.collect_stats);
+      }
+      GRPC_CLOSURE_SCHED(exec_ctx, batch->on_complete, error);
+      break;
+    case HEDGED_ATTEMPT_NUM_CLOSURES:
+      GPR_UNREACHABLE_CODE(break);
+  }
+}
+
+static void hedged_attempt_commit_locked(grpc_exec_ctx *exec_ctx,
+                                         hedged_attempt *attempt) {
+  grpc_call_element *elem = attempt->elem;
+  call_data *calld = elem->call_data;
+  hedging_state *hs = calld->hedging;
   if (GRPC_TRACER_ON(grpc_client_channel_trace)) {
-    gpr_log(GPR_DEBUG, "chand=%p calld=%p: applying service config to call",
-            chand, calld);
+    gpr_log(GPR_DEBUG,
+            "chand=%p calld=%p: committing hedged attempt %p "
+            "(subchannel_call=%p)",
+            elem->channel_data, calld, attempt, attempt->subchannel_call);
+  }
+  hs->committed = attempt;
+  if (hs->hedge_timer_pending) {
+    grpc_timer_cancel(exec_ctx, &hs->hedge_timer);
+  }
+  for (size_t i = 0; i < hs->num_attempts; ++i) {
+    hedged_attempt *other = hs->attempts[i];
+    if (other != attempt && !other->abandoned) {
+      hedged_attempt_cancel_locked(
+          exec_ctx, other,
+          grpc_error_set_int(
+              GRPC_ERROR_CREATE_FROM_STATIC_STRING("Hedged attempt lost"),
+              GRPC_ERROR_INT_GRPC_STATUS, GRPC_STATUS_CANCELLED));
+    }
   }
-  if (chand->retry_throttle_data != NULL) {
-    calld->retry_throttle_data =
-        grpc_server_retry_throttle_data_ref(chand->retry_throttle_data);
+  /* from now on, the surface's batches go straight to the winner */
+  if (set_call_or_error(calld, (call_or_error){.subchannel_call =
+                                                   attempt->subchannel_call})) {
+    attempt->owns_subchannel_call = false;
   }
-  if (chand->method_params_table != NULL) {
-    calld->method_params = grpc_method_config_table_get(
-        exec_ctx, chand->method_params_table, calld->path);
-    if (calld->method_params != NULL) {
-      method_parameters_ref(calld->method_params);
-      // If the deadline from the service config is shorter than the one
-      // from the client API, reset the deadline timer.
-      if (chand->deadline_checking_enabled &&
-          gpr_time_cmp(calld->method_params->timeout,
-                       gpr_time_0(GPR_TIMESPAN)) != 0) {
-        const gpr_timespec per_method_deadline =
-            gpr_time_add(calld->call_start_time, calld->method_params->timeout);
-        if (gpr_time_cmp(per_method_deadline, calld->deadline) < 0) {
-          calld->deadline = per_method_deadline;
-          grpc_deadline_state_reset(exec_ctx, elem, calld->deadline);
-        }
+  waiting_for_pick_batches_resume_locked(exec_ctx, elem);
+  for (int i = 0; i < HEDGED_ATTEMPT_NUM_CLOSURES; ++i) {
+    if (attempt->closure_done[i]) {
+      hedged_attempt_deliver_locked(exec_ctx, attempt,
+                                    (hedged_attempt_closure)i);
+    }
+  }
+}
+
+static void hedged_attempt_start_locked(
+    grpc_exec_ctx *exec_ctx, grpc_call_element *elem, hedged_attempt *attempt,
+    grpc_metadata_batch *send_initial_metadata,
+    grpc_metadata_batch *send_trailing_metadata);
+
+/* Picks and sends the next hedge, if the hedging policy and the retry
+   throttle allow it. Returns false if nothing was sent. */
+static bool hedging_start_next_attempt_locked(grpc_exec_ctx *exec_ctx,
+                                              grpc_call_element *elem) {
+  channel_data *chand = elem->channel_data;
+  call_data *calld = elem->call_data;
+  hedging_state *hs = calld->hedging;
+  if (hs->num_attempts == (size_t)hs->max_attempts) return false;
+  if (calld->retry_throttle_data != NULL &&
+      !grpc_server_retry_throttle_data_retries_allowed(
+          calld->retry_throttle_data)) {
+    if (GRPC_TRACER_ON(grpc_client_channel_trace)) {
+      gpr_log(GPR_DEBUG, "chand=%p calld=%p: hedge throttled", chand, calld);
+    }
+    return false;
+  }
+  grpc_lb_picker *picker =
+      chand->lb_policy == NULL
+          ? NULL
+          : grpc_lb_policy_ref_picker_locked(chand->lb_policy);
+  if (picker == NULL) return false;
+  hedged_attempt *attempt = gpr_arena_alloc(calld->arena, sizeof(*attempt));
+  memset(attempt, 0, sizeof(*attempt));
+  attempt->elem = elem;
+  attempt->context = attempt->hedge_context;
+  copy_metadata_batch(exec_ctx, calld->arena, &attempt->send_initial_metadata,
+                      &hs->send_initial_metadata, NULL);
+  copy_metadata_batch(exec_ctx, calld->arena, &attempt->send_trailing_metadata,
+                      &hs->send_trailing_metadata, NULL);
+  const grpc_lb_policy_pick_args inputs = {
+      &attempt->send_initial_metadata,
+      hs->batch->payload->send_initial_metadata.send_initial_metadata_flags,
+      &attempt->lb_token_mdelem};
+  /* prefer a subchannel that no live attempt is using, but settle for any */
+  bool picked = false;
+  for (int i = 0; i < hs->max_attempts; ++i) {
+    if (picked) hedged_attempt_drop_pick(exec_ctx, attempt);
+    picked = grpc_lb_picker_pick(exec_ctx, picker, &inputs,
+                                 &attempt->connected_subchannel,
+                                 attempt->context);
+    if (!picked ||
+        !hedging_subchannel_in_use(hs, attempt->connected_subchannel)) {
+      break;
+    }
+  }
+  grpc_lb_picker_unref(exec_ctx, picker);
+  if (!picked || attempt->connected_subchannel == NULL) {
+    if (GRPC_TRACER_ON(grpc_client_channel_trace)) {
+      gpr_log(GPR_DEBUG, "chand=%p calld=%p: no subchannel to hedge on",
+              chand, calld);
+    }
+    hedged_attempt_drop_pick(exec_ctx, attempt);
+    grpc_metadata_batch_destroy(exec_ctx, &attempt->send_initial_metadata);
+    grpc_metadata_batch_destroy(exec_ctx, &attempt->send_trailing_metadata);
+    return false;
+  }
+  hedged_attempt_start_locked(exec_ctx, elem, attempt,
+                              &attempt->send_initial_metadata,
+                              &attempt->send_trailing_metadata);
+  return true;
+}
+
+/* Called when an attempt failed without a response: lets another attempt
+   answer the call if there's one, or else the failure. */
+static void hedged_attempt_failed_locked(grpc_exec_ctx *exec_ctx,
+                                         hedged_attempt *attempt) {
+  grpc_call_element *elem = attempt->elem;
+  call_data *calld = elem->call_data;
+  hedging_state *hs = calld->hedging;
+  if (calld->retry_throttle_data != NULL) {
+    grpc_server_retry_throttle_data_record_failure(calld->retry_throttle_data);
+  }
+  attempt->abandoned = true;
+  /* don't wait for the hedging delay to replace it */
+  if (!hedging_start_next_attempt_locked(exec_ctx, elem) &&
+      !hedging_has_live_attempts(hs)) {
+    attempt->abandoned = false;
+    hedged_attempt_commit_locked(exec_ctx, attempt);
+  } else {
+    if (GRPC_TRACER_ON(grpc_client_channel_trace)) {
+      gpr_log(GPR_DEBUG, "chand=%p calld=%p: abandoning hedged attempt %p",
+              elem->channel_data, calld, attempt);
+    }
+    hedged_attempt_cancel_locked(
+        exec_ctx, attempt,
+        GRPC_ERROR_CREATE_FROM_STATIC_STRING("Hedged attempt failed"));
+  }
+}
+
+static void hedged_attempt_closure_done_locked(grpc_exec_ctx *exec_ctx,
+                                               hedged_attempt *attempt,
+                                               hedged_attempt_closure which,
+                                               grpc_error *error) {
+  call_data *calld = attempt->elem->call_data;
+  hedging_state *hs = calld->hedging;
+  attempt->closure_done[which] = true;
+  attempt->closure_error[which] = GRPC_ERROR_REF(error);
+  if (hs->committed == attempt) {
+    hedged_attempt_deliver_locked(exec_ctx, attempt, which);
+  } else if (hs->committed == NULL && !hs->cancelled && !attempt->abandoned) {
+    if (error != GRPC_ERROR_NONE) {
+      hedged_attempt_failed_locked(exec_ctx, attempt);
+    } else if (which == HEDGED_ATTEMPT_ON_COMPLETE ||
+               (which == HEDGED_ATTEMPT_RECV_INITIAL_METADATA &&
+                !grpc_metadata_batch_is_empty(
+                    &attempt->recv_initial_metadata))) {
+      /* either the server's headers, or a Trailers-Only response */
+      hedged_attempt_commit_locked(exec_ctx, attempt);
+    }
+  }
+  if (--attempt->pending_closures == 0) {
+    if (hs->committed != attempt) {
+      grpc_metadata_batch_destroy(exec_ctx, &attempt->recv_initial_metadata);
+      grpc_metadata_batch_destroy(exec_ctx, &attempt->recv_trailing_metadata);
+      if (attempt->recv_message != NULL) {
+        grpc_byte_stream_destroy(exec_ctx, attempt->recv_message);
       }
     }
+    for (int i = 0; i < HEDGED_ATTEMPT_NUM_CLOSURES; ++i) {
+      GRPC_ERROR_UNREF(attempt->closure_error[i]);
+    }
+    GRPC_CALL_STACK_UNREF(exec_ctx, calld->owning_call, "hedged_attempt");
+  }
+}
+
+static void hedged_attempt_recv_initial_metadata_ready_locked(
+    grpc_exec_ctx *exec_ctx, void *arg, grpc_error *error) {
+  hedged_attempt_closure_done_locked(exec_ctx, arg,
+                                     HEDGED_ATTEMPT_RECV_INITIAL_METADATA,
+                                     error);
+}
+
+static void hedged_attempt_recv_message_ready_locked(grpc_exec_ctx *exec_ctx,
+                                                     void *arg,
+                                                     grpc_error *error) {
+  hedged_attempt_closure_done_locked(exec_ctx, arg, HEDGED_ATTEMPT_RECV_MESSAGE,
+                                     error);
+}
+
+static void hedged_attempt_on_complete_locked(grpc_exec_ctx *exec_ctx,
+                                              void *arg, grpc_error *error) {
+  hedged_attempt_closure_done_locked(exec_ctx, arg, HEDGED_ATTEMPT_ON_COMPLETE,
+                                     error);
+}
+
+/* Creates the attempt's subchannel call and sends it the request, asking for
+   the whole response. */
+static void hedged_attempt_start_locked(
+    grpc_exec_ctx *exec_ctx, grpc_call_element *elem, hedged_attempt *attempt,
+    grpc_metadata_batch *send_initial_metadata,
+    grpc_metadata_batch *send_trailing_metadata) {
+  channel_data *chand = elem->channel_data;
+  call_data *calld = elem->call_data;
+  hedging_state *hs = calld->hedging;
+  grpc_transport_stream_op_batch_payload *surface_payload = hs->batch->payload;
+  hs->attempts[hs->num_attempts++] = attempt;
+  GRPC_CALL_STACK_REF(calld->owning_call, "hedged_attempt");
+  attempt->pending_closures = HEDGED_ATTEMPT_NUM_CLOSURES;
+  GRPC_CLOSURE_INIT(
+      &attempt->closures[HEDGED_ATTEMPT_RECV_INITIAL_METADATA],
+      hedged_attempt_recv_initial_metadata_ready_locked, attempt,
+      grpc_combiner_scheduler(chand->combiner));
+  GRPC_CLOSURE_INIT(&attempt->closures[HEDGED_ATTEMPT_RECV_MESSAGE],
+                    hedged_attempt_recv_message_ready_locked, attempt,
+                    grpc_combiner_scheduler(chand->combiner));
+  GRPC_CLOSURE_INIT(&attempt->closures[HEDGED_ATTEMPT_ON_COMPLETE],
+                    hedged_attempt_on_complete_locked, attempt,
+                    grpc_combiner_scheduler(chand->combiner));
+  grpc_transport_stream_op_batch *batch = &attempt->batch;
+  grpc_transport_stream_op_batch_payload *payload = &attempt->payload;
+  batch->payload = payload;
+  batch->on_complete = &attempt->closures[HEDGED_ATTEMPT_ON_COMPLETE];
+  batch->send_initial_metadata = true;
+  batch->send_message = true;
+  batch->send_trailing_metadata = true;
+  batch->recv_initial_metadata = true;
+  batch->recv_message = true;
+  batch->recv_trailing_metadata = true;
+  batch->collect_stats = hs->batch->collect_stats;
+  payload->send_initial_metadata.send_initial_metadata = send_initial_metadata;
+  payload->send_initial_metadata.send_initial_metadata_flags =
+      surface_payload->send_initial_metadata.send_initial_metadata_flags;
+  payload->send_trailing_metadata.send_trailing_metadata =
+      send_trailing_metadata;
+  grpc_slice_buffer_stream_init(&attempt->send_message, &hs->send_message,
+                                hs->send_message_flags);
+  payload->send_message.send_message = &attempt->send_message.base;
+  grpc_metadata_batch_init(&attempt->recv_initial_metadata);
+  payload->recv_initial_metadata.recv_initial_metadata =
+      &attempt->recv_initial_metadata;
+  if (surface_payload->recv_initial_metadata.recv_flags != NULL) {
+    payload->recv_initial_metadata.recv_flags = &attempt->recv_flags;
+  }
+  if (surface_payload->recv_initial_metadata.trailing_metadata_available !=
+      NULL) {
+    payload->recv_initial_metadata.trailing_metadata_available =
+        &attempt->trailing_metadata_available;
+  }
+  payload->recv_initial_metadata.recv_initial_metadata_ready =
+      &attempt->closures[HEDGED_ATTEMPT_RECV_INITIAL_METADATA];
+  payload->recv_message.recv_message = &attempt->recv_message;
+  payload->recv_message.recv_message_ready =
+      &attempt->closures[HEDGED_ATTEMPT_RECV_MESSAGE];
+  grpc_metadata_batch_init(&attempt->recv_trailing_metadata);
+  payload->recv_trailing_metadata.recv_trailing_metadata =
+      &attempt->recv_trailing_metadata;
+  payload->collect_stats.collect_stats = &attempt->collect_stats;
+  payload->context = surface_payload->context;
+  const grpc_connected_subchannel_call_args call_args = {
+      .pollent = calld->pollent,
+      .path = calld->path,
+      .start_time = calld->call_start_time,
+      .deadline = calld->deadline,
+      .arena = calld->arena,
+      .context = attempt->context};
+  grpc_error *error = grpc_connected_subchannel_create_call(
+      exec_ctx, attempt->connected_subchannel, &call_args,
+      &attempt->subchannel_call);
+  attempt->owns_subchannel_call = true;
+  if (GRPC_TRACER_ON(grpc_client_channel_trace)) {
+    gpr_log(GPR_DEBUG,
+            "chand=%p calld=%p: starting hedged attempt %" PRIuPTR
+            " %p: create subchannel_call=%p: error=%s",
+            chand, calld, hs->num_attempts, attempt, attempt->subchannel_call,
+            grpc_error_string(error));
+  }
+  if (error != GRPC_ERROR_NONE) {
+    grpc_transport_stream_op_batch_finish_with_failure(exec_ctx, batch, error);
+  } else {
+    attempt->sent = true;
+    grpc_subchannel_call_process_op(exec_ctx, attempt->subchannel_call, batch);
+  }
+}
+
+static void hedging_arm_timer_locked(grpc_exec_ctx *exec_ctx,
+                                     grpc_call_element *elem) {
+  call_data *calld = elem->call_data;
+  hedging_state *hs = calld->hedging;
+  GRPC_CALL_STACK_REF(calld->owning_call, "hedge_timer");
+  hs->hedge_timer_pending = true;
+  const gpr_timespec now = gpr_now(GPR_CLOCK_MONOTONIC);
+  grpc_timer_init(exec_ctx, &hs->hedge_timer, gpr_time_add(now, hs->delay),
+                  &hs->on_hedge_timer, now);
+}
+
+static void on_hedge_timer_locked(grpc_exec_ctx *exec_ctx, void *arg,
+                                  grpc_error *error) {
+  grpc_call_element *elem = arg;
+  call_data *calld = elem->call_data;
+  hedging_state *hs = calld->hedging;
+  hs->hedge_timer_pending = false;
+  if (error == GRPC_ERROR_NONE && hs->committed == NULL && !hs->cancelled) {
+    if (GRPC_TRACER_ON(grpc_client_channel_trace)) {
+      gpr_log(GPR_DEBUG, "chand=%p calld=%p: no response after %" PRIuPTR
+                         " hedged attempts, hedging",
+              elem->channel_data, calld, hs->num_attempts);
+    }
+    if (hedging_start_next_attempt_locked(exec_ctx, elem) &&
+        hs->num_attempts < (size_t)hs->max_attempts) {
+      hedging_arm_timer_locked(exec_ctx, elem);
+    }
+  }
+  GRPC_CALL_STACK_UNREF(exec_ctx, calld->owning_call, "hedge_timer");
+}
+
+/* Hedges the batch waiting for the pick, which carries the whole call: the
+   first attempt goes to the subchannel calld picked. */
+static void hedging_start_locked(grpc_exec_ctx *exec_ctx,
+                                 grpc_call_element *elem) {
+  channel_data *chand = elem->channel_data;
+  call_data *calld = elem->call_data;
+  hedging_state *hs = gpr_arena_alloc(calld->arena, sizeof(*hs));
+  memset(hs, 0, sizeof(*hs));
+  calld->hedging = hs;
+  hs->batch = calld->waiting_for_pick_batches[0];
+  calld->waiting_for_pick_batches_count = 0;
+  hs->max_attempts = calld->method_params->hedging_max_attempts;
+  hs->delay = calld->method_params->hedging_delay;
+  if (GRPC_TRACER_ON(grpc_client_channel_trace)) {
+    gpr_log(GPR_DEBUG,
+            "chand=%p calld=%p: hedging up to %d attempts every %" PRId64
+            ".%09ds",
+            chand, calld, hs->max_attempts, hs->delay.tv_sec,
+            hs->delay.tv_nsec);
+  }
+  /* keep the request around for the hedges, before the first attempt's
+     filters get to change it */
+  grpc_transport_stream_op_batch_payload *payload = hs->batch->payload;
+  copy_metadata_batch(exec_ctx, calld->arena, &hs->send_initial_metadata,
+                      payload->send_initial_metadata.send_initial_metadata,
+                      &calld->lb_token_mdelem);
+  copy_metadata_batch(exec_ctx, calld->arena, &hs->send_trailing_metadata,
+                      payload->send_trailing_metadata.send_trailing_metadata,
+                      NULL);
+  /* the surface's messages are backed by a slice buffer (see
+     grpc_call_start_batch()), so they can be read right away */
+  grpc_byte_stream *message = payload->send_message.send_message;
+  hs->send_message_flags = message->flags;
+  grpc_slice_buffer_init(&hs->send_message);
+  while (hs->send_message.length < message->length) {
+    const int available =
+        grpc_byte_stream_next(exec_ctx, message, SIZE_MAX, NULL);
+    GPR_ASSERT(available);
+    grpc_slice slice;
+    grpc_error *error = grpc_byte_stream_pull(exec_ctx, message, &slice);
+    GPR_ASSERT(error == GRPC_ERROR_NONE);
+    grpc_slice_buffer_add(&hs->send_message, slice);
+  }
+  GRPC_CLOSURE_INIT(&hs->on_hedge_timer, on_hedge_timer_locked, elem,
+                    grpc_combiner_scheduler(chand->combiner));
+  hedged_attempt *attempt = gpr_arena_alloc(calld->arena, sizeof(*attempt));
+  memset(attempt, 0, sizeof(*attempt));
+  attempt->elem = elem;
+  attempt->connected_subchannel = calld->connected_subchannel;
+  attempt->context = calld->subchannel_call_context;
+  hedged_attempt_start_locked(
+      exec_ctx, elem, attempt,
+      payload->send_initial_metadata.send_initial_metadata,
+      payload->send_trailing_metadata.send_trailing_metadata);
+  hedging_arm_timer_locked(exec_ctx, elem);
+}
+
+/* Cancels the surface batch before any attempt got committed. */
+static void hedging_cancel_locked(grpc_exec_ctx *exec_ctx,
+                                  grpc_call_element *elem, grpc_error *error) {
+  call_data *calld = elem->call_data;
+  hedging_state *hs = calld->hedging;
+  GPR_ASSERT(hs->committed == NULL);
+  if (hs->cancelled) {
+    GRPC_ERROR_UNREF(error);
+    return;
+  }
+  hs->cancelled = true;
+  if (hs->hedge_timer_pending) {
+    grpc_timer_cancel(exec_ctx, &hs->hedge_timer);
+  }
+  for (size_t i = 0; i < hs->num_attempts; ++i) {
+    if (!hs->attempts[i]->abandoned) {
+      hedged_attempt_cancel_locked(exec_ctx, hs->attempts[i],
+                                   GRPC_ERROR_REF(error));
+    }
+  }
+  grpc_transport_stream_op_batch_finish_with_failure(exec_ctx, hs->batch,
+                                                     error);
+}
+
+static void hedging_cleanup_done(grpc_exec_ctx *exec_ctx, void *arg,
+                                 grpc_error *error) {
+  hedging_state *hs = arg;
+  if (gpr_unref(&hs->cleanup_refs)) {
+    GRPC_CLOSURE_SCHED(exec_ctx, hs->then_schedule_closure, GRPC_ERROR_NONE);
+  }
+}
+
+/* Releases what the call's attempts still hold. Returns the closure to use
+   in place of then_schedule_closure, which waits for the attempts' subchannel
+   calls to be destroyed too. */
+static grpc_closure *hedging_destroy(grpc_exec_ctx *exec_ctx,
+                                     grpc_call_element *elem,
+                                     grpc_closure *then_schedule_closure) {
+  call_data *calld = elem->call_data;
+  hedging_state *hs = calld->hedging;
+  grpc_metadata_batch_destroy(exec_ctx, &hs->send_initial_metadata);
+  grpc_metadata_batch_destroy(exec_ctx, &hs->send_trailing_metadata);
+  grpc_slice_buffer_destroy_internal(exec_ctx, &hs->send_message);
+  hs->then_schedule_closure = then_schedule_closure;
+  gpr_ref_init(&hs->cleanup_refs, 1);
+  GRPC_CLOSURE_INIT(&hs->cleanup_closure, hedging_cleanup_done, hs,
+                    grpc_schedule_on_exec_ctx);
+  for (size_t i = 0; i < hs->num_attempts; ++i) {
+    hedged_attempt *attempt = hs->attempts[i];
+    GPR_ASSERT(attempt->pending_closures == 0);
+    /* the first attempt's pick and request belong to calld */
+    if (i > 0) {
+      hedged_attempt_drop_pick(exec_ctx, attempt);
+      grpc_metadata_batch_destroy(exec_ctx, &attempt->send_initial_metadata);
+      grpc_metadata_batch_destroy(exec_ctx, &attempt->send_trailing_metadata);
+    }
+    if (attempt->owns_subchannel_call) {
+      gpr_ref(&hs->cleanup_refs);
+      GRPC_CLOSURE_INIT(&attempt->cleanup_closure, hedging_cleanup_done, hs,
+                        grpc_schedule_on_exec_ctx);
+      grpc_subchannel_call_set_cleanup_closure(attempt->subchannel_call,
+                                               &attempt->cleanup_closure);
+      GRPC_SUBCHANNEL_CALL_UNREF(exec_ctx, attempt->subchannel_call,
+                                 "hedged_attempt");
+    }
   }
+  return &hs->cleanup_closure;
 }
 
 static void create_subchannel_call_locked(grpc_exec_ctx *exec_ctx,
                                           grpc_call_element *elem,
                                           grpc_error *error) {
   call_data *calld = elem->call_data;
+  if (calld->method_params != NULL &&
+      calld->method_params->hedging_max_attempts > 0 &&
+      calld->waiting_for_pick_batches_count == 1 &&
+      batch_can_hedge(calld->waiting_for_pick_batches[0])) {
+    hedging_start_locked(exec_ctx, elem);
+    GRPC_ERROR_UNREF(error);
+    return;
+  }
   grpc_subchannel_call *subchannel_call = NULL;
   const grpc_connected_subchannel_call_args call_args = {
       .pollent = calld->pollent,
@@ -1304,7 +2180,9 @@ static void start_transport_stream_op_batch_locked(grpc_exec_ctx *exec_ctx,
        is in the past when the call starts), we can return the right
        error to the caller when the first batch does get passed down. */
     set_call_or_error(calld, (call_or_error){.error = GRPC_ERROR_REF(error)});
-    if (calld->lb_policy != NULL) {
+    if (calld->hedging != NULL) {
+      hedging_cancel_locked(exec_ctx, elem, GRPC_ERROR_REF(error));
+    } else if (calld->lb_policy != NULL) {
       pick_callback_cancel_locked(exec_ctx, elem, GRPC_ERROR_REF(error));
     } else {
       pick_after_resolver_result_cancel_locked(exec_ctx, elem,
@@ -1365,14 +2243,106 @@ static void on_complete(grpc_exec_ctx *exec_ctx, void *arg, grpc_error *error) {
                    GRPC_ERROR_REF(error));
 }
 
+static void resume_waiting_batches_locked(grpc_exec_ctx *exec_ctx, void *arg,
+                                          grpc_error *error_ignored) {
+  grpc_call_element *elem = arg;
+  call_data *calld = elem->call_data;
+  waiting_for_pick_batches_resume_locked(exec_ctx, elem);
+  GRPC_CALL_STACK_UNREF(exec_ctx, calld->owning_call, "resume_waiting_batches");
+}
+
+/* Picks a subchannel from chand->pick_snapshot, creates the subchannel call
+   and sends it batch (which carries send_initial_metadata), all without
+   entering the combiner. Returns false, with calld left untouched, if the
+   batch must go through the combiner instead. */
+static bool pick_subchannel_from_snapshot(
+    grpc_exec_ctx *exec_ctx, grpc_call_element *elem,
+    grpc_transport_stream_op_batch *batch) {
+  channel_data *chand = elem->channel_data;
+  call_data *calld = elem->call_data;
+  /* batches already sent through the combiner expect the pick to be made
+     there */
+  if (gpr_atm_acq_load(&calld->combiner_batches) != 0) return false;
+  pick_snapshot *snapshot = acquire_pick_snapshot(chand);
+  if (snapshot == NULL) return false;
+  method_parameters *method_params =
+      snapshot->method_params_table == NULL
+          ? NULL
+          : grpc_method_config_table_get(
+                exec_ctx, snapshot->method_params_table, calld->path);
+  /* hedged calls juggle their attempts under the combiner */
+  if (method_params != NULL && method_params->hedging_max_attempts > 0 &&
+      batch_can_hedge(batch)) {
+    pick_snapshot_unref(exec_ctx, snapshot);
+    return false;
+  }
+  const grpc_lb_policy_pick_args inputs = {
+      batch->payload->send_initial_metadata.send_initial_metadata,
+      batch->payload->send_initial_metadata.send_initial_metadata_flags,
+      &calld->lb_token_mdelem};
+  const bool picked = grpc_lb_picker_pick(exec_ctx, snapshot->picker, &inputs,
+                                          &calld->connected_subchannel,
+                                          calld->subchannel_call_context);
+  if (picked) {
+    apply_service_config_to_call(exec_ctx, elem, snapshot->retry_throttle_data,
+                                 method_params);
+  }
+  pick_snapshot_unref(exec_ctx, snapshot);
+  if (!picked) return false;
+  grpc_subchannel_call *subchannel_call = NULL;
+  const grpc_connected_subchannel_call_args call_args = {
+      .pollent = calld->pollent,
+      .path = calld->path,
+      .start_time = calld->call_start_time,
+      .deadline = calld->deadline,
+      .arena = calld->arena,
+      .context = calld->subchannel_call_context};
+  grpc_error *error = grpc_connected_subchannel_create_call(
+      exec_ctx, calld->connected_subchannel, &call_args, &subchannel_call);
+  if (GRPC_TRACER_ON(grpc_client_channel_trace)) {
+    gpr_log(GPR_DEBUG,
+            "chand=%p calld=%p: picked without combiner: create "
+            "subchannel_call=%p: error=%s",
+            chand, calld, subchannel_call, grpc_error_string(error));
+  }
+  if (!gpr_atm_full_cas(&calld->subchannel_call_or_error, 0,
+                        (gpr_atm)subchannel_call)) {
+    /* the call got cancelled through the combiner meanwhile */
+    GRPC_ERROR_UNREF(error);
+    GRPC_SUBCHANNEL_CALL_UNREF(exec_ctx, subchannel_call,
+                               "client_channel_cancelled_pick");
+    grpc_transport_stream_op_batch_finish_with_failure(
+        exec_ctx, batch, GRPC_ERROR_REF(get_call_or_error(calld).error));
+    return true;
+  }
+  /* pairs with the increment in cc_start_transport_stream_op_batch(): either
+     we see it, or the batch it counts sees subchannel_call in the combiner */
+  if (gpr_atm_full_fetch_add(&calld->combiner_batches, 0) != 0) {
+    GRPC_CALL_STACK_REF(calld->owning_call, "resume_waiting_batches");
+    GRPC_CLOSURE_SCHED(
+        exec_ctx,
+        GRPC_CLOSURE_INIT(&calld->resume_batches_closure,
+                          resume_waiting_batches_locked, elem,
+                          grpc_combiner_scheduler(chand->combiner)),
+        GRPC_ERROR_NONE);
+  }
+  if (error != GRPC_ERROR_NONE) {
+    grpc_transport_stream_op_batch_finish_with_failure(exec_ctx, batch, error);
+  } else {
+    grpc_subchannel_call_process_op(exec_ctx, subchannel_call, batch);
+  }
+  return true;
+}
+
 /* The logic here is fairly complicated, due to (a) the fact that we
    need to handle the case where we receive the send op before the
    initial metadata op, and (b) the need for efficiency, especially in
    the streaming case.
 
    We use double-checked locking to initially see if initialization has been
-   performed. If it has not, we acquire the combiner and perform initialization.
-   If it has, we proceed on the fast path. */
+   performed. If it has not, we acquire the combiner and perform initialization
+   (unless the LB policy's picker lets us do it right away). If it has, we
+   proceed on the fast path. */
 static void cc_start_transport_stream_op_batch(
     grpc_exec_ctx *exec_ctx, grpc_call_element *elem,
     grpc_transport_stream_op_batch *batch) {
@@ -1416,10 +2386,17 @@ static void cc_start_transport_stream_op_batch(
     grpc_subchannel_call_process_op(exec_ctx, coe.subchannel_call, batch);
     goto done;
   }
+  /* if this batch starts the call, the LB policy's picker may let us get a
+     subchannel call without the combiner */
+  if (batch->send_initial_metadata && !batch->cancel_stream &&
+      pick_subchannel_from_snapshot(exec_ctx, elem, batch)) {
+    goto done;
+  }
   /* we failed; lock and figure out what to do */
   if (GRPC_TRACER_ON(grpc_client_channel_trace)) {
     gpr_log(GPR_DEBUG, "chand=%p calld=%p: entering combiner", chand, calld);
   }
+  gpr_atm_full_fetch_add(&calld->combiner_batches, 1);
   GRPC_CALL_STACK_REF(calld->owning_call, "start_transport_stream_op_batch");
   batch->handler_private.extra_arg = elem;
   GRPC_CLOSURE_SCHED(
@@ -1463,6 +2440,10 @@ static void cc_destroy_call_elem(grpc_exec_ctx *exec_ctx,
   if (calld->method_params != NULL) {
     method_parameters_unref(calld->method_params);
   }
+  if (calld->hedging != NULL) {
+    then_schedule_closure =
+        hedging_destroy(exec_ctx, elem, then_schedule_closure);
+  }
   call_or_error coe = get_call_or_error(calld);
   GRPC_ERROR_UNREF(coe.error);
   if (coe.subchannel_call != NULL) {
@@ -33,6 +33,8 @@ void grpc_lb_policy_init(grpc_lb_policy *policy,
   gpr_atm_no_barrier_store(&policy->ref_pair, 1 << WEAK_REF_BITS);
   policy->interested_parties = grpc_pollset_set_create();
   policy->combiner = GRPC_COMBINER_REF(combiner, "lb_policy");
+  policy->picker = NULL;
+  policy->on_picker_changed = NULL;
 }
 
 #ifndef NDEBUG
@@ -69,6 +71,14 @@ static void shutdown_locked(grpc_exec_ctx *exec_ctx, void *arg,
                             grpc_error *error) {
   grpc_lb_policy *policy = arg;
   policy->vtable->shutdown_locked(exec_ctx, policy);
+  /* nobody picks from a policy that is shut down: drop its picker, and let
+     whoever watches it know */
+  if (policy->picker != NULL) {
+    grpc_lb_picker_unref(exec_ctx, policy->picker);
+    policy->picker = NULL;
+  }
+  GRPC_CLOSURE_SCHED(exec_ctx, policy->on_picker_changed, GRPC_ERROR_NONE);
+  policy->on_picker_changed = NULL;
   GRPC_LB_POLICY_WEAK_UNREF(exec_ctx, policy, "strong-unref");
 }
 
@@ -106,6 +116,30 @@ void grpc_lb_policy_weak_unref(grpc_exec_ctx *exec_ctx,
   }
 }
 
+void grpc_lb_picker_init(grpc_lb_picker *picker,
+                         const grpc_lb_picker_vtable *vtable) {
+  picker->vtable = vtable;
+  gpr_ref_init(&picker->refs, 1);
+}
+
+grpc_lb_picker *grpc_lb_picker_ref(grpc_lb_picker *picker) {
+  gpr_ref_non_zero(&picker->refs);
+  return picker;
+}
+
+void grpc_lb_picker_unref(grpc_exec_ctx *exec_ctx, grpc_lb_picker *picker) {
+  if (gpr_unref(&picker->refs)) {
+    picker->vtable->destroy(exec_ctx, picker);
+  }
+}
+
+bool grpc_lb_picker_pick(grpc_exec_ctx *exec_ctx, grpc_lb_picker *picker,
+                         const grpc_lb_policy_pick_args *pick_args,
+                         grpc_connected_subchannel **target,
+                         grpc_call_context_element *context) {
+  return picker->vtable->pick(exec_ctx, picker, pick_args, target, context);
+}
+
 int grpc_lb_policy_pick_locked(grpc_exec_ctx *exec_ctx, grpc_lb_policy *policy,
                                const grpc_lb_policy_pick_args *pick_args,
                                grpc_connected_subchannel **target,
@@ -162,3 +196,26 @@ void grpc_lb_policy_update_locked(grpc_exec_ctx *exec_ctx,
                                   const grpc_lb_policy_args *lb_policy_args) {
   policy->vtable->update_locked(exec_ctx, policy, lb_policy_args);
 }
+
+void grpc_lb_policy_set_picker_locked(grpc_exec_ctx *exec_ctx,
+                                      grpc_lb_policy *policy,
+                                      grpc_lb_picker *picker) {
+  if (picker == NULL && policy->picker == NULL) return;
+  if (policy->picker != NULL) {
+    grpc_lb_picker_unref(exec_ctx, policy->picker);
+  }
+  policy->picker = picker;
+  GRPC_CLOSURE_SCHED(exec_ctx, policy->on_picker_changed, GRPC_ERROR_NONE);
+  policy->on_picker_changed = NULL;
+}
+
+grpc_lb_picker *grpc_lb_policy_ref_picker_locked(grpc_lb_policy *policy) {
+  return policy->picker == NULL ? NULL : grpc_lb_picker_ref(policy->picker);
+}
+
+void grpc_lb_policy_notify_on_picker_change_locked(grpc_exec_ctx *exec_ctx,
+                                                   grpc_lb_policy *policy,
+                                                   grpc_closure *closure) {
+  GPR_ASSERT(policy->on_picker_changed == NULL);
+  policy->on_picker_changed = closure;
+}
@@ -28,6 +28,7 @@
 typedef struct grpc_lb_policy grpc_lb_policy;
 typedef struct grpc_lb_policy_vtable grpc_lb_policy_vtable;
 typedef struct grpc_lb_policy_args grpc_lb_policy_args;
+typedef struct grpc_lb_picker grpc_lb_picker;
 
 #ifndef NDEBUG
 extern grpc_tracer_flag grpc_trace_lb_policy_refcount;
@@ -40,6 +41,12 @@ struct grpc_lb_policy {
   grpc_pollset_set *interested_parties;
   /* combiner under which lb_policy actions take place */
   grpc_combiner *combiner;
+  /* latest picker published by the policy (owned), or NULL if picks must go
+     through pick_locked: guarded by the combiner */
+  grpc_lb_picker *picker;
+  /* closure to invoke when a new picker gets published, or NULL: guarded by
+     the combiner */
+  grpc_closure *on_picker_changed;
 };
 
 /** Extra arguments for an LB pick */
@@ -54,6 +61,26 @@ typedef struct grpc_lb_policy_pick_args {
   grpc_linked_mdelem *lb_token_mdelem_storage;
 } grpc_lb_policy_pick_args;
 
+/** A picker is an immutable snapshot of the picking decisions of an LB policy
+    (eg. the list of READY subchannels), that channels can consult from any
+    thread without entering the policy's combiner. It is published by the
+    policy (see \a grpc_lb_policy_set_picker_locked) whenever the outcome of
+    its picks may have changed. */
+typedef struct grpc_lb_picker_vtable {
+  void (*destroy)(grpc_exec_ctx *exec_ctx, grpc_lb_picker *picker);
+
+  /** \see grpc_lb_picker_pick */
+  bool (*pick)(grpc_exec_ctx *exec_ctx, grpc_lb_picker *picker,
+               const grpc_lb_policy_pick_args *pick_args,
+               grpc_connected_subchannel **target,
+               grpc_call_context_element *context);
+} grpc_lb_picker_vtable;
+
+struct grpc_lb_picker {
+  const grpc_lb_picker_vtable *vtable;
+  gpr_refcount refs;
+};
+
 struct grpc_lb_policy_vtable {
   void (*destroy)(grpc_exec_ctx *exec_ctx, grpc_lb_policy *policy);
   void (*shutdown_locked)(grpc_exec_ctx *exec_ctx, grpc_lb_policy *policy);
@@ -139,6 +166,26 @@ void grpc_lb_policy_init(grpc_lb_policy *policy,
                          const grpc_lb_policy_vtable *vtable,
                          grpc_combiner *combiner);
 
+/** called by concrete implementations to initialize the base picker struct,
+    with a single ref owned by the caller */
+void grpc_lb_picker_init(grpc_lb_picker *picker,
+                         const grpc_lb_picker_vtable *vtable);
+
+grpc_lb_picker *grpc_lb_picker_ref(grpc_lb_picker *picker);
+void grpc_lb_picker_unref(grpc_exec_ctx *exec_ctx, grpc_lb_picker *picker);
+
+/** Picks a subchannel for a call without waiting for anything, and without
+    needing the policy's combiner: safe to call from any thread.
+
+    Returns true with \a target set to a new ref to the selected subchannel,
+    or false if the pick must go through \a grpc_lb_policy_pick_locked (eg.
+    because no subchannel is READY). Pickers don't fail or queue picks, so
+    they may ignore the wait_for_ready bit of \a pick_args. */
+bool grpc_lb_picker_pick(grpc_exec_ctx *exec_ctx, grpc_lb_picker *picker,
+                         const grpc_lb_policy_pick_args *pick_args,
+                         grpc_connected_subchannel **target,
+                         grpc_call_context_element *context);
+
 /** Finds an appropriate subchannel for a call, based on \a pick_args.
 
     \a target will be set to the selected subchannel, or NULL on failure
@@ -199,6 +246,23 @@ grpc_connectivity_state grpc_lb_policy_check_connectivity_locked(
     grpc_exec_ctx *exec_ctx, grpc_lb_policy *policy,
     grpc_error **connectivity_error);
 
+/** Called by concrete implementations to publish \a picker (taking ownership
+    of the caller's ref), replacing the previous one. NULL means that picks must
+    go through \a grpc_lb_policy_pick_locked. */
+void grpc_lb_policy_set_picker_locked(grpc_exec_ctx *exec_ctx,
+                                      grpc_lb_policy *policy,
+                                      grpc_lb_picker *picker);
+
+/** Returns a new ref to the latest picker published by \a policy, or NULL if
+    there is none */
+grpc_lb_picker *grpc_lb_policy_ref_picker_locked(grpc_lb_policy *policy);
+
+/** Invoke \a closure the next time \a policy publishes a picker, or when it
+    shuts down. Only one closure may be pending at a time. */
+void grpc_lb_policy_notify_on_picker_change_locked(grpc_exec_ctx *exec_ctx,
+                                                   grpc_lb_policy *policy,
+                                                   grpc_closure *closure);
+
 /** Update \a policy with \a lb_policy_args. */
 void grpc_lb_policy_update_locked(grpc_exec_ctx *exec_ctx,
                                   grpc_lb_policy *policy,
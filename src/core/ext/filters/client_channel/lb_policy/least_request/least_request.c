@@ -0,0 +1,907 @@
+/*
+ *
+ * Copyright 2017 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/** Least Request Policy.
+ *
+ * Tracks the number of calls in flight on every subchannel: a pick counts
+ * against the subchannel it returns until the call receives its trailing
+ * metadata, as seen by the least_request_call_tracking filter added to the
+ * subchannels created by this policy (or until the call is destroyed, should
+ * that never happen). Every pick draws two distinct READY subchannels at random
+ * and returns the one with fewer calls in flight ("power of two choices"),
+ * which steers traffic away from backends that are slow to complete their calls
+ * without the herding that always picking the least loaded one would cause.
+ *
+ * Subchannel lists are managed as round_robin's (see subchannel_list.h). */
+
+#include <string.h>
+
+#include <grpc/support/alloc.h>
+
+#include "src/core/ext/filters/client_channel/lb_policy/subchannel_list.h"
+#include "src/core/ext/filters/client_channel/lb_policy_registry.h"
+#include "src/core/ext/filters/client_channel/subchannel.h"
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/channel/channel_stack_builder.h"
+#include "src/core/lib/debug/trace.h"
+#include "src/core/lib/profiling/timers.h"
+#include "src/core/lib/surface/channel_init.h"
+#include "src/core/lib/transport/connectivity_state.h"
+
+grpc_tracer_flag grpc_lb_least_request_trace =
+    GRPC_TRACER_INITIALIZER(false, "least_request");
+
+/** List of entities waiting for a pick.
+ *
+ * Once a pick is available, \a target is updated and \a on_complete called. */
+typedef struct pending_pick {
+  struct pending_pick *next;
+
+  /* output argument where to store the pick()ed user_data. It'll be NULL if no
+   * such data is present or there's an error (the definite test for errors is
+   * \a target being NULL). */
+  void **user_data;
+
+  /* bitmask passed to pick() and used for selective cancelling. See
+   * grpc_lb_policy_cancel_picks() */
+  uint32_t initial_metadata_flags;
+
+  /* output argument where to store the pick()ed connected subchannel, or NULL
+   * upon error. */
+  grpc_connected_subchannel **target;
+
+  /* call context of the pick: tracks the call against the subchannel picked */
+  grpc_call_context_element *context;
+
+  /* to be invoked once the pick() has completed (regardless of success) */
+  grpc_closure *on_complete;
+} pending_pick;
+
+/** Number of calls in flight on a connected subchannel. Shared by the pickers
+ * offering the connected subchannel and by the calls that picked it. */
+typedef struct {
+  gpr_refcount refs;
+  gpr_atm in_flight;
+} lr_load;
+
+static lr_load *lr_load_create(void) {
+  lr_load *load = gpr_malloc(sizeof(*load));
+  gpr_ref_init(&load->refs, 1);
+  gpr_atm_no_barrier_store(&load->in_flight, 0);
+  return load;
+}
+
+static lr_load *lr_load_ref(lr_load *load) {
+  gpr_ref_non_zero(&load->refs);
+  return load;
+}
+
+static void lr_load_unref(lr_load *load) {
+  if (gpr_unref(&load->refs)) {
+    gpr_free(load);
+  }
+}
+
+/** A call counted against the load of the subchannel it picked. Shared by the
+ * call's context (GRPC_CONTEXT_LB_CALL_STATE) and the call tracking filter of
+ * the subchannel call. */
+typedef struct {
+  gpr_refcount refs;
+  lr_load *load;
+  /** set once the call no longer counts against \a load */
+  gpr_atm done;
+} lr_call_state;
+
+static lr_call_state *lr_call_state_ref(lr_call_state *state) {
+  gpr_ref_non_zero(&state->refs);
+  return state;
+}
+
+static void lr_call_state_unref(lr_call_state *state) {
+  if (gpr_unref(&state->refs)) {
+    lr_load_unref(state->load);
+    gpr_free(state);
+  }
+}
+
+/** Stops counting the call against its load. Idempotent. */
+static void lr_call_state_finish(lr_call_state *state) {
+  if (gpr_atm_no_barrier_cas(&state->done, 0, 1)) {
+    gpr_atm_no_barrier_fetch_add(&state->load->in_flight, -1);
+  }
+}
+
+/** Destroy function of GRPC_CONTEXT_LB_CALL_STATE: calls that never got their
+ * trailing metadata stop counting here */
+static void lr_call_state_context_destroy(void *arg) {
+  lr_call_state *state = arg;
+  lr_call_state_finish(state);
+  lr_call_state_unref(state);
+}
+
+/** Counts the call owning \a context against \a load until it receives its
+ * trailing metadata */
+static void lr_load_call_started(lr_load *load,
+                                 grpc_call_context_element *context) {
+  if (context == NULL) return;
+  grpc_call_context_element *call_state = &context[GRPC_CONTEXT_LB_CALL_STATE];
+  if (call_state->value != NULL) {
+    /* the call is picking again: it's done with its previous subchannel */
+    call_state->destroy(call_state->value);
+  }
+  lr_call_state *state = gpr_malloc(sizeof(*state));
+  gpr_ref_init(&state->refs, 1);
+  state->load = lr_load_ref(load);
+  gpr_atm_no_barrier_store(&state->done, 0);
+  gpr_atm_no_barrier_fetch_add(&load->in_flight, 1);
+  call_state->value = state;
+  call_state->destroy = lr_call_state_context_destroy;
+}
+
+typedef struct least_request_lb_policy {
+  /** base policy: must be first */
+  grpc_lb_policy base;
+
+  grpc_lb_subchannel_list *subchannel_list;
+
+  /** have we started picking? */
+  bool started_picking;
+  /** are we shutting down? */
+  bool shutdown;
+  /** List of picks that are waiting on connectivity */
+  pending_pick *pending_picks;
+
+  /** our connectivity state tracker */
+  grpc_connectivity_state_tracker state_tracker;
+
+  /** Latest version of the subchannel list.
+   * Subchannel connectivity callbacks will only promote updated subchannel
+   * lists if they equal \a latest_pending_subchannel_list. In other words,
+   * racing callbacks that reference outdated subchannel lists won't perform any
+   * update. */
+  grpc_lb_subchannel_list *latest_pending_subchannel_list;
+} least_request_lb_policy;
+
+/** A READY subchannel, as seen by an \a lr_picker */
+typedef struct {
+  grpc_connected_subchannel *connected_subchannel;
+  lr_load *load;
+  /** index of the subchannel in the policy's subchannel list */
+  size_t subchannel_list_index;
+} lr_picker_entry;
+
+/** Picker choosing among the subchannels that were READY when it was
+ * published. The policy picks through it as well while it's published. */
+typedef struct {
+  /** base picker: must be first */
+  grpc_lb_picker base;
+  /** number of draws so far, mixed into the random numbers */
+  gpr_atm draws;
+  uint64_t seed;
+  size_t num_subchannels;
+  lr_picker_entry *subchannels;
+} lr_picker;
+
+/* splitmix64's output function: consecutive inputs give uncorrelated outputs */
+static uint64_t mix64(uint64_t x) {
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+  return x ^ (x >> 31);
+}
+
+/** Draws two distinct subchannels and returns the less loaded one */
+static lr_picker_entry *lr_picker_choose(lr_picker *picker) {
+  const size_t n = picker->num_subchannels;
+  if (n == 1) return &picker->subchannels[0];
+  const uint64_t draw =
+      (uint64_t)gpr_atm_no_barrier_fetch_add(&picker->draws, 1);
+  const uint64_t r = mix64(picker->seed + draw * 0x9e3779b97f4a7c15ULL);
+  const size_t first = (size_t)(r % n);
+  const size_t second = (first + 1 + (size_t)((r >> 32) % (n - 1))) % n;
+  lr_picker_entry *a = &picker->subchannels[first];
+  lr_picker_entry *b = &picker->subchannels[second];
+  return gpr_atm_no_barrier_load(&b->load->in_flight) <
+                 gpr_atm_no_barrier_load(&a->load->in_flight)
+             ? b
+             : a;
+}
+
+static void lr_picker_destroy(grpc_exec_ctx *exec_ctx, grpc_lb_picker *base) {
+  lr_picker *picker = (lr_picker *)base;
+  for (size_t i = 0; i < picker->num_subchannels; i++) {
+    GRPC_CONNECTED_SUBCHANNEL_UNREF(
+        exec_ctx, picker->subchannels[i].connected_subchannel, "lr_picker");
+    lr_load_unref(picker->subchannels[i].load);
+  }
+  gpr_free(picker->subchannels);
+  gpr_free(picker);
+}
+
+static bool lr_picker_pick(grpc_exec_ctx *exec_ctx, grpc_lb_picker *base,
+                           const grpc_lb_policy_pick_args *pick_args,
+                           grpc_connected_subchannel **target,
+                           grpc_call_context_element *context) {
+  lr_picker_entry *entry = lr_picker_choose((lr_picker *)base);
+  *target =
+      GRPC_CONNECTED_SUBCHANNEL_REF(entry->connected_subchannel, "lr_picked");
+  lr_load_call_started(entry->load, context);
+  return true;
+}
+
+static const grpc_lb_picker_vtable lr_picker_vtable = {lr_picker_destroy,
+                                                       lr_picker_pick};
+
+/** Returns the load of \a connected_subchannel in \a picker if it's there, so
+ * that calls in flight keep counting across pickers (and subchannel lists,
+ * which share their subchannels), or a new one */
+static lr_load *lr_picker_find_load(
+    lr_picker *picker, grpc_connected_subchannel *connected_subchannel) {
+  if (picker != NULL) {
+    for (size_t i = 0; i < picker->num_subchannels; i++) {
+      if (picker->subchannels[i].connected_subchannel == connected_subchannel) {
+        return lr_load_ref(picker->subchannels[i].load);
+      }
+    }
+  }
+  return lr_load_create();
+}
+
+/** Publishes a picker for the READY subchannels of p->subchannel_list (or none
+ * at all if there are no such subchannels) */
+static void lr_update_picker_locked(grpc_exec_ctx *exec_ctx,
+                                    least_request_lb_policy *p) {
+  grpc_lb_subchannel_list *subchannel_list = p->subchannel_list;
+  if (p->shutdown || subchannel_list == NULL ||
+      subchannel_list->num_ready == 0) {
+    grpc_lb_policy_set_picker_locked(exec_ctx, &p->base, NULL);
+    return;
+  }
+  lr_picker *old_picker = (lr_picker *)p->base.picker;
+  lr_picker *picker = gpr_zalloc(sizeof(*picker));
+  grpc_lb_picker_init(&picker->base, &lr_picker_vtable);
+  picker->seed = (uint64_t)(uintptr_t)picker ^
+                 (uint64_t)gpr_now(GPR_CLOCK_MONOTONIC).tv_nsec;
+  picker->subchannels = gpr_malloc(sizeof(*picker->subchannels) *
+                                   subchannel_list->num_ready);
+  for (size_t i = 0; i < subchannel_list->num_subchannels; i++) {
+    grpc_lb_subchannel_data *sd = &subchannel_list->subchannels[i];
+    if (sd->curr_connectivity_state != GRPC_CHANNEL_READY) continue;
+    grpc_connected_subchannel *connected_subchannel =
+        grpc_subchannel_get_connected_subchannel(sd->subchannel);
+    if (connected_subchannel == NULL) continue;
+    GPR_ASSERT(picker->num_subchannels < subchannel_list->num_ready);
+    lr_picker_entry *entry = &picker->subchannels[picker->num_subchannels++];
+    entry->connected_subchannel =
+        GRPC_CONNECTED_SUBCHANNEL_REF(connected_subchannel, "lr_picker");
+    entry->load = lr_picker_find_load(old_picker, connected_subchannel);
+    entry->subchannel_list_index = i;
+  }
+  if (GRPC_TRACER_ON(grpc_lb_least_request_trace)) {
+    gpr_log(GPR_DEBUG, "[LR %p] publishing picker %p over %lu subchannels",
+            (void *)p, (void *)picker, (unsigned long)picker->num_subchannels);
+  }
+  if (picker->num_subchannels == 0) {
+    lr_picker_destroy(exec_ctx, &picker->base);
+    picker = NULL;
+  }
+  grpc_lb_policy_set_picker_locked(exec_ctx, &p->base,
+                                   picker == NULL ? NULL : &picker->base);
+}
+
+/** Picks from the published picker into \a target and \a user_data, returning
+ * false if there's nothing to pick from */
+static bool lr_pick_from_picker_locked(least_request_lb_policy *p,
+                                       grpc_connected_subchannel **target,
+                                       grpc_call_context_element *context,
+                                       void **user_data) {
+  if (p->base.picker == NULL) return false;
+  /* the picker only knows about READY subchannels of p->subchannel_list */
+  GPR_ASSERT(p->subchannel_list != NULL);
+  lr_picker_entry *entry = lr_picker_choose((lr_picker *)p->base.picker);
+  grpc_lb_subchannel_data *sd =
+      &p->subchannel_list->subchannels[entry->subchannel_list_index];
+  *target =
+      GRPC_CONNECTED_SUBCHANNEL_REF(entry->connected_subchannel, "lr_picked");
+  if (user_data != NULL) {
+    *user_data = sd->user_data;
+  }
+  lr_load_call_started(entry->load, context);
+  if (GRPC_TRACER_ON(grpc_lb_least_request_trace)) {
+    gpr_log(GPR_DEBUG,
+            "[LR %p] Picked target <-- Subchannel %p (connected %p) (sl %p, "
+            "index %lu, in flight %ld)",
+            (void *)p, (void *)sd->subchannel, (void *)*target,
+            (void *)sd->subchannel_list,
+            (unsigned long)entry->subchannel_list_index,
+            (long)gpr_atm_no_barrier_load(&entry->load->in_flight));
+  }
+  return true;
+}
+
+static void lr_destroy(grpc_exec_ctx *exec_ctx, grpc_lb_policy *pol) {
+  least_request_lb_policy *p = (least_request_lb_policy *)pol;
+  if (GRPC_TRACER_ON(grpc_lb_least_request_trace)) {
+    gpr_log(GPR_DEBUG, "[LR %p] Destroying Least Request policy at %p",
+            (void *)pol, (void *)pol);
+  }
+  grpc_connectivity_state_destroy(exec_ctx, &p->state_tracker);
+  gpr_free(p);
+}
+
+static void lr_shutdown_locked(grpc_exec_ctx *exec_ctx, grpc_lb_policy *pol) {
+  least_request_lb_policy *p = (least_request_lb_policy *)pol;
+  if (GRPC_TRACER_ON(grpc_lb_least_request_trace)) {
+    gpr_log(GPR_DEBUG, "[LR %p] Shutting down Least Request policy at %p",
+            (void *)pol, (void *)pol);
+  }
+  p->shutdown = true;
+  pending_pick *pp;
+  while ((pp = p->pending_picks)) {
+    p->pending_picks = pp->next;
+    *pp->target = NULL;
+    GRPC_CLOSURE_SCHED(
+        exec_ctx, pp->on_complete,
+        GRPC_ERROR_CREATE_FROM_STATIC_STRING("Channel Shutdown"));
+    gpr_free(pp);
+  }
+  grpc_connectivity_state_set(
+      exec_ctx, &p->state_tracker, GRPC_CHANNEL_SHUTDOWN,
+      GRPC_ERROR_CREATE_FROM_STATIC_STRING("Channel Shutdown"), "lr_shutdown");
+  const bool latest_is_current =
+      p->subchannel_list == p->latest_pending_subchannel_list;
+  grpc_lb_subchannel_list_shutdown_and_unref(exec_ctx, p->subchannel_list,
+                                             "sl_shutdown_lr_shutdown");
+  p->subchannel_list = NULL;
+  if (!latest_is_current && p->latest_pending_subchannel_list != NULL &&
+      !p->latest_pending_subchannel_list->shutting_down) {
+    grpc_lb_subchannel_list_shutdown_and_unref(
+        exec_ctx, p->latest_pending_subchannel_list,
+        "sl_shutdown_pending_lr_shutdown");
+    p->latest_pending_subchannel_list = NULL;
+  }
+}
+
+static void lr_cancel_pick_locked(grpc_exec_ctx *exec_ctx, grpc_lb_policy *pol,
+                                  grpc_connected_subchannel **target,
+                                  grpc_error *error) {
+  least_request_lb_policy *p = (least_request_lb_policy *)pol;
+  pending_pick *pp = p->pending_picks;
+  p->pending_picks = NULL;
+  while (pp != NULL) {
+    pending_pick *next = pp->next;
+    if (pp->target == target) {
+      *target = NULL;
+      GRPC_CLOSURE_SCHED(exec_ctx, pp->on_complete,
+                         GRPC_ERROR_CREATE_REFERENCING_FROM_STATIC_STRING(
+                             "Pick cancelled", &error, 1));
+      gpr_free(pp);
+    } else {
+      pp->next = p->pending_picks;
+      p->pending_picks = pp;
+    }
+    pp = next;
+  }
+  GRPC_ERROR_UNREF(error);
+}
+
+static void lr_cancel_picks_locked(grpc_exec_ctx *exec_ctx, grpc_lb_policy *pol,
+                                   uint32_t initial_metadata_flags_mask,
+                                   uint32_t initial_metadata_flags_eq,
+                                   grpc_error *error) {
+  least_request_lb_policy *p = (least_request_lb_policy *)pol;
+  pending_pick *pp = p->pending_picks;
+  p->pending_picks = NULL;
+  while (pp != NULL) {
+    pending_pick *next = pp->next;
+    if ((pp->initial_metadata_flags & initial_metadata_flags_mask) ==
+        initial_metadata_flags_eq) {
+      *pp->target = NULL;
+      GRPC_CLOSURE_SCHED(exec_ctx, pp->on_complete,
+                         GRPC_ERROR_CREATE_REFERENCING_FROM_STATIC_STRING(
+                             "Pick cancelled", &error, 1));
+      gpr_free(pp);
+    } else {
+      pp->next = p->pending_picks;
+      p->pending_picks = pp;
+    }
+    pp = next;
+  }
+  GRPC_ERROR_UNREF(error);
+}
+
+static void start_picking_locked(grpc_exec_ctx *exec_ctx,
+                                 least_request_lb_policy *p) {
+  p->started_picking = true;
+  for (size_t i = 0; i < p->subchannel_list->num_subchannels; i++) {
+    grpc_lb_subchannel_data *sd = &p->subchannel_list->subchannels[i];
+    GRPC_LB_POLICY_WEAK_REF(&p->base, "start_picking_locked");
+    grpc_lb_subchannel_list_ref(sd->subchannel_list, "started_picking");
+    grpc_subchannel_notify_on_state_change(
+        exec_ctx, sd->subchannel, p->base.interested_parties,
+        &sd->pending_connectivity_state_unsafe,
+        &sd->connectivity_changed_closure);
+  }
+}
+
+static void lr_exit_idle_locked(grpc_exec_ctx *exec_ctx, grpc_lb_policy *pol) {
+  least_request_lb_policy *p = (least_request_lb_policy *)pol;
+  if (!p->started_picking) {
+    start_picking_locked(exec_ctx, p);
+  }
+}
+
+static int lr_pick_locked(grpc_exec_ctx *exec_ctx, grpc_lb_policy *pol,
+                          const grpc_lb_policy_pick_args *pick_args,
+                          grpc_connected_subchannel **target,
+                          grpc_call_context_element *context, void **user_data,
+                          grpc_closure *on_complete) {
+  least_request_lb_policy *p = (least_request_lb_policy *)pol;
+  if (GRPC_TRACER_ON(grpc_lb_least_request_trace)) {
+    gpr_log(GPR_INFO, "[LR %p] Trying to pick", (void *)pol);
+  }
+  if (lr_pick_from_picker_locked(p, target, context, user_data)) {
+    return 1;
+  }
+  /* no pick currently available. Save for later in list of pending picks */
+  if (!p->started_picking) {
+    start_picking_locked(exec_ctx, p);
+  }
+  pending_pick *pp = gpr_malloc(sizeof(*pp));
+  pp->next = p->pending_picks;
+  pp->target = target;
+  pp->context = context;
+  pp->on_complete = on_complete;
+  pp->initial_metadata_flags = pick_args->initial_metadata_flags;
+  pp->user_data = user_data;
+  p->pending_picks = pp;
+  return 0;
+}
+
+/** Sets the policy's connectivity status based on that of the passed-in \a sd
+ * (the subchannel_data associted with the updated subchannel) and the
+ * subchannel list \a sd belongs to (sd->subchannel_list). \a error will only be
+ * used upon policy transition to TRANSIENT_FAILURE or SHUTDOWN. Returns the
+ * connectivity status set. Follows the same rules as round_robin. */
+static grpc_connectivity_state update_lb_connectivity_status_locked(
+    grpc_exec_ctx *exec_ctx, grpc_lb_subchannel_data *sd, grpc_error *error) {
+  grpc_connectivity_state new_state = sd->curr_connectivity_state;
+  grpc_lb_subchannel_list *subchannel_list = sd->subchannel_list;
+  least_request_lb_policy *p =
+      (least_request_lb_policy *)subchannel_list->policy;
+  if (subchannel_list->num_ready > 0) { /* 1) READY */
+    grpc_connectivity_state_set(exec_ctx, &p->state_tracker, GRPC_CHANNEL_READY,
+                                GRPC_ERROR_NONE, "lr_ready");
+    new_state = GRPC_CHANNEL_READY;
+  } else if (sd->curr_connectivity_state ==
+             GRPC_CHANNEL_CONNECTING) { /* 2) CONNECTING */
+    grpc_connectivity_state_set(exec_ctx, &p->state_tracker,
+                                GRPC_CHANNEL_CONNECTING, GRPC_ERROR_NONE,
+                                "lr_connecting");
+    new_state = GRPC_CHANNEL_CONNECTING;
+  } else if (p->subchannel_list->num_shutdown ==
+             p->subchannel_list->num_subchannels) { /* 3) SHUTDOWN */
+    grpc_connectivity_state_set(exec_ctx, &p->state_tracker,
+                                GRPC_CHANNEL_SHUTDOWN, GRPC_ERROR_REF(error),
+                                "lr_shutdown");
+    new_state = GRPC_CHANNEL_SHUTDOWN;
+  } else if (subchannel_list->num_transient_failures ==
+             p->subchannel_list->num_subchannels) { /* 4) TRANSIENT_FAILURE */
+    grpc_connectivity_state_set(exec_ctx, &p->state_tracker,
+                                GRPC_CHANNEL_TRANSIENT_FAILURE,
+                                GRPC_ERROR_REF(error), "lr_transient_failure");
+    new_state = GRPC_CHANNEL_TRANSIENT_FAILURE;
+  } else if (subchannel_list->num_idle ==
+             p->subchannel_list->num_subchannels) { /* 5) IDLE */
+    grpc_connectivity_state_set(exec_ctx, &p->state_tracker, GRPC_CHANNEL_IDLE,
+                                GRPC_ERROR_NONE, "lr_idle");
+    new_state = GRPC_CHANNEL_IDLE;
+  }
+  GRPC_ERROR_UNREF(error);
+  return new_state;
+}
+
+static void lr_connectivity_changed_locked(grpc_exec_ctx *exec_ctx, void *arg,
+                                           grpc_error *error) {
+  grpc_lb_subchannel_data *sd = arg;
+  least_request_lb_policy *p =
+      (least_request_lb_policy *)sd->subchannel_list->policy;
+  if (GRPC_TRACER_ON(grpc_lb_least_request_trace)) {
+    gpr_log(
+        GPR_DEBUG,
+        "[LR %p] connectivity changed for subchannel %p, subchannel_list %p: "
+        "prev_state=%s new_state=%s p->shutdown=%d "
+        "sd->subchannel_list->shutting_down=%d error=%s",
+        (void *)p, (void *)sd->subchannel, (void *)sd->subchannel_list,
+        grpc_connectivity_state_name(sd->prev_connectivity_state),
+        grpc_connectivity_state_name(sd->pending_connectivity_state_unsafe),
+        p->shutdown, sd->subchannel_list->shutting_down,
+        grpc_error_string(error));
+  }
+  // If the policy is shutting down, unref and return.
+  if (p->shutdown) {
+    grpc_lb_subchannel_list_unref(exec_ctx, sd->subchannel_list,
+                                  "pol_shutdown+started_picking");
+    GRPC_LB_POLICY_WEAK_UNREF(exec_ctx, &p->base, "pol_shutdown");
+    return;
+  }
+  if (sd->subchannel_list->shutting_down && error == GRPC_ERROR_CANCELLED) {
+    // the subchannel list associated with sd has been discarded. This callback
+    // corresponds to the unsubscription. The unrefs correspond to the picking
+    // ref (start_picking_locked or update_started_picking).
+    grpc_lb_subchannel_list_unref(exec_ctx, sd->subchannel_list,
+                                  "sl_shutdown+started_picking");
+    GRPC_LB_POLICY_WEAK_UNREF(exec_ctx, &p->base, "sl_shutdown+picking");
+    return;
+  }
+  // Dispose of outdated subchannel lists.
+  if (sd->subchannel_list != p->subchannel_list &&
+      sd->subchannel_list != p->latest_pending_subchannel_list) {
+    // sd belongs to an outdated subchannel_list: get rid of it.
+    grpc_lb_subchannel_list_shutdown_and_unref(exec_ctx, sd->subchannel_list,
+                                               "sl_outdated");
+    GRPC_LB_POLICY_WEAK_UNREF(exec_ctx, &p->base, "sl_outdated");
+    return;
+  }
+  // Now that we're inside the combiner, copy the pending connectivity
+  // state (which was set by the connectivity state watcher) to
+  // curr_connectivity_state, which is what we use inside of the combiner.
+  sd->curr_connectivity_state = sd->pending_connectivity_state_unsafe;
+  const bool was_ready = sd->prev_connectivity_state == GRPC_CHANNEL_READY;
+  // Update state counters and determine new overall state.
+  grpc_lb_subchannel_data_update_state_counters(sd);
+  sd->prev_connectivity_state = sd->curr_connectivity_state;
+  const grpc_connectivity_state new_policy_connectivity_state =
+      update_lb_connectivity_status_locked(exec_ctx, sd, GRPC_ERROR_REF(error));
+  // If the sd's new state is SHUTDOWN, unref the subchannel, and if the new
+  // policy's state is SHUTDOWN, clean up.
+  if (sd->curr_connectivity_state == GRPC_CHANNEL_SHUTDOWN) {
+    GRPC_SUBCHANNEL_UNREF(exec_ctx, sd->subchannel, "lr_subchannel_shutdown");
+    sd->subchannel = NULL;
+    if (sd->user_data != NULL) {
+      GPR_ASSERT(sd->user_data_vtable != NULL);
+      sd->user_data_vtable->destroy(exec_ctx, sd->user_data);
+      sd->user_data = NULL;
+    }
+    if (new_policy_connectivity_state == GRPC_CHANNEL_SHUTDOWN) {
+      // the policy is shutting down. Flush all the pending picks...
+      pending_pick *pp;
+      while ((pp = p->pending_picks)) {
+        p->pending_picks = pp->next;
+        *pp->target = NULL;
+        GRPC_CLOSURE_SCHED(exec_ctx, pp->on_complete, GRPC_ERROR_NONE);
+        gpr_free(pp);
+      }
+    }
+    grpc_lb_subchannel_list_unref(exec_ctx, sd->subchannel_list,
+                                  "sd_shutdown+started_picking");
+    // unref the "lr_connectivity_update" weak ref from start_picking.
+    GRPC_LB_POLICY_WEAK_UNREF(exec_ctx, &p->base,
+                              "lr_connectivity_sd_shutdown");
+  } else {  // sd not in SHUTDOWN
+    if (sd->curr_connectivity_state == GRPC_CHANNEL_READY &&
+        sd->subchannel_list != p->subchannel_list) {
+      // promote sd->subchannel_list to p->subchannel_list.
+      // sd->subchannel_list must be equal to
+      // p->latest_pending_subchannel_list because we have already filtered
+      // for sds belonging to outdated subchannel lists.
+      GPR_ASSERT(sd->subchannel_list == p->latest_pending_subchannel_list);
+      GPR_ASSERT(!sd->subchannel_list->shutting_down);
+      if (GRPC_TRACER_ON(grpc_lb_least_request_trace)) {
+        gpr_log(GPR_DEBUG,
+                "[LR %p] phasing out subchannel list %p in favor of %p",
+                (void *)p, (void *)p->subchannel_list,
+                (void *)sd->subchannel_list);
+      }
+      if (p->subchannel_list != NULL) {
+        // dispose of the current subchannel_list
+        grpc_lb_subchannel_list_shutdown_and_unref(
+            exec_ctx, p->subchannel_list, "sl_phase_out_shutdown");
+      }
+      p->subchannel_list = p->latest_pending_subchannel_list;
+      p->latest_pending_subchannel_list = NULL;
+    }
+    /* renew notification: reuses the "lr_connectivity_update" weak ref on the
+     * policy as well as the sd->subchannel_list ref. */
+    grpc_subchannel_notify_on_state_change(
+        exec_ctx, sd->subchannel, p->base.interested_parties,
+        &sd->pending_connectivity_state_unsafe,
+        &sd->connectivity_changed_closure);
+  }
+  // The set of READY subchannels changed: picks made outside of the combiner
+  // need to know.
+  if (was_ready || sd->curr_connectivity_state == GRPC_CHANNEL_READY) {
+    lr_update_picker_locked(exec_ctx, p);
+  }
+  // Fulfill the pending picks, each choosing on its own so that they spread
+  // over the READY subchannels.
+  pending_pick *pp;
+  while (p->base.picker != NULL && (pp = p->pending_picks) != NULL) {
+    p->pending_picks = pp->next;
+    GPR_ASSERT(
+        lr_pick_from_picker_locked(p, pp->target, pp->context, pp->user_data));
+    if (GRPC_TRACER_ON(grpc_lb_least_request_trace)) {
+      gpr_log(GPR_DEBUG, "[LR %p] Fulfilled pending pick. Target <-- %p",
+              (void *)p, (void *)*pp->target);
+    }
+    GRPC_CLOSURE_SCHED(exec_ctx, pp->on_complete, GRPC_ERROR_NONE);
+    gpr_free(pp);
+  }
+}
+
+static grpc_connectivity_state lr_check_connectivity_locked(
+    grpc_exec_ctx *exec_ctx, grpc_lb_policy *pol, grpc_error **error) {
+  least_request_lb_policy *p = (least_request_lb_policy *)pol;
+  return grpc_connectivity_state_get(&p->state_tracker, error);
+}
+
+static void lr_notify_on_state_change_locked(grpc_exec_ctx *exec_ctx,
+                                             grpc_lb_policy *pol,
+                                             grpc_connectivity_state *current,
+                                             grpc_closure *notify) {
+  least_request_lb_policy *p = (least_request_lb_policy *)pol;
+  grpc_connectivity_state_notify_on_state_change(exec_ctx, &p->state_tracker,
+                                                 current, notify);
+}
+
+static void lr_ping_one_locked(grpc_exec_ctx *exec_ctx, grpc_lb_policy *pol,
+                               grpc_closure *closure) {
+  least_request_lb_policy *p = (least_request_lb_policy *)pol;
+  if (p->base.picker != NULL) {
+    lr_picker_entry *entry = lr_picker_choose((lr_picker *)p->base.picker);
+    grpc_connected_subchannel_ping(exec_ctx, entry->connected_subchannel,
+                                   closure);
+  } else {
+    GRPC_CLOSURE_SCHED(exec_ctx, closure, GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+                                              "Least Request not connected"));
+  }
+}
+
+static void lr_update_locked(grpc_exec_ctx *exec_ctx, grpc_lb_policy *policy,
+                             const grpc_lb_policy_args *args) {
+  least_request_lb_policy *p = (least_request_lb_policy *)policy;
+  /* Find the number of backend addresses. We ignore balancer addresses, since
+   * we don't know how to handle them. */
+  const grpc_arg *arg =
+      grpc_channel_args_find(args->args, GRPC_ARG_LB_ADDRESSES);
+  if (arg == NULL || arg->type != GRPC_ARG_POINTER) {
+    if (p->subchannel_list == NULL) {
+      // If we don't have a current subchannel list, go into TRANSIENT FAILURE.
+      grpc_connectivity_state_set(
+          exec_ctx, &p->state_tracker, GRPC_CHANNEL_TRANSIENT_FAILURE,
+          GRPC_ERROR_CREATE_FROM_STATIC_STRING("Missing update in args"),
+          "lr_update_missing");
+    } else {
+      // otherwise, keep using the current subchannel list (ignore this update).
+      gpr_log(GPR_ERROR,
+              "[LR %p] No valid LB addresses channel arg for update, ignoring.",
+              (void *)p);
+    }
+    return;
+  }
+  const grpc_lb_addresses *addresses = arg->value.pointer.p;
+  size_t num_addrs = 0;
+  for (size_t i = 0; i < addresses->num_addresses; i++) {
+    if (!addresses->addresses[i].is_balancer) ++num_addrs;
+  }
+  if (num_addrs == 0) {
+    grpc_connectivity_state_set(
+        exec_ctx, &p->state_tracker, GRPC_CHANNEL_TRANSIENT_FAILURE,
+        GRPC_ERROR_CREATE_FROM_STATIC_STRING("Empty update"),
+        "lr_update_empty");
+    if (p->subchannel_list != NULL) {
+      grpc_lb_subchannel_list_shutdown_and_unref(exec_ctx, p->subchannel_list,
+                                                 "sl_shutdown_empty_update");
+      p->subchannel_list = NULL;
+      lr_update_picker_locked(exec_ctx, p);
+    }
+    return;
+  }
+  grpc_lb_subchannel_list *subchannel_list = grpc_lb_subchannel_list_create(
+      exec_ctx, &p->base, &grpc_lb_least_request_trace, addresses, args,
+      lr_connectivity_changed_locked);
+  if (p->latest_pending_subchannel_list != NULL && p->started_picking) {
+    if (GRPC_TRACER_ON(grpc_lb_least_request_trace)) {
+      gpr_log(GPR_DEBUG,
+              "[LR %p] Shutting down latest pending subchannel list %p, about "
+              "to be replaced by newer latest %p",
+              (void *)p, (void *)p->latest_pending_subchannel_list,
+              (void *)subchannel_list);
+    }
+    grpc_lb_subchannel_list_shutdown_and_unref(
+        exec_ctx, p->latest_pending_subchannel_list, "sl_outdated_dont_smash");
+  }
+  p->latest_pending_subchannel_list = subchannel_list;
+  if (p->started_picking) {
+    for (size_t i = 0; i < subchannel_list->num_subchannels; i++) {
+      grpc_lb_subchannel_data *sd = &subchannel_list->subchannels[i];
+      grpc_lb_subchannel_list_ref(subchannel_list, "update_started_picking");
+      GRPC_LB_POLICY_WEAK_REF(&p->base, "lr_connectivity_update");
+      /* Watch every new subchannel. A subchannel list becomes active the
+       * moment one of its subchannels is READY. At that moment, we swap
+       * p->subchannel_list for sd->subchannel_list, provided the subchannel
+       * list is still valid (ie, isn't shutting down) */
+      grpc_subchannel_notify_on_state_change(
+          exec_ctx, sd->subchannel, p->base.interested_parties,
+          &sd->pending_connectivity_state_unsafe,
+          &sd->connectivity_changed_closure);
+    }
+  }
+  if (!p->started_picking) {
+    // The policy isn't picking yet. Save the update for later, disposing of
+    // previous version if any.
+    if (p->subchannel_list != NULL) {
+      grpc_lb_subchannel_list_shutdown_and_unref(
+          exec_ctx, p->subchannel_list, "lr_update_before_started_picking");
+    }
+    p->subchannel_list = subchannel_list;
+    p->latest_pending_subchannel_list = NULL;
+  }
+}
+
+static const grpc_lb_policy_vtable least_request_lb_policy_vtable = {
+    lr_destroy,
+    lr_shutdown_locked,
+    lr_pick_locked,
+    lr_cancel_pick_locked,
+    lr_cancel_picks_locked,
+    lr_ping_one_locked,
+    lr_exit_idle_locked,
+    lr_check_connectivity_locked,
+    lr_notify_on_state_change_locked,
+    lr_update_locked};
+
+static void least_request_factory_ref(grpc_lb_policy_factory *factory) {}
+
+static void least_request_factory_unref(grpc_lb_policy_factory *factory) {}
+
+static grpc_lb_policy *least_request_create(grpc_exec_ctx *exec_ctx,
+                                            grpc_lb_policy_factory *factory,
+                                            grpc_lb_policy_args *args) {
+  GPR_ASSERT(args->client_channel_factory != NULL);
+  least_request_lb_policy *p = gpr_zalloc(sizeof(*p));
+  lr_update_locked(exec_ctx, &p->base, args);
+  grpc_lb_policy_init(&p->base, &least_request_lb_policy_vtable,
+                      args->combiner);
+  grpc_connectivity_state_init(&p->state_tracker, GRPC_CHANNEL_IDLE,
+                               "least_request");
+  if (GRPC_TRACER_ON(grpc_lb_least_request_trace)) {
+    gpr_log(GPR_DEBUG, "[LR %p] Created with %lu subchannels", (void *)p,
+            (unsigned long)p->subchannel_list->num_subchannels);
+  }
+  return &p->base;
+}
+
+static const grpc_lb_policy_factory_vtable least_request_factory_vtable = {
+    least_request_factory_ref, least_request_factory_unref,
+    least_request_create, "least_request"};
+
+static grpc_lb_policy_factory least_request_lb_policy_factory = {
+    &least_request_factory_vtable};
+
+static grpc_lb_policy_factory *least_request_lb_factory_create() {
+  return &least_request_lb_policy_factory;
+}
+
+/* least_request_call_tracking filter: added to the subchannels of the policy,
+ * it stops counting a call against the load of the subchannel it was picked for
+ * (its GRPC_CONTEXT_LB_CALL_STATE) as soon as the call receives its trailing
+ * metadata, rather than when the application gets around to destroying it. */
+
+typedef struct {
+  /** the call's state, or NULL if it isn't tracked */
+  lr_call_state *state;
+  /** state for intercepting recv_trailing_metadata */
+  grpc_closure on_complete;
+  grpc_closure *original_on_complete;
+} call_tracking_call_data;
+
+static void call_tracking_on_complete(grpc_exec_ctx *exec_ctx, void *arg,
+                                      grpc_error *error) {
+  call_tracking_call_data *calld = arg;
+  /* failed or not, the call is done with the subchannel */
+  lr_call_state_finish(calld->state);
+  GRPC_CLOSURE_RUN(exec_ctx, calld->original_on_complete,
+                   GRPC_ERROR_REF(error));
+}
+
+static grpc_error *call_tracking_init_call_elem(
+    grpc_exec_ctx *exec_ctx, grpc_call_element *elem,
+    const grpc_call_element_args *args) {
+  call_tracking_call_data *calld = elem->call_data;
+  calld->state = NULL;
+  if (args->context != NULL &&
+      args->context[GRPC_CONTEXT_LB_CALL_STATE].value != NULL) {
+    calld->state =
+        lr_call_state_ref(args->context[GRPC_CONTEXT_LB_CALL_STATE].value);
+  }
+  return GRPC_ERROR_NONE;
+}
+
+static void call_tracking_destroy_call_elem(
+    grpc_exec_ctx *exec_ctx, grpc_call_element *elem,
+    const grpc_call_final_info *final_info, grpc_closure *ignored) {
+  call_tracking_call_data *calld = elem->call_data;
+  if (calld->state != NULL) lr_call_state_unref(calld->state);
+}
+
+static grpc_error *call_tracking_init_channel_elem(
+    grpc_exec_ctx *exec_ctx, grpc_channel_element *elem,
+    grpc_channel_element_args *args) {
+  return GRPC_ERROR_NONE;
+}
+
+static void call_tracking_destroy_channel_elem(grpc_exec_ctx *exec_ctx,
+                                               grpc_channel_element *elem) {}
+
+static void call_tracking_start_transport_stream_op_batch(
+    grpc_exec_ctx *exec_ctx, grpc_call_element *elem,
+    grpc_transport_stream_op_batch *batch) {
+  call_tracking_call_data *calld = elem->call_data;
+  GPR_TIMER_BEGIN("call_tracking_start_transport_stream_op_batch", 0);
+  if (batch->recv_trailing_metadata && calld->state != NULL) {
+    calld->original_on_complete = batch->on_complete;
+    GRPC_CLOSURE_INIT(&calld->on_complete, call_tracking_on_complete, calld,
+                      grpc_schedule_on_exec_ctx);
+    batch->on_complete = &calld->on_complete;
+  }
+  grpc_call_next_op(exec_ctx, elem, batch);
+  GPR_TIMER_END("call_tracking_start_transport_stream_op_batch", 0);
+}
+
+static const grpc_channel_filter call_tracking_filter = {
+    call_tracking_start_transport_stream_op_batch,
+    grpc_channel_next_op,
+    sizeof(call_tracking_call_data),
+    call_tracking_init_call_elem,
+    grpc_call_stack_ignore_set_pollset_or_pollset_set,
+    call_tracking_destroy_call_elem,
+    0,  // sizeof(channel_data)
+    call_tracking_init_channel_elem,
+    call_tracking_destroy_channel_elem,
+    grpc_call_next_get_peer,
+    grpc_channel_next_get_info,
+    "least_request_call_tracking"};
+
+/* Plugin registration */
+
+// Only add the call tracking filter to the subchannels of this policy.
+static bool maybe_add_call_tracking_filter(grpc_exec_ctx *exec_ctx,
+                                           grpc_channel_stack_builder *builder,
+                                           void *arg) {
+  const grpc_channel_args *args =
+      grpc_channel_stack_builder_get_channel_arguments(builder);
+  const grpc_arg *channel_arg =
+      grpc_channel_args_find(args, GRPC_ARG_LB_POLICY_NAME);
+  if (channel_arg != NULL && channel_arg->type == GRPC_ARG_STRING &&
+      strcmp(channel_arg->value.string, "least_request") == 0) {
+    return grpc_channel_stack_builder_append_filter(
+        builder, (const grpc_channel_filter *)arg, NULL, NULL);
+  }
+  return true;
+}
+
+void grpc_lb_policy_least_request_init() {
+  grpc_register_lb_policy(least_request_lb_factory_create());
+  grpc_register_tracer(&grpc_lb_least_request_trace);
+  grpc_channel_init_register_stage(GRPC_CLIENT_SUBCHANNEL,
+                                   GRPC_CHANNEL_INIT_BUILTIN_PRIORITY,
+                                   maybe_add_call_tracking_filter,
+                                   (void *)&call_tracking_filter);
+}
+
+void grpc_lb_policy_least_request_shutdown() {}
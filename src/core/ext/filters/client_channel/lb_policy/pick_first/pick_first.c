@@ -16,6 +16,7 @@
  *
  */
 
+#include <limits.h>
 #include <string.h>
 
 #include <grpc/support/alloc.h>
@@ -26,6 +27,7 @@
 #include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/iomgr/combiner.h"
 #include "src/core/lib/iomgr/sockaddr_utils.h"
+#include "src/core/lib/iomgr/timer.h"
 #include "src/core/lib/transport/connectivity_state.h"
 
 grpc_tracer_flag grpc_lb_pick_first_trace =
@@ -38,6 +40,10 @@ typedef struct pending_pick {
   grpc_closure *on_complete;
 } pending_pick;
 
+#define GRPC_PICK_FIRST_DEFAULT_CONNECTION_ATTEMPT_DELAY_MS 250
+
+typedef struct pf_racer pf_racer;
+
 typedef struct {
   /** base policy: must be first */
   grpc_lb_policy base;
@@ -74,10 +80,202 @@ typedef struct {
   /** list of picks that are waiting on connectivity */
   pending_pick *pending_picks;
 
+  /** time after which a connection attempt is raced by one to the next
+   * subchannel, in ms, or 0 to check the subchannels one at a time */
+  int connection_attempt_delay_ms;
+  /** index of the next subchannel to race against the checked one */
+  size_t next_attempt;
+  /** timer starting the next racing attempt */
+  grpc_timer attempt_timer;
+  grpc_closure on_attempt_timer;
+  bool attempt_timer_pending;
+  /** racing attempts in progress */
+  pf_racer *racers;
+  /** racing subchannel that connected first: it gets selected once the watch
+   * on the checked subchannel has been cancelled */
+  grpc_subchannel *switch_to;
+
   /** our connectivity state tracker */
   grpc_connectivity_state_tracker state_tracker;
 } pick_first_lb_policy;
 
+/** Watch over a subchannel connecting in parallel with the checked one, so
+ * that an address that does not answer does not hold up the next ones */
+struct pf_racer {
+  pick_first_lb_policy *p;
+  grpc_subchannel *subchannel;
+  grpc_connectivity_state connectivity;
+  grpc_closure connectivity_changed;
+  /** set once the watch is cancelled: the subchannel lost the race */
+  bool cancelled;
+  pf_racer *next;
+};
+
+/** Picker handing out the selected subchannel, for picks made outside of the
+ * combiner */
+typedef struct {
+  /** base picker: must be first */
+  grpc_lb_picker base;
+  grpc_connected_subchannel *selected;
+} pf_picker;
+
+static void pf_picker_destroy(grpc_exec_ctx *exec_ctx, grpc_lb_picker *base) {
+  pf_picker *picker = (pf_picker *)base;
+  GRPC_CONNECTED_SUBCHANNEL_UNREF(exec_ctx, picker->selected, "pf_picker");
+  gpr_free(picker);
+}
+
+static bool pf_picker_pick(grpc_exec_ctx *exec_ctx, grpc_lb_picker *base,
+                           const grpc_lb_policy_pick_args *pick_args,
+                           grpc_connected_subchannel **target,
+                           grpc_call_context_element *context) {
+  pf_picker *picker = (pf_picker *)base;
+  *target = GRPC_CONNECTED_SUBCHANNEL_REF(picker->selected, "picked");
+  return true;
+}
+
+static const grpc_lb_picker_vtable pf_picker_vtable = {pf_picker_destroy,
+                                                       pf_picker_pick};
+
+/** Publishes a picker for the selected subchannel while it is READY, or none at
+ * all otherwise */
+static void pf_update_picker_locked(grpc_exec_ctx *exec_ctx,
+                                    pick_first_lb_policy *p) {
+  if (p->shutdown || p->selected == NULL || p->updating_selected ||
+      p->checking_connectivity != GRPC_CHANNEL_READY) {
+    grpc_lb_policy_set_picker_locked(exec_ctx, &p->base, NULL);
+    return;
+  }
+  pf_picker *picker = gpr_malloc(sizeof(*picker));
+  grpc_lb_picker_init(&picker->base, &pf_picker_vtable);
+  picker->selected = GRPC_CONNECTED_SUBCHANNEL_REF(p->selected, "pf_picker");
+  grpc_lb_policy_set_picker_locked(exec_ctx, &p->base, &picker->base);
+}
+
+/** Whether attempts to the subchannels not yet tried should be raced */
+static bool racing_locked(pick_first_lb_policy *p) {
+  return p->started_picking && !p->shutdown && p->selected == NULL &&
+         !p->updating_selected && !p->updating_subchannels &&
+         p->switch_to == NULL && p->next_attempt < p->num_subchannels;
+}
+
+static void pf_racer_connectivity_changed_locked(grpc_exec_ctx *exec_ctx,
+                                                 void *arg, grpc_error *error) {
+  pf_racer *r = arg;
+  pick_first_lb_policy *p = r->p;
+  if (!r->cancelled && !p->shutdown) {
+    switch (r->connectivity) {
+      case GRPC_CHANNEL_IDLE:
+      case GRPC_CHANNEL_CONNECTING:
+        grpc_subchannel_notify_on_state_change(
+            exec_ctx, r->subchannel, p->base.interested_parties,
+            &r->connectivity, &r->connectivity_changed);
+        return;
+      case GRPC_CHANNEL_READY:
+        /* we won: have the checked subchannel's watcher select us */
+        if (p->started_picking && p->selected == NULL &&
+            !p->updating_selected && !p->updating_subchannels &&
+            p->switch_to == NULL && p->num_subchannels > 0) {
+          if (GRPC_TRACER_ON(grpc_lb_pick_first_trace)) {
+            gpr_log(GPR_INFO, "Pick First %p racing subchannel %p connected",
+                    (void *)p, (void *)r->subchannel);
+          }
+          p->switch_to = GRPC_SUBCHANNEL_REF(r->subchannel, "pf_switch_to");
+          grpc_subchannel_notify_on_state_change(
+              exec_ctx, p->subchannels[p->checking_subchannel], NULL, NULL,
+              &p->connectivity_changed);
+        }
+        break;
+      case GRPC_CHANNEL_INIT:
+      case GRPC_CHANNEL_TRANSIENT_FAILURE:
+      case GRPC_CHANNEL_SHUTDOWN:
+        /* the checked subchannel's watcher gets to it in due course */
+        break;
+    }
+  }
+  pf_racer **link = &p->racers;
+  while (*link != r) link = &(*link)->next;
+  *link = r->next;
+  GRPC_SUBCHANNEL_UNREF(exec_ctx, r->subchannel, "pf_racer");
+  gpr_free(r);
+  GRPC_LB_POLICY_WEAK_UNREF(exec_ctx, &p->base, "pick_first_racer");
+}
+
+static void start_racer_locked(grpc_exec_ctx *exec_ctx,
+                               pick_first_lb_policy *p, size_t index) {
+  pf_racer *r = gpr_zalloc(sizeof(*r));
+  r->p = p;
+  r->subchannel = GRPC_SUBCHANNEL_REF(p->subchannels[index], "pf_racer");
+  r->connectivity = GRPC_CHANNEL_IDLE;
+  GRPC_CLOSURE_INIT(&r->connectivity_changed,
+                    pf_racer_connectivity_changed_locked, r,
+                    grpc_combiner_scheduler(p->base.combiner));
+  r->next = p->racers;
+  p->racers = r;
+  if (GRPC_TRACER_ON(grpc_lb_pick_first_trace)) {
+    gpr_log(GPR_INFO, "Pick First %p racing subchannel %p (index %lu)",
+            (void *)p, (void *)r->subchannel, (unsigned long)index);
+  }
+  GRPC_LB_POLICY_WEAK_REF(&p->base, "pick_first_racer");
+  grpc_subchannel_notify_on_state_change(
+      exec_ctx, r->subchannel, p->base.interested_parties, &r->connectivity,
+      &r->connectivity_changed);
+}
+
+static void maybe_start_attempt_timer_locked(grpc_exec_ctx *exec_ctx,
+                                             pick_first_lb_policy *p) {
+  if (p->attempt_timer_pending || p->connection_attempt_delay_ms == 0 ||
+      !racing_locked(p)) {
+    return;
+  }
+  p->attempt_timer_pending = true;
+  GRPC_LB_POLICY_WEAK_REF(&p->base, "pick_first_attempt_timer");
+  gpr_timespec now = gpr_now(GPR_CLOCK_MONOTONIC);
+  grpc_timer_init(
+      exec_ctx, &p->attempt_timer,
+      gpr_time_add(now, gpr_time_from_millis(p->connection_attempt_delay_ms,
+                                             GPR_TIMESPAN)),
+      &p->on_attempt_timer, now);
+}
+
+static void pf_on_attempt_timer_locked(grpc_exec_ctx *exec_ctx, void *arg,
+                                       grpc_error *error) {
+  pick_first_lb_policy *p = arg;
+  p->attempt_timer_pending = false;
+  if (error == GRPC_ERROR_NONE && racing_locked(p)) {
+    const size_t index = p->next_attempt++;
+    if (index != p->checking_subchannel) start_racer_locked(exec_ctx, p, index);
+  }
+  /* even when cancelled: a new subchannel list may have come in since */
+  maybe_start_attempt_timer_locked(exec_ctx, p);
+  GRPC_LB_POLICY_WEAK_UNREF(exec_ctx, &p->base, "pick_first_attempt_timer");
+}
+
+/** Starts racing the subchannels after the first one, which is being checked */
+static void start_racing_locked(grpc_exec_ctx *exec_ctx,
+                                pick_first_lb_policy *p) {
+  p->next_attempt = 1;
+  maybe_start_attempt_timer_locked(exec_ctx, p);
+}
+
+/** Cancels the racing attempts, whose subchannels lost */
+static void cancel_racing_locked(grpc_exec_ctx *exec_ctx,
+                                 pick_first_lb_policy *p) {
+  if (p->attempt_timer_pending) {
+    grpc_timer_cancel(exec_ctx, &p->attempt_timer);
+  }
+  for (pf_racer *r = p->racers; r != NULL; r = r->next) {
+    if (r->cancelled) continue;
+    r->cancelled = true;
+    grpc_subchannel_notify_on_state_change(exec_ctx, r->subchannel, NULL, NULL,
+                                           &r->connectivity_changed);
+  }
+  if (p->switch_to != NULL) {
+    GRPC_SUBCHANNEL_UNREF(exec_ctx, p->switch_to, "pf_switch_to");
+    p->switch_to = NULL;
+  }
+}
+
 static void pf_destroy(grpc_exec_ctx *exec_ctx, grpc_lb_policy *pol) {
   pick_first_lb_policy *p = (pick_first_lb_policy *)pol;
   GPR_ASSERT(p->pending_picks == NULL);
@@ -110,6 +308,7 @@ static void pf_shutdown_locked(grpc_exec_ctx *exec_ctx, grpc_lb_policy *pol) {
   grpc_connectivity_state_set(
       exec_ctx, &p->state_tracker, GRPC_CHANNEL_SHUTDOWN,
       GRPC_ERROR_CREATE_FROM_STATIC_STRING("Channel shutdown"), "shutdown");
+  cancel_racing_locked(exec_ctx, p);
   /* cancel subscription */
   if (p->selected != NULL) {
     grpc_connected_subchannel_notify_on_state_change(
@@ -189,6 +388,7 @@ static void start_picking_locked(grpc_exec_ctx *exec_ctx,
         exec_ctx, p->subchannels[p->checking_subchannel],
         p->base.interested_parties, &p->checking_connectivity,
         &p->connectivity_changed);
+    start_racing_locked(exec_ctx, p);
   }
 }
 
@@ -270,6 +470,7 @@ static void pf_ping_one_locked(grpc_exec_ctx *exec_ctx, grpc_lb_policy *pol,
 /* unsubscribe all subchannels */
 static void stop_connectivity_watchers(grpc_exec_ctx *exec_ctx,
                                        pick_first_lb_policy *p) {
+  cancel_racing_locked(exec_ctx, p);
   if (p->num_subchannels > 0) {
     GPR_ASSERT(p->selected == NULL);
     if (GRPC_TRACER_ON(grpc_lb_pick_first_trace)) {
@@ -289,6 +490,7 @@ static void stop_connectivity_watchers(grpc_exec_ctx *exec_ctx,
     grpc_connected_subchannel_notify_on_state_change(
         exec_ctx, p->selected, NULL, NULL, &p->connectivity_changed);
     p->updating_selected = true;
+    pf_update_picker_locked(exec_ctx, p);
   }
 }
 
@@ -454,6 +656,7 @@ static void pf_update_locked(grpc_exec_ctx *exec_ctx, grpc_lb_policy *policy,
           exec_ctx, p->subchannels[p->checking_subchannel],
           p->base.interested_parties, &p->checking_connectivity,
           &p->connectivity_changed);
+      start_racing_locked(exec_ctx, p);
     }
   }
 }
@@ -527,6 +730,7 @@ static void pf_connectivity_changed_locked(grpc_exec_ctx *exec_ctx, void *arg,
           exec_ctx, p->subchannels[p->checking_subchannel],
           p->base.interested_parties, &p->checking_connectivity,
           &p->connectivity_changed);
+      start_racing_locked(exec_ctx, p);
     }
     if (p->pending_update_args != NULL) {
       const grpc_lb_policy_args *args = p->pending_update_args;
@@ -540,7 +744,21 @@ static void pf_connectivity_changed_locked(grpc_exec_ctx *exec_ctx, void *arg,
     GRPC_LB_POLICY_WEAK_UNREF(exec_ctx, &p->base, "pick_first_connectivity");
     GRPC_ERROR_UNREF(error);
     return;
-  } else if (p->selected != NULL) {
+  }
+  if (p->switch_to != NULL) {
+    /* a racing subchannel connected first, and the watch on the checked one
+     * got cancelled (or fired in the meantime): check the winner instead */
+    grpc_subchannel *winner = p->switch_to;
+    p->switch_to = NULL;
+    for (size_t i = 0; i < p->num_subchannels; i++) {
+      if (p->subchannels[i] == winner) p->checking_subchannel = i;
+    }
+    GRPC_SUBCHANNEL_UNREF(exec_ctx, winner, "pf_switch_to");
+    GRPC_ERROR_UNREF(error);
+    p->checking_connectivity = grpc_subchannel_check_connectivity(
+        p->subchannels[p->checking_subchannel], &error);
+  }
+  if (p->selected != NULL) {
     if (p->checking_connectivity == GRPC_CHANNEL_TRANSIENT_FAILURE) {
       /* if the selected channel goes bad, we're done */
       p->checking_connectivity = GRPC_CHANNEL_SHUTDOWN;
@@ -548,6 +766,7 @@ static void pf_connectivity_changed_locked(grpc_exec_ctx *exec_ctx, void *arg,
     grpc_connectivity_state_set(exec_ctx, &p->state_tracker,
                                 p->checking_connectivity, GRPC_ERROR_REF(error),
                                 "selected_changed");
+    pf_update_picker_locked(exec_ctx, p);
     if (p->checking_connectivity != GRPC_CHANNEL_SHUTDOWN) {
       grpc_connected_subchannel_notify_on_state_change(
           exec_ctx, p->selected, p->base.interested_parties,
@@ -576,6 +795,7 @@ static void pf_connectivity_changed_locked(grpc_exec_ctx *exec_ctx, void *arg,
         }
         p->selected_key = grpc_subchannel_get_key(selected_subchannel);
         /* drop the pick list: we are connected now */
+        cancel_racing_locked(exec_ctx, p);
         GRPC_LB_POLICY_WEAK_REF(&p->base, "destroy_subchannels");
         destroy_subchannels_locked(exec_ctx, p);
         /* update any calls that were waiting for a pick */
@@ -590,6 +810,7 @@ static void pf_connectivity_changed_locked(grpc_exec_ctx *exec_ctx, void *arg,
           GRPC_CLOSURE_SCHED(exec_ctx, pp->on_complete, GRPC_ERROR_NONE);
           gpr_free(pp);
         }
+        pf_update_picker_locked(exec_ctx, p);
         grpc_connected_subchannel_notify_on_state_change(
             exec_ctx, p->selected, p->base.interested_parties,
             &p->checking_connectivity, &p->connectivity_changed);
@@ -686,10 +907,16 @@ static grpc_lb_policy *create_pick_first(grpc_exec_ctx *exec_ctx,
   if (GRPC_TRACER_ON(grpc_lb_pick_first_trace)) {
     gpr_log(GPR_DEBUG, "Pick First %p created.", (void *)p);
   }
+  p->connection_attempt_delay_ms = grpc_channel_arg_get_integer(
+      grpc_channel_args_find(args->args, GRPC_ARG_CONNECTION_ATTEMPT_DELAY_MS),
+      (grpc_integer_options){GRPC_PICK_FIRST_DEFAULT_CONNECTION_ATTEMPT_DELAY_MS,
+                             0, INT_MAX});
   pf_update_locked(exec_ctx, &p->base, args);
   grpc_lb_policy_init(&p->base, &pick_first_lb_policy_vtable, args->combiner);
   GRPC_CLOSURE_INIT(&p->connectivity_changed, pf_connectivity_changed_locked, p,
                     grpc_combiner_scheduler(args->combiner));
+  GRPC_CLOSURE_INIT(&p->on_attempt_timer, pf_on_attempt_timer_locked, p,
+                    grpc_combiner_scheduler(args->combiner));
   return &p->base;
 }
 
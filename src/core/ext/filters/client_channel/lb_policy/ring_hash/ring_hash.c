@@ -0,0 +1,867 @@
+/*
+ *
+ * Copyright 2017 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/** Ring Hash Policy.
+ *
+ * Spreads the backends over a ketama-style hash ring (see
+ * \a grpc_ring_hash_ring) and sends each call to the first READY backend on
+ * the ring at or after the hash of its GRPC_ARG_RING_HASH_LB_HASH_KEY initial
+ * metadata (or of its :path). Calls with the same key therefore keep going to
+ * the same backend for as long as it stays READY, which keeps per-key state
+ * such as caches hot on the backends, and an update of the addresses only
+ * moves the keys of the backends it adds or removes.
+ *
+ * Subchannel list management is the same as round_robin's, through
+ * grpc_lb_subchannel_list. */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <grpc/support/alloc.h>
+#include <grpc/support/useful.h>
+
+#include "src/core/ext/filters/client_channel/lb_policy/ring_hash/ring_hash.h"
+#include "src/core/ext/filters/client_channel/lb_policy/subchannel_list.h"
+#include "src/core/ext/filters/client_channel/lb_policy_registry.h"
+#include "src/core/ext/filters/client_channel/subchannel.h"
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/debug/trace.h"
+#include "src/core/lib/iomgr/combiner.h"
+#include "src/core/lib/iomgr/sockaddr_utils.h"
+#include "src/core/lib/slice/slice_internal.h"
+#include "src/core/lib/support/murmur_hash.h"
+#include "src/core/lib/transport/connectivity_state.h"
+#include "src/core/lib/transport/static_metadata.h"
+
+grpc_tracer_flag grpc_lb_ring_hash_trace =
+    GRPC_TRACER_INITIALIZER(false, "ring_hash");
+
+/** List of entities waiting for a pick.
+ *
+ * Once a pick is available, \a target is updated and \a on_complete called. */
+typedef struct pending_pick {
+  struct pending_pick *next;
+
+  /* output argument where to store the pick()ed user_data. It'll be NULL if no
+   * such data is present or there's an error (the definite test for errors is
+   * \a target being NULL). */
+  void **user_data;
+
+  /* bitmask passed to pick() and used for selective cancelling. See
+   * grpc_lb_policy_cancel_picks() */
+  uint32_t initial_metadata_flags;
+
+  /* initial metadata of the picking call, whose key decides the pick */
+  grpc_metadata_batch *initial_metadata;
+
+  /* output argument where to store the pick()ed connected subchannel, or NULL
+   * upon error. */
+  grpc_connected_subchannel **target;
+
+  /* to be invoked once the pick() has completed (regardless of success) */
+  grpc_closure *on_complete;
+} pending_pick;
+
+typedef struct {
+  uint32_t hash;
+  /** index of the owning backend */
+  uint32_t backend;
+} ring_point;
+
+struct grpc_ring_hash_ring {
+  gpr_refcount refs;
+  /** sorted by hash */
+  size_t num_points;
+  ring_point *points;
+};
+
+static int ring_point_cmp(const void *a, const void *b) {
+  const ring_point *pa = a;
+  const ring_point *pb = b;
+  const int c = GPR_ICMP(pa->hash, pb->hash);
+  return c != 0 ? c : GPR_ICMP(pa->backend, pb->backend);
+}
+
+grpc_ring_hash_ring *grpc_ring_hash_ring_create(
+    const grpc_lb_addresses *addresses, size_t points_per_backend) {
+  GPR_ASSERT(points_per_backend > 0);
+  size_t num_backends = 0;
+  for (size_t i = 0; i < addresses->num_addresses; i++) {
+    if (!addresses->addresses[i].is_balancer) ++num_backends;
+  }
+  GPR_ASSERT(num_backends > 0);
+  grpc_ring_hash_ring *ring = gpr_malloc(sizeof(*ring));
+  gpr_ref_init(&ring->refs, 1);
+  ring->num_points = 0;
+  ring->points =
+      gpr_malloc(sizeof(*ring->points) * num_backends * points_per_backend);
+  uint32_t backend = 0;
+  for (size_t i = 0; i < addresses->num_addresses; i++) {
+    if (addresses->addresses[i].is_balancer) continue;
+    /* hash the textual form of the address, as ketama does, so that the
+     * points of a backend don't depend on how its address was resolved */
+    const grpc_resolved_address *address = &addresses->addresses[i].address;
+    char *uri = grpc_sockaddr_to_uri(address);
+    const void *key = uri != NULL ? (const void *)uri : address->addr;
+    const size_t key_len = uri != NULL ? strlen(uri) : address->len;
+    for (size_t j = 0; j < points_per_backend; j++) {
+      ring_point *point = &ring->points[ring->num_points++];
+      point->hash = gpr_murmur_hash3(key, key_len, (uint32_t)j);
+      point->backend = backend;
+    }
+    gpr_free(uri);
+    ++backend;
+  }
+  qsort(ring->points, ring->num_points, sizeof(*ring->points), ring_point_cmp);
+  return ring;
+}
+
+grpc_ring_hash_ring *grpc_ring_hash_ring_ref(grpc_ring_hash_ring *ring) {
+  gpr_ref_non_zero(&ring->refs);
+  return ring;
+}
+
+void grpc_ring_hash_ring_unref(grpc_ring_hash_ring *ring) {
+  if (gpr_unref(&ring->refs)) {
+    gpr_free(ring->points);
+    gpr_free(ring);
+  }
+}
+
+size_t grpc_ring_hash_ring_size(const grpc_ring_hash_ring *ring) {
+  return ring->num_points;
+}
+
+size_t grpc_ring_hash_ring_find(const grpc_ring_hash_ring *ring,
+                                uint32_t hash) {
+  size_t lo = 0;
+  size_t hi = ring->num_points;
+  while (lo < hi) {
+    const size_t mid = lo + (hi - lo) / 2;
+    if (ring->points[mid].hash < hash) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return lo == ring->num_points ? 0 : lo;
+}
+
+size_t grpc_ring_hash_ring_backend(const grpc_ring_hash_ring *ring,
+                                   size_t position) {
+  return ring->points[position].backend;
+}
+
+uint32_t grpc_ring_hash_key_hash(grpc_metadata_batch *initial_metadata,
+                                 grpc_slice hash_key) {
+  if (initial_metadata == NULL) return 0;
+  grpc_linked_mdelem *md = grpc_metadata_batch_find(initial_metadata, hash_key);
+  if (md == NULL) md = initial_metadata->idx.named.path;
+  if (md == NULL) return 0;
+  const grpc_slice value = GRPC_MDVALUE(md->md);
+  return gpr_murmur_hash3(GRPC_SLICE_START_PTR(value), GRPC_SLICE_LENGTH(value),
+                          0);
+}
+
+typedef struct ring_hash_lb_policy {
+  /** base policy: must be first */
+  grpc_lb_policy base;
+
+  grpc_lb_subchannel_list *subchannel_list;
+
+  /** have we started picking? */
+  bool started_picking;
+  /** are we shutting down? */
+  bool shutdown;
+  /** List of picks that are waiting on connectivity */
+  pending_pick *pending_picks;
+
+  /** our connectivity state tracker */
+  grpc_connectivity_state_tracker state_tracker;
+
+  /** initial metadata key hashed by picks (interned) */
+  grpc_slice hash_key;
+  /** number of points of each backend on the ring */
+  size_t points_per_backend;
+
+  /** Latest version of the subchannel list.
+   * Subchannel connectivity callbacks will only promote updated subchannel
+   * lists if they equal \a latest_pending_subchannel_list. In other words,
+   * racing callbacks that reference outdated subchannel lists won't perform any
+   * update. */
+  grpc_lb_subchannel_list *latest_pending_subchannel_list;
+} ring_hash_lb_policy;
+
+/* The ring over the subchannels of a subchannel list, in the same order, is the
+ * list's policy data */
+
+static void rh_subchannel_list_ring_destroy(grpc_exec_ctx *exec_ctx,
+                                            void *ring) {
+  grpc_ring_hash_ring_unref(ring);
+}
+
+static grpc_ring_hash_ring *rh_subchannel_list_ring(
+    const grpc_lb_subchannel_list *subchannel_list) {
+  return subchannel_list->policy_data;
+}
+
+/** Picker hashing calls onto the ring of the subchannel list it was published
+ * for. The policy picks through it as well while it's published. */
+typedef struct {
+  /** base picker: must be first */
+  grpc_lb_picker base;
+  grpc_ring_hash_ring *ring;
+  grpc_slice hash_key;
+  /** connected subchannel of each backend of \a ring, or NULL for those that
+   * weren't connected when the picker was published */
+  size_t num_subchannels;
+  grpc_connected_subchannel **subchannels;
+  /** for each point of \a ring, the backend of the first point at or after it
+   * whose subchannel is connected, so that picks don't walk past the points of
+   * unconnected backends */
+  uint32_t *connected_backends;
+} rh_picker;
+
+/** Fills picker->connected_backends in. There must be at least one connected
+ * subchannel. */
+static void rh_picker_index_connected_backends(rh_picker *picker) {
+  const size_t num_points = grpc_ring_hash_ring_size(picker->ring);
+  picker->connected_backends =
+      gpr_malloc(sizeof(*picker->connected_backends) * num_points);
+  /* walk the ring backwards twice: the first lap finds the connected backend
+   * following the last point, which the second lap hands down to the others */
+  uint32_t next_connected = UINT32_MAX;
+  for (size_t i = 2 * num_points; i-- > 0;) {
+    const size_t position = i % num_points;
+    const size_t backend = grpc_ring_hash_ring_backend(picker->ring, position);
+    if (picker->subchannels[backend] != NULL) {
+      next_connected = (uint32_t)backend;
+    }
+    if (i < num_points) {
+      GPR_ASSERT(next_connected != UINT32_MAX);
+      picker->connected_backends[position] = next_connected;
+    }
+  }
+}
+
+/** Returns the index of the backend of the call with \a initial_metadata: the
+ * first connected one on the ring at or after the hash of the call's key */
+static size_t rh_picker_choose(rh_picker *picker,
+                               grpc_metadata_batch *initial_metadata) {
+  const uint32_t hash =
+      grpc_ring_hash_key_hash(initial_metadata, picker->hash_key);
+  const size_t position = grpc_ring_hash_ring_find(picker->ring, hash);
+  return picker->connected_backends[position];
+}
+
+static void rh_picker_destroy(grpc_exec_ctx *exec_ctx, grpc_lb_picker *base) {
+  rh_picker *picker = (rh_picker *)base;
+  for (size_t i = 0; i < picker->num_subchannels; i++) {
+    if (picker->subchannels[i] != NULL) {
+      GRPC_CONNECTED_SUBCHANNEL_UNREF(exec_ctx, picker->subchannels[i],
+                                      "rh_picker");
+    }
+  }
+  grpc_ring_hash_ring_unref(picker->ring);
+  grpc_slice_unref_internal(exec_ctx, picker->hash_key);
+  gpr_free(picker->subchannels);
+  gpr_free(picker->connected_backends);
+  gpr_free(picker);
+}
+
+static bool rh_picker_pick(grpc_exec_ctx *exec_ctx, grpc_lb_picker *base,
+                           const grpc_lb_policy_pick_args *pick_args,
+                           grpc_connected_subchannel **target,
+                           grpc_call_context_element *context) {
+  rh_picker *picker = (rh_picker *)base;
+  const size_t backend = rh_picker_choose(picker, pick_args->initial_metadata);
+  *target =
+      GRPC_CONNECTED_SUBCHANNEL_REF(picker->subchannels[backend], "rh_picked");
+  return true;
+}
+
+static const grpc_lb_picker_vtable rh_picker_vtable = {rh_picker_destroy,
+                                                       rh_picker_pick};
+
+/** Publishes a picker for the connected subchannels of p->subchannel_list (or
+ * none at all if there are no such subchannels) */
+static void rh_update_picker_locked(grpc_exec_ctx *exec_ctx,
+                                    ring_hash_lb_policy *p) {
+  grpc_lb_subchannel_list *subchannel_list = p->subchannel_list;
+  if (p->shutdown || subchannel_list == NULL) {
+    grpc_lb_policy_set_picker_locked(exec_ctx, &p->base, NULL);
+    return;
+  }
+  rh_picker *picker = gpr_zalloc(sizeof(*picker));
+  grpc_lb_picker_init(&picker->base, &rh_picker_vtable);
+  picker->ring =
+      grpc_ring_hash_ring_ref(rh_subchannel_list_ring(subchannel_list));
+  picker->hash_key = grpc_slice_ref_internal(p->hash_key);
+  picker->num_subchannels = subchannel_list->num_subchannels;
+  picker->subchannels =
+      gpr_zalloc(sizeof(*picker->subchannels) * picker->num_subchannels);
+  size_t num_connected = 0;
+  for (size_t i = 0; i < subchannel_list->num_subchannels; i++) {
+    grpc_lb_subchannel_data *sd = &subchannel_list->subchannels[i];
+    /* Don't wait for the READY notification of subchannels that were already
+     * connected through an earlier subchannel list: until it arrives, their
+     * keys would move to the next backend on the ring. */
+    if (sd->subchannel == NULL) continue;
+    grpc_connected_subchannel *connected_subchannel =
+        grpc_subchannel_get_connected_subchannel(sd->subchannel);
+    if (connected_subchannel == NULL) continue;
+    picker->subchannels[i] =
+        GRPC_CONNECTED_SUBCHANNEL_REF(connected_subchannel, "rh_picker");
+    ++num_connected;
+  }
+  if (GRPC_TRACER_ON(grpc_lb_ring_hash_trace)) {
+    gpr_log(GPR_DEBUG,
+            "[RH %p] publishing picker %p over %lu connected subchannels of %lu",
+            (void *)p, (void *)picker, (unsigned long)num_connected,
+            (unsigned long)picker->num_subchannels);
+  }
+  if (num_connected == 0) {
+    rh_picker_destroy(exec_ctx, &picker->base);
+    picker = NULL;
+  } else {
+    rh_picker_index_connected_backends(picker);
+  }
+  grpc_lb_policy_set_picker_locked(exec_ctx, &p->base,
+                                   picker == NULL ? NULL : &picker->base);
+}
+
+/** Picks from the published picker into \a target and \a user_data, returning
+ * false if there's nothing to pick from */
+static bool rh_pick_from_picker_locked(ring_hash_lb_policy *p,
+                                       grpc_metadata_batch *initial_metadata,
+                                       grpc_connected_subchannel **target,
+                                       void **user_data) {
+  if (p->base.picker == NULL) return false;
+  /* the picker is always that of p->subchannel_list */
+  GPR_ASSERT(p->subchannel_list != NULL);
+  rh_picker *picker = (rh_picker *)p->base.picker;
+  const size_t backend = rh_picker_choose(picker, initial_metadata);
+  grpc_lb_subchannel_data *sd = &p->subchannel_list->subchannels[backend];
+  *target =
+      GRPC_CONNECTED_SUBCHANNEL_REF(picker->subchannels[backend], "rh_picked");
+  if (user_data != NULL) {
+    *user_data = sd->user_data;
+  }
+  if (GRPC_TRACER_ON(grpc_lb_ring_hash_trace)) {
+    gpr_log(GPR_DEBUG,
+            "[RH %p] Picked target <-- Subchannel %p (connected %p) (sl %p, "
+            "index %lu)",
+            (void *)p, (void *)sd->subchannel, (void *)*target,
+            (void *)sd->subchannel_list, (unsigned long)backend);
+  }
+  return true;
+}
+
+static void rh_destroy(grpc_exec_ctx *exec_ctx, grpc_lb_policy *pol) {
+  ring_hash_lb_policy *p = (ring_hash_lb_policy *)pol;
+  if (GRPC_TRACER_ON(grpc_lb_ring_hash_trace)) {
+    gpr_log(GPR_DEBUG, "[RH %p] Destroying Ring Hash policy at %p",
+            (void *)pol, (void *)pol);
+  }
+  grpc_connectivity_state_destroy(exec_ctx, &p->state_tracker);
+  grpc_slice_unref_internal(exec_ctx, p->hash_key);
+  gpr_free(p);
+}
+
+static void rh_shutdown_locked(grpc_exec_ctx *exec_ctx, grpc_lb_policy *pol) {
+  ring_hash_lb_policy *p = (ring_hash_lb_policy *)pol;
+  if (GRPC_TRACER_ON(grpc_lb_ring_hash_trace)) {
+    gpr_log(GPR_DEBUG, "[RH %p] Shutting down Ring Hash policy at %p",
+            (void *)pol, (void *)pol);
+  }
+  p->shutdown = true;
+  pending_pick *pp;
+  while ((pp = p->pending_picks)) {
+    p->pending_picks = pp->next;
+    *pp->target = NULL;
+    GRPC_CLOSURE_SCHED(
+        exec_ctx, pp->on_complete,
+        GRPC_ERROR_CREATE_FROM_STATIC_STRING("Channel Shutdown"));
+    gpr_free(pp);
+  }
+  grpc_connectivity_state_set(
+      exec_ctx, &p->state_tracker, GRPC_CHANNEL_SHUTDOWN,
+      GRPC_ERROR_CREATE_FROM_STATIC_STRING("Channel Shutdown"), "rh_shutdown");
+  const bool latest_is_current =
+      p->subchannel_list == p->latest_pending_subchannel_list;
+  grpc_lb_subchannel_list_shutdown_and_unref(exec_ctx, p->subchannel_list,
+                                        "sl_shutdown_rh_shutdown");
+  p->subchannel_list = NULL;
+  if (!latest_is_current && p->latest_pending_subchannel_list != NULL &&
+      !p->latest_pending_subchannel_list->shutting_down) {
+    grpc_lb_subchannel_list_shutdown_and_unref(exec_ctx,
+                                          p->latest_pending_subchannel_list,
+                                          "sl_shutdown_pending_rh_shutdown");
+    p->latest_pending_subchannel_list = NULL;
+  }
+}
+
+static void rh_cancel_pick_locked(grpc_exec_ctx *exec_ctx, grpc_lb_policy *pol,
+                                  grpc_connected_subchannel **target,
+                                  grpc_error *error) {
+  ring_hash_lb_policy *p = (ring_hash_lb_policy *)pol;
+  pending_pick *pp = p->pending_picks;
+  p->pending_picks = NULL;
+  while (pp != NULL) {
+    pending_pick *next = pp->next;
+    if (pp->target == target) {
+      *target = NULL;
+      GRPC_CLOSURE_SCHED(exec_ctx, pp->on_complete,
+                         GRPC_ERROR_CREATE_REFERENCING_FROM_STATIC_STRING(
+                             "Pick cancelled", &error, 1));
+      gpr_free(pp);
+    } else {
+      pp->next = p->pending_picks;
+      p->pending_picks = pp;
+    }
+    pp = next;
+  }
+  GRPC_ERROR_UNREF(error);
+}
+
+static void rh_cancel_picks_locked(grpc_exec_ctx *exec_ctx, grpc_lb_policy *pol,
+                                   uint32_t initial_metadata_flags_mask,
+                                   uint32_t initial_metadata_flags_eq,
+                                   grpc_error *error) {
+  ring_hash_lb_policy *p = (ring_hash_lb_policy *)pol;
+  pending_pick *pp = p->pending_picks;
+  p->pending_picks = NULL;
+  while (pp != NULL) {
+    pending_pick *next = pp->next;
+    if ((pp->initial_metadata_flags & initial_metadata_flags_mask) ==
+        initial_metadata_flags_eq) {
+      *pp->target = NULL;
+      GRPC_CLOSURE_SCHED(exec_ctx, pp->on_complete,
+                         GRPC_ERROR_CREATE_REFERENCING_FROM_STATIC_STRING(
+                             "Pick cancelled", &error, 1));
+      gpr_free(pp);
+    } else {
+      pp->next = p->pending_picks;
+      p->pending_picks = pp;
+    }
+    pp = next;
+  }
+  GRPC_ERROR_UNREF(error);
+}
+
+static void start_picking_locked(grpc_exec_ctx *exec_ctx,
+                                 ring_hash_lb_policy *p) {
+  p->started_picking = true;
+  for (size_t i = 0; i < p->subchannel_list->num_subchannels; i++) {
+    grpc_lb_subchannel_data *sd = &p->subchannel_list->subchannels[i];
+    GRPC_LB_POLICY_WEAK_REF(&p->base, "start_picking_locked");
+    grpc_lb_subchannel_list_ref(sd->subchannel_list, "started_picking");
+    grpc_subchannel_notify_on_state_change(
+        exec_ctx, sd->subchannel, p->base.interested_parties,
+        &sd->pending_connectivity_state_unsafe,
+        &sd->connectivity_changed_closure);
+  }
+}
+
+static void rh_exit_idle_locked(grpc_exec_ctx *exec_ctx, grpc_lb_policy *pol) {
+  ring_hash_lb_policy *p = (ring_hash_lb_policy *)pol;
+  if (!p->started_picking) {
+    start_picking_locked(exec_ctx, p);
+  }
+}
+
+static int rh_pick_locked(grpc_exec_ctx *exec_ctx, grpc_lb_policy *pol,
+                          const grpc_lb_policy_pick_args *pick_args,
+                          grpc_connected_subchannel **target,
+                          grpc_call_context_element *context, void **user_data,
+                          grpc_closure *on_complete) {
+  ring_hash_lb_policy *p = (ring_hash_lb_policy *)pol;
+  if (GRPC_TRACER_ON(grpc_lb_ring_hash_trace)) {
+    gpr_log(GPR_INFO, "[RH %p] Trying to pick", (void *)pol);
+  }
+  if (rh_pick_from_picker_locked(p, pick_args->initial_metadata, target,
+                                 user_data)) {
+    return 1;
+  }
+  /* no pick currently available. Save for later in list of pending picks */
+  if (!p->started_picking) {
+    start_picking_locked(exec_ctx, p);
+  }
+  pending_pick *pp = gpr_malloc(sizeof(*pp));
+  pp->next = p->pending_picks;
+  pp->target = target;
+  pp->initial_metadata = pick_args->initial_metadata;
+  pp->on_complete = on_complete;
+  pp->initial_metadata_flags = pick_args->initial_metadata_flags;
+  pp->user_data = user_data;
+  p->pending_picks = pp;
+  return 0;
+}
+
+/** Sets the policy's connectivity status based on that of the passed-in \a sd
+ * (the subchannel_data associted with the updated subchannel) and the
+ * subchannel list \a sd belongs to (sd->subchannel_list). \a error will only be
+ * used upon policy transition to TRANSIENT_FAILURE or SHUTDOWN. Returns the
+ * connectivity status set. Follows the same rules as round_robin. */
+static grpc_connectivity_state update_lb_connectivity_status_locked(
+    grpc_exec_ctx *exec_ctx, grpc_lb_subchannel_data *sd, grpc_error *error) {
+  grpc_connectivity_state new_state = sd->curr_connectivity_state;
+  grpc_lb_subchannel_list *subchannel_list = sd->subchannel_list;
+  ring_hash_lb_policy *p = (ring_hash_lb_policy *)subchannel_list->policy;
+  if (subchannel_list->num_ready > 0) { /* 1) READY */
+    grpc_connectivity_state_set(exec_ctx, &p->state_tracker, GRPC_CHANNEL_READY,
+                                GRPC_ERROR_NONE, "rh_ready");
+    new_state = GRPC_CHANNEL_READY;
+  } else if (sd->curr_connectivity_state ==
+             GRPC_CHANNEL_CONNECTING) { /* 2) CONNECTING */
+    grpc_connectivity_state_set(exec_ctx, &p->state_tracker,
+                                GRPC_CHANNEL_CONNECTING, GRPC_ERROR_NONE,
+                                "rh_connecting");
+    new_state = GRPC_CHANNEL_CONNECTING;
+  } else if (p->subchannel_list->num_shutdown ==
+             p->subchannel_list->num_subchannels) { /* 3) SHUTDOWN */
+    grpc_connectivity_state_set(exec_ctx, &p->state_tracker,
+                                GRPC_CHANNEL_SHUTDOWN, GRPC_ERROR_REF(error),
+                                "rh_shutdown");
+    new_state = GRPC_CHANNEL_SHUTDOWN;
+  } else if (subchannel_list->num_transient_failures ==
+             p->subchannel_list->num_subchannels) { /* 4) TRANSIENT_FAILURE */
+    grpc_connectivity_state_set(exec_ctx, &p->state_tracker,
+                                GRPC_CHANNEL_TRANSIENT_FAILURE,
+                                GRPC_ERROR_REF(error), "rh_transient_failure");
+    new_state = GRPC_CHANNEL_TRANSIENT_FAILURE;
+  } else if (subchannel_list->num_idle ==
+             p->subchannel_list->num_subchannels) { /* 5) IDLE */
+    grpc_connectivity_state_set(exec_ctx, &p->state_tracker, GRPC_CHANNEL_IDLE,
+                                GRPC_ERROR_NONE, "rh_idle");
+    new_state = GRPC_CHANNEL_IDLE;
+  }
+  GRPC_ERROR_UNREF(error);
+  return new_state;
+}
+
+static void rh_connectivity_changed_locked(grpc_exec_ctx *exec_ctx, void *arg,
+                                           grpc_error *error) {
+  grpc_lb_subchannel_data *sd = arg;
+  ring_hash_lb_policy *p = (ring_hash_lb_policy *)sd->subchannel_list->policy;
+  if (GRPC_TRACER_ON(grpc_lb_ring_hash_trace)) {
+    gpr_log(
+        GPR_DEBUG,
+        "[RH %p] connectivity changed for subchannel %p, subchannel_list %p: "
+        "prev_state=%s new_state=%s p->shutdown=%d "
+        "sd->subchannel_list->shutting_down=%d error=%s",
+        (void *)p, (void *)sd->subchannel, (void *)sd->subchannel_list,
+        grpc_connectivity_state_name(sd->prev_connectivity_state),
+        grpc_connectivity_state_name(sd->pending_connectivity_state_unsafe),
+        p->shutdown, sd->subchannel_list->shutting_down,
+        grpc_error_string(error));
+  }
+  // If the policy is shutting down, unref and return.
+  if (p->shutdown) {
+    grpc_lb_subchannel_list_unref(exec_ctx, sd->subchannel_list,
+                             "pol_shutdown+started_picking");
+    GRPC_LB_POLICY_WEAK_UNREF(exec_ctx, &p->base, "pol_shutdown");
+    return;
+  }
+  if (sd->subchannel_list->shutting_down && error == GRPC_ERROR_CANCELLED) {
+    // the subchannel list associated with sd has been discarded. This callback
+    // corresponds to the unsubscription. The unrefs correspond to the picking
+    // ref (start_picking_locked or update_started_picking).
+    grpc_lb_subchannel_list_unref(exec_ctx, sd->subchannel_list,
+                             "sl_shutdown+started_picking");
+    GRPC_LB_POLICY_WEAK_UNREF(exec_ctx, &p->base, "sl_shutdown+picking");
+    return;
+  }
+  // Dispose of outdated subchannel lists.
+  if (sd->subchannel_list != p->subchannel_list &&
+      sd->subchannel_list != p->latest_pending_subchannel_list) {
+    // sd belongs to an outdated subchannel_list: get rid of it.
+    grpc_lb_subchannel_list_shutdown_and_unref(exec_ctx, sd->subchannel_list,
+                                          "sl_outdated");
+    GRPC_LB_POLICY_WEAK_UNREF(exec_ctx, &p->base, "sl_outdated");
+    return;
+  }
+  // Now that we're inside the combiner, copy the pending connectivity
+  // state (which was set by the connectivity state watcher) to
+  // curr_connectivity_state, which is what we use inside of the combiner.
+  sd->curr_connectivity_state = sd->pending_connectivity_state_unsafe;
+  const bool was_ready = sd->prev_connectivity_state == GRPC_CHANNEL_READY;
+  // Update state counters and determine new overall state.
+  grpc_lb_subchannel_data_update_state_counters(sd);
+  sd->prev_connectivity_state = sd->curr_connectivity_state;
+  const grpc_connectivity_state new_policy_connectivity_state =
+      update_lb_connectivity_status_locked(exec_ctx, sd, GRPC_ERROR_REF(error));
+  // If the sd's new state is SHUTDOWN, unref the subchannel, and if the new
+  // policy's state is SHUTDOWN, clean up.
+  if (sd->curr_connectivity_state == GRPC_CHANNEL_SHUTDOWN) {
+    GRPC_SUBCHANNEL_UNREF(exec_ctx, sd->subchannel, "rh_subchannel_shutdown");
+    sd->subchannel = NULL;
+    if (sd->user_data != NULL) {
+      GPR_ASSERT(sd->user_data_vtable != NULL);
+      sd->user_data_vtable->destroy(exec_ctx, sd->user_data);
+      sd->user_data = NULL;
+    }
+    if (new_policy_connectivity_state == GRPC_CHANNEL_SHUTDOWN) {
+      // the policy is shutting down. Flush all the pending picks...
+      pending_pick *pp;
+      while ((pp = p->pending_picks)) {
+        p->pending_picks = pp->next;
+        *pp->target = NULL;
+        GRPC_CLOSURE_SCHED(exec_ctx, pp->on_complete, GRPC_ERROR_NONE);
+        gpr_free(pp);
+      }
+    }
+    grpc_lb_subchannel_list_unref(exec_ctx, sd->subchannel_list,
+                             "sd_shutdown+started_picking");
+    // unref the "rh_connectivity_update" weak ref from start_picking.
+    GRPC_LB_POLICY_WEAK_UNREF(exec_ctx, &p->base,
+                              "rh_connectivity_sd_shutdown");
+  } else {  // sd not in SHUTDOWN
+    if (sd->curr_connectivity_state == GRPC_CHANNEL_READY &&
+        sd->subchannel_list != p->subchannel_list) {
+      // promote sd->subchannel_list to p->subchannel_list.
+      // sd->subchannel_list must be equal to
+      // p->latest_pending_subchannel_list because we have already filtered
+      // for sds belonging to outdated subchannel lists.
+      GPR_ASSERT(sd->subchannel_list == p->latest_pending_subchannel_list);
+      GPR_ASSERT(!sd->subchannel_list->shutting_down);
+      if (GRPC_TRACER_ON(grpc_lb_ring_hash_trace)) {
+        gpr_log(GPR_DEBUG,
+                "[RH %p] phasing out subchannel list %p in favor of %p",
+                (void *)p, (void *)p->subchannel_list,
+                (void *)sd->subchannel_list);
+      }
+      if (p->subchannel_list != NULL) {
+        // dispose of the current subchannel_list
+        grpc_lb_subchannel_list_shutdown_and_unref(exec_ctx, p->subchannel_list,
+                                              "sl_phase_out_shutdown");
+      }
+      p->subchannel_list = p->latest_pending_subchannel_list;
+      p->latest_pending_subchannel_list = NULL;
+    }
+    /* renew notification: reuses the "rh_connectivity_update" weak ref on the
+     * policy as well as the sd->subchannel_list ref. */
+    grpc_subchannel_notify_on_state_change(
+        exec_ctx, sd->subchannel, p->base.interested_parties,
+        &sd->pending_connectivity_state_unsafe,
+        &sd->connectivity_changed_closure);
+  }
+  // The set of READY subchannels changed: picks made outside of the combiner
+  // need to know.
+  if (was_ready || sd->curr_connectivity_state == GRPC_CHANNEL_READY) {
+    rh_update_picker_locked(exec_ctx, p);
+  }
+  // Fulfill the pending picks, each hashing its own key.
+  pending_pick *pp;
+  while (p->base.picker != NULL && (pp = p->pending_picks) != NULL) {
+    p->pending_picks = pp->next;
+    GPR_ASSERT(rh_pick_from_picker_locked(p, pp->initial_metadata, pp->target,
+                                          pp->user_data));
+    if (GRPC_TRACER_ON(grpc_lb_ring_hash_trace)) {
+      gpr_log(GPR_DEBUG, "[RH %p] Fulfilled pending pick. Target <-- %p",
+              (void *)p, (void *)*pp->target);
+    }
+    GRPC_CLOSURE_SCHED(exec_ctx, pp->on_complete, GRPC_ERROR_NONE);
+    gpr_free(pp);
+  }
+}
+
+static grpc_connectivity_state rh_check_connectivity_locked(
+    grpc_exec_ctx *exec_ctx, grpc_lb_policy *pol, grpc_error **error) {
+  ring_hash_lb_policy *p = (ring_hash_lb_policy *)pol;
+  return grpc_connectivity_state_get(&p->state_tracker, error);
+}
+
+static void rh_notify_on_state_change_locked(grpc_exec_ctx *exec_ctx,
+                                             grpc_lb_policy *pol,
+                                             grpc_connectivity_state *current,
+                                             grpc_closure *notify) {
+  ring_hash_lb_policy *p = (ring_hash_lb_policy *)pol;
+  grpc_connectivity_state_notify_on_state_change(exec_ctx, &p->state_tracker,
+                                                 current, notify);
+}
+
+static void rh_ping_one_locked(grpc_exec_ctx *exec_ctx, grpc_lb_policy *pol,
+                               grpc_closure *closure) {
+  ring_hash_lb_policy *p = (ring_hash_lb_policy *)pol;
+  if (p->base.picker != NULL) {
+    rh_picker *picker = (rh_picker *)p->base.picker;
+    grpc_connected_subchannel_ping(
+        exec_ctx, picker->subchannels[rh_picker_choose(picker, NULL)],
+        closure);
+  } else {
+    GRPC_CLOSURE_SCHED(exec_ctx, closure, GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+                                              "Ring Hash not connected"));
+  }
+}
+
+static void rh_update_locked(grpc_exec_ctx *exec_ctx, grpc_lb_policy *policy,
+                             const grpc_lb_policy_args *args) {
+  ring_hash_lb_policy *p = (ring_hash_lb_policy *)policy;
+  /* Find the number of backend addresses. We ignore balancer addresses, since
+   * we don't know how to handle them. */
+  const grpc_arg *arg =
+      grpc_channel_args_find(args->args, GRPC_ARG_LB_ADDRESSES);
+  if (arg == NULL || arg->type != GRPC_ARG_POINTER) {
+    if (p->subchannel_list == NULL) {
+      // If we don't have a current subchannel list, go into TRANSIENT FAILURE.
+      grpc_connectivity_state_set(
+          exec_ctx, &p->state_tracker, GRPC_CHANNEL_TRANSIENT_FAILURE,
+          GRPC_ERROR_CREATE_FROM_STATIC_STRING("Missing update in args"),
+          "rh_update_missing");
+    } else {
+      // otherwise, keep using the current subchannel list (ignore this update).
+      gpr_log(GPR_ERROR,
+              "[RH %p] No valid LB addresses channel arg for update, ignoring.",
+              (void *)p);
+    }
+    return;
+  }
+  grpc_lb_addresses *addresses = arg->value.pointer.p;
+  size_t num_addrs = 0;
+  for (size_t i = 0; i < addresses->num_addresses; i++) {
+    if (!addresses->addresses[i].is_balancer) ++num_addrs;
+  }
+  if (num_addrs == 0) {
+    grpc_connectivity_state_set(
+        exec_ctx, &p->state_tracker, GRPC_CHANNEL_TRANSIENT_FAILURE,
+        GRPC_ERROR_CREATE_FROM_STATIC_STRING("Empty update"),
+        "rh_update_empty");
+    if (p->subchannel_list != NULL) {
+      grpc_lb_subchannel_list_shutdown_and_unref(exec_ctx, p->subchannel_list,
+                                            "sl_shutdown_empty_update");
+      p->subchannel_list = NULL;
+      rh_update_picker_locked(exec_ctx, p);
+    }
+    return;
+  }
+  grpc_lb_subchannel_list *subchannel_list = grpc_lb_subchannel_list_create(
+      exec_ctx, &p->base, &grpc_lb_ring_hash_trace, addresses, args,
+      rh_connectivity_changed_locked);
+  subchannel_list->policy_data =
+      grpc_ring_hash_ring_create(addresses, p->points_per_backend);
+  subchannel_list->policy_data_destroy = rh_subchannel_list_ring_destroy;
+  if (GRPC_TRACER_ON(grpc_lb_ring_hash_trace)) {
+    gpr_log(GPR_INFO, "[RH %p] Subchannel list %p has %lu ring points",
+            (void *)p, (void *)subchannel_list,
+            (unsigned long)grpc_ring_hash_ring_size(
+                rh_subchannel_list_ring(subchannel_list)));
+  }
+  if (p->latest_pending_subchannel_list != NULL && p->started_picking) {
+    if (GRPC_TRACER_ON(grpc_lb_ring_hash_trace)) {
+      gpr_log(GPR_DEBUG,
+              "[RH %p] Shutting down latest pending subchannel list %p, about "
+              "to be replaced by newer latest %p",
+              (void *)p, (void *)p->latest_pending_subchannel_list,
+              (void *)subchannel_list);
+    }
+    grpc_lb_subchannel_list_shutdown_and_unref(
+        exec_ctx, p->latest_pending_subchannel_list, "sl_outdated_dont_smash");
+  }
+  p->latest_pending_subchannel_list = subchannel_list;
+  if (p->started_picking) {
+    for (size_t i = 0; i < subchannel_list->num_subchannels; i++) {
+      grpc_lb_subchannel_data *sd = &subchannel_list->subchannels[i];
+      grpc_lb_subchannel_list_ref(subchannel_list, "update_started_picking");
+      GRPC_LB_POLICY_WEAK_REF(&p->base, "rh_connectivity_update");
+      /* Watch every new subchannel. A subchannel list becomes active the
+       * moment one of its subchannels is READY. At that moment, we swap
+       * p->subchannel_list for sd->subchannel_list, provided the subchannel
+       * list is still valid (ie, isn't shutting down) */
+      grpc_subchannel_notify_on_state_change(
+          exec_ctx, sd->subchannel, p->base.interested_parties,
+          &sd->pending_connectivity_state_unsafe,
+          &sd->connectivity_changed_closure);
+    }
+  }
+  if (!p->started_picking) {
+    // The policy isn't picking yet. Save the update for later, disposing of
+    // previous version if any.
+    if (p->subchannel_list != NULL) {
+      grpc_lb_subchannel_list_shutdown_and_unref(exec_ctx, p->subchannel_list,
+                                            "rh_update_before_started_picking");
+    }
+    p->subchannel_list = subchannel_list;
+    p->latest_pending_subchannel_list = NULL;
+  }
+}
+
+static const grpc_lb_policy_vtable ring_hash_lb_policy_vtable = {
+    rh_destroy,
+    rh_shutdown_locked,
+    rh_pick_locked,
+    rh_cancel_pick_locked,
+    rh_cancel_picks_locked,
+    rh_ping_one_locked,
+    rh_exit_idle_locked,
+    rh_check_connectivity_locked,
+    rh_notify_on_state_change_locked,
+    rh_update_locked};
+
+static void ring_hash_factory_ref(grpc_lb_policy_factory *factory) {}
+
+static void ring_hash_factory_unref(grpc_lb_policy_factory *factory) {}
+
+static grpc_lb_policy *ring_hash_create(grpc_exec_ctx *exec_ctx,
+                                        grpc_lb_policy_factory *factory,
+                                        grpc_lb_policy_args *args) {
+  GPR_ASSERT(args->client_channel_factory != NULL);
+  ring_hash_lb_policy *p = gpr_zalloc(sizeof(*p));
+  const grpc_arg *arg =
+      grpc_channel_args_find(args->args, GRPC_ARG_RING_HASH_LB_HASH_KEY);
+  if (arg != NULL && arg->type == GRPC_ARG_STRING) {
+    p->hash_key =
+        grpc_slice_intern(grpc_slice_from_static_string(arg->value.string));
+  } else {
+    p->hash_key = GRPC_MDSTR_PATH;
+  }
+  arg = grpc_channel_args_find(args->args,
+                               GRPC_ARG_RING_HASH_LB_POINTS_PER_BACKEND);
+  p->points_per_backend = (size_t)grpc_channel_arg_get_integer(
+      arg, (grpc_integer_options){GRPC_RING_HASH_DEFAULT_POINTS_PER_BACKEND, 1,
+                                  INT16_MAX});
+  rh_update_locked(exec_ctx, &p->base, args);
+  grpc_lb_policy_init(&p->base, &ring_hash_lb_policy_vtable, args->combiner);
+  grpc_connectivity_state_init(&p->state_tracker, GRPC_CHANNEL_IDLE,
+                               "ring_hash");
+  if (GRPC_TRACER_ON(grpc_lb_ring_hash_trace)) {
+    gpr_log(GPR_DEBUG, "[RH %p] Created with %lu subchannels", (void *)p,
+            (unsigned long)p->subchannel_list->num_subchannels);
+  }
+  return &p->base;
+}
+
+static const grpc_lb_policy_factory_vtable ring_hash_factory_vtable = {
+    ring_hash_factory_ref, ring_hash_factory_unref, ring_hash_create,
+    "ring_hash"};
+
+static grpc_lb_policy_factory ring_hash_lb_policy_factory = {
+    &ring_hash_factory_vtable};
+
+static grpc_lb_policy_factory *ring_hash_lb_factory_create() {
+  return &ring_hash_lb_policy_factory;
+}
+
+/* Plugin registration */
+
+void grpc_lb_policy_ring_hash_init() {
+  grpc_register_lb_policy(ring_hash_lb_factory_create());
+  grpc_register_tracer(&grpc_lb_ring_hash_trace);
+}
+
+void grpc_lb_policy_ring_hash_shutdown() {}
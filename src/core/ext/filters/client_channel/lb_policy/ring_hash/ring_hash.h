@@ -0,0 +1,62 @@
+/*
+ *
+ * Copyright 2017 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GRPC_CORE_EXT_FILTERS_CLIENT_CHANNEL_LB_POLICY_RING_HASH_RING_HASH_H
+#define GRPC_CORE_EXT_FILTERS_CLIENT_CHANNEL_LB_POLICY_RING_HASH_RING_HASH_H
+
+#include "src/core/ext/filters/client_channel/lb_policy_factory.h"
+#include "src/core/lib/transport/metadata_batch.h"
+
+/** Number of points each backend gets on the ring unless
+ * GRPC_ARG_RING_HASH_LB_POINTS_PER_BACKEND says otherwise */
+#define GRPC_RING_HASH_DEFAULT_POINTS_PER_BACKEND 100
+
+/** An immutable, refcounted ketama-style hash ring over the backend (ie, non
+ * balancer) addresses of a \a grpc_lb_addresses, numbered in the order they
+ * appear in it. Every backend owns the arcs of the ring ending at each of its
+ * points, whose positions only depend on the backend's address: a key only
+ * moves to another backend when an update adds or removes the backend it
+ * was on, or one whose point lands right before the key's. */
+typedef struct grpc_ring_hash_ring grpc_ring_hash_ring;
+
+/** Returns a ring with \a points_per_backend points for each backend in
+ * \a addresses, which must contain at least one backend */
+grpc_ring_hash_ring *grpc_ring_hash_ring_create(
+    const grpc_lb_addresses *addresses, size_t points_per_backend);
+grpc_ring_hash_ring *grpc_ring_hash_ring_ref(grpc_ring_hash_ring *ring);
+void grpc_ring_hash_ring_unref(grpc_ring_hash_ring *ring);
+
+/** Returns the number of points on \a ring */
+size_t grpc_ring_hash_ring_size(const grpc_ring_hash_ring *ring);
+
+/** Returns the position of the first point of \a ring at or after \a hash
+ * (wrapping around to the first point past the last one) */
+size_t grpc_ring_hash_ring_find(const grpc_ring_hash_ring *ring,
+                                uint32_t hash);
+
+/** Returns the index of the backend owning the point at \a position */
+size_t grpc_ring_hash_ring_backend(const grpc_ring_hash_ring *ring,
+                                   size_t position);
+
+/** Returns the hash of the value of \a hash_key in \a initial_metadata, or of
+ * its :path if \a hash_key isn't there */
+uint32_t grpc_ring_hash_key_hash(grpc_metadata_batch *initial_metadata,
+                                 grpc_slice hash_key);
+
+#endif /* GRPC_CORE_EXT_FILTERS_CLIENT_CHANNEL_LB_POLICY_RING_HASH_RING_HASH_H \
+          */
@@ -0,0 +1,1050 @@
+/*
+ *
+ * Copyright 2017 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/** Weighted Round Robin Policy.
+ *
+ * Sends every backend a share of the calls inversely proportional to what its
+ * calls cost it. Backends report the cost of each call as a decimal number
+ * under the GRPC_LB_BACKEND_COST_MD_KEY trailing metadata key (any unit will
+ * do, as long as all the backends agree on it; the server's load reporting
+ * filter reports the time the server spent on the call, in milliseconds,
+ * unless the application set a value of its own). The backend_cost filter,
+ * added to the subchannels created by this policy, feeds those reports into an
+ * exponentially weighted moving average of the cost of each subchannel.
+ *
+ * Picks are scheduled earliest deadline first: every READY subchannel has a
+ * deadline on a virtual clock, and a pick returns the subchannel with the
+ * earliest one and pushes it back by the subchannel's average cost. A backend
+ * whose calls cost half as much is thus picked twice as often, and picks of the
+ * different backends are interleaved rather than sent in bursts. Subchannels
+ * without reports yet are taken to cost the average of the others.
+ *
+ * Subchannel list management is the same as round_robin's, through
+ * grpc_lb_subchannel_list. */
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <grpc/load_reporting.h>
+#include <grpc/support/alloc.h>
+#include <grpc/support/sync.h>
+
+#include "src/core/ext/filters/client_channel/lb_policy/subchannel_list.h"
+#include "src/core/ext/filters/client_channel/lb_policy_registry.h"
+#include "src/core/ext/filters/client_channel/subchannel.h"
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/channel/channel_stack_builder.h"
+#include "src/core/lib/debug/trace.h"
+#include "src/core/lib/iomgr/combiner.h"
+#include "src/core/lib/profiling/timers.h"
+#include "src/core/lib/surface/channel_init.h"
+#include "src/core/lib/transport/connectivity_state.h"
+
+/** Each cost report moves the average cost of its subchannel this fraction of
+ * the way towards the reported value */
+#define WRR_COST_EWMA_WEIGHT 0.2f
+/** Reported costs are clamped to this minimum, so that deadlines always move */
+#define WRR_MIN_COST 1e-6f
+
+grpc_tracer_flag grpc_lb_weighted_round_robin_trace =
+    GRPC_TRACER_INITIALIZER(false, "weighted_round_robin");
+
+/** List of entities waiting for a pick.
+ *
+ * Once a pick is available, \a target is updated and \a on_complete called. */
+typedef struct pending_pick {
+  struct pending_pick *next;
+
+  /* output argument where to store the pick()ed user_data. It'll be NULL if no
+   * such data is present or there's an error (the definite test for errors is
+   * \a target being NULL). */
+  void **user_data;
+
+  /* bitmask passed to pick() and used for selective cancelling. See
+   * grpc_lb_policy_cancel_picks() */
+  uint32_t initial_metadata_flags;
+
+  /* output argument where to store the pick()ed connected subchannel, or NULL
+   * upon error. */
+  grpc_connected_subchannel **target;
+
+  /* call context of the pick: lets the call report its cost */
+  grpc_call_context_element *context;
+
+  /* to be invoked once the pick() has completed (regardless of success) */
+  grpc_closure *on_complete;
+} pending_pick;
+
+/** Average cost of the calls on a subchannel. Shared by the subchannel lists
+ * and pickers referring to the subchannel, and by the calls that picked it,
+ * which report their cost into it. */
+typedef struct {
+  gpr_refcount refs;
+  /** bits of the average cost, as a float. 0 until the first report */
+  gpr_atm cost_bits;
+} wrr_load;
+
+static wrr_load *wrr_load_create(void) {
+  wrr_load *load = gpr_malloc(sizeof(*load));
+  gpr_ref_init(&load->refs, 1);
+  gpr_atm_no_barrier_store(&load->cost_bits, 0);
+  return load;
+}
+
+static wrr_load *wrr_load_ref(wrr_load *load) {
+  gpr_ref_non_zero(&load->refs);
+  return load;
+}
+
+static void wrr_load_unref(wrr_load *load) {
+  if (gpr_unref(&load->refs)) {
+    gpr_free(load);
+  }
+}
+
+static float cost_from_bits(gpr_atm bits) {
+  const uint32_t u = (uint32_t)bits;
+  float cost;
+  memcpy(&cost, &u, sizeof(cost));
+  return cost;
+}
+
+static gpr_atm cost_to_bits(float cost) {
+  uint32_t u;
+  memcpy(&u, &cost, sizeof(u));
+  return (gpr_atm)u;
+}
+
+/** Returns the average cost of the calls on \a load, or 0 if none reported */
+static float wrr_load_get_cost(wrr_load *load) {
+  return cost_from_bits(gpr_atm_no_barrier_load(&load->cost_bits));
+}
+
+/** Folds the \a cost reported by a call into the average of \a load */
+static void wrr_load_add_report(wrr_load *load, float cost) {
+  if (cost < WRR_MIN_COST) cost = WRR_MIN_COST;
+  gpr_atm old_bits;
+  float average;
+  do {
+    old_bits = gpr_atm_no_barrier_load(&load->cost_bits);
+    average = old_bits == 0 ? cost
+                            : cost_from_bits(old_bits) +
+                                  WRR_COST_EWMA_WEIGHT *
+                                      (cost - cost_from_bits(old_bits));
+  } while (!gpr_atm_no_barrier_cas(&load->cost_bits, old_bits,
+                                   cost_to_bits(average)));
+}
+
+/** Destroy function of GRPC_CONTEXT_LB_CALL_STATE: the call is done */
+static void wrr_load_call_done(void *arg) { wrr_load_unref(arg); }
+
+/** Lets the call owning \a context report its cost into \a load */
+static void wrr_load_call_started(wrr_load *load,
+                                  grpc_call_context_element *context) {
+  if (context == NULL) return;
+  grpc_call_context_element *call_state = &context[GRPC_CONTEXT_LB_CALL_STATE];
+  if (call_state->value != NULL) {
+    /* the call is picking again: it's done with its previous subchannel */
+    call_state->destroy(call_state->value);
+  }
+  call_state->value = wrr_load_ref(load);
+  call_state->destroy = wrr_load_call_done;
+}
+
+typedef struct weighted_round_robin_lb_policy {
+  /** base policy: must be first */
+  grpc_lb_policy base;
+
+  grpc_lb_subchannel_list *subchannel_list;
+
+  /** have we started picking? */
+  bool started_picking;
+  /** are we shutting down? */
+  bool shutdown;
+  /** List of picks that are waiting on connectivity */
+  pending_pick *pending_picks;
+
+  /** our connectivity state tracker */
+  grpc_connectivity_state_tracker state_tracker;
+
+  /** Latest version of the subchannel list.
+   * Subchannel connectivity callbacks will only promote updated subchannel
+   * lists if they equal \a latest_pending_subchannel_list. In other words,
+   * racing callbacks that reference outdated subchannel lists won't perform any
+   * update. */
+  grpc_lb_subchannel_list *latest_pending_subchannel_list;
+} weighted_round_robin_lb_policy;
+
+/** The loads of the subchannels of a subchannel list, in the same order: its
+ * policy data */
+typedef struct {
+  size_t num_subchannels;
+  wrr_load **loads;
+} wrr_subchannel_list_loads;
+
+static void wrr_subchannel_list_loads_destroy(grpc_exec_ctx *exec_ctx,
+                                              void *arg) {
+  wrr_subchannel_list_loads *list_loads = arg;
+  for (size_t i = 0; i < list_loads->num_subchannels; i++) {
+    wrr_load_unref(list_loads->loads[i]);
+  }
+  gpr_free(list_loads->loads);
+  gpr_free(list_loads);
+}
+
+/** Returns the average cost of the calls on the subchannel of \a sd */
+static wrr_load *wrr_subchannel_load(const grpc_lb_subchannel_data *sd) {
+  const grpc_lb_subchannel_list *subchannel_list = sd->subchannel_list;
+  const wrr_subchannel_list_loads *list_loads = subchannel_list->policy_data;
+  return list_loads->loads[sd - subchannel_list->subchannels];
+}
+
+/** A READY subchannel, as seen by an \a wrr_picker */
+typedef struct {
+  grpc_connected_subchannel *connected_subchannel;
+  wrr_load *load;
+  /** index of the subchannel in the policy's subchannel list */
+  size_t subchannel_list_index;
+  /** virtual time at which the subchannel is next due to be picked */
+  double deadline;
+} wrr_picker_entry;
+
+/** Picker choosing among the subchannels that were READY when it was
+ * published. The policy picks through it as well while it's published. */
+typedef struct {
+  /** base picker: must be first */
+  grpc_lb_picker base;
+  /** guards the deadlines of \a subchannels and \a schedule */
+  gpr_mu mu;
+  size_t num_subchannels;
+  wrr_picker_entry *subchannels;
+  /** indices into \a subchannels, as a binary min-heap on their deadlines */
+  size_t *schedule;
+} wrr_picker;
+
+/** Returns the average cost of the calls on \a entry or, if none has reported
+ * yet, that of the other subchannels of \a picker */
+static double wrr_picker_entry_cost(const wrr_picker *picker,
+                                    const wrr_picker_entry *entry) {
+  const float cost = wrr_load_get_cost(entry->load);
+  if (cost > 0) return cost;
+  double total = 0;
+  size_t num_reported = 0;
+  for (size_t i = 0; i < picker->num_subchannels; i++) {
+    const float other_cost = wrr_load_get_cost(picker->subchannels[i].load);
+    if (other_cost > 0) {
+      total += other_cost;
+      ++num_reported;
+    }
+  }
+  return num_reported == 0 ? 1.0 : total / (double)num_reported;
+}
+
+/** Whether the entry at \a a is due before the one at \a b. Ties go to the
+ * lower index, which makes equal costs plain round robin */
+static bool wrr_schedule_before(const wrr_picker *picker, size_t a, size_t b) {
+  const double deadline_a = picker->subchannels[a].deadline;
+  const double deadline_b = picker->subchannels[b].deadline;
+  return deadline_a < deadline_b || (deadline_a == deadline_b && a < b);
+}
+
+/** Restores the heap property of the schedule below \a pos */
+static void wrr_schedule_sift_down(wrr_picker *picker, size_t pos) {
+  size_t *schedule = picker->schedule;
+  const size_t n = picker->num_subchannels;
+  for (;;) {
+    size_t earliest = pos;
+    const size_t left = 2 * pos + 1;
+    const size_t right = left + 1;
+    if (left < n &&
+        wrr_schedule_before(picker, schedule[left], schedule[earliest])) {
+      earliest = left;
+    }
+    if (right < n &&
+        wrr_schedule_before(picker, schedule[right], schedule[earliest])) {
+      earliest = right;
+    }
+    if (earliest == pos) return;
+    const size_t tmp = schedule[pos];
+    schedule[pos] = schedule[earliest];
+    schedule[earliest] = tmp;
+    pos = earliest;
+  }
+}
+
+/** Returns the subchannel with the earliest deadline, pushing it back by its
+ * cost */
+static wrr_picker_entry *wrr_picker_choose(wrr_picker *picker) {
+  if (picker->num_subchannels == 1) return &picker->subchannels[0];
+  gpr_mu_lock(&picker->mu);
+  wrr_picker_entry *entry = &picker->subchannels[picker->schedule[0]];
+  entry->deadline += wrr_picker_entry_cost(picker, entry);
+  wrr_schedule_sift_down(picker, 0);
+  gpr_mu_unlock(&picker->mu);
+  return entry;
+}
+
+static void wrr_picker_destroy(grpc_exec_ctx *exec_ctx, grpc_lb_picker *base) {
+  wrr_picker *picker = (wrr_picker *)base;
+  for (size_t i = 0; i < picker->num_subchannels; i++) {
+    GRPC_CONNECTED_SUBCHANNEL_UNREF(
+        exec_ctx, picker->subchannels[i].connected_subchannel, "wrr_picker");
+    wrr_load_unref(picker->subchannels[i].load);
+  }
+  gpr_mu_destroy(&picker->mu);
+  gpr_free(picker->schedule);
+  gpr_free(picker->subchannels);
+  gpr_free(picker);
+}
+
+static bool wrr_picker_pick(grpc_exec_ctx *exec_ctx, grpc_lb_picker *base,
+                            const grpc_lb_policy_pick_args *pick_args,
+                            grpc_connected_subchannel **target,
+                            grpc_call_context_element *context) {
+  wrr_picker_entry *entry = wrr_picker_choose((wrr_picker *)base);
+  *target =
+      GRPC_CONNECTED_SUBCHANNEL_REF(entry->connected_subchannel, "wrr_picked");
+  wrr_load_call_started(entry->load, context);
+  return true;
+}
+
+static const grpc_lb_picker_vtable wrr_picker_vtable = {wrr_picker_destroy,
+                                                        wrr_picker_pick};
+
+/** Publishes a picker for the READY subchannels of p->subchannel_list (or none
+ * at all if there are no such subchannels) */
+static void wrr_update_picker_locked(grpc_exec_ctx *exec_ctx,
+                                     weighted_round_robin_lb_policy *p) {
+  grpc_lb_subchannel_list *subchannel_list = p->subchannel_list;
+  if (p->shutdown || subchannel_list == NULL ||
+      subchannel_list->num_ready == 0) {
+    grpc_lb_policy_set_picker_locked(exec_ctx, &p->base, NULL);
+    return;
+  }
+  wrr_picker *picker = gpr_zalloc(sizeof(*picker));
+  grpc_lb_picker_init(&picker->base, &wrr_picker_vtable);
+  gpr_mu_init(&picker->mu);
+  picker->subchannels = gpr_malloc(sizeof(*picker->subchannels) *
+                                   subchannel_list->num_ready);
+  picker->schedule =
+      gpr_malloc(sizeof(*picker->schedule) * subchannel_list->num_ready);
+  for (size_t i = 0; i < subchannel_list->num_subchannels; i++) {
+    grpc_lb_subchannel_data *sd = &subchannel_list->subchannels[i];
+    if (sd->curr_connectivity_state != GRPC_CHANNEL_READY) continue;
+    grpc_connected_subchannel *connected_subchannel =
+        grpc_subchannel_get_connected_subchannel(sd->subchannel);
+    if (connected_subchannel == NULL) continue;
+    GPR_ASSERT(picker->num_subchannels < subchannel_list->num_ready);
+    picker->schedule[picker->num_subchannels] = picker->num_subchannels;
+    wrr_picker_entry *entry = &picker->subchannels[picker->num_subchannels++];
+    entry->connected_subchannel =
+        GRPC_CONNECTED_SUBCHANNEL_REF(connected_subchannel, "wrr_picker");
+    entry->load = wrr_load_ref(wrr_subchannel_load(sd));
+    entry->subchannel_list_index = i;
+  }
+  /* every subchannel is first due one period (its cost) from now */
+  for (size_t i = 0; i < picker->num_subchannels; i++) {
+    picker->subchannels[i].deadline =
+        wrr_picker_entry_cost(picker, &picker->subchannels[i]);
+  }
+  for (size_t i = picker->num_subchannels / 2; i-- > 0;) {
+    wrr_schedule_sift_down(picker, i);
+  }
+  if (GRPC_TRACER_ON(grpc_lb_weighted_round_robin_trace)) {
+    gpr_log(GPR_DEBUG, "[WRR %p] publishing picker %p over %lu subchannels",
+            (void *)p, (void *)picker, (unsigned long)picker->num_subchannels);
+  }
+  if (picker->num_subchannels == 0) {
+    wrr_picker_destroy(exec_ctx, &picker->base);
+    picker = NULL;
+  }
+  grpc_lb_policy_set_picker_locked(exec_ctx, &p->base,
+                                   picker == NULL ? NULL : &picker->base);
+}
+
+/** Picks from the published picker into \a target and \a user_data, returning
+ * false if there's nothing to pick from */
+static bool wrr_pick_from_picker_locked(weighted_round_robin_lb_policy *p,
+                                        grpc_connected_subchannel **target,
+                                        grpc_call_context_element *context,
+                                        void **user_data) {
+  if (p->base.picker == NULL) return false;
+  /* the picker only knows about READY subchannels of p->subchannel_list */
+  GPR_ASSERT(p->subchannel_list != NULL);
+  wrr_picker_entry *entry = wrr_picker_choose((wrr_picker *)p->base.picker);
+  grpc_lb_subchannel_data *sd =
+      &p->subchannel_list->subchannels[entry->subchannel_list_index];
+  *target =
+      GRPC_CONNECTED_SUBCHANNEL_REF(entry->connected_subchannel, "wrr_picked");
+  if (user_data != NULL) {
+    *user_data = sd->user_data;
+  }
+  wrr_load_call_started(entry->load, context);
+  if (GRPC_TRACER_ON(grpc_lb_weighted_round_robin_trace)) {
+    gpr_log(GPR_DEBUG,
+            "[WRR %p] Picked target <-- Subchannel %p (connected %p) (sl %p, "
+            "index %lu, average cost %f)",
+            (void *)p, (void *)sd->subchannel, (void *)*target,
+            (void *)sd->subchannel_list,
+            (unsigned long)entry->subchannel_list_index,
+            (double)wrr_load_get_cost(entry->load));
+  }
+  return true;
+}
+
+static void wrr_destroy(grpc_exec_ctx *exec_ctx, grpc_lb_policy *pol) {
+  weighted_round_robin_lb_policy *p = (weighted_round_robin_lb_policy *)pol;
+  if (GRPC_TRACER_ON(grpc_lb_weighted_round_robin_trace)) {
+    gpr_log(GPR_DEBUG, "[WRR %p] Destroying Weighted Round Robin policy at %p",
+            (void *)pol, (void *)pol);
+  }
+  grpc_connectivity_state_destroy(exec_ctx, &p->state_tracker);
+  gpr_free(p);
+}
+
+static void wrr_shutdown_locked(grpc_exec_ctx *exec_ctx, grpc_lb_policy *pol) {
+  weighted_round_robin_lb_policy *p = (weighted_round_robin_lb_policy *)pol;
+  if (GRPC_TRACER_ON(grpc_lb_weighted_round_robin_trace)) {
+    gpr_log(GPR_DEBUG,
+            "[WRR %p] Shutting down Weighted Round Robin policy at %p",
+            (void *)pol, (void *)pol);
+  }
+  p->shutdown = true;
+  pending_pick *pp;
+  while ((pp = p->pending_picks)) {
+    p->pending_picks = pp->next;
+    *pp->target = NULL;
+    GRPC_CLOSURE_SCHED(
+        exec_ctx, pp->on_complete,
+        GRPC_ERROR_CREATE_FROM_STATIC_STRING("Channel Shutdown"));
+    gpr_free(pp);
+  }
+  grpc_connectivity_state_set(
+      exec_ctx, &p->state_tracker, GRPC_CHANNEL_SHUTDOWN,
+      GRPC_ERROR_CREATE_FROM_STATIC_STRING("Channel Shutdown"), "wrr_shutdown");
+  const bool latest_is_current =
+      p->subchannel_list == p->latest_pending_subchannel_list;
+  grpc_lb_subchannel_list_shutdown_and_unref(exec_ctx, p->subchannel_list,
+                                         "sl_shutdown_wrr_shutdown");
+  p->subchannel_list = NULL;
+  if (!latest_is_current && p->latest_pending_subchannel_list != NULL &&
+      !p->latest_pending_subchannel_list->shutting_down) {
+    grpc_lb_subchannel_list_shutdown_and_unref(exec_ctx,
+                                           p->latest_pending_subchannel_list,
+                                           "sl_shutdown_pending_wrr_shutdown");
+    p->latest_pending_subchannel_list = NULL;
+  }
+}
+
+static void wrr_cancel_pick_locked(grpc_exec_ctx *exec_ctx, grpc_lb_policy *pol,
+                                   grpc_connected_subchannel **target,
+                                   grpc_error *error) {
+  weighted_round_robin_lb_policy *p = (weighted_round_robin_lb_policy *)pol;
+  pending_pick *pp = p->pending_picks;
+  p->pending_picks = NULL;
+  while (pp != NULL) {
+    pending_pick *next = pp->next;
+    if (pp->target == target) {
+      *target = NULL;
+      GRPC_CLOSURE_SCHED(exec_ctx, pp->on_complete,
+                         GRPC_ERROR_CREATE_REFERENCING_FROM_STATIC_STRING(
+                             "Pick cancelled", &error, 1));
+      gpr_free(pp);
+    } else {
+      pp->next = p->pending_picks;
+      p->pending_picks = pp;
+    }
+    pp = next;
+  }
+  GRPC_ERROR_UNREF(error);
+}
+
+static void wrr_cancel_picks_locked(grpc_exec_ctx *exec_ctx,
+                                    grpc_lb_policy *pol,
+                                    uint32_t initial_metadata_flags_mask,
+                                    uint32_t initial_metadata_flags_eq,
+                                    grpc_error *error) {
+  weighted_round_robin_lb_policy *p = (weighted_round_robin_lb_policy *)pol;
+  pending_pick *pp = p->pending_picks;
+  p->pending_picks = NULL;
+  while (pp != NULL) {
+    pending_pick *next = pp->next;
+    if ((pp->initial_metadata_flags & initial_metadata_flags_mask) ==
+        initial_metadata_flags_eq) {
+      *pp->target = NULL;
+      GRPC_CLOSURE_SCHED(exec_ctx, pp->on_complete,
+                         GRPC_ERROR_CREATE_REFERENCING_FROM_STATIC_STRING(
+                             "Pick cancelled", &error, 1));
+      gpr_free(pp);
+    } else {
+      pp->next = p->pending_picks;
+      p->pending_picks = pp;
+    }
+    pp = next;
+  }
+  GRPC_ERROR_UNREF(error);
+}
+
+static void start_picking_locked(grpc_exec_ctx *exec_ctx,
+                                 weighted_round_robin_lb_policy *p) {
+  p->started_picking = true;
+  for (size_t i = 0; i < p->subchannel_list->num_subchannels; i++) {
+    grpc_lb_subchannel_data *sd = &p->subchannel_list->subchannels[i];
+    GRPC_LB_POLICY_WEAK_REF(&p->base, "start_picking_locked");
+    grpc_lb_subchannel_list_ref(sd->subchannel_list, "started_picking");
+    grpc_subchannel_notify_on_state_change(
+        exec_ctx, sd->subchannel, p->base.interested_parties,
+        &sd->pending_connectivity_state_unsafe,
+        &sd->connectivity_changed_closure);
+  }
+}
+
+static void wrr_exit_idle_locked(grpc_exec_ctx *exec_ctx, grpc_lb_policy *pol) {
+  weighted_round_robin_lb_policy *p = (weighted_round_robin_lb_policy *)pol;
+  if (!p->started_picking) {
+    start_picking_locked(exec_ctx, p);
+  }
+}
+
+static int wrr_pick_locked(grpc_exec_ctx *exec_ctx, grpc_lb_policy *pol,
+                           const grpc_lb_policy_pick_args *pick_args,
+                           grpc_connected_subchannel **target,
+                           grpc_call_context_element *context, void **user_data,
+                           grpc_closure *on_complete) {
+  weighted_round_robin_lb_policy *p = (weighted_round_robin_lb_policy *)pol;
+  if (GRPC_TRACER_ON(grpc_lb_weighted_round_robin_trace)) {
+    gpr_log(GPR_INFO, "[WRR %p] Trying to pick", (void *)pol);
+  }
+  if (wrr_pick_from_picker_locked(p, target, context, user_data)) {
+    return 1;
+  }
+  /* no pick currently available. Save for later in list of pending picks */
+  if (!p->started_picking) {
+    start_picking_locked(exec_ctx, p);
+  }
+  pending_pick *pp = gpr_malloc(sizeof(*pp));
+  pp->next = p->pending_picks;
+  pp->target = target;
+  pp->context = context;
+  pp->on_complete = on_complete;
+  pp->initial_metadata_flags = pick_args->initial_metadata_flags;
+  pp->user_data = user_data;
+  p->pending_picks = pp;
+  return 0;
+}
+
+/** Sets the policy's connectivity status based on that of the passed-in \a sd
+ * (the subchannel_data associted with the updated subchannel) and the
+ * subchannel list \a sd belongs to (sd->subchannel_list). \a error will only be
+ * used upon policy transition to TRANSIENT_FAILURE or SHUTDOWN. Returns the
+ * connectivity status set. Follows the same rules as round_robin. */
+static grpc_connectivity_state update_lb_connectivity_status_locked(
+    grpc_exec_ctx *exec_ctx, grpc_lb_subchannel_data *sd, grpc_error *error) {
+  grpc_connectivity_state new_state = sd->curr_connectivity_state;
+  grpc_lb_subchannel_list *subchannel_list = sd->subchannel_list;
+  weighted_round_robin_lb_policy *p =
+      (weighted_round_robin_lb_policy *)subchannel_list->policy;
+  if (subchannel_list->num_ready > 0) { /* 1) READY */
+    grpc_connectivity_state_set(exec_ctx, &p->state_tracker, GRPC_CHANNEL_READY,
+                                GRPC_ERROR_NONE, "wrr_ready");
+    new_state = GRPC_CHANNEL_READY;
+  } else if (sd->curr_connectivity_state ==
+             GRPC_CHANNEL_CONNECTING) { /* 2) CONNECTING */
+    grpc_connectivity_state_set(exec_ctx, &p->state_tracker,
+                                GRPC_CHANNEL_CONNECTING, GRPC_ERROR_NONE,
+                                "wrr_connecting");
+    new_state = GRPC_CHANNEL_CONNECTING;
+  } else if (p->subchannel_list->num_shutdown ==
+             p->subchannel_list->num_subchannels) { /* 3) SHUTDOWN */
+    grpc_connectivity_state_set(exec_ctx, &p->state_tracker,
+                                GRPC_CHANNEL_SHUTDOWN, GRPC_ERROR_REF(error),
+                                "wrr_shutdown");
+    new_state = GRPC_CHANNEL_SHUTDOWN;
+  } else if (subchannel_list->num_transient_failures ==
+             p->subchannel_list->num_subchannels) { /* 4) TRANSIENT_FAILURE */
+    grpc_connectivity_state_set(exec_ctx, &p->state_tracker,
+                                GRPC_CHANNEL_TRANSIENT_FAILURE,
+                                GRPC_ERROR_REF(error), "wrr_transient_failure");
+    new_state = GRPC_CHANNEL_TRANSIENT_FAILURE;
+  } else if (subchannel_list->num_idle ==
+             p->subchannel_list->num_subchannels) { /* 5) IDLE */
+    grpc_connectivity_state_set(exec_ctx, &p->state_tracker, GRPC_CHANNEL_IDLE,
+                                GRPC_ERROR_NONE, "wrr_idle");
+    new_state = GRPC_CHANNEL_IDLE;
+  }
+  GRPC_ERROR_UNREF(error);
+  return new_state;
+}
+
+static void wrr_connectivity_changed_locked(grpc_exec_ctx *exec_ctx, void *arg,
+                                            grpc_error *error) {
+  grpc_lb_subchannel_data *sd = arg;
+  weighted_round_robin_lb_policy *p =
+      (weighted_round_robin_lb_policy *)sd->subchannel_list->policy;
+  if (GRPC_TRACER_ON(grpc_lb_weighted_round_robin_trace)) {
+    gpr_log(
+        GPR_DEBUG,
+        "[WRR %p] connectivity changed for subchannel %p, subchannel_list %p: "
+        "prev_state=%s new_state=%s p->shutdown=%d "
+        "sd->subchannel_list->shutting_down=%d error=%s",
+        (void *)p, (void *)sd->subchannel, (void *)sd->subchannel_list,
+        grpc_connectivity_state_name(sd->prev_connectivity_state),
+        grpc_connectivity_state_name(sd->pending_connectivity_state_unsafe),
+        p->shutdown, sd->subchannel_list->shutting_down,
+        grpc_error_string(error));
+  }
+  // If the policy is shutting down, unref and return.
+  if (p->shutdown) {
+    grpc_lb_subchannel_list_unref(exec_ctx, sd->subchannel_list,
+                              "pol_shutdown+started_picking");
+    GRPC_LB_POLICY_WEAK_UNREF(exec_ctx, &p->base, "pol_shutdown");
+    return;
+  }
+  if (sd->subchannel_list->shutting_down && error == GRPC_ERROR_CANCELLED) {
+    // the subchannel list associated with sd has been discarded. This callback
+    // corresponds to the unsubscription. The unrefs correspond to the picking
+    // ref (start_picking_locked or update_started_picking).
+    grpc_lb_subchannel_list_unref(exec_ctx, sd->subchannel_list,
+                              "sl_shutdown+started_picking");
+    GRPC_LB_POLICY_WEAK_UNREF(exec_ctx, &p->base, "sl_shutdown+picking");
+    return;
+  }
+  // Dispose of outdated subchannel lists.
+  if (sd->subchannel_list != p->subchannel_list &&
+      sd->subchannel_list != p->latest_pending_subchannel_list) {
+    // sd belongs to an outdated subchannel_list: get rid of it.
+    grpc_lb_subchannel_list_shutdown_and_unref(exec_ctx, sd->subchannel_list,
+                                           "sl_outdated");
+    GRPC_LB_POLICY_WEAK_UNREF(exec_ctx, &p->base, "sl_outdated");
+    return;
+  }
+  // Now that we're inside the combiner, copy the pending connectivity
+  // state (which was set by the connectivity state watcher) to
+  // curr_connectivity_state, which is what we use inside of the combiner.
+  sd->curr_connectivity_state = sd->pending_connectivity_state_unsafe;
+  const bool was_ready = sd->prev_connectivity_state == GRPC_CHANNEL_READY;
+  // Update state counters and determine new overall state.
+  grpc_lb_subchannel_data_update_state_counters(sd);
+  sd->prev_connectivity_state = sd->curr_connectivity_state;
+  const grpc_connectivity_state new_policy_connectivity_state =
+      update_lb_connectivity_status_locked(exec_ctx, sd, GRPC_ERROR_REF(error));
+  // If the sd's new state is SHUTDOWN, unref the subchannel, and if the new
+  // policy's state is SHUTDOWN, clean up.
+  if (sd->curr_connectivity_state == GRPC_CHANNEL_SHUTDOWN) {
+    GRPC_SUBCHANNEL_UNREF(exec_ctx, sd->subchannel, "wrr_subchannel_shutdown");
+    sd->subchannel = NULL;
+    if (sd->user_data != NULL) {
+      GPR_ASSERT(sd->user_data_vtable != NULL);
+      sd->user_data_vtable->destroy(exec_ctx, sd->user_data);
+      sd->user_data = NULL;
+    }
+    if (new_policy_connectivity_state == GRPC_CHANNEL_SHUTDOWN) {
+      // the policy is shutting down. Flush all the pending picks...
+      pending_pick *pp;
+      while ((pp = p->pending_picks)) {
+        p->pending_picks = pp->next;
+        *pp->target = NULL;
+        GRPC_CLOSURE_SCHED(exec_ctx, pp->on_complete, GRPC_ERROR_NONE);
+        gpr_free(pp);
+      }
+    }
+    grpc_lb_subchannel_list_unref(exec_ctx, sd->subchannel_list,
+                              "sd_shutdown+started_picking");
+    // unref the "wrr_connectivity_update" weak ref from start_picking.
+    GRPC_LB_POLICY_WEAK_UNREF(exec_ctx, &p->base,
+                              "wrr_connectivity_sd_shutdown");
+  } else {  // sd not in SHUTDOWN
+    if (sd->curr_connectivity_state == GRPC_CHANNEL_READY &&
+        sd->subchannel_list != p->subchannel_list) {
+      // promote sd->subchannel_list to p->subchannel_list.
+      // sd->subchannel_list must be equal to
+      // p->latest_pending_subchannel_list because we have already filtered
+      // for sds belonging to outdated subchannel lists.
+      GPR_ASSERT(sd->subchannel_list == p->latest_pending_subchannel_list);
+      GPR_ASSERT(!sd->subchannel_list->shutting_down);
+      if (GRPC_TRACER_ON(grpc_lb_weighted_round_robin_trace)) {
+        gpr_log(GPR_DEBUG,
+                "[WRR %p] phasing out subchannel list %p in favor of %p",
+                (void *)p, (void *)p->subchannel_list,
+                (void *)sd->subchannel_list);
+      }
+      if (p->subchannel_list != NULL) {
+        // dispose of the current subchannel_list
+        grpc_lb_subchannel_list_shutdown_and_unref(exec_ctx, p->subchannel_list,
+                                               "sl_phase_out_shutdown");
+      }
+      p->subchannel_list = p->latest_pending_subchannel_list;
+      p->latest_pending_subchannel_list = NULL;
+    }
+    /* renew notification: reuses the "wrr_connectivity_update" weak ref on the
+     * policy as well as the sd->subchannel_list ref. */
+    grpc_subchannel_notify_on_state_change(
+        exec_ctx, sd->subchannel, p->base.interested_parties,
+        &sd->pending_connectivity_state_unsafe,
+        &sd->connectivity_changed_closure);
+  }
+  // The set of READY subchannels changed: picks made outside of the combiner
+  // need to know.
+  if (was_ready || sd->curr_connectivity_state == GRPC_CHANNEL_READY) {
+    wrr_update_picker_locked(exec_ctx, p);
+  }
+  // Fulfill the pending picks, each choosing on its own so that they spread
+  // over the READY subchannels.
+  pending_pick *pp;
+  while (p->base.picker != NULL && (pp = p->pending_picks) != NULL) {
+    p->pending_picks = pp->next;
+    GPR_ASSERT(
+        wrr_pick_from_picker_locked(p, pp->target, pp->context, pp->user_data));
+    if (GRPC_TRACER_ON(grpc_lb_weighted_round_robin_trace)) {
+      gpr_log(GPR_DEBUG, "[WRR %p] Fulfilled pending pick. Target <-- %p",
+              (void *)p, (void *)*pp->target);
+    }
+    GRPC_CLOSURE_SCHED(exec_ctx, pp->on_complete, GRPC_ERROR_NONE);
+    gpr_free(pp);
+  }
+}
+
+static grpc_connectivity_state wrr_check_connectivity_locked(
+    grpc_exec_ctx *exec_ctx, grpc_lb_policy *pol, grpc_error **error) {
+  weighted_round_robin_lb_policy *p = (weighted_round_robin_lb_policy *)pol;
+  return grpc_connectivity_state_get(&p->state_tracker, error);
+}
+
+static void wrr_notify_on_state_change_locked(grpc_exec_ctx *exec_ctx,
+                                              grpc_lb_policy *pol,
+                                              grpc_connectivity_state *current,
+                                              grpc_closure *notify) {
+  weighted_round_robin_lb_policy *p = (weighted_round_robin_lb_policy *)pol;
+  grpc_connectivity_state_notify_on_state_change(exec_ctx, &p->state_tracker,
+                                                 current, notify);
+}
+
+static void wrr_ping_one_locked(grpc_exec_ctx *exec_ctx, grpc_lb_policy *pol,
+                                grpc_closure *closure) {
+  weighted_round_robin_lb_policy *p = (weighted_round_robin_lb_policy *)pol;
+  if (p->base.picker != NULL) {
+    wrr_picker_entry *entry = wrr_picker_choose((wrr_picker *)p->base.picker);
+    grpc_connected_subchannel_ping(exec_ctx, entry->connected_subchannel,
+                                   closure);
+  } else {
+    GRPC_CLOSURE_SCHED(exec_ctx, closure,
+                       GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+                           "Weighted Round Robin not connected"));
+  }
+}
+
+/** Returns the load of \a subchannel in the current subchannel list if it's
+ * there, so that its average cost survives updates, or a new one */
+static wrr_load *wrr_load_for_subchannel_locked(
+    weighted_round_robin_lb_policy *p, grpc_subchannel *subchannel) {
+  if (p->subchannel_list != NULL) {
+    for (size_t i = 0; i < p->subchannel_list->num_subchannels; i++) {
+      grpc_lb_subchannel_data *sd = &p->subchannel_list->subchannels[i];
+      if (sd->subchannel == subchannel) {
+        return wrr_load_ref(wrr_subchannel_load(sd));
+      }
+    }
+  }
+  return wrr_load_create();
+}
+
+static void wrr_update_locked(grpc_exec_ctx *exec_ctx, grpc_lb_policy *policy,
+                              const grpc_lb_policy_args *args) {
+  weighted_round_robin_lb_policy *p = (weighted_round_robin_lb_policy *)policy;
+  /* Find the number of backend addresses. We ignore balancer addresses, since
+   * we don't know how to handle them. */
+  const grpc_arg *arg =
+      grpc_channel_args_find(args->args, GRPC_ARG_LB_ADDRESSES);
+  if (arg == NULL || arg->type != GRPC_ARG_POINTER) {
+    if (p->subchannel_list == NULL) {
+      // If we don't have a current subchannel list, go into TRANSIENT FAILURE.
+      grpc_connectivity_state_set(
+          exec_ctx, &p->state_tracker, GRPC_CHANNEL_TRANSIENT_FAILURE,
+          GRPC_ERROR_CREATE_FROM_STATIC_STRING("Missing update in args"),
+          "wrr_update_missing");
+    } else {
+      // otherwise, keep using the current subchannel list (ignore this update).
+      gpr_log(
+          GPR_ERROR,
+          "[WRR %p] No valid LB addresses channel arg for update, ignoring.",
+          (void *)p);
+    }
+    return;
+  }
+  grpc_lb_addresses *addresses = arg->value.pointer.p;
+  size_t num_addrs = 0;
+  for (size_t i = 0; i < addresses->num_addresses; i++) {
+    if (!addresses->addresses[i].is_balancer) ++num_addrs;
+  }
+  if (num_addrs == 0) {
+    grpc_connectivity_state_set(
+        exec_ctx, &p->state_tracker, GRPC_CHANNEL_TRANSIENT_FAILURE,
+        GRPC_ERROR_CREATE_FROM_STATIC_STRING("Empty update"),
+        "wrr_update_empty");
+    if (p->subchannel_list != NULL) {
+      grpc_lb_subchannel_list_shutdown_and_unref(exec_ctx, p->subchannel_list,
+                                             "sl_shutdown_empty_update");
+      p->subchannel_list = NULL;
+      wrr_update_picker_locked(exec_ctx, p);
+    }
+    return;
+  }
+  /* The policy name, which may come from the service config rather than the
+   * channel args, makes the subchannels report the cost of their calls. */
+  static const char *keys_to_remove[] = {GRPC_ARG_LB_POLICY_NAME};
+  grpc_arg policy_name_arg = grpc_channel_arg_string_create(
+      GRPC_ARG_LB_POLICY_NAME, "weighted_round_robin");
+  grpc_lb_policy_args subchannel_args = *args;
+  subchannel_args.args = grpc_channel_args_copy_and_add_and_remove(
+      args->args, keys_to_remove, GPR_ARRAY_SIZE(keys_to_remove),
+      &policy_name_arg, 1);
+  grpc_lb_subchannel_list *subchannel_list = grpc_lb_subchannel_list_create(
+      exec_ctx, &p->base, &grpc_lb_weighted_round_robin_trace, addresses,
+      &subchannel_args, wrr_connectivity_changed_locked);
+  grpc_channel_args_destroy(exec_ctx, subchannel_args.args);
+  wrr_subchannel_list_loads *list_loads = gpr_malloc(sizeof(*list_loads));
+  list_loads->num_subchannels = subchannel_list->num_subchannels;
+  list_loads->loads =
+      gpr_malloc(sizeof(*list_loads->loads) * list_loads->num_subchannels);
+  for (size_t i = 0; i < subchannel_list->num_subchannels; i++) {
+    list_loads->loads[i] = wrr_load_for_subchannel_locked(
+        p, subchannel_list->subchannels[i].subchannel);
+  }
+  subchannel_list->policy_data = list_loads;
+  subchannel_list->policy_data_destroy = wrr_subchannel_list_loads_destroy;
+  if (p->latest_pending_subchannel_list != NULL && p->started_picking) {
+    if (GRPC_TRACER_ON(grpc_lb_weighted_round_robin_trace)) {
+      gpr_log(GPR_DEBUG,
+              "[WRR %p] Shutting down latest pending subchannel list %p, about "
+              "to be replaced by newer latest %p",
+              (void *)p, (void *)p->latest_pending_subchannel_list,
+              (void *)subchannel_list);
+    }
+    grpc_lb_subchannel_list_shutdown_and_unref(
+        exec_ctx, p->latest_pending_subchannel_list, "sl_outdated_dont_smash");
+  }
+  p->latest_pending_subchannel_list = subchannel_list;
+  if (p->started_picking) {
+    for (size_t i = 0; i < subchannel_list->num_subchannels; i++) {
+      grpc_lb_subchannel_data *sd = &subchannel_list->subchannels[i];
+      grpc_lb_subchannel_list_ref(subchannel_list, "update_started_picking");
+      GRPC_LB_POLICY_WEAK_REF(&p->base, "wrr_connectivity_update");
+      /* Watch every new subchannel. A subchannel list becomes active the
+       * moment one of its subchannels is READY. At that moment, we swap
+       * p->subchannel_list for sd->subchannel_list, provided the subchannel
+       * list is still valid (ie, isn't shutting down) */
+      grpc_subchannel_notify_on_state_change(
+          exec_ctx, sd->subchannel, p->base.interested_parties,
+          &sd->pending_connectivity_state_unsafe,
+          &sd->connectivity_changed_closure);
+    }
+  }
+  if (!p->started_picking) {
+    // The policy isn't picking yet. Save the update for later, disposing of
+    // previous version if any.
+    if (p->subchannel_list != NULL) {
+      grpc_lb_subchannel_list_shutdown_and_unref(
+          exec_ctx, p->subchannel_list, "wrr_update_before_started_picking");
+    }
+    p->subchannel_list = subchannel_list;
+    p->latest_pending_subchannel_list = NULL;
+  }
+}
+
+static const grpc_lb_policy_vtable weighted_round_robin_lb_policy_vtable = {
+    wrr_destroy,
+    wrr_shutdown_locked,
+    wrr_pick_locked,
+    wrr_cancel_pick_locked,
+    wrr_cancel_picks_locked,
+    wrr_ping_one_locked,
+    wrr_exit_idle_locked,
+    wrr_check_connectivity_locked,
+    wrr_notify_on_state_change_locked,
+    wrr_update_locked};
+
+static void weighted_round_robin_factory_ref(grpc_lb_policy_factory *factory) {}
+
+static void weighted_round_robin_factory_unref(
+    grpc_lb_policy_factory *factory) {}
+
+static grpc_lb_policy *weighted_round_robin_create(
+    grpc_exec_ctx *exec_ctx, grpc_lb_policy_factory *factory,
+    grpc_lb_policy_args *args) {
+  GPR_ASSERT(args->client_channel_factory != NULL);
+  weighted_round_robin_lb_policy *p = gpr_zalloc(sizeof(*p));
+  wrr_update_locked(exec_ctx, &p->base, args);
+  grpc_lb_policy_init(&p->base, &weighted_round_robin_lb_policy_vtable,
+                      args->combiner);
+  grpc_connectivity_state_init(&p->state_tracker, GRPC_CHANNEL_IDLE,
+                               "weighted_round_robin");
+  if (GRPC_TRACER_ON(grpc_lb_weighted_round_robin_trace)) {
+    gpr_log(GPR_DEBUG, "[WRR %p] Created with %lu subchannels", (void *)p,
+            (unsigned long)p->subchannel_list->num_subchannels);
+  }
+  return &p->base;
+}
+
+static const grpc_lb_policy_factory_vtable
+    weighted_round_robin_factory_vtable = {
+        weighted_round_robin_factory_ref, weighted_round_robin_factory_unref,
+        weighted_round_robin_create, "weighted_round_robin"};
+
+static grpc_lb_policy_factory weighted_round_robin_lb_policy_factory = {
+    &weighted_round_robin_factory_vtable};
+
+static grpc_lb_policy_factory *weighted_round_robin_lb_factory_create() {
+  return &weighted_round_robin_lb_policy_factory;
+}
+
+/* backend_cost filter: added to the subchannels of the policy, it reports the
+ * cost found in the trailing metadata of every call into the load of the
+ * subchannel the call was picked for (its GRPC_CONTEXT_LB_CALL_STATE). */
+
+typedef struct {
+  /** where to report the cost of the call, or NULL */
+  wrr_load *load;
+  /** state for intercepting recv_trailing_metadata */
+  grpc_metadata_batch *recv_trailing_metadata;
+  grpc_closure on_complete;
+  grpc_closure *original_on_complete;
+} backend_cost_call_data;
+
+/** Parses the decimal number in \a value into \a cost */
+static bool parse_backend_cost(grpc_slice value, float *cost) {
+  char buf[32];
+  const size_t len = GRPC_SLICE_LENGTH(value);
+  if (len == 0 || len >= sizeof(buf)) return false;
+  memcpy(buf, GRPC_SLICE_START_PTR(value), len);
+  buf[len] = '\0';
+  char *end;
+  const double parsed = strtod(buf, &end);
+  if (end != buf + len || !isfinite(parsed) || parsed < 0) return false;
+  *cost = (float)parsed;
+  return true;
+}
+
+static void backend_cost_on_complete(grpc_exec_ctx *exec_ctx, void *arg,
+                                     grpc_error *error) {
+  backend_cost_call_data *calld = arg;
+  if (error == GRPC_ERROR_NONE) {
+    for (grpc_linked_mdelem *l = calld->recv_trailing_metadata->list.head;
+         l != NULL; l = l->next) {
+      if (grpc_slice_str_cmp(GRPC_MDKEY(l->md), GRPC_LB_BACKEND_COST_MD_KEY) !=
+          0) {
+        continue;
+      }
+      float cost;
+      if (parse_backend_cost(GRPC_MDVALUE(l->md), &cost)) {
+        wrr_load_add_report(calld->load, cost);
+      }
+      break;
+    }
+  }
+  GRPC_CLOSURE_RUN(exec_ctx, calld->original_on_complete,
+                   GRPC_ERROR_REF(error));
+}
+
+static grpc_error *backend_cost_init_call_elem(
+    grpc_exec_ctx *exec_ctx, grpc_call_element *elem,
+    const grpc_call_element_args *args) {
+  backend_cost_call_data *calld = elem->call_data;
+  calld->load = NULL;
+  if (args->context != NULL &&
+      args->context[GRPC_CONTEXT_LB_CALL_STATE].value != NULL) {
+    calld->load = wrr_load_ref(args->context[GRPC_CONTEXT_LB_CALL_STATE].value);
+  }
+  return GRPC_ERROR_NONE;
+}
+
+static void backend_cost_destroy_call_elem(
+    grpc_exec_ctx *exec_ctx, grpc_call_element *elem,
+    const grpc_call_final_info *final_info, grpc_closure *ignored) {
+  backend_cost_call_data *calld = elem->call_data;
+  if (calld->load != NULL) wrr_load_unref(calld->load);
+}
+
+static grpc_error *backend_cost_init_channel_elem(
+    grpc_exec_ctx *exec_ctx, grpc_channel_element *elem,
+    grpc_channel_element_args *args) {
+  return GRPC_ERROR_NONE;
+}
+
+static void backend_cost_destroy_channel_elem(grpc_exec_ctx *exec_ctx,
+                                              grpc_channel_element *elem) {}
+
+static void backend_cost_start_transport_stream_op_batch(
+    grpc_exec_ctx *exec_ctx, grpc_call_element *elem,
+    grpc_transport_stream_op_batch *batch) {
+  backend_cost_call_data *calld = elem->call_data;
+  GPR_TIMER_BEGIN("backend_cost_start_transport_stream_op_batch", 0);
+  if (batch->recv_trailing_metadata && calld->load != NULL) {
+    calld->recv_trailing_metadata =
+        batch->payload->recv_trailing_metadata.recv_trailing_metadata;
+    calld->original_on_complete = batch->on_complete;
+    GRPC_CLOSURE_INIT(&calld->on_complete, backend_cost_on_complete, calld,
+                      grpc_schedule_on_exec_ctx);
+    batch->on_complete = &calld->on_complete;
+  }
+  grpc_call_next_op(exec_ctx, elem, batch);
+  GPR_TIMER_END("backend_cost_start_transport_stream_op_batch", 0);
+}
+
+static const grpc_channel_filter backend_cost_filter = {
+    backend_cost_start_transport_stream_op_batch,
+    grpc_channel_next_op,
+    sizeof(backend_cost_call_data),
+    backend_cost_init_call_elem,
+    grpc_call_stack_ignore_set_pollset_or_pollset_set,
+    backend_cost_destroy_call_elem,
+    0,  // sizeof(channel_data)
+    backend_cost_init_channel_elem,
+    backend_cost_destroy_channel_elem,
+    grpc_call_next_get_peer,
+    grpc_channel_next_get_info,
+    "backend_cost"};
+
+/* Plugin registration */
+
+// Only add the backend_cost filter to the subchannels of this policy.
+static bool maybe_add_backend_cost_filter(grpc_exec_ctx *exec_ctx,
+                                          grpc_channel_stack_builder *builder,
+                                          void *arg) {
+  const grpc_channel_args *args =
+      grpc_channel_stack_builder_get_channel_arguments(builder);
+  const grpc_arg *channel_arg =
+      grpc_channel_args_find(args, GRPC_ARG_LB_POLICY_NAME);
+  if (channel_arg != NULL && channel_arg->type == GRPC_ARG_STRING &&
+      strcmp(channel_arg->value.string, "weighted_round_robin") == 0) {
+    return grpc_channel_stack_builder_append_filter(
+        builder, (const grpc_channel_filter *)arg, NULL, NULL);
+  }
+  return true;
+}
+
+void grpc_lb_policy_weighted_round_robin_init() {
+  grpc_register_lb_policy(weighted_round_robin_lb_factory_create());
+  grpc_register_tracer(&grpc_lb_weighted_round_robin_trace);
+  grpc_channel_init_register_stage(GRPC_CLIENT_SUBCHANNEL,
+                                   GRPC_CHANNEL_INIT_BUILTIN_PRIORITY,
+                                   maybe_add_backend_cost_filter,
+                                   (void *)&backend_cost_filter);
+}
+
+void grpc_lb_policy_weighted_round_robin_shutdown() {}
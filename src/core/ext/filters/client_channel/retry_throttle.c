@@ -76,6 +76,14 @@ void grpc_server_retry_throttle_data_record_success(
       (gpr_atm)0, (gpr_atm)throttle_data->max_milli_tokens);
 }
 
+bool grpc_server_retry_throttle_data_retries_allowed(
+    grpc_server_retry_throttle_data* throttle_data) {
+  // First, check if we are stale and need to be replaced.
+  get_replacement_throttle_data_if_needed(&throttle_data);
+  return (int)gpr_atm_no_barrier_load(&throttle_data->milli_tokens) >
+         throttle_data->max_milli_tokens / 2;
+}
+
 grpc_server_retry_throttle_data* grpc_server_retry_throttle_data_ref(
     grpc_server_retry_throttle_data* throttle_data) {
   gpr_ref(&throttle_data->refs);
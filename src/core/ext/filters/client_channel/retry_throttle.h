@@ -30,6 +30,10 @@ bool grpc_server_retry_throttle_data_record_failure(
 /// Records a success.
 void grpc_server_retry_throttle_data_record_success(
     grpc_server_retry_throttle_data* throttle_data);
+/// Returns true if it's okay to send a retry or a hedged attempt, without
+/// recording anything.
+bool grpc_server_retry_throttle_data_retries_allowed(
+    grpc_server_retry_throttle_data* throttle_data);
 
 grpc_server_retry_throttle_data* grpc_server_retry_throttle_data_ref(
     grpc_server_retry_throttle_data* throttle_data);
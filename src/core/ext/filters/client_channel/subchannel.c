@@ -50,6 +50,10 @@
 #define GRPC_SUBCHANNEL_RECONNECT_MAX_BACKOFF_SECONDS 120
 #define GRPC_SUBCHANNEL_RECONNECT_JITTER 0.2
 
+#define GRPC_SUBCHANNEL_DEFAULT_CONNECTION_STREAM_THRESHOLD 100
+#define GRPC_SUBCHANNEL_EXTRA_CONNECT_TIMEOUT_SECONDS 20
+#define GRPC_SUBCHANNEL_EXTRA_CONNECT_RETRY_SECONDS 1
+
 #define GET_CONNECTED_SUBCHANNEL(subchannel, barrier)      \
   ((grpc_connected_subchannel *)(gpr_atm_##barrier##_load( \
       &(subchannel)->connected_subchannel)))
@@ -60,6 +64,14 @@ typedef struct {
   grpc_connectivity_state connectivity_state;
 } state_watcher;
 
+/** watches one of the extra connections of a subchannel's pool */
+typedef struct {
+  grpc_closure closure;
+  grpc_subchannel *subchannel;
+  grpc_connected_subchannel *connection;
+  grpc_connectivity_state connectivity_state;
+} pool_watcher;
+
 typedef struct external_state_watcher {
   grpc_subchannel *subchannel;
   grpc_pollset_set *pollset_set;
@@ -71,6 +83,8 @@ typedef struct external_state_watcher {
 
 struct grpc_subchannel {
   grpc_connector *connector;
+  /** opens the extra connections of the pool, or NULL if pooling is off */
+  grpc_connector *pool_connector;
 
   /** refcount
       - lower INTERNAL_REF_BITS bits are for internal references:
@@ -125,6 +139,47 @@ struct grpc_subchannel {
   bool backoff_begun;
   /** our alarm */
   grpc_timer alarm;
+
+  /** connection pooling: calls are spread over up to max_connections
+      connections, another one being opened when every connection has at
+      least stream_threshold active calls */
+  size_t max_connections;
+  int stream_threshold;
+  /** mutex protecting the pool */
+  gpr_mu pool_mu;
+  /** connections opened besides connected_subchannel, each holding a ref */
+  grpc_connected_subchannel **extra_connections;
+  size_t num_extra_connections;
+  /** is pool_connector opening an extra connection (or about to) */
+  bool connecting_extra;
+  /** bumped whenever a new connection is published: the pool belongs to the
+      connection of the current generation, older ones being left alone */
+  uint32_t pool_generation;
+  /** set once the connection owning the current generation is gone */
+  bool pool_closed;
+  /** generation the extra connection being opened is meant for */
+  uint32_t extra_connect_generation;
+  /** no extra connection is attempted before this time */
+  gpr_timespec next_extra_attempt;
+  /** set while an extra connection is being opened */
+  grpc_connect_out_args extra_connecting_result;
+  /** callback for an extra connection finishing */
+  grpc_closure extra_connected;
+};
+
+struct grpc_connected_subchannel {
+  /** the subchannel this connection belongs to (weak ref), or NULL if
+      connection pooling is disabled */
+  grpc_subchannel *subchannel;
+  /** number of subchannel calls on this connection (pooling only) */
+  gpr_atm active_calls;
+  /** is this a connection published by the subchannel (rather than an extra
+      one): calls are spread over the pool of its generation as long as that
+      generation is current, LB policies handing it out as the subchannel's
+      connection even after the subchannel is disconnected */
+  bool owns_pool;
+  uint32_t pool_generation;
+  /* the connection's channel stack follows */
 };
 
 struct grpc_subchannel_call {
@@ -133,12 +188,14 @@ struct grpc_subchannel_call {
 };
 
 #define SUBCHANNEL_CALL_TO_CALL_STACK(call) ((grpc_call_stack *)((call) + 1))
-#define CHANNEL_STACK_FROM_CONNECTION(con) ((grpc_channel_stack *)(con))
+#define CHANNEL_STACK_FROM_CONNECTION(con) ((grpc_channel_stack *)((con) + 1))
 #define CALLSTACK_TO_SUBCHANNEL_CALL(callstack) \
   (((grpc_subchannel_call *)(callstack)) - 1)
 
 static void subchannel_connected(grpc_exec_ctx *exec_ctx, void *subchannel,
                                  grpc_error *error);
+static void subchannel_extra_connected(grpc_exec_ctx *exec_ctx,
+                                       void *subchannel, grpc_error *error);
 
 #ifndef NDEBUG
 #define REF_REASON reason
@@ -155,10 +212,17 @@ static void subchannel_connected(grpc_exec_ctx *exec_ctx, void *subchannel,
  * connection implementation
  */
 
+static void close_pool(grpc_exec_ctx *exec_ctx, grpc_subchannel *c,
+                       uint32_t generation);
+
 static void connection_destroy(grpc_exec_ctx *exec_ctx, void *arg,
                                grpc_error *error) {
   grpc_connected_subchannel *c = arg;
   grpc_channel_stack_destroy(exec_ctx, CHANNEL_STACK_FROM_CONNECTION(c));
+  if (c->owns_pool) close_pool(exec_ctx, c->subchannel, c->pool_generation);
+  if (c->subchannel != NULL) {
+    GRPC_SUBCHANNEL_WEAK_UNREF(exec_ctx, c->subchannel, "connection");
+  }
   gpr_free(c);
 }
 
@@ -186,9 +250,14 @@ static void subchannel_destroy(grpc_exec_ctx *exec_ctx, void *arg,
   grpc_channel_args_destroy(exec_ctx, c->args);
   grpc_connectivity_state_destroy(exec_ctx, &c->state_tracker);
   grpc_connector_unref(exec_ctx, c->connector);
+  if (c->pool_connector != NULL) {
+    grpc_connector_unref(exec_ctx, c->pool_connector);
+  }
   grpc_pollset_set_destroy(exec_ctx, c->pollset_set);
   grpc_subchannel_key_destroy(exec_ctx, c->key);
   gpr_mu_destroy(&c->mu);
+  gpr_mu_destroy(&c->pool_mu);
+  gpr_free(c->extra_connections);
   gpr_free(c);
 }
 
@@ -282,6 +351,7 @@ void grpc_subchannel_weak_unref(grpc_exec_ctx *exec_ctx,
 
 grpc_subchannel *grpc_subchannel_create(grpc_exec_ctx *exec_ctx,
                                         grpc_connector *connector,
+                                        grpc_connector *pool_connector,
                                         const grpc_subchannel_args *args) {
   grpc_subchannel_key *key = grpc_subchannel_key_create(args);
   grpc_subchannel *c = grpc_subchannel_index_find(exec_ctx, key);
@@ -333,6 +403,8 @@ grpc_subchannel *grpc_subchannel_create(grpc_exec_ctx *exec_ctx,
   int min_backoff_ms = GRPC_SUBCHANNEL_RECONNECT_MIN_BACKOFF_SECONDS * 1000;
   int max_backoff_ms = GRPC_SUBCHANNEL_RECONNECT_MAX_BACKOFF_SECONDS * 1000;
   bool fixed_reconnect_backoff = false;
+  int stream_threshold = GRPC_SUBCHANNEL_DEFAULT_CONNECTION_STREAM_THRESHOLD;
+  c->max_connections = 1;
   if (c->args) {
     for (size_t i = 0; i < c->args->num_args; i++) {
       if (0 == strcmp(c->args->args[i].key,
@@ -360,6 +432,15 @@ grpc_subchannel *grpc_subchannel_create(grpc_exec_ctx *exec_ctx,
         initial_backoff_ms = grpc_channel_arg_get_integer(
             &c->args->args[i],
             (grpc_integer_options){initial_backoff_ms, 100, INT_MAX});
+      } else if (0 == strcmp(c->args->args[i].key,
+                             GRPC_ARG_MAX_CONNECTIONS_PER_SUBCHANNEL)) {
+        c->max_connections = (size_t)grpc_channel_arg_get_integer(
+            &c->args->args[i], (grpc_integer_options){1, 1, INT_MAX});
+      } else if (0 == strcmp(c->args->args[i].key,
+                             GRPC_ARG_SUBCHANNEL_CONNECTION_STREAM_THRESHOLD)) {
+        stream_threshold = grpc_channel_arg_get_integer(
+            &c->args->args[i],
+            (grpc_integer_options){stream_threshold, 1, INT_MAX});
       }
     }
   }
@@ -370,6 +451,20 @@ grpc_subchannel *grpc_subchannel_create(grpc_exec_ctx *exec_ctx,
       fixed_reconnect_backoff ? 0.0 : GRPC_SUBCHANNEL_RECONNECT_JITTER,
       min_backoff_ms, max_backoff_ms);
   gpr_mu_init(&c->mu);
+  c->stream_threshold = stream_threshold;
+  gpr_mu_init(&c->pool_mu);
+  c->next_extra_attempt = gpr_inf_past(GPR_CLOCK_MONOTONIC);
+  if (pool_connector == NULL) {
+    c->max_connections = 1;
+  }
+  if (c->max_connections > 1) {
+    c->pool_connector = pool_connector;
+    grpc_connector_ref(c->pool_connector);
+    c->extra_connections = gpr_malloc(sizeof(*c->extra_connections) *
+                                      (c->max_connections - 1));
+    GRPC_CLOSURE_INIT(&c->extra_connected, subchannel_extra_connected, c,
+                      grpc_schedule_on_exec_ctx);
+  }
 
   return grpc_subchannel_index_register(exec_ctx, key, c);
 }
@@ -592,35 +687,51 @@ void grpc_connected_subchannel_ping(grpc_exec_ctx *exec_ctx,
   elem->filter->start_transport_op(exec_ctx, elem, op);
 }
 
-static bool publish_transport_locked(grpc_exec_ctx *exec_ctx,
-                                     grpc_subchannel *c) {
+/* builds the channel stack of a new connection over the transport in
+   \a result; returns NULL on failure */
+static grpc_connected_subchannel *create_connection(
+    grpc_exec_ctx *exec_ctx, grpc_subchannel *c,
+    grpc_connect_out_args *result) {
   grpc_connected_subchannel *con;
-  grpc_channel_stack *stk;
-  state_watcher *sw_subchannel;
 
   /* construct channel stack */
   grpc_channel_stack_builder *builder = grpc_channel_stack_builder_create();
-  grpc_channel_stack_builder_set_channel_arguments(
-      exec_ctx, builder, c->connecting_result.channel_args);
-  grpc_channel_stack_builder_set_transport(builder,
-                                           c->connecting_result.transport);
+  grpc_channel_stack_builder_set_channel_arguments(exec_ctx, builder,
+                                                   result->channel_args);
+  grpc_channel_stack_builder_set_transport(builder, result->transport);
 
   if (!grpc_channel_init_create_stack(exec_ctx, builder,
                                       GRPC_CLIENT_SUBCHANNEL)) {
     grpc_channel_stack_builder_destroy(exec_ctx, builder);
-    return false;
+    return NULL;
   }
   grpc_error *error = grpc_channel_stack_builder_finish(
-      exec_ctx, builder, 0, 1, connection_destroy, NULL, (void **)&con);
+      exec_ctx, builder, sizeof(grpc_connected_subchannel), 1,
+      connection_destroy, NULL, (void **)&con);
   if (error != GRPC_ERROR_NONE) {
-    grpc_transport_destroy(exec_ctx, c->connecting_result.transport);
+    grpc_transport_destroy(exec_ctx, result->transport);
     gpr_log(GPR_ERROR, "error initializing subchannel stack: %s",
             grpc_error_string(error));
     GRPC_ERROR_UNREF(error);
-    return false;
+    return NULL;
+  }
+  memset(result, 0, sizeof(*result));
+  if (c->max_connections > 1) {
+    con->subchannel = GRPC_SUBCHANNEL_WEAK_REF(c, "connection");
   }
-  stk = CHANNEL_STACK_FROM_CONNECTION(con);
-  memset(&c->connecting_result, 0, sizeof(c->connecting_result));
+  return con;
+}
+
+static void open_pool(grpc_exec_ctx *exec_ctx, grpc_subchannel *c,
+                      grpc_connected_subchannel *con);
+
+static bool publish_transport_locked(grpc_exec_ctx *exec_ctx,
+                                     grpc_subchannel *c) {
+  grpc_connected_subchannel *con;
+  state_watcher *sw_subchannel;
+
+  con = create_connection(exec_ctx, c, &c->connecting_result);
+  if (con == NULL) return false;
 
   /* initialize state watcher */
   sw_subchannel = gpr_malloc(sizeof(*sw_subchannel));
@@ -631,8 +742,7 @@ static bool publish_transport_locked(grpc_exec_ctx *exec_ctx,
 
   if (c->disconnected) {
     gpr_free(sw_subchannel);
-    grpc_channel_stack_destroy(exec_ctx, stk);
-    gpr_free(con);
+    connection_destroy(exec_ctx, con, GRPC_ERROR_NONE);
     return false;
   }
 
@@ -642,6 +752,7 @@ static bool publish_transport_locked(grpc_exec_ctx *exec_ctx,
                     seemingly it's not.
                     Re-evaluate if we really need this. */
   gpr_atm_full_barrier();
+  if (con->subchannel != NULL) open_pool(exec_ctx, c, con);
   GPR_ASSERT(gpr_atm_rel_cas(&c->connected_subchannel, 0, (gpr_atm)con));
 
   /* setup subchannel watching connected subchannel for changes; subchannel
@@ -690,6 +801,227 @@ static void subchannel_connected(grpc_exec_ctx *exec_ctx, void *arg,
   grpc_channel_args_destroy(exec_ctx, delete_channel_args);
 }
 
+/*
+ * connection pooling
+ */
+
+static void pool_on_connection_state_changed(grpc_exec_ctx *exec_ctx,
+                                             void *arg, grpc_error *error) {
+  pool_watcher *w = arg;
+  grpc_subchannel *c = w->subchannel;
+  if (w->connectivity_state != GRPC_CHANNEL_TRANSIENT_FAILURE &&
+      w->connectivity_state != GRPC_CHANNEL_SHUTDOWN) {
+    grpc_connected_subchannel_notify_on_state_change(
+        exec_ctx, w->connection, NULL, &w->connectivity_state, &w->closure);
+    return;
+  }
+  /* the connection is going away: stop sending calls to it */
+  grpc_connected_subchannel *removed = NULL;
+  gpr_mu_lock(&c->pool_mu);
+  for (size_t i = 0; i < c->num_extra_connections; i++) {
+    if (c->extra_connections[i] == w->connection) {
+      removed = w->connection;
+      c->extra_connections[i] =
+          c->extra_connections[--c->num_extra_connections];
+      break;
+    }
+  }
+  gpr_mu_unlock(&c->pool_mu);
+  if (removed != NULL) {
+    GRPC_CONNECTED_SUBCHANNEL_UNREF(exec_ctx, removed, "pooled");
+  }
+  GRPC_SUBCHANNEL_WEAK_UNREF(exec_ctx, c, "pool_watcher");
+  gpr_free(w);
+}
+
+/* empties the pool, handing its extra connections over to the caller, to be
+   unreffed with unref_dropped_connections once pool_mu is released (calls
+   still running on them keep them alive until they are done). An extra
+   connection attempt in flight is left to finish and then discarded, as it is
+   for an older generation or a closed pool: shutting pool_connector down would
+   keep it from connecting for any later generation */
+static grpc_connected_subchannel **drain_pool_locked(grpc_subchannel *c,
+                                                     size_t *num_dropped) {
+  grpc_connected_subchannel **dropped = NULL;
+  *num_dropped = c->num_extra_connections;
+  if (*num_dropped > 0) {
+    dropped = gpr_malloc(sizeof(*dropped) * *num_dropped);
+    memcpy(dropped, c->extra_connections, sizeof(*dropped) * *num_dropped);
+    c->num_extra_connections = 0;
+  }
+  return dropped;
+}
+
+static void unref_dropped_connections(grpc_exec_ctx *exec_ctx,
+                                      grpc_connected_subchannel **dropped,
+                                      size_t num_dropped) {
+  for (size_t i = 0; i < num_dropped; i++) {
+    GRPC_CONNECTED_SUBCHANNEL_UNREF(exec_ctx, dropped[i], "pooled");
+  }
+  gpr_free(dropped);
+}
+
+/* called when \a con is published: it takes over the pool under a new
+   generation, dropping the extra connections of the previous one */
+static void open_pool(grpc_exec_ctx *exec_ctx, grpc_subchannel *c,
+                      grpc_connected_subchannel *con) {
+  size_t num_dropped;
+  gpr_mu_lock(&c->pool_mu);
+  grpc_connected_subchannel **dropped = drain_pool_locked(c, &num_dropped);
+  c->pool_generation++;
+  c->pool_closed = false;
+  c->next_extra_attempt = gpr_inf_past(GPR_CLOCK_MONOTONIC);
+  con->owns_pool = true;
+  con->pool_generation = c->pool_generation;
+  gpr_mu_unlock(&c->pool_mu);
+  unref_dropped_connections(exec_ctx, dropped, num_dropped);
+}
+
+/* called when a connection published by the subchannel is destroyed: closes
+   the pool if it is still that connection's */
+static void close_pool(grpc_exec_ctx *exec_ctx, grpc_subchannel *c,
+                       uint32_t generation) {
+  size_t num_dropped = 0;
+  grpc_connected_subchannel **dropped = NULL;
+  gpr_mu_lock(&c->pool_mu);
+  if (generation == c->pool_generation) {
+    c->pool_closed = true;
+    dropped = drain_pool_locked(c, &num_dropped);
+  }
+  gpr_mu_unlock(&c->pool_mu);
+  unref_dropped_connections(exec_ctx, dropped, num_dropped);
+}
+
+/* is the extra connection being opened still wanted; pool_mu must be held */
+static bool extra_connect_stale_locked(grpc_subchannel *c) {
+  return c->pool_closed || c->extra_connect_generation != c->pool_generation;
+}
+
+static void subchannel_extra_connected(grpc_exec_ctx *exec_ctx, void *arg,
+                                       grpc_error *error) {
+  grpc_subchannel *c = arg;
+  grpc_channel_args *delete_channel_args =
+      c->extra_connecting_result.channel_args;
+  grpc_connected_subchannel *con = NULL;
+
+  /* the channel stack is built without holding the pool lock: nothing else
+     touches extra_connecting_result until connecting_extra is cleared */
+  gpr_mu_lock(&c->pool_mu);
+  bool stale = extra_connect_stale_locked(c);
+  gpr_mu_unlock(&c->pool_mu);
+  if (c->extra_connecting_result.transport != NULL) {
+    if (stale) {
+      grpc_transport_destroy(exec_ctx, c->extra_connecting_result.transport);
+      memset(&c->extra_connecting_result, 0,
+             sizeof(c->extra_connecting_result));
+    } else {
+      con = create_connection(exec_ctx, c, &c->extra_connecting_result);
+    }
+  }
+
+  gpr_mu_lock(&c->pool_mu);
+  c->connecting_extra = false;
+  grpc_connected_subchannel *discarded = NULL;
+  if (con != NULL && extra_connect_stale_locked(c)) {
+    /* the pool closed or changed hands while the channel stack was being
+       built */
+    discarded = con;
+  } else if (con != NULL) {
+    c->extra_connections[c->num_extra_connections++] = con;
+    /* watch the connection before the pool can drop it */
+    pool_watcher *w = gpr_malloc(sizeof(*w));
+    w->subchannel = GRPC_SUBCHANNEL_WEAK_REF(c, "pool_watcher");
+    w->connection = con;
+    w->connectivity_state = GRPC_CHANNEL_READY;
+    GRPC_CLOSURE_INIT(&w->closure, pool_on_connection_state_changed, w,
+                      grpc_schedule_on_exec_ctx);
+    grpc_connected_subchannel_notify_on_state_change(
+        exec_ctx, con, c->pollset_set, &w->connectivity_state, &w->closure);
+  } else {
+    c->next_extra_attempt =
+        gpr_time_add(gpr_now(GPR_CLOCK_MONOTONIC),
+                     gpr_time_from_seconds(
+                         GRPC_SUBCHANNEL_EXTRA_CONNECT_RETRY_SECONDS,
+                         GPR_TIMESPAN));
+  }
+  gpr_mu_unlock(&c->pool_mu);
+  if (discarded != NULL) {
+    GRPC_CONNECTED_SUBCHANNEL_UNREF(exec_ctx, discarded, "pooled");
+  } else if (con == NULL && !stale) {
+    gpr_log(GPR_INFO, "Failed to open an extra connection: %s",
+            grpc_error_string(error));
+  }
+  GRPC_SUBCHANNEL_WEAK_UNREF(exec_ctx, c, "connecting_extra");
+  grpc_channel_args_destroy(exec_ctx, delete_channel_args);
+}
+
+/* opens one more connection to the subchannel's target with the pool's own
+   connector for the current generation, unless the pool is closed;
+   connecting_extra is already set */
+static void start_extra_connect(grpc_exec_ctx *exec_ctx, grpc_subchannel *c) {
+  gpr_mu_lock(&c->pool_mu);
+  if (c->pool_closed) {
+    c->connecting_extra = false;
+    gpr_mu_unlock(&c->pool_mu);
+    return;
+  }
+  GRPC_SUBCHANNEL_WEAK_REF(c, "connecting_extra");
+  c->extra_connect_generation = c->pool_generation;
+  grpc_connect_in_args args;
+  args.interested_parties = c->pollset_set;
+  args.deadline = gpr_time_add(
+      gpr_now(GPR_CLOCK_MONOTONIC),
+      gpr_time_from_seconds(GRPC_SUBCHANNEL_EXTRA_CONNECT_TIMEOUT_SECONDS,
+                            GPR_TIMESPAN));
+  args.channel_args = c->args;
+  grpc_connector_connect(exec_ctx, c->pool_connector, &args,
+                         &c->extra_connecting_result, &c->extra_connected);
+  gpr_mu_unlock(&c->pool_mu);
+}
+
+static gpr_atm connection_active_calls(grpc_connected_subchannel *con) {
+  return gpr_atm_no_barrier_load(&con->active_calls);
+}
+
+/* returns a ref to the least loaded connection of \a con's pool, opening a
+   new one if they are all loaded beyond the threshold; a connection whose
+   generation is over only gets its own calls */
+static grpc_connected_subchannel *pick_pooled_connection(
+    grpc_exec_ctx *exec_ctx, grpc_connected_subchannel *con) {
+  grpc_subchannel *c = con->subchannel;
+  bool connect = false;
+  gpr_mu_lock(&c->pool_mu);
+  grpc_connected_subchannel *best = con;
+  if (!con->owns_pool || con->pool_generation != c->pool_generation) {
+    GRPC_CONNECTED_SUBCHANNEL_REF(best, "subchannel_call");
+    gpr_atm_no_barrier_fetch_add(&best->active_calls, (gpr_atm)1);
+    gpr_mu_unlock(&c->pool_mu);
+    return best;
+  }
+  gpr_atm best_calls = connection_active_calls(con);
+  for (size_t i = 0; i < c->num_extra_connections; i++) {
+    gpr_atm calls = connection_active_calls(c->extra_connections[i]);
+    if (calls < best_calls) {
+      best = c->extra_connections[i];
+      best_calls = calls;
+    }
+  }
+  if (best_calls >= c->stream_threshold && !c->connecting_extra &&
+      c->num_extra_connections + 1 < c->max_connections &&
+      gpr_time_cmp(gpr_now(GPR_CLOCK_MONOTONIC), c->next_extra_attempt) >=
+          0) {
+    c->connecting_extra = true;
+    connect = true;
+  }
+  GRPC_CONNECTED_SUBCHANNEL_REF(best, "subchannel_call");
+  gpr_atm_no_barrier_fetch_add(&best->active_calls, (gpr_atm)1);
+  gpr_mu_unlock(&c->pool_mu);
+  if (connect) {
+    start_extra_connect(exec_ctx, c);
+  }
+  return best;
+}
+
 /*
  * grpc_subchannel_call implementation
  */
@@ -702,6 +1034,9 @@ static void subchannel_call_destroy(grpc_exec_ctx *exec_ctx, void *call,
   grpc_connected_subchannel *connection = c->connection;
   grpc_call_stack_destroy(exec_ctx, SUBCHANNEL_CALL_TO_CALL_STACK(c), NULL,
                           c->schedule_closure_after_destroy);
+  if (connection->subchannel != NULL) {
+    gpr_atm_no_barrier_fetch_add(&connection->active_calls, (gpr_atm)-1);
+  }
   GRPC_CONNECTED_SUBCHANNEL_UNREF(exec_ctx, connection, "subchannel_call");
   GPR_TIMER_END("grpc_subchannel_call_unref.destroy", 0);
 }
@@ -755,11 +1090,16 @@ grpc_error *grpc_connected_subchannel_create_call(
     grpc_exec_ctx *exec_ctx, grpc_connected_subchannel *con,
     const grpc_connected_subchannel_call_args *args,
     grpc_subchannel_call **call) {
+  if (con->subchannel != NULL) {
+    con = pick_pooled_connection(exec_ctx, con);
+  } else {
+    GRPC_CONNECTED_SUBCHANNEL_REF(con, "subchannel_call");
+  }
   grpc_channel_stack *chanstk = CHANNEL_STACK_FROM_CONNECTION(con);
   *call = gpr_arena_alloc(
       args->arena, sizeof(grpc_subchannel_call) + chanstk->call_stack_size);
   grpc_call_stack *callstk = SUBCHANNEL_CALL_TO_CALL_STACK(*call);
-  (*call)->connection = GRPC_CONNECTED_SUBCHANNEL_REF(con, "subchannel_call");
+  (*call)->connection = con;
   const grpc_call_element_args call_args = {.call_stack = callstk,
                                             .server_transport_data = NULL,
                                             .context = args->context,
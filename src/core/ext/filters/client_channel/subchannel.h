@@ -174,9 +174,12 @@ struct grpc_subchannel_args {
   const grpc_channel_args *args;
 };
 
-/** create a subchannel given a connector */
+/** create a subchannel given a connector; the extra connections of
+    GRPC_ARG_MAX_CONNECTIONS_PER_SUBCHANNEL are opened with \a pool_connector,
+    which may be NULL to disable connection pooling */
 grpc_subchannel *grpc_subchannel_create(grpc_exec_ctx *exec_ctx,
                                         grpc_connector *connector,
+                                        grpc_connector *pool_connector,
                                         const grpc_subchannel_args *args);
 
 /// Sets \a addr from \a args.
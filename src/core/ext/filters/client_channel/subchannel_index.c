@@ -22,40 +22,80 @@
 #include <string.h>
 
 #include <grpc/support/alloc.h>
-#include <grpc/support/avl.h>
+#include <grpc/support/atm.h>
 #include <grpc/support/string_util.h>
-#include <grpc/support/tls.h>
+#include <grpc/support/sync.h>
 
 #include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/support/murmur_hash.h"
 
 // a map of subchannel_key --> subchannel, used for detecting connections
-// to the same destination in order to share them
-static gpr_avl g_subchannel_index;
-
-static gpr_mu g_mu;
+// to the same destination in order to share them.
+//
+// The index is a fixed size hash table split into shards. Each shard has a
+// mutex serializing its writers (register/unregister); readers (find) never
+// take it: they walk the bucket chains with acquire loads. Unlinked nodes are
+// not freed straight away but put on the shard's retired list, which is
+// reclaimed once no reader is inside the shard any more. Because a node holds
+// a weak ref to its subchannel, a reader that finds a node can always safely
+// attempt to upgrade that ref.
+
+#define SHARD_COUNT 32
+#define BUCKETS_PER_SHARD 128
+
+typedef struct index_node {
+  /* next node in the bucket chain (index_node*), published with release
+     stores so that readers can walk chains without locking */
+  gpr_atm next;
+  grpc_subchannel_key *key;
+  grpc_subchannel *subchannel;
+  /* link in the shard's retired list */
+  struct index_node *next_retired;
+} index_node;
+
+typedef struct {
+  /* serializes writers of this shard */
+  gpr_mu mu;
+  /* number of find() calls currently walking this shard */
+  gpr_atm readers;
+  /* index_node*: nodes unlinked from the buckets but not yet freed, written
+     under mu and read without it as a hint */
+  gpr_atm retired;
+  gpr_atm buckets[BUCKETS_PER_SHARD];
+} index_shard;
+
+static index_shard g_shards[SHARD_COUNT];
 
 struct grpc_subchannel_key {
   grpc_subchannel_args args;
+  uint32_t hash;
 };
 
-GPR_TLS_DECL(subchannel_index_exec_ctx);
-
 static bool g_force_creation = false;
 
-static void enter_ctx(grpc_exec_ctx *exec_ctx) {
-  GPR_ASSERT(gpr_tls_get(&subchannel_index_exec_ctx) == 0);
-  gpr_tls_set(&subchannel_index_exec_ctx, (intptr_t)exec_ctx);
-}
-
-static void leave_ctx(grpc_exec_ctx *exec_ctx) {
-  GPR_ASSERT(gpr_tls_get(&subchannel_index_exec_ctx) == (intptr_t)exec_ctx);
-  gpr_tls_set(&subchannel_index_exec_ctx, 0);
-}
-
-static grpc_exec_ctx *current_ctx() {
-  grpc_exec_ctx *c = (grpc_exec_ctx *)gpr_tls_get(&subchannel_index_exec_ctx);
-  GPR_ASSERT(c != NULL);
-  return c;
+static uint32_t hash_channel_args(const grpc_channel_args *args,
+                                  uint32_t hash) {
+  if (args == NULL) return hash;
+  for (size_t i = 0; i < args->num_args; i++) {
+    const grpc_arg *arg = &args->args[i];
+    hash = gpr_murmur_hash3(&arg->type, sizeof(arg->type), hash);
+    hash = gpr_murmur_hash3(arg->key, strlen(arg->key), hash);
+    switch (arg->type) {
+      case GRPC_ARG_STRING:
+        hash = gpr_murmur_hash3(arg->value.string, strlen(arg->value.string),
+                                hash);
+        break;
+      case GRPC_ARG_INTEGER:
+        hash = gpr_murmur_hash3(&arg->value.integer,
+                                sizeof(arg->value.integer), hash);
+        break;
+      case GRPC_ARG_POINTER:
+        // pointer args are compared through their vtable, so two different
+        // pointers may still be equal: leave them out of the hash
+        break;
+    }
+  }
+  return hash;
 }
 
 static grpc_subchannel_key *create_key(
@@ -72,6 +112,10 @@ static grpc_subchannel_key *create_key(
     k->args.filters = NULL;
   }
   k->args.args = copy_channel_args(args->args);
+  k->hash = gpr_murmur_hash3(k->args.filters,
+                             sizeof(*k->args.filters) * k->args.filter_count,
+                             (uint32_t)k->args.filter_count);
+  k->hash = hash_channel_args(k->args.args, k->hash);
   return k;
 }
 
@@ -80,13 +124,8 @@ grpc_subchannel_key *grpc_subchannel_key_create(
   return create_key(args, grpc_channel_args_normalize);
 }
 
-static grpc_subchannel_key *subchannel_key_copy(grpc_subchannel_key *k) {
-  return create_key(&k->args, grpc_channel_args_copy);
-}
-
-int grpc_subchannel_key_compare(const grpc_subchannel_key *a,
-                                const grpc_subchannel_key *b) {
-  if (g_force_creation) return false;
+static int key_compare(const grpc_subchannel_key *a,
+                       const grpc_subchannel_key *b) {
   int c = GPR_ICMP(a->args.filter_count, b->args.filter_count);
   if (c != 0) return c;
   if (a->args.filter_count > 0) {
@@ -97,6 +136,12 @@ int grpc_subchannel_key_compare(const grpc_subchannel_key *a,
   return grpc_channel_args_compare(a->args.args, b->args.args);
 }
 
+int grpc_subchannel_key_compare(const grpc_subchannel_key *a,
+                                const grpc_subchannel_key *b) {
+  if (g_force_creation) return false;
+  return key_compare(a, b);
+}
+
 void grpc_subchannel_key_destroy(grpc_exec_ctx *exec_ctx,
                                  grpc_subchannel_key *k) {
   gpr_free((grpc_channel_args *)k->args.filters);
@@ -104,154 +149,175 @@ void grpc_subchannel_key_destroy(grpc_exec_ctx *exec_ctx,
   gpr_free(k);
 }
 
-static void sck_avl_destroy(void *p) {
-  grpc_subchannel_key_destroy(current_ctx(), p);
+static index_shard *shard_for(const grpc_subchannel_key *key) {
+  return &g_shards[key->hash % SHARD_COUNT];
 }
 
-static void *sck_avl_copy(void *p) { return subchannel_key_copy(p); }
+static gpr_atm *bucket_for(index_shard *shard,
+                           const grpc_subchannel_key *key) {
+  return &shard->buckets[(key->hash / SHARD_COUNT) % BUCKETS_PER_SHARD];
+}
+
+static bool node_matches(const index_node *node,
+                         const grpc_subchannel_key *key) {
+  return node->key->hash == key->hash && key_compare(node->key, key) == 0;
+}
 
-static long sck_avl_compare(void *a, void *b) {
-  return grpc_subchannel_key_compare(a, b);
+static void destroy_nodes(grpc_exec_ctx *exec_ctx, index_node *node) {
+  while (node != NULL) {
+    index_node *next = node->next_retired;
+    GRPC_SUBCHANNEL_WEAK_UNREF(exec_ctx, node->subchannel, "subchannel_index");
+    gpr_free(node);
+    node = next;
+  }
 }
 
-static void scv_avl_destroy(void *p) {
-  GRPC_SUBCHANNEL_WEAK_UNREF(current_ctx(), p, "subchannel_index");
+// Called with shard->mu held: detaches and returns the retired nodes if no
+// reader can still be looking at them (returns NULL otherwise).
+static index_node *take_reclaimable_locked(index_shard *shard) {
+  index_node *retired = (index_node *)gpr_atm_no_barrier_load(&shard->retired);
+  if (retired == NULL) return NULL;
+  // Every retired node was unlinked before this point: a reader that enters
+  // the shard after the barrier cannot reach them, so if there is no reader
+  // inside right now, nobody ever will.
+  gpr_atm_full_barrier();
+  if (gpr_atm_no_barrier_load(&shard->readers) != 0) return NULL;
+  gpr_atm_no_barrier_store(&shard->retired, (gpr_atm)NULL);
+  return retired;
 }
 
-static void *scv_avl_copy(void *p) {
-  GRPC_SUBCHANNEL_WEAK_REF(p, "subchannel_index");
-  return p;
+static void reader_enter(index_shard *shard) {
+  gpr_atm_full_fetch_add(&shard->readers, (gpr_atm)1);
 }
 
-static const gpr_avl_vtable subchannel_avl_vtable = {
-    .destroy_key = sck_avl_destroy,
-    .copy_key = sck_avl_copy,
-    .compare_keys = sck_avl_compare,
-    .destroy_value = scv_avl_destroy,
-    .copy_value = scv_avl_copy};
+static void reader_leave(grpc_exec_ctx *exec_ctx, index_shard *shard) {
+  if (gpr_atm_full_fetch_add(&shard->readers, (gpr_atm)-1) == 1 &&
+      gpr_atm_acq_load(&shard->retired) != (gpr_atm)NULL &&
+      gpr_mu_trylock(&shard->mu)) {
+    // last reader out: reclaim what writers had to leave behind
+    index_node *reclaimed = take_reclaimable_locked(shard);
+    gpr_mu_unlock(&shard->mu);
+    destroy_nodes(exec_ctx, reclaimed);
+  }
+}
 
 void grpc_subchannel_index_init(void) {
-  g_subchannel_index = gpr_avl_create(&subchannel_avl_vtable);
-  gpr_mu_init(&g_mu);
-  gpr_tls_init(&subchannel_index_exec_ctx);
+  for (size_t i = 0; i < SHARD_COUNT; i++) {
+    index_shard *shard = &g_shards[i];
+    gpr_mu_init(&shard->mu);
+    gpr_atm_no_barrier_store(&shard->readers, 0);
+    gpr_atm_no_barrier_store(&shard->retired, (gpr_atm)NULL);
+    for (size_t j = 0; j < BUCKETS_PER_SHARD; j++) {
+      gpr_atm_no_barrier_store(&shard->buckets[j], (gpr_atm)NULL);
+    }
+  }
 }
 
 void grpc_subchannel_index_shutdown(void) {
-  gpr_mu_destroy(&g_mu);
-  gpr_avl_unref(g_subchannel_index);
-  gpr_tls_destroy(&subchannel_index_exec_ctx);
+  grpc_exec_ctx exec_ctx = GRPC_EXEC_CTX_INIT;
+  for (size_t i = 0; i < SHARD_COUNT; i++) {
+    index_shard *shard = &g_shards[i];
+    GPR_ASSERT(gpr_atm_no_barrier_load(&shard->readers) == 0);
+    index_node *nodes = (index_node *)gpr_atm_no_barrier_load(&shard->retired);
+    for (size_t j = 0; j < BUCKETS_PER_SHARD; j++) {
+      index_node *node =
+          (index_node *)gpr_atm_no_barrier_load(&shard->buckets[j]);
+      while (node != NULL) {
+        index_node *next = (index_node *)gpr_atm_no_barrier_load(&node->next);
+        node->next_retired = nodes;
+        nodes = node;
+        node = next;
+      }
+    }
+    destroy_nodes(&exec_ctx, nodes);
+    gpr_mu_destroy(&shard->mu);
+  }
+  grpc_exec_ctx_finish(&exec_ctx);
 }
 
 grpc_subchannel *grpc_subchannel_index_find(grpc_exec_ctx *exec_ctx,
                                             grpc_subchannel_key *key) {
-  enter_ctx(exec_ctx);
-
-  // Lock, and take a reference to the subchannel index.
-  // We don't need to do the search under a lock as avl's are immutable.
-  gpr_mu_lock(&g_mu);
-  gpr_avl index = gpr_avl_ref(g_subchannel_index);
-  gpr_mu_unlock(&g_mu);
-
-  grpc_subchannel *c =
-      GRPC_SUBCHANNEL_REF_FROM_WEAK_REF(gpr_avl_get(index, key), "index_find");
-  gpr_avl_unref(index);
-
-  leave_ctx(exec_ctx);
+  if (g_force_creation) return NULL;
+  index_shard *shard = shard_for(key);
+  grpc_subchannel *c = NULL;
+  reader_enter(shard);
+  index_node *node = (index_node *)gpr_atm_acq_load(bucket_for(shard, key));
+  while (node != NULL) {
+    // a matching node may belong to a subchannel that is being disconnected
+    // but has not unregistered yet: skip it and keep looking
+    if (node_matches(node, key)) {
+      c = GRPC_SUBCHANNEL_REF_FROM_WEAK_REF(node->subchannel, "index_find");
+      if (c != NULL) break;
+    }
+    node = (index_node *)gpr_atm_acq_load(&node->next);
+  }
+  reader_leave(exec_ctx, shard);
   return c;
 }
 
 grpc_subchannel *grpc_subchannel_index_register(grpc_exec_ctx *exec_ctx,
                                                 grpc_subchannel_key *key,
                                                 grpc_subchannel *constructed) {
-  enter_ctx(exec_ctx);
-
+  index_shard *shard = shard_for(key);
+  gpr_atm *bucket = bucket_for(shard, key);
   grpc_subchannel *c = NULL;
-  bool need_to_unref_constructed;
-
-  while (c == NULL) {
-    need_to_unref_constructed = false;
 
-    // Compare and swap loop:
-    // - take a reference to the current index
-    gpr_mu_lock(&g_mu);
-    gpr_avl index = gpr_avl_ref(g_subchannel_index);
-    gpr_mu_unlock(&g_mu);
-
-    // - Check to see if a subchannel already exists
-    c = gpr_avl_get(index, key);
-    if (c != NULL) {
-      c = GRPC_SUBCHANNEL_REF_FROM_WEAK_REF(c, "index_register");
-    }
-    if (c != NULL) {
-      // yes -> we're done
-      need_to_unref_constructed = true;
-    } else {
-      // no -> update the avl and compare/swap
-      gpr_avl updated =
-          gpr_avl_add(gpr_avl_ref(index), subchannel_key_copy(key),
-                      GRPC_SUBCHANNEL_WEAK_REF(constructed, "index_register"));
-
-      // it may happen (but it's expected to be unlikely)
-      // that some other thread has changed the index:
-      // compare/swap here to check that, and retry as necessary
-      gpr_mu_lock(&g_mu);
-      if (index.root == g_subchannel_index.root) {
-        GPR_SWAP(gpr_avl, updated, g_subchannel_index);
-        c = constructed;
+  gpr_mu_lock(&shard->mu);
+  if (!g_force_creation) {
+    // Check to see if a subchannel already exists
+    for (index_node *node = (index_node *)gpr_atm_no_barrier_load(bucket);
+         node != NULL && c == NULL;
+         node = (index_node *)gpr_atm_no_barrier_load(&node->next)) {
+      if (node_matches(node, key)) {
+        c = GRPC_SUBCHANNEL_REF_FROM_WEAK_REF(node->subchannel,
+                                              "index_register");
       }
-      gpr_mu_unlock(&g_mu);
-
-      gpr_avl_unref(updated);
     }
-    gpr_avl_unref(index);
   }
+  if (c == NULL) {
+    // no -> publish a fully initialized node at the head of the chain
+    index_node *node = gpr_malloc(sizeof(*node));
+    node->key = key;
+    node->subchannel = GRPC_SUBCHANNEL_WEAK_REF(constructed, "index_register");
+    node->next_retired = NULL;
+    gpr_atm_no_barrier_store(&node->next, gpr_atm_no_barrier_load(bucket));
+    gpr_atm_rel_store(bucket, (gpr_atm)node);
+  }
+  gpr_mu_unlock(&shard->mu);
 
-  leave_ctx(exec_ctx);
-
-  if (need_to_unref_constructed) {
+  if (c != NULL) {
+    // yes -> we lost a registration race: use the registered subchannel
     GRPC_SUBCHANNEL_UNREF(exec_ctx, constructed, "index_register");
+    return c;
   }
-
-  return c;
+  return constructed;
 }
 
 void grpc_subchannel_index_unregister(grpc_exec_ctx *exec_ctx,
                                       grpc_subchannel_key *key,
                                       grpc_subchannel *constructed) {
-  enter_ctx(exec_ctx);
-
-  bool done = false;
-  while (!done) {
-    // Compare and swap loop:
-    // - take a reference to the current index
-    gpr_mu_lock(&g_mu);
-    gpr_avl index = gpr_avl_ref(g_subchannel_index);
-    gpr_mu_unlock(&g_mu);
-
-    // Check to see if this key still refers to the previously
-    // registered subchannel
-    grpc_subchannel *c = gpr_avl_get(index, key);
-    if (c != constructed) {
-      gpr_avl_unref(index);
-      break;
-    }
-
-    // compare and swap the update (some other thread may have
-    // mutated the index behind us)
-    gpr_avl updated = gpr_avl_remove(gpr_avl_ref(index), key);
-
-    gpr_mu_lock(&g_mu);
-    if (index.root == g_subchannel_index.root) {
-      GPR_SWAP(gpr_avl, updated, g_subchannel_index);
-      done = true;
-    }
-    gpr_mu_unlock(&g_mu);
-
-    gpr_avl_unref(updated);
-    gpr_avl_unref(index);
+  index_shard *shard = shard_for(key);
+  gpr_atm *prev = bucket_for(shard, key);
+
+  gpr_mu_lock(&shard->mu);
+  // Look for the node registering exactly this subchannel, if any
+  index_node *node = (index_node *)gpr_atm_no_barrier_load(prev);
+  while (node != NULL && node->subchannel != constructed) {
+    prev = &node->next;
+    node = (index_node *)gpr_atm_no_barrier_load(prev);
+  }
+  if (node != NULL) {
+    // Unlink it, leaving its next pointer intact for readers still walking
+    // through it, and retire it until they are gone
+    gpr_atm_rel_store(prev, gpr_atm_no_barrier_load(&node->next));
+    node->next_retired =
+        (index_node *)gpr_atm_no_barrier_load(&shard->retired);
+    gpr_atm_rel_store(&shard->retired, (gpr_atm)node);
   }
+  index_node *reclaimed = take_reclaimable_locked(shard);
+  gpr_mu_unlock(&shard->mu);
 
-  leave_ctx(exec_ctx);
+  destroy_nodes(exec_ctx, reclaimed);
 }
 
 void grpc_subchannel_index_test_only_set_force_creation(bool force_creation) {
@@ -34,14 +34,16 @@ void grpc_subchannel_key_destroy(grpc_exec_ctx *exec_ctx,
 
 /** Given a subchannel key, find the subchannel registered for it.
     Returns NULL if no such channel exists.
-    Thread-safe. */
+    Thread-safe and lock-free. */
 grpc_subchannel *grpc_subchannel_index_find(grpc_exec_ctx *exec_ctx,
                                             grpc_subchannel_key *key);
 
 /** Register a subchannel against a key.
     Takes ownership of \a constructed.
     Returns the registered subchannel. This may be different from
-    \a constructed in the case of a registration race. */
+    \a constructed in the case of a registration race.
+    The index does not copy \a key: it must live as long as \a constructed
+    (normally it is owned by it). */
 grpc_subchannel *grpc_subchannel_index_register(grpc_exec_ctx *exec_ctx,
                                                 grpc_subchannel_key *key,
                                                 grpc_subchannel *constructed);
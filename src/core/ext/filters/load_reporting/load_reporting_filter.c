@@ -40,6 +40,11 @@ typedef struct call_data {
   bool have_service_method;
   grpc_slice service_method;
 
+  /* when the call started, for the backend cost reported to clients */
+  gpr_timespec start_time;
+  /* storage for the backend cost added to the trailing metadata */
+  grpc_linked_mdelem backend_cost;
+
   /* stores the recv_initial_metadata op's ready closure, which we wrap with our
    * own (on_initial_md_ready) in order to capture the incoming initial metadata
    * */
@@ -90,6 +95,7 @@ static grpc_error *init_call_elem(grpc_exec_ctx *exec_ctx,
                                   const grpc_call_element_args *args) {
   call_data *calld = elem->call_data;
   calld->id = (intptr_t)args->call_stack;
+  calld->start_time = gpr_now(GPR_CLOCK_MONOTONIC);
   GRPC_CLOSURE_INIT(&calld->on_initial_md_ready, on_initial_md_ready, elem,
                     grpc_schedule_on_exec_ctx);
 
@@ -185,6 +191,34 @@ static grpc_filtered_mdelem lr_trailing_md_filter(grpc_exec_ctx *exec_ctx,
   return GRPC_FILTERED_MDELEM(md);
 }
 
+/* Unless the application reported a backend cost of its own, report the time
+ * the server spent on the call, in milliseconds, to the client's load
+ * balancing policy. */
+static void add_backend_cost(grpc_exec_ctx *exec_ctx, grpc_call_element *elem,
+                             grpc_metadata_batch *trailing_metadata) {
+  call_data *calld = elem->call_data;
+  for (grpc_linked_mdelem *l = trailing_metadata->list.head; l != NULL;
+       l = l->next) {
+    if (grpc_slice_str_cmp(GRPC_MDKEY(l->md), GRPC_LB_BACKEND_COST_MD_KEY) ==
+        0) {
+      return;
+    }
+  }
+  const gpr_timespec elapsed =
+      gpr_time_sub(gpr_now(GPR_CLOCK_MONOTONIC), calld->start_time);
+  char *cost;
+  gpr_asprintf(&cost, "%.3f", gpr_timespec_to_micros(elapsed) / 1e3);
+  GRPC_LOG_IF_ERROR(
+      "grpc_metadata_batch_add_tail",
+      grpc_metadata_batch_add_tail(
+          exec_ctx, trailing_metadata, &calld->backend_cost,
+          grpc_mdelem_from_slices(
+              exec_ctx,
+              grpc_slice_from_static_string(GRPC_LB_BACKEND_COST_MD_KEY),
+              grpc_slice_from_copied_string(cost))));
+  gpr_free(cost);
+}
+
 static void lr_start_transport_stream_op_batch(
     grpc_exec_ctx *exec_ctx, grpc_call_element *elem,
     grpc_transport_stream_op_batch *op) {
@@ -207,6 +241,8 @@ static void lr_start_transport_stream_op_batch(
             op->payload->send_trailing_metadata.send_trailing_metadata,
             lr_trailing_md_filter, elem,
             "LR trailing metadata filtering error"));
+    add_backend_cost(exec_ctx, elem,
+                     op->payload->send_trailing_metadata.send_trailing_metadata);
   }
   grpc_call_next_op(exec_ctx, elem, op);
 
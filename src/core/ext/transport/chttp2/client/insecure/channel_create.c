@@ -40,8 +40,11 @@ static grpc_subchannel *client_channel_factory_create_subchannel(
     grpc_exec_ctx *exec_ctx, grpc_client_channel_factory *cc_factory,
     const grpc_subchannel_args *args) {
   grpc_connector *connector = grpc_chttp2_connector_create();
-  grpc_subchannel *s = grpc_subchannel_create(exec_ctx, connector, args);
+  grpc_connector *pool_connector = grpc_chttp2_connector_create();
+  grpc_subchannel *s =
+      grpc_subchannel_create(exec_ctx, connector, pool_connector, args);
   grpc_connector_unref(exec_ctx, connector);
+  grpc_connector_unref(exec_ctx, pool_connector);
   return s;
 }
 
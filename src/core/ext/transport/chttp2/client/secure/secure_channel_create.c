@@ -145,9 +145,11 @@ static grpc_subchannel *client_channel_factory_create_subchannel(
     return NULL;
   }
   grpc_connector *connector = grpc_chttp2_connector_create();
-  grpc_subchannel *s =
-      grpc_subchannel_create(exec_ctx, connector, subchannel_args);
+  grpc_connector *pool_connector = grpc_chttp2_connector_create();
+  grpc_subchannel *s = grpc_subchannel_create(exec_ctx, connector,
+                                              pool_connector, subchannel_args);
   grpc_connector_unref(exec_ctx, connector);
+  grpc_connector_unref(exec_ctx, pool_connector);
   grpc_channel_args_destroy(exec_ctx,
                             (grpc_channel_args *)subchannel_args->args);
   gpr_free(subchannel_args);
@@ -89,6 +89,8 @@ static const grpc_transport_vtable vtable;
 static void write_action_begin_locked(grpc_exec_ctx *exec_ctx, void *t,
                                       grpc_error *error);
 static void write_action(grpc_exec_ctx *exec_ctx, void *t, grpc_error *error);
+static void write_action_end(grpc_exec_ctx *exec_ctx, void *t,
+                             grpc_error *error);
 static void write_action_end_locked(grpc_exec_ctx *exec_ctx, void *t,
                                     grpc_error *error);
 
@@ -344,6 +346,7 @@ static void init_transport(grpc_exec_ctx *exec_ctx, grpc_chttp2_transport *t,
   t->force_send_settings = 1 << GRPC_CHTTP2_SETTINGS_INITIAL_WINDOW_SIZE;
   t->sent_local_settings = 0;
   t->write_buffer_size = DEFAULT_WINDOW;
+  t->target_write_size = GRPC_CHTTP2_MAX_TARGET_WRITE_SIZE;
   t->enable_bdp_probe = true;
 
   if (is_client) {
@@ -401,6 +404,7 @@ static void init_transport(grpc_exec_ctx *exec_ctx, grpc_chttp2_transport *t,
   t->keepalive_permit_without_calls = g_default_keepalive_permit_without_calls;
 
   t->opt_target = GRPC_CHTTP2_OPTIMIZE_FOR_LATENCY;
+  t->adapt_write_size = false;
 
   if (channel_args) {
     for (i = 0; i < channel_args->num_args; i++) {
@@ -497,11 +501,14 @@ static void init_transport(grpc_exec_ctx *exec_ctx, grpc_chttp2_transport *t,
                   GRPC_ARG_OPTIMIZATION_TARGET);
         } else if (0 == strcmp(channel_args->args[i].value.string, "blend")) {
           t->opt_target = GRPC_CHTTP2_OPTIMIZE_FOR_LATENCY;
+          t->adapt_write_size = false;
         } else if (0 == strcmp(channel_args->args[i].value.string, "latency")) {
           t->opt_target = GRPC_CHTTP2_OPTIMIZE_FOR_LATENCY;
+          t->adapt_write_size = true;
         } else if (0 ==
                    strcmp(channel_args->args[i].value.string, "throughput")) {
           t->opt_target = GRPC_CHTTP2_OPTIMIZE_FOR_THROUGHPUT;
+          t->adapt_write_size = false;
         } else {
           gpr_log(GPR_ERROR, "%s value '%s' unknown, assuming 'blend'",
                   GRPC_ARG_OPTIMIZATION_TARGET,
@@ -914,13 +921,31 @@ static void write_action_begin_locked(grpc_exec_ctx *exec_ctx, void *gt,
 static void write_action(grpc_exec_ctx *exec_ctx, void *gt, grpc_error *error) {
   grpc_chttp2_transport *t = gt;
   GPR_TIMER_BEGIN("write_action", 0);
-  grpc_endpoint_write(
-      exec_ctx, t->ep, &t->outbuf,
-      GRPC_CLOSURE_INIT(&t->write_action_end_locked, write_action_end_locked, t,
-                        grpc_combiner_scheduler(t->combiner)));
+  grpc_closure *on_written = GRPC_CLOSURE_INIT(
+      &t->write_action_end_locked, write_action_end_locked, t,
+      grpc_combiner_scheduler(t->combiner));
+  if (t->adapt_write_size) {
+    /* time the endpoint write alone: write_action_end samples the clock
+       before waiting for the combiner */
+    t->write_start_time = gpr_now(GPR_CLOCK_MONOTONIC);
+    t->write_start_bytes = t->outbuf.length;
+    on_written = GRPC_CLOSURE_INIT(&t->write_action_end, write_action_end, t,
+                                   grpc_schedule_on_exec_ctx);
+  }
+  grpc_endpoint_write(exec_ctx, t->ep, &t->outbuf, on_written);
   GPR_TIMER_END("write_action", 0);
 }
 
+static void write_action_end(grpc_exec_ctx *exec_ctx, void *gt,
+                             grpc_error *error) {
+  grpc_chttp2_transport *t = gt;
+  gpr_timespec dt =
+      gpr_time_sub(gpr_now(GPR_CLOCK_MONOTONIC), t->write_start_time);
+  t->write_duration = (double)dt.tv_sec + 1e-9 * (double)dt.tv_nsec;
+  GRPC_CLOSURE_SCHED(exec_ctx, &t->write_action_end_locked,
+                     GRPC_ERROR_REF(error));
+}
+
 static void write_action_end_locked(grpc_exec_ctx *exec_ctx, void *tp,
                                     grpc_error *error) {
   GPR_TIMER_BEGIN("terminate_writing_with_lock", 0);
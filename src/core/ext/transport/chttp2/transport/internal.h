@@ -72,6 +72,10 @@ typedef enum {
   GRPC_CHTTP2_OPTIMIZE_FOR_THROUGHPUT,
 } grpc_chttp2_optimization_target;
 
+/* Bounds on how many bytes are batched into a single endpoint write */
+#define GRPC_CHTTP2_MIN_TARGET_WRITE_SIZE (16 * 1024)
+#define GRPC_CHTTP2_MAX_TARGET_WRITE_SIZE (1024 * 1024)
+
 typedef enum {
   GRPC_CHTTP2_PCL_INITIATE = 0,
   GRPC_CHTTP2_PCL_NEXT,
@@ -236,6 +240,9 @@ struct grpc_chttp2_transport {
   bool enable_bdp_probe;
 
   grpc_chttp2_optimization_target opt_target;
+  /** should write sizes adapt to the link bandwidth? only set when latency
+      was explicitly asked for through GRPC_ARG_OPTIMIZATION_TARGET */
+  bool adapt_write_size;
 
   /** various lists of streams */
   grpc_chttp2_stream_list lists[STREAM_LIST_COUNT];
@@ -245,6 +252,7 @@ struct grpc_chttp2_transport {
 
   grpc_closure write_action_begin_locked;
   grpc_closure write_action;
+  grpc_closure write_action_end;
   grpc_closure write_action_end_locked;
 
   grpc_closure read_action_locked;
@@ -269,6 +277,16 @@ struct grpc_chttp2_transport {
 
   /** data to write now */
   grpc_slice_buffer outbuf;
+  /** how many bytes are batched into one endpoint write: adapted in
+      grpc_chttp2_end_write if adapt_write_size is set */
+  uint32_t target_write_size;
+  /** estimate of the rate (bytes/sec) at which the endpoint drains writes */
+  double write_bw_est;
+  /** when the in-flight endpoint write was started, and its size */
+  gpr_timespec write_start_time;
+  size_t write_start_bytes;
+  /** how long (in seconds) the endpoint took to complete the last write */
+  double write_duration;
   /** hpack encoding */
   grpc_chttp2_hpack_compressor hpack_compressor;
   int64_t outgoing_window;
@@ -851,6 +869,16 @@ void grpc_chttp2_fail_pending_writes(grpc_exec_ctx *exec_ctx,
 
 uint32_t grpc_chttp2_target_incoming_window(grpc_chttp2_transport *t);
 
+/** Given that the endpoint took write_duration seconds to complete a write of
+    bytes_written bytes, update the drain rate estimate *write_bw_est and
+    return the next target write size (starting from target_write_size).
+    bdp_bw is the bdp estimator's bandwidth estimate, or 0 if there is none */
+uint32_t grpc_chttp2_adapt_target_write_size(uint32_t target_write_size,
+                                             double *write_bw_est,
+                                             size_t bytes_written,
+                                             double write_duration,
+                                             double bdp_bw);
+
 /** Set the default keepalive configurations, must only be called at
     initialization */
 void grpc_chttp2_config_default_keepalive_args(grpc_channel_args *args,
@@ -157,9 +157,61 @@ uint32_t grpc_chttp2_target_incoming_window(grpc_chttp2_transport *t) {
                      [GRPC_CHTTP2_SETTINGS_INITIAL_WINDOW_SIZE]);
 }
 
+/* Transports that adapt their write size aim for writes that the endpoint can
+   drain within this many seconds, bounding how long a small RPC can be stuck
+   behind bulk data on the same connection */
+#define TARGET_WRITE_DURATION 100e-6
+
 /* How many bytes would we like to put on the wire during a single syscall */
 static uint32_t target_write_size(grpc_chttp2_transport *t) {
-  return 1024 * 1024;
+  return t->target_write_size;
+}
+
+/* If the write took longer than TARGET_WRITE_DURATION the endpoint could not
+   take everything at once (tcp_flush had to wait for the socket to drain), so
+   track the rate it drained at; if a full sized batch went out promptly,
+   probe for more. The bdp estimator's bandwidth estimate is used as a floor,
+   so that writes are never sized below what the link is known to carry. */
+uint32_t grpc_chttp2_adapt_target_write_size(uint32_t target_write_size,
+                                             double *write_bw_est,
+                                             size_t bytes_written,
+                                             double write_duration,
+                                             double bdp_bw) {
+  if (write_duration > TARGET_WRITE_DURATION) {
+    double drain_bw = (double)bytes_written / write_duration;
+    *write_bw_est = *write_bw_est == 0 ? drain_bw
+                                       : 0.5 * *write_bw_est + 0.5 * drain_bw;
+  } else if (bytes_written >= target_write_size) {
+    *write_bw_est = 2.0 * target_write_size / TARGET_WRITE_DURATION;
+  } else {
+    return target_write_size;
+  }
+  double bw = GPR_MAX(*write_bw_est, bdp_bw);
+  double target = bw * TARGET_WRITE_DURATION;
+  if (target < GRPC_CHTTP2_MIN_TARGET_WRITE_SIZE) {
+    target = GRPC_CHTTP2_MIN_TARGET_WRITE_SIZE;
+  } else if (target > GRPC_CHTTP2_MAX_TARGET_WRITE_SIZE) {
+    target = GRPC_CHTTP2_MAX_TARGET_WRITE_SIZE;
+  }
+  return (uint32_t)target;
+}
+
+static void update_target_write_size(grpc_chttp2_transport *t) {
+  if (!t->adapt_write_size || t->write_start_bytes == 0) {
+    return;
+  }
+  double bdp_bw;
+  if (!t->enable_bdp_probe ||
+      !grpc_bdp_estimator_get_bw(&t->bdp_estimator, &bdp_bw)) {
+    bdp_bw = 0;
+  }
+  t->target_write_size = grpc_chttp2_adapt_target_write_size(
+      t->target_write_size, &t->write_bw_est, t->write_start_bytes,
+      t->write_duration, bdp_bw);
+  GRPC_CHTTP2_IF_TRACING(gpr_log(
+      GPR_DEBUG, "%s: wrote %" PRIuPTR " bytes in %lfs; target write size %d",
+      t->peer_string, t->write_start_bytes, t->write_duration,
+      (int)t->target_write_size));
 }
 
 // Returns true if initial_metadata contains only default headers.
@@ -451,6 +503,10 @@ void grpc_chttp2_end_write(grpc_exec_ctx *exec_ctx, grpc_chttp2_transport *t,
   GPR_TIMER_BEGIN("grpc_chttp2_end_write", 0);
   grpc_chttp2_stream *s;
 
+  if (error == GRPC_ERROR_NONE) {
+    update_target_write_size(t);
+  }
+
   while (grpc_chttp2_list_pop_writing_stream(t, &s)) {
     if (s->sent_initial_metadata) {
       grpc_chttp2_complete_closure_step(
@@ -38,6 +38,10 @@ typedef enum {
   /// Value is a \a grpc_grpclb_client_stats.
   GRPC_GRPCLB_CLIENT_STATS,
 
+  /// Value is the per-call state of the LB policy that picked the call's
+  /// subchannel. Destroyed when the call is done with that subchannel.
+  GRPC_CONTEXT_LB_CALL_STATE,
+
   GRPC_CONTEXT_COUNT
 } grpc_context_index;
 
@@ -41,6 +41,9 @@ int grpc_compression_algorithm_parse(grpc_slice name,
   } else if (grpc_slice_eq(name, GRPC_MDSTR_DEFLATE)) {
     *algorithm = GRPC_COMPRESS_DEFLATE;
     return 1;
+  } else if (grpc_slice_eq(name, GRPC_MDSTR_LZ4)) {
+    *algorithm = GRPC_COMPRESS_LZ4;
+    return 1;
   } else {
     return 0;
   }
@@ -60,6 +63,9 @@ int grpc_compression_algorithm_name(grpc_compression_algorithm algorithm,
     case GRPC_COMPRESS_GZIP:
       *name = "gzip";
       return 1;
+    case GRPC_COMPRESS_LZ4:
+      *name = "lz4";
+      return 1;
     case GRPC_COMPRESS_ALGORITHMS_COUNT:
       return 0;
   }
@@ -71,6 +77,7 @@ grpc_compression_algorithm grpc_compression_algorithm_from_slice(
   if (grpc_slice_eq(str, GRPC_MDSTR_IDENTITY)) return GRPC_COMPRESS_NONE;
   if (grpc_slice_eq(str, GRPC_MDSTR_DEFLATE)) return GRPC_COMPRESS_DEFLATE;
   if (grpc_slice_eq(str, GRPC_MDSTR_GZIP)) return GRPC_COMPRESS_GZIP;
+  if (grpc_slice_eq(str, GRPC_MDSTR_LZ4)) return GRPC_COMPRESS_LZ4;
   return GRPC_COMPRESS_ALGORITHMS_COUNT;
 }
 
@@ -83,6 +90,8 @@ grpc_slice grpc_compression_algorithm_slice(
       return GRPC_MDSTR_DEFLATE;
     case GRPC_COMPRESS_GZIP:
       return GRPC_MDSTR_GZIP;
+    case GRPC_COMPRESS_LZ4:
+      return GRPC_MDSTR_LZ4;
     case GRPC_COMPRESS_ALGORITHMS_COUNT:
       return grpc_empty_slice();
   }
@@ -98,6 +107,8 @@ grpc_mdelem grpc_compression_encoding_mdelem(
       return GRPC_MDELEM_GRPC_ENCODING_DEFLATE;
     case GRPC_COMPRESS_GZIP:
       return GRPC_MDELEM_GRPC_ENCODING_GZIP;
+    case GRPC_COMPRESS_LZ4:
+      return GRPC_MDELEM_GRPC_ENCODING_LZ4;
     default:
       break;
   }
@@ -137,9 +148,7 @@ grpc_compression_algorithm grpc_compression_algorithm_for_level(
     abort();
   }
 
-  const size_t num_supported =
-      GPR_BITCOUNT(accepted_encodings) - 1; /* discard NONE */
-  if (level == GRPC_COMPRESS_LEVEL_NONE || num_supported == 0) {
+  if (level == GRPC_COMPRESS_LEVEL_NONE) {
     return GRPC_COMPRESS_NONE;
   }
 
@@ -148,24 +157,25 @@ grpc_compression_algorithm grpc_compression_algorithm_for_level(
   /* Establish a "ranking" or compression algorithms in increasing order of
    * compression.
    * This is simplistic and we will probably want to introduce other dimensions
-   * in the future (cpu/memory cost, etc). */
+   * in the future (cpu/memory cost, etc). LZ4 is left out: it trades ratio for
+   * speed rather than sitting between the others, and ranking it would shift
+   * every level of peers that accept it. It's only used when set as the
+   * algorithm explicitly. */
   const grpc_compression_algorithm algos_ranking[] = {GRPC_COMPRESS_GZIP,
                                                       GRPC_COMPRESS_DEFLATE};
 
   /* intersect algos_ranking with the supported ones keeping the ranked order */
   grpc_compression_algorithm
       sorted_supported_algos[GRPC_COMPRESS_ALGORITHMS_COUNT];
-  size_t algos_supported_idx = 0;
+  size_t num_supported = 0;
   for (size_t i = 0; i < GPR_ARRAY_SIZE(algos_ranking); i++) {
     const grpc_compression_algorithm alg = algos_ranking[i];
-    for (size_t j = 0; j < num_supported; j++) {
-      if (GPR_BITGET(accepted_encodings, alg) == 1) {
-        /* if \a alg in supported */
-        sorted_supported_algos[algos_supported_idx++] = alg;
-        break;
-      }
+    if (GPR_BITGET(accepted_encodings, alg) == 1) {
+      sorted_supported_algos[num_supported++] = alg;
     }
-    if (algos_supported_idx == num_supported) break;
+  }
+  if (num_supported == 0) {
+    return GRPC_COMPRESS_NONE;
   }
 
   switch (level) {
@@ -0,0 +1,627 @@
+/*
+ *
+ * Copyright 2017 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "src/core/lib/compression/lz4.h"
+
+#include <string.h>
+
+#include <grpc/support/alloc.h>
+#include <grpc/support/log.h>
+#include <grpc/support/useful.h>
+
+#include "src/core/lib/slice/slice_internal.h"
+
+/* --- Frame format --- */
+
+#define FRAME_MAGIC 0x184D2204u
+/* Skippable frames use the magic numbers 0x184D2A50 to 0x184D2A5F */
+#define SKIPPABLE_FRAME_MAGIC 0x184D2A50u
+#define SKIPPABLE_FRAME_MAGIC_MASK 0xFFFFFFF0u
+
+#define FLG_VERSION_MASK 0xC0
+#define FLG_VERSION 0x40
+#define FLG_BLOCK_INDEPENDENCE 0x20
+#define FLG_BLOCK_CHECKSUM 0x10
+#define FLG_CONTENT_SIZE 0x08
+#define FLG_CONTENT_CHECKSUM 0x04
+#define FLG_RESERVED 0x02
+#define FLG_DICT_ID 0x01
+
+#define BD_RESERVED 0x8F
+#define BD_BLOCK_MAX_SIZE_SHIFT 4
+/* Block maximum sizes 4 to 7 stand for 64KiB, 256KiB, 1MiB and 4MiB */
+#define BD_MIN_BLOCK_MAX_SIZE 4
+
+/* Magic number, FLG and BD bytes, header checksum */
+#define FRAME_HEADER_SIZE 7
+#define BLOCK_HEADER_SIZE 4
+#define BLOCK_UNCOMPRESSED 0x80000000u
+
+/* The compressor writes blocks of the smallest size the format allows, which
+   keeps the offsets of its hash table within 16 bits */
+#define COMPRESS_BLOCK_SIZE (64 * 1024)
+#define COMPRESS_FLG (FLG_VERSION | FLG_BLOCK_INDEPENDENCE)
+#define COMPRESS_BD (BD_MIN_BLOCK_MAX_SIZE << BD_BLOCK_MAX_SIZE_SHIFT)
+
+/* --- Block format --- */
+
+#define MIN_MATCH 4
+/* The last match starts at least MF_LIMIT bytes before the end of the block,
+   and the last LAST_LITERALS bytes of a block are literals */
+#define MF_LIMIT 12
+#define LAST_LITERALS 5
+#define RUN_MASK 15
+#define HASH_LOG 12
+/* The distance between two probes for a match grows by one every
+   2^SKIP_TRIGGER failed probes, which makes incompressible input cheap */
+#define SKIP_TRIGGER 6
+
+/* Output slices start at the size of the input, within these bounds, and
+   double in size while the output grows */
+#define MIN_OUTPUT_BLOCK_SIZE 1024
+#define MAX_OUTPUT_BLOCK_SIZE (256 * 1024)
+
+static uint32_t read_le32(const uint8_t* p) {
+  return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) |
+         ((uint32_t)p[3] << 24);
+}
+
+static uint64_t read_le64(const uint8_t* p) {
+  return (uint64_t)read_le32(p) | ((uint64_t)read_le32(p + 4) << 32);
+}
+
+static void write_le32(uint8_t* p, uint32_t value) {
+  p[0] = (uint8_t)value;
+  p[1] = (uint8_t)(value >> 8);
+  p[2] = (uint8_t)(value >> 16);
+  p[3] = (uint8_t)(value >> 24);
+}
+
+/* --- xxHash32, with a zero seed, for the checksums of the frame format --- */
+
+#define PRIME32_1 2654435761u
+#define PRIME32_2 2246822519u
+#define PRIME32_3 3266489917u
+#define PRIME32_4 668265263u
+#define PRIME32_5 374761393u
+
+typedef struct {
+  uint32_t acc[4];
+  uint8_t pending[16];
+  size_t pending_size;
+  uint64_t total_size;
+} xxh32_state;
+
+static uint32_t rotl32(uint32_t x, int r) {
+  return (x << r) | (x >> (32 - r));
+}
+
+static uint32_t xxh32_round(uint32_t acc, uint32_t input) {
+  return rotl32(acc + input * PRIME32_2, 13) * PRIME32_1;
+}
+
+static void xxh32_init(xxh32_state* state) {
+  state->acc[0] = PRIME32_1 + PRIME32_2;
+  state->acc[1] = PRIME32_2;
+  state->acc[2] = 0;
+  state->acc[3] = 0 - PRIME32_1;
+  state->pending_size = 0;
+  state->total_size = 0;
+}
+
+static void xxh32_stripe(xxh32_state* state, const uint8_t* p) {
+  int i;
+  for (i = 0; i < 4; i++) {
+    state->acc[i] = xxh32_round(state->acc[i], read_le32(p + 4 * i));
+  }
+}
+
+static void xxh32_update(xxh32_state* state, const uint8_t* p, size_t size) {
+  state->total_size += size;
+  if (state->pending_size > 0) {
+    size_t n = GPR_MIN(size, 16 - state->pending_size);
+    memcpy(state->pending + state->pending_size, p, n);
+    state->pending_size += n;
+    p += n;
+    size -= n;
+    if (state->pending_size < 16) return;
+    xxh32_stripe(state, state->pending);
+    state->pending_size = 0;
+  }
+  for (; size >= 16; p += 16, size -= 16) {
+    xxh32_stripe(state, p);
+  }
+  memcpy(state->pending, p, size);
+  state->pending_size = size;
+}
+
+static uint32_t xxh32_digest(const xxh32_state* state) {
+  const uint8_t* p = state->pending;
+  size_t size = state->pending_size;
+  uint32_t h;
+  if (state->total_size >= 16) {
+    h = rotl32(state->acc[0], 1) + rotl32(state->acc[1], 7) +
+        rotl32(state->acc[2], 12) + rotl32(state->acc[3], 18);
+  } else {
+    h = PRIME32_5;
+  }
+  h += (uint32_t)state->total_size;
+  for (; size >= 4; p += 4, size -= 4) {
+    h = rotl32(h + read_le32(p) * PRIME32_3, 17) * PRIME32_4;
+  }
+  for (; size > 0; p++, size--) {
+    h = rotl32(h + (uint32_t)*p * PRIME32_5, 11) * PRIME32_1;
+  }
+  h ^= h >> 15;
+  h *= PRIME32_2;
+  h ^= h >> 13;
+  h *= PRIME32_3;
+  h ^= h >> 16;
+  return h;
+}
+
+static uint32_t xxh32(const uint8_t* p, size_t size) {
+  xxh32_state state;
+  xxh32_init(&state);
+  xxh32_update(&state, p, size);
+  return xxh32_digest(&state);
+}
+
+/* --- Block compression --- */
+
+static uint32_t hash_sequence(uint32_t sequence) {
+  return (sequence * PRIME32_1) >> (32 - HASH_LOG);
+}
+
+/* Writes the bytes of a length that did not fit in its token */
+static uint8_t* write_length(uint8_t* op, size_t length) {
+  for (length -= RUN_MASK; length >= 255; length -= 255) {
+    *op++ = 255;
+  }
+  *op++ = (uint8_t)length;
+  return op;
+}
+
+/* Writes a sequence of literals followed by a match, or by nothing if
+   match_length is 0. Returns NULL if it does not fit before op_end. */
+static uint8_t* write_sequence(uint8_t* op, const uint8_t* op_end,
+                               const uint8_t* literals, size_t literal_length,
+                               size_t offset, size_t match_length) {
+  size_t size = 1 + literal_length;
+  uint8_t* token = op;
+  if (literal_length >= RUN_MASK) size += (literal_length - RUN_MASK) / 255 + 1;
+  if (match_length > 0) {
+    size += 2;
+    if (match_length - MIN_MATCH >= RUN_MASK) {
+      size += (match_length - MIN_MATCH - RUN_MASK) / 255 + 1;
+    }
+  }
+  if (size > (size_t)(op_end - op)) return NULL;
+  op++;
+  if (literal_length >= RUN_MASK) {
+    *token = RUN_MASK << 4;
+    op = write_length(op, literal_length);
+  } else {
+    *token = (uint8_t)(literal_length << 4);
+  }
+  memcpy(op, literals, literal_length);
+  op += literal_length;
+  if (match_length > 0) {
+    *op++ = (uint8_t)offset;
+    *op++ = (uint8_t)(offset >> 8);
+    match_length -= MIN_MATCH;
+    if (match_length >= RUN_MASK) {
+      *token |= RUN_MASK;
+      op = write_length(op, match_length);
+    } else {
+      *token |= (uint8_t)match_length;
+    }
+  }
+  return op;
+}
+
+size_t grpc_lz4_compress_block(const uint8_t* input, size_t input_size,
+                               uint8_t* output, size_t output_capacity) {
+  const uint8_t* const end = input + input_size;
+  const uint8_t* ip = input;
+  const uint8_t* anchor = input;
+  uint8_t* op = output;
+  const uint8_t* const op_end = output + output_capacity;
+  /* positions of the last sequences seen with each hash, relative to input */
+  uint16_t table[1 << HASH_LOG];
+
+  GPR_ASSERT(input_size <= COMPRESS_BLOCK_SIZE);
+  if (input_size > MF_LIMIT) {
+    const uint8_t* const match_start_limit = end - MF_LIMIT;
+    const uint8_t* const match_end_limit = end - LAST_LITERALS;
+    memset(table, 0, sizeof(table));
+    ip++;
+    while (ip <= match_start_limit) {
+      const uint8_t* match = NULL;
+      size_t attempts = 1 << SKIP_TRIGGER;
+      size_t length = MIN_MATCH;
+      /* look for a match, every position of the input being within reach of
+         16 bit offsets */
+      while (ip <= match_start_limit) {
+        uint32_t sequence = read_le32(ip);
+        uint32_t h = hash_sequence(sequence);
+        const uint8_t* candidate = input + table[h];
+        table[h] = (uint16_t)(ip - input);
+        if (read_le32(candidate) == sequence) {
+          match = candidate;
+          break;
+        }
+        ip += attempts++ >> SKIP_TRIGGER;
+      }
+      if (match == NULL) break;
+      while (ip > anchor && match > input && ip[-1] == match[-1]) {
+        ip--;
+        match--;
+      }
+      while (ip + length < match_end_limit && ip[length] == match[length]) {
+        length++;
+      }
+      op = write_sequence(op, op_end, anchor, (size_t)(ip - anchor),
+                          (size_t)(ip - match), length);
+      if (op == NULL) return 0;
+      ip += length;
+      anchor = ip;
+      if (ip <= match_start_limit) {
+        table[hash_sequence(read_le32(ip - 2))] = (uint16_t)(ip - 2 - input);
+      }
+    }
+  }
+  op = write_sequence(op, op_end, anchor, (size_t)(end - anchor), 0, 0);
+  if (op == NULL) return 0;
+  return (size_t)(op - output);
+}
+
+/* --- Block decompression --- */
+
+/* Adds the bytes of a length that did not fit in its token to *length */
+static int read_length(const uint8_t** ip, const uint8_t* end,
+                       size_t* length) {
+  uint8_t b;
+  do {
+    if (*ip == end) return 0;
+    b = *(*ip)++;
+    *length += b;
+  } while (b == 255);
+  return 1;
+}
+
+/* Copies a match that may overlap the bytes it produces. Its bytes then repeat
+   with a period of offset, so each copy can be twice as large as the last. */
+static void copy_match(uint8_t* op, size_t offset, size_t length) {
+  const uint8_t* match = op - offset;
+  size_t chunk = offset;
+  while (length > chunk) {
+    memcpy(op, match, chunk);
+    op += chunk;
+    length -= chunk;
+    chunk *= 2;
+  }
+  memcpy(op, match, length);
+}
+
+int grpc_lz4_decompress_block(const uint8_t* input, size_t input_size,
+                              uint8_t* output, size_t output_capacity,
+                              size_t* output_size) {
+  const uint8_t* ip = input;
+  const uint8_t* const end = input + input_size;
+  uint8_t* op = output;
+  const uint8_t* const op_end = output + output_capacity;
+  for (;;) {
+    uint8_t token;
+    size_t length;
+    size_t offset;
+    if (ip == end) return 0;
+    token = *ip++;
+    length = (size_t)(token >> 4);
+    if (length == RUN_MASK && !read_length(&ip, end, &length)) return 0;
+    if (length > (size_t)(end - ip) || length > (size_t)(op_end - op)) {
+      return 0;
+    }
+    memcpy(op, ip, length);
+    ip += length;
+    op += length;
+    /* the last sequence of a block has no match */
+    if (ip == end) break;
+    if (end - ip < 2) return 0;
+    offset = (size_t)ip[0] | ((size_t)ip[1] << 8);
+    ip += 2;
+    if (offset == 0 || offset > (size_t)(op - output)) return 0;
+    length = (size_t)(token & RUN_MASK);
+    if (length == RUN_MASK && !read_length(&ip, end, &length)) return 0;
+    length += MIN_MATCH;
+    if (length > (size_t)(op_end - op)) return 0;
+    copy_match(op, offset, length);
+    op += length;
+  }
+  *output_size = (size_t)(op - output);
+  return 1;
+}
+
+/* --- Frames --- */
+
+/* Appends bytes to a slice buffer, in slices of growing sizes */
+typedef struct {
+  grpc_slice_buffer* output;
+  size_t count_before;
+  size_t length_before;
+  /* slice being filled, not yet added to output */
+  grpc_slice slice;
+  size_t used;
+  size_t next_size;
+} output_writer;
+
+static void writer_init(output_writer* w, grpc_slice_buffer* output,
+                        size_t size_hint) {
+  w->output = output;
+  w->count_before = output->count;
+  w->length_before = output->length;
+  w->slice = grpc_empty_slice();
+  w->used = 0;
+  w->next_size =
+      GPR_CLAMP(size_hint, MIN_OUTPUT_BLOCK_SIZE, MAX_OUTPUT_BLOCK_SIZE);
+}
+
+static size_t writer_room(const output_writer* w) {
+  return GRPC_SLICE_LENGTH(w->slice) - w->used;
+}
+
+static uint8_t* writer_ptr(output_writer* w) {
+  return GRPC_SLICE_START_PTR(w->slice) + w->used;
+}
+
+/* Number of bytes written so far */
+static size_t writer_length(const output_writer* w) {
+  return w->output->length - w->length_before + w->used;
+}
+
+static void writer_flush(grpc_exec_ctx* exec_ctx, output_writer* w) {
+  if (w->used > 0) {
+    GRPC_SLICE_SET_LENGTH(w->slice, w->used);
+    grpc_slice_buffer_add_indexed(w->output, w->slice);
+  } else {
+    grpc_slice_unref_internal(exec_ctx, w->slice);
+  }
+  w->slice = grpc_empty_slice();
+  w->used = 0;
+}
+
+/* Continues in a new slice with room for at least size bytes */
+static void writer_reserve(grpc_exec_ctx* exec_ctx, output_writer* w,
+                           size_t size) {
+  writer_flush(exec_ctx, w);
+  w->slice = GRPC_SLICE_MALLOC(GPR_MAX(size, w->next_size));
+  w->next_size = GPR_MIN(2 * w->next_size, MAX_OUTPUT_BLOCK_SIZE);
+}
+
+static void writer_write(grpc_exec_ctx* exec_ctx, output_writer* w,
+                         const uint8_t* data, size_t size) {
+  while (size > 0) {
+    size_t n;
+    if (writer_room(w) == 0) writer_reserve(exec_ctx, w, 0);
+    n = GPR_MIN(size, writer_room(w));
+    memcpy(writer_ptr(w), data, n);
+    w->used += n;
+    data += n;
+    size -= n;
+  }
+}
+
+/* Drops everything written, leaving the output as it was */
+static void writer_abort(grpc_exec_ctx* exec_ctx, output_writer* w) {
+  size_t i;
+  grpc_slice_unref_internal(exec_ctx, w->slice);
+  for (i = w->count_before; i < w->output->count; i++) {
+    grpc_slice_unref_internal(exec_ctx, w->output->slices[i]);
+  }
+  w->output->count = w->count_before;
+  w->output->length = w->length_before;
+}
+
+/* Returns the bytes of input in a single buffer, which *copy holds if input
+   had to be copied */
+static const uint8_t* flatten_input(grpc_slice_buffer* input, uint8_t** copy) {
+  size_t i;
+  uint8_t* p;
+  *copy = NULL;
+  if (input->count == 1) return GRPC_SLICE_START_PTR(input->slices[0]);
+  p = *copy = gpr_malloc(input->length);
+  for (i = 0; i < input->count; i++) {
+    memcpy(p, GRPC_SLICE_START_PTR(input->slices[i]),
+           GRPC_SLICE_LENGTH(input->slices[i]));
+    p += GRPC_SLICE_LENGTH(input->slices[i]);
+  }
+  return *copy;
+}
+
+int grpc_lz4_compress(grpc_exec_ctx* exec_ctx, grpc_slice_buffer* input,
+                      grpc_slice_buffer* output) {
+  output_writer w;
+  uint8_t header[FRAME_HEADER_SIZE];
+  uint8_t end_mark[BLOCK_HEADER_SIZE] = {0, 0, 0, 0};
+  uint8_t* copy;
+  const uint8_t* data;
+  size_t pos;
+  int r = 0;
+
+  if (input->length == 0) return 0;
+  data = flatten_input(input, &copy);
+  writer_init(&w, output,
+              input->length + FRAME_HEADER_SIZE + BLOCK_HEADER_SIZE);
+  write_le32(header, FRAME_MAGIC);
+  header[4] = COMPRESS_FLG;
+  header[5] = COMPRESS_BD;
+  header[6] = (uint8_t)(xxh32(header + 4, 2) >> 8);
+  writer_write(exec_ctx, &w, header, sizeof(header));
+  for (pos = 0; pos < input->length; pos += COMPRESS_BLOCK_SIZE) {
+    size_t block_size = GPR_MIN(COMPRESS_BLOCK_SIZE, input->length - pos);
+    size_t compressed_size;
+    uint8_t* p;
+    if (writer_room(&w) < BLOCK_HEADER_SIZE + block_size) {
+      writer_reserve(exec_ctx, &w, BLOCK_HEADER_SIZE + block_size);
+    }
+    p = writer_ptr(&w);
+    /* blocks that do not shrink are stored uncompressed */
+    compressed_size = grpc_lz4_compress_block(
+        data + pos, block_size, p + BLOCK_HEADER_SIZE, block_size - 1);
+    if (compressed_size == 0) {
+      write_le32(p, (uint32_t)block_size | BLOCK_UNCOMPRESSED);
+      memcpy(p + BLOCK_HEADER_SIZE, data + pos, block_size);
+      compressed_size = block_size;
+    } else {
+      write_le32(p, (uint32_t)compressed_size);
+    }
+    w.used += BLOCK_HEADER_SIZE + compressed_size;
+    if (writer_length(&w) >= input->length) goto done;
+  }
+  writer_write(exec_ctx, &w, end_mark, sizeof(end_mark));
+  r = writer_length(&w) < input->length;
+
+done:
+  if (r) {
+    writer_flush(exec_ctx, &w);
+  } else {
+    writer_abort(exec_ctx, &w);
+  }
+  gpr_free(copy);
+  return r;
+}
+
+/* Decompresses the frame starting at *pos, and moves *pos past it */
+static int decompress_frame(grpc_exec_ctx* exec_ctx, const uint8_t* data,
+                            size_t length, size_t* pos, output_writer* w) {
+  const uint8_t* p = data + *pos;
+  const uint8_t* const end = data + length;
+  xxh32_state content_hash;
+  size_t content_start = writer_length(w);
+  size_t descriptor_size = 2;
+  size_t block_max_size;
+  uint8_t flg;
+  uint8_t bd;
+
+  if (end - p < 8) return 0;
+  if ((read_le32(p) & SKIPPABLE_FRAME_MAGIC_MASK) == SKIPPABLE_FRAME_MAGIC) {
+    size_t skipped = read_le32(p + 4);
+    if (skipped > (size_t)(end - p) - 8) return 0;
+    *pos += 8 + skipped;
+    return 1;
+  }
+  if (read_le32(p) != FRAME_MAGIC) return 0;
+  flg = p[4];
+  bd = p[5];
+  /* linked blocks would need the previous block to be kept contiguous with
+     the current one, which neither lz4 nor this compressor write by default */
+  if ((flg & FLG_VERSION_MASK) != FLG_VERSION ||
+      (flg & (FLG_RESERVED | FLG_DICT_ID)) != 0 ||
+      (flg & FLG_BLOCK_INDEPENDENCE) == 0 || (bd & BD_RESERVED) != 0 ||
+      (bd >> BD_BLOCK_MAX_SIZE_SHIFT) < BD_MIN_BLOCK_MAX_SIZE) {
+    return 0;
+  }
+  block_max_size = (size_t)1 << (2 * (bd >> BD_BLOCK_MAX_SIZE_SHIFT) + 8);
+  if (flg & FLG_CONTENT_SIZE) descriptor_size += 8;
+  if ((size_t)(end - p) < 5 + descriptor_size) return 0;
+  if ((uint8_t)(xxh32(p + 4, descriptor_size) >> 8) !=
+      p[4 + descriptor_size]) {
+    return 0;
+  }
+  xxh32_init(&content_hash);
+
+  for (p += 5 + descriptor_size;;) {
+    uint32_t block;
+    size_t block_size;
+    uint8_t* out;
+    size_t out_size;
+    if (end - p < BLOCK_HEADER_SIZE) return 0;
+    block = read_le32(p);
+    p += BLOCK_HEADER_SIZE;
+    if (block == 0) break;
+    block_size = block & ~BLOCK_UNCOMPRESSED;
+    if (block_size > block_max_size || block_size > (size_t)(end - p)) {
+      return 0;
+    }
+    if (flg & FLG_BLOCK_CHECKSUM) {
+      if ((size_t)(end - p) - block_size < 4 ||
+          xxh32(p, block_size) != read_le32(p + block_size)) {
+        return 0;
+      }
+    }
+    if (block & BLOCK_UNCOMPRESSED) {
+      if (flg & FLG_CONTENT_CHECKSUM) {
+        xxh32_update(&content_hash, p, block_size);
+      }
+      writer_write(exec_ctx, w, p, block_size);
+    } else {
+      /* the size of the block once decompressed is unknown: retry in larger
+         slices until it reaches the maximum the frame allows */
+      size_t room = writer_room(w);
+      while (!grpc_lz4_decompress_block(p, block_size, writer_ptr(w), room,
+                                        &out_size)) {
+        if (room >= block_max_size) return 0;
+        writer_reserve(exec_ctx, w, GPR_MIN(block_max_size,
+                                            GPR_MAX(2 * room, 4 * block_size)));
+        room = writer_room(w);
+      }
+      out = writer_ptr(w);
+      if (flg & FLG_CONTENT_CHECKSUM) {
+        xxh32_update(&content_hash, out, out_size);
+      }
+      w->used += out_size;
+    }
+    p += block_size;
+    if (flg & FLG_BLOCK_CHECKSUM) p += 4;
+  }
+
+  if (flg & FLG_CONTENT_CHECKSUM) {
+    if (end - p < 4 || xxh32_digest(&content_hash) != read_le32(p)) return 0;
+    p += 4;
+  }
+  if ((flg & FLG_CONTENT_SIZE) &&
+      read_le64(data + *pos + 6) != writer_length(w) - content_start) {
+    return 0;
+  }
+  *pos = (size_t)(p - data);
+  return 1;
+}
+
+int grpc_lz4_decompress(grpc_exec_ctx* exec_ctx, grpc_slice_buffer* input,
+                        grpc_slice_buffer* output) {
+  output_writer w;
+  uint8_t* copy;
+  const uint8_t* data;
+  size_t pos = 0;
+  int r = 1;
+
+  if (input->length == 0) return 0;
+  data = flatten_input(input, &copy);
+  writer_init(&w, output, 2 * input->length);
+  while (r && pos < input->length) {
+    r = decompress_frame(exec_ctx, data, input->length, &pos, &w);
+  }
+  if (r) {
+    writer_flush(exec_ctx, &w);
+  } else {
+    gpr_log(GPR_INFO, "lz4: invalid frame");
+    writer_abort(exec_ctx, &w);
+  }
+  gpr_free(copy);
+  return r;
+}
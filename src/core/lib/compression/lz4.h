@@ -0,0 +1,61 @@
+/*
+ *
+ * Copyright 2017 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GRPC_CORE_LIB_COMPRESSION_LZ4_H
+#define GRPC_CORE_LIB_COMPRESSION_LZ4_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <grpc/slice_buffer.h>
+
+#include "src/core/lib/iomgr/exec_ctx.h"
+
+/* LZ4 compression of messages, in the LZ4 frame format
+   (https://github.com/lz4/lz4/blob/dev/doc/lz4_Frame_format.md).
+
+   The compressor trades compression ratio for speed: it emits a single frame
+   of independent 64KiB blocks, without checksums, and finds matches with a
+   single hash table probe per position. The decompressor accepts any frame
+   with independent blocks, such as the ones written by the lz4 command line
+   tool, and verifies the checksums they carry. */
+
+/* Appends the compression of input to output and returns 1 if it is smaller
+   than input. Otherwise leaves output unchanged and returns 0. */
+int grpc_lz4_compress(grpc_exec_ctx* exec_ctx, grpc_slice_buffer* input,
+                      grpc_slice_buffer* output);
+
+/* Appends the decompression of input to output and returns 1. If input is not
+   a valid sequence of frames, leaves output unchanged and returns 0. */
+int grpc_lz4_decompress(grpc_exec_ctx* exec_ctx, grpc_slice_buffer* input,
+                        grpc_slice_buffer* output);
+
+/* Compresses a single block of input_size bytes into output, in the LZ4 block
+   format. Returns the compressed size, or 0 if it would exceed
+   output_capacity. input_size must not exceed 64KiB. */
+size_t grpc_lz4_compress_block(const uint8_t* input, size_t input_size,
+                               uint8_t* output, size_t output_capacity);
+
+/* Decompresses a single block in the LZ4 block format into output. Returns 1
+   and sets *output_size on success, or 0 if the block is malformed or would
+   decompress to more than output_capacity bytes. */
+int grpc_lz4_decompress_block(const uint8_t* input, size_t input_size,
+                              uint8_t* output, size_t output_capacity,
+                              size_t* output_size);
+
+#endif /* GRPC_CORE_LIB_COMPRESSION_LZ4_H */
@@ -22,12 +22,52 @@
 
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
+#include <grpc/support/sync.h>
+#include <grpc/support/useful.h>
 
 #include <zlib.h>
 
+#include "src/core/lib/compression/lz4.h"
 #include "src/core/lib/slice/slice_internal.h"
 
-#define OUTPUT_BLOCK_SIZE 1024
+/* Output slices start at the size of the input, within these bounds, and
+   double in size while the output grows */
+#define MIN_OUTPUT_BLOCK_SIZE 1024
+#define MAX_OUTPUT_BLOCK_SIZE (256 * 1024)
+
+/* Number of idle streams kept by each of the stream pools. A deflate stream
+   holds about 256KiB of state, an inflate stream about 40KiB. */
+#define MAX_POOLED_STREAMS 8
+
+/* Streams of one kind (deflate or inflate, zlib or gzip wrapper), reset after
+   each message so that the next ones do not allocate their state again */
+typedef struct {
+  gpr_mu mu;
+  z_stream* streams[MAX_POOLED_STREAMS];
+  size_t count;
+} stream_pool;
+
+typedef enum {
+  DEFLATE_POOL,
+  GZIP_POOL,
+  INFLATE_POOL,
+  GUNZIP_POOL,
+  POOL_COUNT
+} pool_index;
+
+/* The pools are set up on first use, rather than by grpc_init, because
+   messages are also (de)compressed outside of grpc_init/grpc_shutdown (byte
+   buffer readers, for one). They live as long as the process. */
+static gpr_once g_pools_once = GPR_ONCE_INIT;
+static stream_pool g_pools[POOL_COUNT];
+
+static void init_pools(void) {
+  int i;
+  for (i = 0; i < POOL_COUNT; i++) {
+    gpr_mu_init(&g_pools[i].mu);
+    g_pools[i].count = 0;
+  }
+}
 
 static int zlib_body(grpc_exec_ctx* exec_ctx, z_stream* zs,
                      grpc_slice_buffer* input, grpc_slice_buffer* output,
@@ -35,7 +75,9 @@ static int zlib_body(grpc_exec_ctx* exec_ctx, z_stream* zs,
   int r;
   int flush;
   size_t i;
-  grpc_slice outbuf = GRPC_SLICE_MALLOC(OUTPUT_BLOCK_SIZE);
+  size_t block_size = GPR_CLAMP(input->length, MIN_OUTPUT_BLOCK_SIZE,
+                                MAX_OUTPUT_BLOCK_SIZE);
+  grpc_slice outbuf = GRPC_SLICE_MALLOC(block_size);
   const uInt uint_max = ~(uInt)0;
 
   GPR_ASSERT(GRPC_SLICE_LENGTH(outbuf) <= uint_max);
@@ -50,7 +92,8 @@ static int zlib_body(grpc_exec_ctx* exec_ctx, z_stream* zs,
     do {
       if (zs->avail_out == 0) {
         grpc_slice_buffer_add_indexed(output, outbuf);
-        outbuf = GRPC_SLICE_MALLOC(OUTPUT_BLOCK_SIZE);
+        block_size = GPR_MIN(2 * block_size, MAX_OUTPUT_BLOCK_SIZE);
+        outbuf = GRPC_SLICE_MALLOC(block_size);
         GPR_ASSERT(GRPC_SLICE_LENGTH(outbuf) <= uint_max);
         zs->avail_out = (uInt)GRPC_SLICE_LENGTH(outbuf);
         zs->next_out = GRPC_SLICE_START_PTR(outbuf);
@@ -84,20 +127,78 @@ static void* zalloc_gpr(void* opaque, unsigned int items, unsigned int size) {
 
 static void zfree_gpr(void* opaque, void* address) { gpr_free(address); }
 
+static pool_index get_pool_index(int decompress, int gzip) {
+  return decompress ? (gzip ? GUNZIP_POOL : INFLATE_POOL)
+                    : (gzip ? GZIP_POOL : DEFLATE_POOL);
+}
+
+/* Takes a stream ready for a new message out of its pool, or creates one if
+   the pool is empty */
+static z_stream* stream_pool_get(pool_index index) {
+  stream_pool* pool = &g_pools[index];
+  z_stream* zs = NULL;
+  int r;
+  gpr_once_init(&g_pools_once, init_pools);
+  gpr_mu_lock(&pool->mu);
+  if (pool->count > 0) zs = pool->streams[--pool->count];
+  gpr_mu_unlock(&pool->mu);
+  if (zs != NULL) return zs;
+  zs = gpr_zalloc(sizeof(*zs));
+  zs->zalloc = zalloc_gpr;
+  zs->zfree = zfree_gpr;
+  switch (index) {
+    case DEFLATE_POOL:
+    case GZIP_POOL:
+      r = deflateInit2(zs, Z_DEFAULT_COMPRESSION, Z_DEFLATED,
+                       15 | (index == GZIP_POOL ? 16 : 0), 8,
+                       Z_DEFAULT_STRATEGY);
+      break;
+    default:
+      r = inflateInit2(zs, 15 | (index == GUNZIP_POOL ? 16 : 0));
+      break;
+  }
+  GPR_ASSERT(r == Z_OK);
+  return zs;
+}
+
+static void stream_destroy(pool_index index, z_stream* zs) {
+  if (index == DEFLATE_POOL || index == GZIP_POOL) {
+    deflateEnd(zs);
+  } else {
+    inflateEnd(zs);
+  }
+  gpr_free(zs);
+}
+
+/* Resets a stream, whatever state its last message left it in, and returns it
+   to its pool */
+static void stream_pool_put(pool_index index, z_stream* zs) {
+  stream_pool* pool = &g_pools[index];
+  int r;
+  if (index == DEFLATE_POOL || index == GZIP_POOL) {
+    r = deflateReset(zs);
+  } else {
+    r = inflateReset(zs);
+  }
+  GPR_ASSERT(r == Z_OK);
+  gpr_mu_lock(&pool->mu);
+  if (pool->count < MAX_POOLED_STREAMS) {
+    pool->streams[pool->count++] = zs;
+    zs = NULL;
+  }
+  gpr_mu_unlock(&pool->mu);
+  if (zs != NULL) stream_destroy(index, zs);
+}
+
 static int zlib_compress(grpc_exec_ctx* exec_ctx, grpc_slice_buffer* input,
                          grpc_slice_buffer* output, int gzip) {
-  z_stream zs;
+  pool_index index = get_pool_index(0, gzip);
+  z_stream* zs = stream_pool_get(index);
   int r;
   size_t i;
   size_t count_before = output->count;
   size_t length_before = output->length;
-  memset(&zs, 0, sizeof(zs));
-  zs.zalloc = zalloc_gpr;
-  zs.zfree = zfree_gpr;
-  r = deflateInit2(&zs, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 | (gzip ? 16 : 0),
-                   8, Z_DEFAULT_STRATEGY);
-  GPR_ASSERT(r == Z_OK);
-  r = zlib_body(exec_ctx, &zs, input, output, deflate) &&
+  r = zlib_body(exec_ctx, zs, input, output, deflate) &&
       output->length < input->length;
   if (!r) {
     for (i = count_before; i < output->count; i++) {
@@ -106,23 +207,19 @@ static int zlib_compress(grpc_exec_ctx* exec_ctx, grpc_slice_buffer* input,
     output->count = count_before;
     output->length = length_before;
   }
-  deflateEnd(&zs);
+  stream_pool_put(index, zs);
   return r;
 }
 
 static int zlib_decompress(grpc_exec_ctx* exec_ctx, grpc_slice_buffer* input,
                            grpc_slice_buffer* output, int gzip) {
-  z_stream zs;
+  pool_index index = get_pool_index(1, gzip);
+  z_stream* zs = stream_pool_get(index);
   int r;
   size_t i;
   size_t count_before = output->count;
   size_t length_before = output->length;
-  memset(&zs, 0, sizeof(zs));
-  zs.zalloc = zalloc_gpr;
-  zs.zfree = zfree_gpr;
-  r = inflateInit2(&zs, 15 | (gzip ? 16 : 0));
-  GPR_ASSERT(r == Z_OK);
-  r = zlib_body(exec_ctx, &zs, input, output, inflate);
+  r = zlib_body(exec_ctx, zs, input, output, inflate);
   if (!r) {
     for (i = count_before; i < output->count; i++) {
       grpc_slice_unref_internal(exec_ctx, output->slices[i]);
@@ -130,7 +227,7 @@ static int zlib_decompress(grpc_exec_ctx* exec_ctx, grpc_slice_buffer* input,
     output->count = count_before;
     output->length = length_before;
   }
-  inflateEnd(&zs);
+  stream_pool_put(index, zs);
   return r;
 }
 
@@ -154,6 +251,8 @@ static int compress_inner(grpc_exec_ctx* exec_ctx,
       return zlib_compress(exec_ctx, input, output, 0);
     case GRPC_COMPRESS_GZIP:
       return zlib_compress(exec_ctx, input, output, 1);
+    case GRPC_COMPRESS_LZ4:
+      return grpc_lz4_compress(exec_ctx, input, output);
     case GRPC_COMPRESS_ALGORITHMS_COUNT:
       break;
   }
@@ -181,6 +280,8 @@ int grpc_msg_decompress(grpc_exec_ctx* exec_ctx,
       return zlib_decompress(exec_ctx, input, output, 0);
     case GRPC_COMPRESS_GZIP:
       return zlib_decompress(exec_ctx, input, output, 1);
+    case GRPC_COMPRESS_LZ4:
+      return grpc_lz4_decompress(exec_ctx, input, output);
     case GRPC_COMPRESS_ALGORITHMS_COUNT:
       break;
   }
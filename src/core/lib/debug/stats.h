@@ -0,0 +1,75 @@
+/*
+ *
+ * Copyright 2017 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GRPC_CORE_LIB_DEBUG_STATS_H
+#define GRPC_CORE_LIB_DEBUG_STATS_H
+
+#include <grpc/support/atm.h>
+#include "src/core/lib/debug/stats_data.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+
+/* Process wide counters and histograms, always on and cheap enough for hot
+   paths: each cpu increments its own copy without locks, and readers sum the
+   copies up with grpc_stats_collect. The set of stats is declared in
+   stats_data.yaml. */
+
+typedef struct grpc_stats_data {
+  gpr_atm counters[GRPC_STATS_COUNTER_COUNT];
+  gpr_atm histograms[GRPC_STATS_HISTOGRAM_BUCKETS];
+} grpc_stats_data;
+
+/* one grpc_stats_data per cpu, indexed by GRPC_EXEC_CTX_STARTING_CPU */
+extern grpc_stats_data *grpc_stats_per_cpu_storage;
+
+#define GRPC_THREAD_STATS_DATA(exec_ctx) \
+  (&grpc_stats_per_cpu_storage[GRPC_EXEC_CTX_STARTING_CPU(exec_ctx)])
+
+#define GRPC_STATS_INC_COUNTER(exec_ctx, ctr) \
+  (gpr_atm_no_barrier_fetch_add(              \
+      &GRPC_THREAD_STATS_DATA((exec_ctx))->counters[(ctr)], 1))
+
+#define GRPC_STATS_INC_HISTOGRAM(exec_ctx, histogram, index)  \
+  (gpr_atm_no_barrier_fetch_add(                              \
+      &GRPC_THREAD_STATS_DATA((exec_ctx))                     \
+           ->histograms[grpc_stats_histo_start[(histogram)] + \
+                        (index)],                             \
+      1))
+
+/* Allocate the per-cpu storage: idempotent, and the storage is never released
+   so that stragglers incrementing stats during or after shutdown stay safe */
+void grpc_stats_init(void);
+/* Sum the per-cpu stats into *output */
+void grpc_stats_collect(grpc_stats_data *output);
+/* c = b - a: the stats accumulated between snapshot a and later snapshot b */
+void grpc_stats_diff(const grpc_stats_data *b, const grpc_stats_data *a,
+                     grpc_stats_data *c);
+/* Render all stats as a json object (the caller owns the result) */
+char *grpc_stats_data_as_json(const grpc_stats_data *data);
+/* Index of the bucket of table (table_size lower bounds, ascending) that
+   value falls into */
+int grpc_stats_histo_find_bucket(const int *table, int table_size, int value);
+/* Number of samples recorded in histogram */
+size_t grpc_stats_histo_count(const grpc_stats_data *data,
+                              grpc_stats_histograms histogram);
+/* Estimate of the given percentile (0..100) of histogram, interpolating
+   linearly within buckets */
+double grpc_stats_histo_percentile(const grpc_stats_data *data,
+                                   grpc_stats_histograms histogram,
+                                   double percentile);
+
+#endif /* GRPC_CORE_LIB_DEBUG_STATS_H */
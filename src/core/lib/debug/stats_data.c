@@ -0,0 +1,126 @@
+/*
+ * Copyright 2017 gRPC authors.
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Automatically generated by tools/codegen/core/gen_stats_data.py
+ */
+
+#include "src/core/lib/debug/stats_data.h"
+#include "src/core/lib/debug/stats.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+
+const char *grpc_stats_counter_name[GRPC_STATS_COUNTER_COUNT] = {
+  "client_calls_created",
+  "server_calls_created",
+  "server_slowpath_requests_queued",
+  "syscall_poll",
+  "syscall_write",
+  "syscall_read",
+  "tcp_zerocopy_sends",
+  "combiner_locks_initiated",
+  "combiner_locks_scheduled_items",
+  "combiner_locks_scheduled_final_items",
+  "combiner_locks_offloaded",
+  "executor_scheduled_items",
+  "executor_wakeup_initiated",
+  "executor_threads_created",
+  "executor_closures_stolen",
+  "hpack_send_indexed",
+  "hpack_send_lithdr_incidx",
+  "hpack_send_lithdr_incidx_v",
+  "hpack_send_lithdr_notidx",
+  "hpack_send_lithdr_notidx_v",
+  "hpack_send_uncompressed",
+  "hpack_send_huffman",
+  "hpack_send_binary",
+  "hpack_send_binary_base64",
+};
+const char *grpc_stats_counter_doc[GRPC_STATS_COUNTER_COUNT] = {
+  "Number of client side calls created by this process",
+  "Number of server side calls created by this process",
+  "Number of server side calls that found no request waiting and were queued to be matched later",
+  "Number of polling syscalls (epoll_wait, io_uring_enter, ...) made by pollers",
+  "Number of write syscalls (or equivalent - eg sendmsg) made by this process",
+  "Number of read syscalls (or equivalent - eg recvmsg) made by this process",
+  "Number of sendmsg calls made with MSG_ZEROCOPY",
+  "Number of combiner lock entries by process (first items queued to a combiner)",
+  "Number of items scheduled against combiner locks",
+  "Number of final items scheduled against combiner locks",
+  "Number of combiner locks offloaded to different threads",
+  "Number of closures scheduled against the executor",
+  "Number of times an executor thread was woken to run closures",
+  "Number of executor threads started beyond the first",
+  "Number of closures run by an executor thread other than the one they were queued to",
+  "Number of HPACK indexed fields sent (hits in the encoder's table)",
+  "Number of HPACK literal headers sent with an indexed key, added to the table",
+  "Number of HPACK literal headers sent with a literal key, added to the table",
+  "Number of HPACK literal headers sent with an indexed key, not added to the table",
+  "Number of HPACK literal headers sent with a literal key, not added to the table",
+  "Number of uncompressed HPACK values sent",
+  "Number of huffman compressed HPACK values sent",
+  "Number of binary HPACK values sent with true binary metadata",
+  "Number of binary HPACK values sent base64 encoded",
+};
+const char *grpc_stats_histogram_name[GRPC_STATS_HISTOGRAM_COUNT] = {
+  "tcp_write_size",
+  "tcp_write_iov_size",
+  "tcp_read_size",
+  "tcp_read_offer",
+  "executor_queue_depth",
+};
+const char *grpc_stats_histogram_doc[GRPC_STATS_HISTOGRAM_COUNT] = {
+  "Number of bytes offered to each syscall_write",
+  "Number of byte segments offered to each syscall_write",
+  "Number of bytes received by each syscall_read",
+  "Number of bytes offered to each syscall_read",
+  "Depth of the target executor thread's queue as each closure is pushed",
+};
+const int grpc_stats_table_0[32] = {
+    0, 1, 2, 4, 7, 13, 23, 40, 69, 119, 204, 350, 600, 1029, 1764, 3024, 5184,
+    8886, 15231, 26106, 44745, 76691, 131445, 225290, 386135, 661815, 1134316,
+    1944157, 3332181, 5711178, 9788650, 16777216};
+const int grpc_stats_table_1[16] = {
+    0, 1, 2, 4, 7, 12, 19, 30, 47, 73, 114, 177, 275, 427, 662, 1024};
+void grpc_stats_inc_tcp_write_size(grpc_exec_ctx *exec_ctx, int value) {
+  GRPC_STATS_INC_HISTOGRAM((exec_ctx), GRPC_STATS_HISTOGRAM_TCP_WRITE_SIZE,
+                           grpc_stats_histo_find_bucket(
+                               grpc_stats_table_0, 32, value));
+}
+void grpc_stats_inc_tcp_write_iov_size(grpc_exec_ctx *exec_ctx, int value) {
+  GRPC_STATS_INC_HISTOGRAM((exec_ctx), GRPC_STATS_HISTOGRAM_TCP_WRITE_IOV_SIZE,
+                           grpc_stats_histo_find_bucket(
+                               grpc_stats_table_1, 16, value));
+}
+void grpc_stats_inc_tcp_read_size(grpc_exec_ctx *exec_ctx, int value) {
+  GRPC_STATS_INC_HISTOGRAM((exec_ctx), GRPC_STATS_HISTOGRAM_TCP_READ_SIZE,
+                           grpc_stats_histo_find_bucket(
+                               grpc_stats_table_0, 32, value));
+}
+void grpc_stats_inc_tcp_read_offer(grpc_exec_ctx *exec_ctx, int value) {
+  GRPC_STATS_INC_HISTOGRAM((exec_ctx), GRPC_STATS_HISTOGRAM_TCP_READ_OFFER,
+                           grpc_stats_histo_find_bucket(
+                               grpc_stats_table_0, 32, value));
+}
+void grpc_stats_inc_executor_queue_depth(grpc_exec_ctx *exec_ctx, int value) {
+  GRPC_STATS_INC_HISTOGRAM((exec_ctx), GRPC_STATS_HISTOGRAM_EXECUTOR_QUEUE_DEPTH,
+                           grpc_stats_histo_find_bucket(
+                               grpc_stats_table_1, 16, value));
+}
+const int grpc_stats_histo_buckets[5] = {32, 16, 32, 32, 16};
+const int grpc_stats_histo_start[5] = {0, 32, 48, 80, 112};
+const int *const grpc_stats_histo_bucket_boundaries[5] = {
+    grpc_stats_table_0, grpc_stats_table_1, grpc_stats_table_0,
+    grpc_stats_table_0, grpc_stats_table_1};
@@ -39,6 +39,7 @@
 #include <grpc/support/tls.h>
 #include <grpc/support/useful.h>
 
+#include "src/core/lib/debug/stats.h"
 #include "src/core/lib/iomgr/ev_posix.h"
 #include "src/core/lib/iomgr/iomgr_internal.h"
 #include "src/core/lib/iomgr/lockfree_event.h"
@@ -47,9 +48,52 @@
 #include "src/core/lib/support/block_annotate.h"
 #include "src/core/lib/support/string.h"
 
-static grpc_wakeup_fd global_wakeup_fd;
 static int g_epfd;
 
+/*******************************************************************************
+ * Epoll set Declarations
+ */
+
+/* Fds are watched by the epoll set of a neighbourhood, and each set has (at
+ * most) one designated poller at a time. By default all neighbourhoods share a
+ * single set: g_epfd.
+ *
+ * The "epoll1-sharded" engine gives every neighbourhood a set of its own
+ * instead: an fd joins the set of the cpu that creates it (usually the one that
+ * accepted or connected it), so its events get picked up by a poller close to
+ * where its data landed, and pollers on different cpus stop funnelling through
+ * one epoll_wait.
+ *
+ * Fds of a set nobody polls would get stranded, so in sharded mode sets start
+ * out handed over to g_epfd, which then watches the set's own epoll fd, and a
+ * set that loses its designated poller without a successor is handed over
+ * again. While g_epfd watches any set, one designated poller (the fallback
+ * poller) waits on g_epfd rather than on its own set, which it hands over too,
+ * and collects the events of every set g_epfd reports ready. If nobody is the
+ * fallback poller when a set is handed over, the designated poller of another
+ * set gets kicked to take the job on. A set is taken back from g_epfd by the
+ * next designated poller that polls it without being the fallback poller. */
+
+typedef struct epoll_set {
+  int epfd;
+  /* Kicks the designated poller of the set */
+  grpc_wakeup_fd wakeup_fd;
+  /* The designated poller: the actual type stored is (grpc_pollset_worker *) */
+  gpr_atm active_poller;
+  /* Non-zero while g_epfd watches epfd: only changed under g_handover_mu */
+  gpr_atm handed_over;
+  char pad[GPR_CACHELINE_SIZE];
+} epoll_set;
+
+static bool g_sharded;
+static epoll_set *g_epoll_sets;
+static size_t g_num_epoll_sets;
+static gpr_mu g_handover_mu;
+/* Number of sets g_epfd watches */
+static gpr_atm g_num_handed_over;
+/* Non-zero while some designated poller waits on g_epfd for everybody */
+static gpr_atm g_fallback_polling;
+
 /*******************************************************************************
  * Fd Declarations
  */
@@ -61,6 +105,7 @@ struct grpc_fd {
   gpr_atm write_closure;
 
   struct grpc_fd *freelist_next;
+  epoll_set *epoll_set;
 
   /* The pollset that last noticed that the fd is readable. The actual type
    * stored in this is (grpc_pollset *) */
@@ -93,6 +138,7 @@ static const char *kick_state_string(kick_state st) {
 struct grpc_pollset_worker {
   kick_state kick_state;
   int kick_state_mutator;  // which line of code last changed kick state
+  epoll_set *epoll_set;    // the set this worker polls when designated
   bool initialized_cv;
   grpc_pollset_worker *next;
   grpc_pollset_worker *prev;
@@ -111,6 +157,7 @@ struct grpc_pollset_worker {
 typedef struct pollset_neighbourhood {
   gpr_mu mu;
   grpc_pollset *active_root;
+  epoll_set *epoll_set;
   char pad[GPR_CACHELINE_SIZE];
 } pollset_neighbourhood;
 
@@ -157,6 +204,83 @@ static bool append_error(grpc_error **composite, grpc_error *error,
   return false;
 }
 
+/*******************************************************************************
+ * Epoll set Definitions
+ */
+
+static grpc_error *epoll_set_add(epoll_set *set, int fd, uint32_t events,
+                                 void *data_ptr) {
+  struct epoll_event ev = {.events = events, .data.ptr = data_ptr};
+  if (epoll_ctl(set->epfd, EPOLL_CTL_ADD, fd, &ev) != 0) {
+    return GRPC_OS_ERROR(errno, "epoll_ctl");
+  }
+  return GRPC_ERROR_NONE;
+}
+
+static grpc_error *epoll_set_init(epoll_set *set) {
+  gpr_atm_no_barrier_store(&set->active_poller, 0);
+  gpr_atm_no_barrier_store(&set->handed_over, 0);
+  if (g_sharded) {
+    set->epfd = epoll_create1(EPOLL_CLOEXEC);
+    if (set->epfd < 0) return GRPC_OS_ERROR(errno, "epoll_create1");
+  } else {
+    set->epfd = g_epfd;
+  }
+  grpc_error *err = grpc_wakeup_fd_init(&set->wakeup_fd);
+  if (err != GRPC_ERROR_NONE) return err;
+  return epoll_set_add(set, set->wakeup_fd.read_fd,
+                       (uint32_t)(EPOLLIN | EPOLLET), &set->wakeup_fd);
+}
+
+static void epoll_set_destroy(epoll_set *set) {
+  if (set->wakeup_fd.read_fd != -1) grpc_wakeup_fd_destroy(&set->wakeup_fd);
+  if (set->epfd != -1 && set->epfd != g_epfd) close(set->epfd);
+}
+
+static size_t g_num_shards_for_testing;
+static size_t (*g_current_shard_for_testing)(void);
+
+static size_t shard_of_current_thread(void) {
+  return g_current_shard_for_testing != NULL ? g_current_shard_for_testing()
+                                             : (size_t)gpr_cpu_current_cpu();
+}
+
+static epoll_set *choose_epoll_set(void) {
+  return &g_epoll_sets[shard_of_current_thread() % g_num_epoll_sets];
+}
+
+/* Make g_epfd watch set (or stop watching it) */
+static void epoll_set_hand_over(epoll_set *set, bool hand_over) {
+  gpr_mu_lock(&g_handover_mu);
+  if ((gpr_atm_no_barrier_load(&set->handed_over) != 0) != hand_over) {
+    struct epoll_event ev = {.events = EPOLLIN, .data.ptr = set};
+    if (epoll_ctl(g_epfd, hand_over ? EPOLL_CTL_ADD : EPOLL_CTL_DEL, set->epfd,
+                  &ev) == 0) {
+      gpr_atm_no_barrier_store(&set->handed_over, hand_over);
+      gpr_atm_no_barrier_fetch_add(&g_num_handed_over, hand_over ? 1 : -1);
+    } else {
+      gpr_log(GPR_ERROR, "epoll_ctl(g_epfd) failed: %s", strerror(errno));
+    }
+  }
+  gpr_mu_unlock(&g_handover_mu);
+}
+
+/* set lost its designated poller, and nobody took over */
+static grpc_error *epoll_set_abandoned(epoll_set *set) {
+  epoll_set_hand_over(set, true);
+  if (gpr_atm_no_barrier_load(&g_fallback_polling) != 0) {
+    return GRPC_ERROR_NONE;
+  }
+  /* a designated poller becomes the fallback poller the next time it polls */
+  for (size_t i = 0; i < g_num_epoll_sets; i++) {
+    epoll_set *other = &g_epoll_sets[i];
+    if (other != set && gpr_atm_no_barrier_load(&other->active_poller) != 0) {
+      return grpc_wakeup_fd_wakeup(&other->wakeup_fd);
+    }
+  }
+  return GRPC_ERROR_NONE;
+}
+
 /*******************************************************************************
  * Fd Definitions
  */
@@ -226,11 +350,11 @@ static grpc_fd *fd_create(int fd, const char *name) {
 #endif
   gpr_free(fd_name);
 
-  struct epoll_event ev = {.events = (uint32_t)(EPOLLIN | EPOLLOUT | EPOLLET),
-                           .data.ptr = new_fd};
-  if (epoll_ctl(g_epfd, EPOLL_CTL_ADD, fd, &ev) != 0) {
-    gpr_log(GPR_ERROR, "epoll_ctl failed: %s", strerror(errno));
-  }
+  new_fd->epoll_set = choose_epoll_set();
+  GRPC_LOG_IF_ERROR(
+      "fd_create",
+      epoll_set_add(new_fd->epoll_set, fd,
+                    (uint32_t)(EPOLLIN | EPOLLOUT | EPOLLET), new_fd));
 
   return new_fd;
 }
@@ -313,7 +437,6 @@ static void fd_become_writable(grpc_exec_ctx *exec_ctx, grpc_fd *fd) {
 
 GPR_TLS_DECL(g_current_thread_pollset);
 GPR_TLS_DECL(g_current_thread_worker);
-static gpr_atm g_active_poller;
 static pollset_neighbourhood *g_neighbourhoods;
 static size_t g_num_neighbourhoods;
 
@@ -355,26 +478,35 @@ static worker_remove_result worker_remove(grpc_pollset *pollset,
 }
 
 static size_t choose_neighbourhood(void) {
-  return (size_t)gpr_cpu_current_cpu() % g_num_neighbourhoods;
+  return shard_of_current_thread() % g_num_neighbourhoods;
 }
 
 static grpc_error *pollset_global_init(void) {
   gpr_tls_init(&g_current_thread_pollset);
   gpr_tls_init(&g_current_thread_worker);
-  gpr_atm_no_barrier_store(&g_active_poller, 0);
-  global_wakeup_fd.read_fd = -1;
-  grpc_error *err = grpc_wakeup_fd_init(&global_wakeup_fd);
-  if (err != GRPC_ERROR_NONE) return err;
-  struct epoll_event ev = {.events = (uint32_t)(EPOLLIN | EPOLLET),
-                           .data.ptr = &global_wakeup_fd};
-  if (epoll_ctl(g_epfd, EPOLL_CTL_ADD, global_wakeup_fd.read_fd, &ev) != 0) {
-    return GRPC_OS_ERROR(errno, "epoll_ctl");
+  gpr_mu_init(&g_handover_mu);
+  gpr_atm_no_barrier_store(&g_num_handed_over, 0);
+  gpr_atm_no_barrier_store(&g_fallback_polling, 0);
+  g_num_neighbourhoods = GPR_CLAMP(g_num_shards_for_testing != 0
+                                       ? g_num_shards_for_testing
+                                       : (size_t)gpr_cpu_num_cores(),
+                                   1, MAX_NEIGHBOURHOODS);
+  g_num_epoll_sets = g_sharded ? g_num_neighbourhoods : 1;
+  g_epoll_sets = gpr_zalloc(sizeof(*g_epoll_sets) * g_num_epoll_sets);
+  for (size_t i = 0; i < g_num_epoll_sets; i++) {
+    g_epoll_sets[i].epfd = -1;
+    g_epoll_sets[i].wakeup_fd.read_fd = -1;
   }
-  g_num_neighbourhoods = GPR_CLAMP(gpr_cpu_num_cores(), 1, MAX_NEIGHBOURHOODS);
   g_neighbourhoods =
       gpr_zalloc(sizeof(*g_neighbourhoods) * g_num_neighbourhoods);
   for (size_t i = 0; i < g_num_neighbourhoods; i++) {
     gpr_mu_init(&g_neighbourhoods[i].mu);
+    g_neighbourhoods[i].epoll_set = &g_epoll_sets[i % g_num_epoll_sets];
+  }
+  for (size_t i = 0; i < g_num_epoll_sets; i++) {
+    grpc_error *err = epoll_set_init(&g_epoll_sets[i]);
+    if (err != GRPC_ERROR_NONE) return err;
+    if (g_sharded) epoll_set_hand_over(&g_epoll_sets[i], true);
   }
   return GRPC_ERROR_NONE;
 }
@@ -382,11 +514,15 @@ static grpc_error *pollset_global_init(void) {
 static void pollset_global_shutdown(void) {
   gpr_tls_destroy(&g_current_thread_pollset);
   gpr_tls_destroy(&g_current_thread_worker);
-  if (global_wakeup_fd.read_fd != -1) grpc_wakeup_fd_destroy(&global_wakeup_fd);
+  for (size_t i = 0; i < g_num_epoll_sets; i++) {
+    epoll_set_destroy(&g_epoll_sets[i]);
+  }
+  gpr_free(g_epoll_sets);
   for (size_t i = 0; i < g_num_neighbourhoods; i++) {
     gpr_mu_destroy(&g_neighbourhoods[i].mu);
   }
   gpr_free(g_neighbourhoods);
+  gpr_mu_destroy(&g_handover_mu);
 }
 
 static void pollset_init(grpc_pollset *pollset, gpr_mu **mu) {
@@ -440,7 +576,8 @@ static grpc_error *pollset_kick_all(grpc_pollset *pollset) {
           break;
         case DESIGNATED_POLLER:
           SET_KICK_STATE(worker, KICKED);
-          append_error(&error, grpc_wakeup_fd_wakeup(&global_wakeup_fd),
+          append_error(&error,
+                       grpc_wakeup_fd_wakeup(&worker->epoll_set->wakeup_fd),
                        "pollset_kick_all");
           break;
       }
@@ -493,46 +630,101 @@ static int poll_deadline_to_millis_timeout(gpr_timespec deadline,
   return millis >= 1 ? millis : 1;
 }
 
+/* Process the events of ready, a set that pollset's designated poller for set
+ * (its own set) polled, directly or through g_epfd */
+static void process_epoll_events(grpc_exec_ctx *exec_ctx, grpc_pollset *pollset,
+                                 epoll_set *set, epoll_set *ready,
+                                 struct epoll_event *events, int num_events,
+                                 grpc_error **error) {
+  static const char *err_desc = "pollset_poll";
+  for (int i = 0; i < num_events; i++) {
+    void *data_ptr = events[i].data.ptr;
+    if (data_ptr == &ready->wakeup_fd) {
+      if (ready == set || gpr_atm_no_barrier_load(&ready->active_poller) == 0) {
+        append_error(error, grpc_wakeup_fd_consume_wakeup(&ready->wakeup_fd),
+                     err_desc);
+      } else {
+        /* a kick meant for the designated poller of another set, which is
+           taking its set back: re-arm the wakeup fd for it to see */
+        struct epoll_event ev = {.events = (uint32_t)(EPOLLIN | EPOLLET),
+                                 .data.ptr = data_ptr};
+        if (epoll_ctl(ready->epfd, EPOLL_CTL_MOD, ready->wakeup_fd.read_fd,
+                      &ev) != 0) {
+          append_error(error, GRPC_OS_ERROR(errno, "epoll_ctl"), err_desc);
+        }
+      }
+    } else {
+      grpc_fd *fd = (grpc_fd *)(data_ptr);
+      bool cancel = (events[i].events & (EPOLLERR | EPOLLHUP)) != 0;
+      bool read_ev = (events[i].events & (EPOLLIN | EPOLLPRI)) != 0;
+      bool write_ev = (events[i].events & EPOLLOUT) != 0;
+      if (read_ev || cancel) {
+        fd_become_readable(exec_ctx, fd, pollset);
+      }
+      if (write_ev || cancel) {
+        fd_become_writable(exec_ctx, fd);
+      }
+    }
+  }
+}
+
 static grpc_error *pollset_epoll(grpc_exec_ctx *exec_ctx, grpc_pollset *pollset,
-                                 gpr_timespec now, gpr_timespec deadline) {
+                                 epoll_set *set, gpr_timespec now,
+                                 gpr_timespec deadline) {
   struct epoll_event events[MAX_EPOLL_EVENTS];
-  static const char *err_desc = "pollset_poll";
 
   int timeout = poll_deadline_to_millis_timeout(deadline, now);
 
+  int epfd = set->epfd;
+  bool fallback = false;
+  if (g_sharded && timeout != 0) {
+    if (gpr_atm_no_barrier_load(&g_num_handed_over) > 0 &&
+        gpr_atm_no_barrier_cas(&g_fallback_polling, 0, 1)) {
+      /* hand our own set over as well, to keep seeing its events and kicks */
+      epoll_set_hand_over(set, true);
+      fallback = true;
+      epfd = g_epfd;
+    } else if (gpr_atm_no_barrier_load(&set->handed_over) != 0) {
+      epoll_set_hand_over(set, false);
+    }
+  }
+
   if (timeout != 0) {
     GRPC_SCHEDULING_START_BLOCKING_REGION;
   }
   int r;
   do {
-    r = epoll_wait(g_epfd, events, MAX_EPOLL_EVENTS, timeout);
+    GRPC_STATS_INC_SYSCALL_POLL(exec_ctx);
+    r = epoll_wait(epfd, events, MAX_EPOLL_EVENTS, timeout);
   } while (r < 0 && errno == EINTR);
   if (timeout != 0) {
     GRPC_SCHEDULING_END_BLOCKING_REGION;
   }
+  if (fallback) {
+    gpr_atm_no_barrier_store(&g_fallback_polling, 0);
+  }
 
   if (r < 0) return GRPC_OS_ERROR(errno, "epoll_wait");
 
   grpc_error *error = GRPC_ERROR_NONE;
+  if (!fallback) {
+    process_epoll_events(exec_ctx, pollset, set, set, events, r, &error);
+    return error;
+  }
+  /* g_epfd reports sets with events pending: collect them */
   for (int i = 0; i < r; i++) {
-    void *data_ptr = events[i].data.ptr;
-    if (data_ptr == &global_wakeup_fd) {
-      append_error(&error, grpc_wakeup_fd_consume_wakeup(&global_wakeup_fd),
-                   err_desc);
-    } else {
-      grpc_fd *fd = (grpc_fd *)(data_ptr);
-      bool cancel = (events[i].events & (EPOLLERR | EPOLLHUP)) != 0;
-      bool read_ev = (events[i].events & (EPOLLIN | EPOLLPRI)) != 0;
-      bool write_ev = (events[i].events & EPOLLOUT) != 0;
-      if (read_ev || cancel) {
-        fd_become_readable(exec_ctx, fd, pollset);
-      }
-      if (write_ev || cancel) {
-        fd_become_writable(exec_ctx, fd);
-      }
+    epoll_set *ready = events[i].data.ptr;
+    struct epoll_event set_events[MAX_EPOLL_EVENTS];
+    int n;
+    do {
+      n = epoll_wait(ready->epfd, set_events, MAX_EPOLL_EVENTS, 0);
+    } while (n < 0 && errno == EINTR);
+    if (n < 0) {
+      append_error(&error, GRPC_OS_ERROR(errno, "epoll_wait"), "pollset_poll");
+      continue;
     }
+    process_epoll_events(exec_ctx, pollset, set, ready, set_events, n, &error);
   }
-
   return error;
 }
 
@@ -542,6 +734,7 @@ static bool begin_worker(grpc_pollset *pollset, grpc_pollset_worker *worker,
   if (worker_hdl != NULL) *worker_hdl = worker;
   worker->initialized_cv = false;
   SET_KICK_STATE(worker, UNKICKED);
+  worker->epoll_set = pollset->neighbourhood->epoll_set;
   worker->schedule_on_end_work = (grpc_closure_list)GRPC_CLOSURE_LIST_INIT;
   pollset->begin_refs++;
 
@@ -577,6 +770,7 @@ static bool begin_worker(grpc_pollset *pollset, grpc_pollset_worker *worker,
         goto retry_lock_neighbourhood;
       }
       pollset->seen_inactive = false;
+      worker->epoll_set = neighbourhood->epoll_set;
       if (neighbourhood->active_root == NULL) {
         neighbourhood->active_root = pollset->next = pollset->prev = pollset;
         /* TODO: sreek. Why would this worker state be other than UNKICKED
@@ -585,7 +779,8 @@ static bool begin_worker(grpc_pollset *pollset, grpc_pollset_worker *worker,
 
         /* If there is no designated poller, make this the designated poller */
         if (worker->kick_state == UNKICKED &&
-            gpr_atm_no_barrier_cas(&g_active_poller, 0, (gpr_atm)worker)) {
+            gpr_atm_no_barrier_cas(&worker->epoll_set->active_poller, 0,
+                                   (gpr_atm)worker)) {
           SET_KICK_STATE(worker, DESIGNATED_POLLER);
         }
       } else {
@@ -604,7 +799,8 @@ static bool begin_worker(grpc_pollset *pollset, grpc_pollset_worker *worker,
   worker_insert(pollset, worker);
   pollset->begin_refs--;
   if (worker->kick_state == UNKICKED && !pollset->kicked_without_poller) {
-    GPR_ASSERT(gpr_atm_no_barrier_load(&g_active_poller) != (gpr_atm)worker);
+    GPR_ASSERT(gpr_atm_no_barrier_load(&worker->epoll_set->active_poller) !=
+               (gpr_atm)worker);
     worker->initialized_cv = true;
     gpr_cv_init(&worker->cv);
     while (worker->kick_state == UNKICKED && !pollset->shutting_down) {
@@ -664,8 +860,8 @@ static bool check_neighbourhood_for_available_poller(
       do {
         switch (inspect_worker->kick_state) {
           case UNKICKED:
-            if (gpr_atm_no_barrier_cas(&g_active_poller, 0,
-                                       (gpr_atm)inspect_worker)) {
+            if (gpr_atm_no_barrier_cas(&neighbourhood->epoll_set->active_poller,
+                                       0, (gpr_atm)inspect_worker)) {
               if (GRPC_TRACER_ON(grpc_polling_trace)) {
                 gpr_log(GPR_DEBUG, " .. choose next poller to be %p",
                         inspect_worker);
@@ -721,13 +917,17 @@ static void end_worker(grpc_exec_ctx *exec_ctx, grpc_pollset *pollset,
   SET_KICK_STATE(worker, KICKED);
   grpc_closure_list_move(&worker->schedule_on_end_work,
                          &exec_ctx->closure_list);
-  if (gpr_atm_no_barrier_load(&g_active_poller) == (gpr_atm)worker) {
+  epoll_set *set = worker->epoll_set;
+  if (gpr_atm_no_barrier_load(&set->active_poller) == (gpr_atm)worker) {
     if (worker->next != worker && worker->next->kick_state == UNKICKED) {
       if (GRPC_TRACER_ON(grpc_polling_trace)) {
         gpr_log(GPR_DEBUG, " .. choose next poller to be peer %p", worker);
       }
       GPR_ASSERT(worker->next->initialized_cv);
-      gpr_atm_no_barrier_store(&g_active_poller, (gpr_atm)worker->next);
+      /* the pollset may have moved to another neighbourhood (and set) since
+         this worker began: the peer takes over polling this worker's set */
+      worker->next->epoll_set = set;
+      gpr_atm_no_barrier_store(&set->active_poller, (gpr_atm)worker->next);
       SET_KICK_STATE(worker->next, DESIGNATED_POLLER);
       gpr_cv_signal(&worker->next->cv);
       if (grpc_exec_ctx_has_work(exec_ctx)) {
@@ -736,7 +936,7 @@ static void end_worker(grpc_exec_ctx *exec_ctx, grpc_pollset *pollset,
         gpr_mu_lock(&pollset->mu);
       }
     } else {
-      gpr_atm_no_barrier_store(&g_active_poller, 0);
+      gpr_atm_no_barrier_store(&set->active_poller, 0);
       size_t poller_neighbourhood_idx =
           (size_t)(pollset->neighbourhood - g_neighbourhoods);
       gpr_mu_unlock(&pollset->mu);
@@ -746,7 +946,10 @@ static void end_worker(grpc_exec_ctx *exec_ctx, grpc_pollset *pollset,
         pollset_neighbourhood *neighbourhood =
             &g_neighbourhoods[(poller_neighbourhood_idx + i) %
                               g_num_neighbourhoods];
-        if (gpr_mu_trylock(&neighbourhood->mu)) {
+        if (neighbourhood->epoll_set != set) {
+          /* its pollers could not take over polling this set */
+          scan_state[i] = true;
+        } else if (gpr_mu_trylock(&neighbourhood->mu)) {
           found_worker =
               check_neighbourhood_for_available_poller(neighbourhood);
           gpr_mu_unlock(&neighbourhood->mu);
@@ -764,6 +967,9 @@ static void end_worker(grpc_exec_ctx *exec_ctx, grpc_pollset *pollset,
         found_worker = check_neighbourhood_for_available_poller(neighbourhood);
         gpr_mu_unlock(&neighbourhood->mu);
       }
+      if (!found_worker && g_sharded) {
+        GRPC_LOG_IF_ERROR("epoll_set_abandoned", epoll_set_abandoned(set));
+      }
       grpc_exec_ctx_flush(exec_ctx);
       gpr_mu_lock(&pollset->mu);
     }
@@ -781,7 +987,7 @@ static void end_worker(grpc_exec_ctx *exec_ctx, grpc_pollset *pollset,
   if (EMPTIED == worker_remove(pollset, worker)) {
     pollset_maybe_finish_shutdown(exec_ctx, pollset);
   }
-  GPR_ASSERT(gpr_atm_no_barrier_load(&g_active_poller) != (gpr_atm)worker);
+  GPR_ASSERT(gpr_atm_no_barrier_load(&set->active_poller) != (gpr_atm)worker);
 }
 
 /* pollset->po.mu lock must be held by the caller before calling this.
@@ -804,8 +1010,10 @@ static grpc_error *pollset_work(grpc_exec_ctx *exec_ctx, grpc_pollset *pollset,
     GPR_ASSERT(!pollset->shutting_down);
     GPR_ASSERT(!pollset->seen_inactive);
     gpr_mu_unlock(&pollset->mu);
-    append_error(&error, pollset_epoll(exec_ctx, pollset, now, deadline),
-                 err_desc);
+    append_error(
+        &error,
+        pollset_epoll(exec_ctx, pollset, worker.epoll_set, now, deadline),
+        err_desc);
     gpr_mu_lock(&pollset->mu);
     gpr_tls_set(&g_current_thread_worker, 0);
   } else {
@@ -871,12 +1079,12 @@ static grpc_error *pollset_kick(grpc_pollset *pollset,
                      next_worker &&  // only try and wake up a poller if
                                      // there is no next worker
                  root_worker == (grpc_pollset_worker *)gpr_atm_no_barrier_load(
-                                    &g_active_poller)) {
+                                    &root_worker->epoll_set->active_poller)) {
         if (GRPC_TRACER_ON(grpc_polling_trace)) {
           gpr_log(GPR_ERROR, " .. kicked %p", root_worker);
         }
         SET_KICK_STATE(root_worker, KICKED);
-        return grpc_wakeup_fd_wakeup(&global_wakeup_fd);
+        return grpc_wakeup_fd_wakeup(&root_worker->epoll_set->wakeup_fd);
       } else if (next_worker->kick_state == UNKICKED) {
         if (GRPC_TRACER_ON(grpc_polling_trace)) {
           gpr_log(GPR_ERROR, " .. kicked %p", next_worker);
@@ -904,7 +1112,7 @@ static grpc_error *pollset_kick(grpc_pollset *pollset,
                     root_worker);
           }
           SET_KICK_STATE(next_worker, KICKED);
-          return grpc_wakeup_fd_wakeup(&global_wakeup_fd);
+          return grpc_wakeup_fd_wakeup(&next_worker->epoll_set->wakeup_fd);
         }
       } else {
         GPR_ASSERT(next_worker->kick_state == KICKED);
@@ -930,12 +1138,13 @@ static grpc_error *pollset_kick(grpc_pollset *pollset,
     SET_KICK_STATE(specific_worker, KICKED);
     return GRPC_ERROR_NONE;
   } else if (specific_worker ==
-             (grpc_pollset_worker *)gpr_atm_no_barrier_load(&g_active_poller)) {
+             (grpc_pollset_worker *)gpr_atm_no_barrier_load(
+                 &specific_worker->epoll_set->active_poller)) {
     if (GRPC_TRACER_ON(grpc_polling_trace)) {
       gpr_log(GPR_ERROR, " .. kick active poller");
     }
     SET_KICK_STATE(specific_worker, KICKED);
-    return grpc_wakeup_fd_wakeup(&global_wakeup_fd);
+    return grpc_wakeup_fd_wakeup(&specific_worker->epoll_set->wakeup_fd);
   } else if (specific_worker->initialized_cv) {
     if (GRPC_TRACER_ON(grpc_polling_trace)) {
       gpr_log(GPR_ERROR, " .. kick waiting worker");
@@ -1029,11 +1238,13 @@ static const grpc_event_engine_vtable vtable = {
 
 /* It is possible that GLIBC has epoll but the underlying kernel doesn't.
  * Create a dummy epoll_fd to make sure epoll support is available */
-const grpc_event_engine_vtable *grpc_init_epoll1_linux(bool explicit_request) {
+static const grpc_event_engine_vtable *init_epoll1_linux(bool sharded) {
   if (!grpc_has_wakeup_fd()) {
     return NULL;
   }
 
+  g_sharded = sharded;
+
   g_epfd = epoll_create1(EPOLL_CLOEXEC);
   if (g_epfd < 0) {
     gpr_log(GPR_ERROR, "epoll unavailable");
@@ -1043,6 +1254,7 @@ const grpc_event_engine_vtable *grpc_init_epoll1_linux(bool explicit_request) {
   fd_global_init();
 
   if (!GRPC_LOG_IF_ERROR("pollset_global_init", pollset_global_init())) {
+    pollset_global_shutdown();
     close(g_epfd);
     fd_global_shutdown();
     return NULL;
@@ -1053,6 +1265,21 @@ const grpc_event_engine_vtable *grpc_init_epoll1_linux(bool explicit_request) {
   return &vtable;
 }
 
+const grpc_event_engine_vtable *grpc_init_epoll1_linux(bool explicit_request) {
+  return init_epoll1_linux(false);
+}
+
+const grpc_event_engine_vtable *grpc_init_epoll1_sharded_linux(
+    bool explicit_request) {
+  return init_epoll1_linux(true);
+}
+
+void grpc_epoll1_set_shards_for_testing(size_t num_shards,
+                                        size_t (*current_shard)(void)) {
+  g_num_shards_for_testing = num_shards;
+  g_current_shard_for_testing = current_shard;
+}
+
 #else /* defined(GRPC_LINUX_EPOLL) */
 #if defined(GRPC_POSIX_SOCKET)
 #include "src/core/lib/iomgr/ev_posix.h"
@@ -1061,5 +1288,13 @@ const grpc_event_engine_vtable *grpc_init_epoll1_linux(bool explicit_request) {
 const grpc_event_engine_vtable *grpc_init_epoll1_linux(bool explicit_request) {
   return NULL;
 }
+
+const grpc_event_engine_vtable *grpc_init_epoll1_sharded_linux(
+    bool explicit_request) {
+  return NULL;
+}
+
+void grpc_epoll1_set_shards_for_testing(size_t num_shards,
+                                        size_t (*current_shard)(void)) {}
 #endif /* defined(GRPC_POSIX_SOCKET) */
 #endif /* !defined(GRPC_LINUX_EPOLL) */
@@ -26,4 +26,16 @@
 
 const grpc_event_engine_vtable *grpc_init_epoll1_linux(bool explicit_request);
 
+// the same, with an epoll set (and turnstile) per neighbourhood of cpus
+
+const grpc_event_engine_vtable *grpc_init_epoll1_sharded_linux(
+    bool explicit_request);
+
+// test only: use num_shards neighbourhoods, and in sharded mode as many epoll
+// sets, and place new fds and pollsets by current_shard() rather than by the
+// current cpu. Call before the engine is initialized
+
+void grpc_epoll1_set_shards_for_testing(size_t num_shards,
+                                        size_t (*current_shard)(void));
+
 #endif /* GRPC_CORE_LIB_IOMGR_EV_EPOLL1_LINUX_H */
@@ -18,6 +18,7 @@
 
 #include "src/core/lib/iomgr/exec_ctx.h"
 
+#include <grpc/support/cpu.h>
 #include <grpc/support/log.h>
 #include <grpc/support/sync.h>
 #include <grpc/support/thd.h>
@@ -46,6 +47,12 @@ bool grpc_always_ready_to_finish(grpc_exec_ctx *exec_ctx, void *arg_ignored) {
   return true;
 }
 
+unsigned grpc_exec_ctx_lookup_starting_cpu(grpc_exec_ctx *exec_ctx) {
+  /* cpu ids need not be dense: fold them into [0, num_cores) */
+  exec_ctx->starting_cpu = gpr_cpu_current_cpu() % gpr_cpu_num_cores();
+  return exec_ctx->starting_cpu;
+}
+
 bool grpc_exec_ctx_has_work(grpc_exec_ctx *exec_ctx) {
   return exec_ctx->active_combiner != NULL ||
          !grpc_closure_list_empty(exec_ctx->closure_list);
@@ -64,12 +64,20 @@ struct grpc_exec_ctx {
   uintptr_t flags;
   void *check_ready_to_finish_arg;
   bool (*check_ready_to_finish)(grpc_exec_ctx *exec_ctx, void *arg);
+  /** cpu the first user of GRPC_EXEC_CTX_STARTING_CPU ran on, in
+      [0, gpr_cpu_num_cores()): GRPC_EXEC_CTX_UNKNOWN_CPU until then */
+  unsigned starting_cpu;
 };
 
+#define GRPC_EXEC_CTX_UNKNOWN_CPU ((unsigned)-1)
+
 /* initializer for grpc_exec_ctx:
    prefer to use GRPC_EXEC_CTX_INIT whenever possible */
 #define GRPC_EXEC_CTX_INITIALIZER(flags, finish_check, finish_check_arg) \
-  { GRPC_CLOSURE_LIST_INIT, NULL, NULL, flags, finish_check_arg, finish_check }
+  {                                                                      \
+    GRPC_CLOSURE_LIST_INIT, NULL, NULL, flags, finish_check_arg,         \
+        finish_check, GRPC_EXEC_CTX_UNKNOWN_CPU                          \
+  }
 
 /* initialize an execution context at the top level of an API call into grpc
    (this is safe to use elsewhere, though possibly not as efficient) */
@@ -96,6 +104,16 @@ bool grpc_never_ready_to_finish(grpc_exec_ctx *exec_ctx, void *arg_ignored);
 /** A finish check that is always ready to finish */
 bool grpc_always_ready_to_finish(grpc_exec_ctx *exec_ctx, void *arg_ignored);
 
+/** Looks up (and caches) exec_ctx->starting_cpu: use
+    GRPC_EXEC_CTX_STARTING_CPU instead */
+unsigned grpc_exec_ctx_lookup_starting_cpu(grpc_exec_ctx *exec_ctx);
+/** A cpu index in [0, gpr_cpu_num_cores()) that this exec_ctx ran on: stable
+    for the exec_ctx's lifetime, so usable to shard per-cpu state */
+#define GRPC_EXEC_CTX_STARTING_CPU(exec_ctx)                   \
+  ((exec_ctx)->starting_cpu != GRPC_EXEC_CTX_UNKNOWN_CPU       \
+       ? (exec_ctx)->starting_cpu                              \
+       : grpc_exec_ctx_lookup_starting_cpu(exec_ctx))
+
 void grpc_exec_ctx_global_init(void);
 
 void grpc_exec_ctx_global_init(void);
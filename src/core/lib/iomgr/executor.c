@@ -28,17 +28,25 @@
 #include <grpc/support/tls.h>
 #include <grpc/support/useful.h>
 
+#include "src/core/lib/debug/stats.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/support/mpscq.h"
 #include "src/core/lib/support/spinlock.h"
 
 #define MAX_DEPTH 2
 
 typedef struct {
+  /* closures pushed to this thread: pushing never blocks, and when this
+     thread is busy, idle threads steal from the queue */
+  gpr_locked_mpscq queue;
+  /* closures in queue that no thread has popped yet */
+  gpr_atm depth;
+  /* mu and cv are only used to park the thread while it has nothing to do:
+     pushers take mu only if sleeping is set */
   gpr_mu mu;
   gpr_cv cv;
-  grpc_closure_list elems;
-  size_t depth;
-  bool shutdown;
+  gpr_atm sleeping;
+  gpr_atm shutdown;
   gpr_thd_id id;
 } thread_state;
 
@@ -51,23 +59,56 @@ GPR_TLS_DECL(g_this_thread_state);
 
 static void executor_thread(void *arg);
 
-static size_t run_closures(grpc_exec_ctx *exec_ctx, grpc_closure_list list) {
-  size_t n = 0;
-
-  grpc_closure *c = list.head;
-  while (c != NULL) {
-    grpc_closure *next = c->next_data.next;
-    grpc_error *error = c->error_data.error;
+static void run_closure(grpc_exec_ctx *exec_ctx, grpc_closure *c) {
+  grpc_error *error = c->error_data.error;
 #ifndef NDEBUG
-    c->scheduled = false;
+  c->scheduled = false;
 #endif
-    c->cb(exec_ctx, c->cb_arg, error);
-    GRPC_ERROR_UNREF(error);
-    c = next;
-    n++;
+  c->cb(exec_ctx, c->cb_arg, error);
+  GRPC_ERROR_UNREF(error);
+}
+
+/* Pops the oldest closure queued on ts: if \a steal is set, gives up rather
+   than wait for another thread popping the same queue */
+static grpc_closure *pop_closure(thread_state *ts, bool steal) {
+  if (gpr_atm_acq_load(&ts->depth) == 0) return NULL;
+  grpc_closure *c =
+      (grpc_closure *)(steal ? gpr_locked_mpscq_try_pop(&ts->queue)
+                             : gpr_locked_mpscq_pop(&ts->queue));
+  if (c != NULL) {
+    gpr_atm_full_fetch_add(&ts->depth, -1);
+  }
+  return c;
+}
+
+/* Takes a closure from some other thread's queue, starting with the thread
+   after ts so that thieves spread out over their victims */
+static grpc_closure *steal_closure(thread_state *ts) {
+  size_t cur_threads = (size_t)gpr_atm_no_barrier_load(&g_cur_threads);
+  size_t me = (size_t)(ts - g_thread_state);
+  for (size_t i = 1; i < cur_threads; i++) {
+    grpc_closure *c =
+        pop_closure(&g_thread_state[(me + i) % cur_threads], true);
+    if (c != NULL) return c;
   }
+  return NULL;
+}
+
+static void wake_thread(thread_state *ts) {
+  gpr_mu_lock(&ts->mu);
+  gpr_cv_signal(&ts->cv);
+  gpr_mu_unlock(&ts->mu);
+}
 
-  return n;
+/* Wakes some sleeping thread to steal work: returns false if all are busy */
+static bool wake_idle_thread(size_t cur_threads) {
+  for (size_t i = 0; i < cur_threads; i++) {
+    if (gpr_atm_acq_load(&g_thread_state[i].sleeping)) {
+      wake_thread(&g_thread_state[i]);
+      return true;
+    }
+  }
+  return false;
 }
 
 bool grpc_executor_is_threaded() {
@@ -83,9 +124,9 @@ void grpc_executor_set_threading(grpc_exec_ctx *exec_ctx, bool threading) {
     gpr_tls_init(&g_this_thread_state);
     g_thread_state = gpr_zalloc(sizeof(thread_state) * g_max_threads);
     for (size_t i = 0; i < g_max_threads; i++) {
+      gpr_locked_mpscq_init(&g_thread_state[i].queue);
       gpr_mu_init(&g_thread_state[i].mu);
       gpr_cv_init(&g_thread_state[i].cv);
-      g_thread_state[i].elems = (grpc_closure_list)GRPC_CLOSURE_LIST_INIT;
     }
 
     gpr_thd_options opt = gpr_thd_options_default();
@@ -96,7 +137,7 @@ void grpc_executor_set_threading(grpc_exec_ctx *exec_ctx, bool threading) {
     if (cur_threads == 0) return;
     for (size_t i = 0; i < g_max_threads; i++) {
       gpr_mu_lock(&g_thread_state[i].mu);
-      g_thread_state[i].shutdown = true;
+      gpr_atm_no_barrier_store(&g_thread_state[i].shutdown, 1);
       gpr_cv_signal(&g_thread_state[i].cv);
       gpr_mu_unlock(&g_thread_state[i].mu);
     }
@@ -109,9 +150,13 @@ void grpc_executor_set_threading(grpc_exec_ctx *exec_ctx, bool threading) {
     }
     gpr_atm_no_barrier_store(&g_cur_threads, 0);
     for (size_t i = 0; i < g_max_threads; i++) {
+      grpc_closure *c;
+      while ((c = pop_closure(&g_thread_state[i], false)) != NULL) {
+        run_closure(exec_ctx, c);
+      }
+      gpr_locked_mpscq_destroy(&g_thread_state[i].queue);
       gpr_mu_destroy(&g_thread_state[i].mu);
       gpr_cv_destroy(&g_thread_state[i].cv);
-      run_closures(exec_ctx, g_thread_state[i].elems);
     }
     gpr_free(g_thread_state);
     gpr_tls_destroy(&g_this_thread_state);
@@ -134,23 +179,28 @@ static void executor_thread(void *arg) {
   grpc_exec_ctx exec_ctx =
       GRPC_EXEC_CTX_INITIALIZER(0, grpc_never_ready_to_finish, NULL);
 
-  size_t subtract_depth = 0;
   for (;;) {
+    if (gpr_atm_no_barrier_load(&ts->shutdown)) break;
+    grpc_closure *c = pop_closure(ts, false);
+    if (c == NULL) {
+      c = steal_closure(ts);
+      if (c != NULL) GRPC_STATS_INC_EXECUTOR_CLOSURES_STOLEN(&exec_ctx);
+    }
+    if (c != NULL) {
+      run_closure(&exec_ctx, c);
+      grpc_exec_ctx_flush(&exec_ctx);
+      continue;
+    }
     gpr_mu_lock(&ts->mu);
-    ts->depth -= subtract_depth;
-    while (grpc_closure_list_empty(ts->elems) && !ts->shutdown) {
+    /* pairs with the barrier after a push bumps depth: either the pusher
+       sees sleeping set and signals, or we see its closure here */
+    gpr_atm_full_xchg(&ts->sleeping, 1);
+    if (gpr_atm_acq_load(&ts->depth) == 0 &&
+        !gpr_atm_no_barrier_load(&ts->shutdown)) {
       gpr_cv_wait(&ts->cv, &ts->mu, gpr_inf_future(GPR_CLOCK_REALTIME));
     }
-    if (ts->shutdown) {
-      gpr_mu_unlock(&ts->mu);
-      break;
-    }
-    grpc_closure_list exec = ts->elems;
-    ts->elems = (grpc_closure_list)GRPC_CLOSURE_LIST_INIT;
+    gpr_atm_no_barrier_store(&ts->sleeping, 0);
     gpr_mu_unlock(&ts->mu);
-
-    subtract_depth = run_closures(&exec_ctx, exec);
-    grpc_exec_ctx_flush(&exec_ctx);
   }
   grpc_exec_ctx_finish(&exec_ctx);
 }
@@ -166,18 +216,29 @@ static void executor_push(grpc_exec_ctx *exec_ctx, grpc_closure *closure,
   if (ts == NULL) {
     ts = &g_thread_state[GPR_HASH_POINTER(exec_ctx, cur_thread_count)];
   }
-  gpr_mu_lock(&ts->mu);
-  if (grpc_closure_list_empty(ts->elems)) {
-    gpr_cv_signal(&ts->cv);
+  GRPC_STATS_INC_EXECUTOR_SCHEDULED_ITEMS(exec_ctx);
+  closure->error_data.error = error;
+  gpr_locked_mpscq_push(&ts->queue, &closure->next_data.atm_next);
+  size_t depth = (size_t)gpr_atm_full_fetch_add(&ts->depth, 1) + 1;
+  GRPC_STATS_INC_EXECUTOR_QUEUE_DEPTH(exec_ctx, depth);
+  if (gpr_atm_acq_load(&ts->sleeping)) {
+    GRPC_STATS_INC_EXECUTOR_WAKEUP_INITIATED(exec_ctx);
+    wake_thread(ts);
+    return;
   }
-  grpc_closure_list_append(&ts->elems, closure, error);
-  ts->depth++;
-  bool try_new_thread = ts->depth > MAX_DEPTH &&
-                        cur_thread_count < g_max_threads && !ts->shutdown;
-  gpr_mu_unlock(&ts->mu);
+  /* ts is busy: have an idle thread steal the backlog, or failing that add a
+     thread to do so */
+  if (depth <= MAX_DEPTH) return;
+  if (wake_idle_thread(cur_thread_count)) {
+    GRPC_STATS_INC_EXECUTOR_WAKEUP_INITIATED(exec_ctx);
+    return;
+  }
+  bool try_new_thread = cur_thread_count < g_max_threads &&
+                        !gpr_atm_no_barrier_load(&ts->shutdown);
   if (try_new_thread && gpr_spinlock_trylock(&g_adding_thread_lock)) {
     cur_thread_count = (size_t)gpr_atm_no_barrier_load(&g_cur_threads);
     if (cur_thread_count < g_max_threads) {
+      GRPC_STATS_INC_EXECUTOR_THREADS_CREATED(exec_ctx);
       gpr_atm_no_barrier_store(&g_cur_threads, cur_thread_count + 1);
 
       gpr_thd_options opt = gpr_thd_options_default();
@@ -56,7 +56,13 @@
 #define GRPC_HAVE_IP_PKTINFO 1
 #define GRPC_HAVE_MSG_NOSIGNAL 1
 #define GRPC_HAVE_UNIX_SOCKET 1
+#define GRPC_LINUX_ERRQUEUE 1
 #define GRPC_LINUX_MULTIPOLL_WITH_EPOLL 1
+#ifdef __has_include
+#if __has_include(<linux/tls.h>)
+#define GRPC_LINUX_KTLS 1
+#endif
+#endif
 #define GRPC_POSIX_SOCKET 1
 #define GRPC_POSIX_SOCKETADDR 1
 #define GRPC_POSIX_WAKEUP_FD 1
@@ -24,6 +24,7 @@
 #include "src/core/lib/iomgr/tcp_posix.h"
 
 #include <errno.h>
+#include <limits.h>
 #include <stdbool.h>
 #include <stdlib.h>
 #include <string.h>
@@ -31,6 +32,11 @@
 #include <sys/types.h>
 #include <unistd.h>
 
+#ifdef GRPC_LINUX_ERRQUEUE
+#include <linux/errqueue.h>
+#include <netinet/in.h>
+#endif
+
 #include <grpc/slice.h>
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
@@ -40,8 +46,10 @@
 #include <grpc/support/useful.h>
 
 #include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/debug/stats.h"
 #include "src/core/lib/debug/trace.h"
 #include "src/core/lib/iomgr/ev_posix.h"
+#include "src/core/lib/iomgr/timer.h"
 #include "src/core/lib/profiling/timers.h"
 #include "src/core/lib/slice/slice_internal.h"
 #include "src/core/lib/slice/slice_string_helpers.h"
@@ -53,6 +61,23 @@
 #define SENDMSG_FLAGS 0
 #endif
 
+#ifdef GRPC_LINUX_ERRQUEUE
+/* Older libc and kernel headers predate MSG_ZEROCOPY (Linux 4.14); the
+   values are ABI, and kernels without support reject SO_ZEROCOPY at runtime */
+#ifndef SO_ZEROCOPY
+#define SO_ZEROCOPY 60
+#endif
+#ifndef MSG_ZEROCOPY
+#define MSG_ZEROCOPY 0x4000000
+#endif
+#ifndef SO_EE_ORIGIN_ZEROCOPY
+#define SO_EE_ORIGIN_ZEROCOPY 5
+#endif
+#ifndef SO_EE_CODE_ZEROCOPY_COPIED
+#define SO_EE_CODE_ZEROCOPY_COPIED 1
+#endif
+#endif
+
 #ifdef GRPC_MSG_IOVLEN_TYPE
 typedef GRPC_MSG_IOVLEN_TYPE msg_iovlen_type;
 #else
@@ -61,12 +86,20 @@ typedef size_t msg_iovlen_type;
 
 grpc_tracer_flag grpc_tcp_trace = GRPC_TRACER_INITIALIZER(false, "tcp");
 
+/* Slices referenced by one MSG_ZEROCOPY sendmsg. The kernel keeps reading
+   from their memory after sendmsg returns, until it posts a completion for
+   sequence number \a seq on the socket error queue. */
+typedef struct zerocopy_record {
+  uint32_t seq;
+  grpc_slice_buffer slices;
+  struct zerocopy_record *next;
+} zerocopy_record;
+
 typedef struct {
   grpc_endpoint base;
   grpc_fd *em_fd;
   int fd;
   bool finished_edge;
-  msg_iovlen_type iov_size; /* Number of slices to allocate per read attempt */
   double target_length;
   double bytes_read_this_round;
   gpr_refcount refcount;
@@ -74,11 +107,18 @@ typedef struct {
 
   int min_read_chunk_size;
   int max_read_chunk_size;
+  /* if non-zero, keep reading until the socket is drained or this many bytes
+     have been gathered before invoking the read callback */
+  size_t read_drain_budget;
 
   /* garbage after the last read */
   grpc_slice_buffer last_read_buffer;
 
   grpc_slice_buffer *incoming_buffer;
+  /** number of leading slices (and bytes) of incoming_buffer already filled
+      by earlier reads of the current drain loop */
+  size_t incoming_filled_count;
+  size_t incoming_filled_length;
   grpc_slice_buffer *outgoing_buffer;
   /** slice within outgoing_buffer to write next */
   size_t outgoing_slice_idx;
@@ -97,6 +137,22 @@ typedef struct {
 
   grpc_resource_user *resource_user;
   grpc_resource_user_slice_allocator slice_allocator;
+
+  /* zero copy sends: cleared if the socket turns out not to support them */
+  gpr_atm zerocopy_enabled;
+  size_t zerocopy_threshold;
+  /** sequence number the kernel will give the next zero copy send */
+  uint32_t zerocopy_next_seq;
+  /** sends not yet reported complete, oldest first; guarded by zerocopy_mu
+      since completions are reaped from both the read and write paths */
+  gpr_mu zerocopy_mu;
+  zerocopy_record *zerocopy_head;
+  zerocopy_record *zerocopy_tail;
+  gpr_atm zerocopy_outstanding;
+  /** polls for the completions still outstanding once the endpoint is freed */
+  grpc_timer zerocopy_reap_timer;
+  grpc_closure zerocopy_reap_closure;
+  int zerocopy_reap_interval_ms;
 } grpc_tcp;
 
 static void add_to_estimate(grpc_tcp *tcp, size_t bytes) {
@@ -154,15 +210,224 @@ static void tcp_shutdown(grpc_exec_ctx *exec_ctx, grpc_endpoint *ep,
   grpc_resource_user_shutdown(exec_ctx, tcp->resource_user);
 }
 
-static void tcp_free(grpc_exec_ctx *exec_ctx, grpc_tcp *tcp) {
+#ifdef GRPC_LINUX_ERRQUEUE
+/* Takes a ref on each of the \a iov_size slices of outgoing_buffer starting
+   at \a slice_idx, and repoints \a iov at the record's copies: an inlined
+   slice carries its bytes in the slice struct itself, so the kernel must read
+   them from memory that lives as long as the record. */
+static zerocopy_record *zerocopy_record_create(grpc_tcp *tcp, size_t slice_idx,
+                                               size_t byte_idx,
+                                               struct iovec *iov,
+                                               msg_iovlen_type iov_size) {
+  zerocopy_record *record = (zerocopy_record *)gpr_malloc(sizeof(*record));
+  msg_iovlen_type i;
+  grpc_slice_buffer_init(&record->slices);
+  for (i = 0; i < iov_size; i++) {
+    grpc_slice_buffer_add_indexed(
+        &record->slices,
+        grpc_slice_ref_internal(tcp->outgoing_buffer->slices[slice_idx + i]));
+  }
+  for (i = 0; i < iov_size; i++) {
+    iov[i].iov_base =
+        GRPC_SLICE_START_PTR(record->slices.slices[i]) + (i == 0 ? byte_idx : 0);
+  }
+  record->next = NULL;
+  return record;
+}
+
+static void zerocopy_record_destroy(grpc_exec_ctx *exec_ctx,
+                                    zerocopy_record *record) {
+  grpc_slice_buffer_destroy_internal(exec_ctx, &record->slices);
+  gpr_free(record);
+}
+
+/* Queues \a record under the sequence number the kernel will give the next
+   zero copy send (it numbers them consecutively from 0). This must happen
+   before sendmsg: a concurrent read can reap the completion as soon as the
+   send is made. */
+static void zerocopy_record_queue(grpc_tcp *tcp, zerocopy_record *record) {
+  record->seq = tcp->zerocopy_next_seq;
+  gpr_mu_lock(&tcp->zerocopy_mu);
+  if (tcp->zerocopy_tail == NULL) {
+    tcp->zerocopy_head = record;
+  } else {
+    tcp->zerocopy_tail->next = record;
+  }
+  tcp->zerocopy_tail = record;
+  gpr_atm_no_barrier_fetch_add(&tcp->zerocopy_outstanding, 1);
+  gpr_mu_unlock(&tcp->zerocopy_mu);
+}
+
+/* Called once sendmsg returned. If it made no zero copy send, the kernel did
+   not use \a record's sequence number, and nothing can have completed it:
+   take it back off the queue (where it is still last) and release it. */
+static void zerocopy_record_finish(grpc_exec_ctx *exec_ctx, grpc_tcp *tcp,
+                                   zerocopy_record *record, bool sent) {
+  zerocopy_record **prev;
+  if (sent) {
+    tcp->zerocopy_next_seq++;
+    return;
+  }
+  gpr_mu_lock(&tcp->zerocopy_mu);
+  tcp->zerocopy_tail = NULL;
+  prev = &tcp->zerocopy_head;
+  while (*prev != record) {
+    tcp->zerocopy_tail = *prev;
+    prev = &(*prev)->next;
+  }
+  GPR_ASSERT(record->next == NULL);
+  *prev = NULL;
+  gpr_atm_no_barrier_fetch_add(&tcp->zerocopy_outstanding, -1);
+  gpr_mu_unlock(&tcp->zerocopy_mu);
+  zerocopy_record_destroy(exec_ctx, record);
+}
+
+/* Releases the records of sends \a lo through \a hi (inclusive, modulo 2^32) */
+static void zerocopy_sends_done(grpc_exec_ctx *exec_ctx, grpc_tcp *tcp,
+                                uint32_t lo, uint32_t hi) {
+  zerocopy_record *done = NULL;
+  zerocopy_record *last = NULL;
+  zerocopy_record **prev;
+  gpr_mu_lock(&tcp->zerocopy_mu);
+  prev = &tcp->zerocopy_head;
+  while (*prev != NULL) {
+    zerocopy_record *record = *prev;
+    if ((uint32_t)(record->seq - lo) <= (uint32_t)(hi - lo)) {
+      *prev = record->next;
+      record->next = done;
+      done = record;
+      gpr_atm_no_barrier_fetch_add(&tcp->zerocopy_outstanding, -1);
+    } else {
+      last = record;
+      prev = &record->next;
+    }
+  }
+  tcp->zerocopy_tail = last;
+  gpr_mu_unlock(&tcp->zerocopy_mu);
+  while (done != NULL) {
+    zerocopy_record *next = done->next;
+    zerocopy_record_destroy(exec_ctx, done);
+    done = next;
+  }
+}
+
+/* Reaps the completions the kernel has posted to the socket error queue so
+   far, without blocking */
+static void process_zerocopy_completions(grpc_exec_ctx *exec_ctx,
+                                         grpc_tcp *tcp) {
+  union {
+    char buf[CMSG_SPACE(sizeof(struct sock_extended_err)) +
+             CMSG_SPACE(sizeof(struct sockaddr_in6))];
+    struct cmsghdr align;
+  } control;
+  while (gpr_atm_no_barrier_load(&tcp->zerocopy_outstanding) > 0) {
+    struct msghdr msg;
+    struct cmsghdr *cmsg;
+    ssize_t r;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_control = control.buf;
+    msg.msg_controllen = sizeof(control.buf);
+    do {
+      r = recvmsg(tcp->fd, &msg, MSG_ERRQUEUE);
+    } while (r < 0 && errno == EINTR);
+    if (r < 0) {
+      /* EAGAIN: nothing more has completed yet */
+      return;
+    }
+    for (cmsg = CMSG_FIRSTHDR(&msg); cmsg != NULL;
+         cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+      struct sock_extended_err *serr;
+      if (!(cmsg->cmsg_level == IPPROTO_IP && cmsg->cmsg_type == IP_RECVERR) &&
+          !(cmsg->cmsg_level == IPPROTO_IPV6 &&
+            cmsg->cmsg_type == IPV6_RECVERR)) {
+        continue;
+      }
+      serr = (struct sock_extended_err *)CMSG_DATA(cmsg);
+      if (serr->ee_errno != 0 || serr->ee_origin != SO_EE_ORIGIN_ZEROCOPY) {
+        continue;
+      }
+      if (serr->ee_code & SO_EE_CODE_ZEROCOPY_COPIED) {
+        /* the kernel copied the data anyway (loopback, or a device without
+           scatter-gather): pinning just adds overhead from here on */
+        if (GRPC_TRACER_ON(grpc_tcp_trace)) {
+          gpr_log(GPR_DEBUG, "TCP %p: zero copy sends copied, disabling", tcp);
+        }
+        gpr_atm_no_barrier_store(&tcp->zerocopy_enabled, 0);
+      }
+      zerocopy_sends_done(exec_ctx, tcp, serr->ee_info, serr->ee_data);
+    }
+  }
+}
+
+#endif
+
+static void tcp_release(grpc_exec_ctx *exec_ctx, grpc_tcp *tcp) {
   grpc_fd_orphan(exec_ctx, tcp->em_fd, tcp->release_fd_cb, tcp->release_fd,
                  "tcp_unref_orphan");
   grpc_slice_buffer_destroy_internal(exec_ctx, &tcp->last_read_buffer);
   grpc_resource_user_unref(exec_ctx, tcp->resource_user);
+  gpr_mu_destroy(&tcp->zerocopy_mu);
   gpr_free(tcp->peer_string);
   gpr_free(tcp);
 }
 
+#ifdef GRPC_LINUX_ERRQUEUE
+#define ZEROCOPY_REAP_MIN_INTERVAL_MS 10
+#define ZEROCOPY_REAP_MAX_INTERVAL_MS 1000
+
+static void zerocopy_reap_after_free(grpc_exec_ctx *exec_ctx, void *arg,
+                                     grpc_error *error);
+
+static void zerocopy_schedule_reap(grpc_exec_ctx *exec_ctx, grpc_tcp *tcp) {
+  gpr_timespec now = gpr_now(GPR_CLOCK_MONOTONIC);
+  grpc_timer_init(
+      exec_ctx, &tcp->zerocopy_reap_timer,
+      gpr_time_add(now, gpr_time_from_millis(tcp->zerocopy_reap_interval_ms,
+                                             GPR_TIMESPAN)),
+      &tcp->zerocopy_reap_closure, now);
+}
+
+/* The kernel may still be reading from the slices of outstanding sends when
+   the endpoint is freed, so the socket stays open (the completions arrive on
+   its error queue) and the endpoint is only released once they all have. */
+static void zerocopy_reap_after_free(grpc_exec_ctx *exec_ctx, void *arg,
+                                     grpc_error *error) {
+  grpc_tcp *tcp = (grpc_tcp *)arg;
+  process_zerocopy_completions(exec_ctx, tcp);
+  if (gpr_atm_no_barrier_load(&tcp->zerocopy_outstanding) > 0) {
+    if (error == GRPC_ERROR_NONE) {
+      tcp->zerocopy_reap_interval_ms = GPR_MIN(
+          2 * tcp->zerocopy_reap_interval_ms, ZEROCOPY_REAP_MAX_INTERVAL_MS);
+      zerocopy_schedule_reap(exec_ctx, tcp);
+      return;
+    }
+    /* timers are cancelled when grpc shuts down: leave the slices of the
+       sends still outstanding alone rather than let the kernel send freed
+       memory */
+    gpr_log(GPR_ERROR,
+            "%s: leaking %" PRIdPTR " zero copy sends not yet released by the "
+            "kernel",
+            tcp->peer_string,
+            gpr_atm_no_barrier_load(&tcp->zerocopy_outstanding));
+  }
+  tcp_release(exec_ctx, tcp);
+}
+#endif
+
+static void tcp_free(grpc_exec_ctx *exec_ctx, grpc_tcp *tcp) {
+#ifdef GRPC_LINUX_ERRQUEUE
+  process_zerocopy_completions(exec_ctx, tcp);
+  if (gpr_atm_no_barrier_load(&tcp->zerocopy_outstanding) > 0) {
+    GRPC_CLOSURE_INIT(&tcp->zerocopy_reap_closure, zerocopy_reap_after_free,
+                      tcp, grpc_schedule_on_exec_ctx);
+    tcp->zerocopy_reap_interval_ms = ZEROCOPY_REAP_MIN_INTERVAL_MS;
+    zerocopy_schedule_reap(exec_ctx, tcp);
+    return;
+  }
+#endif
+  tcp_release(exec_ctx, tcp);
+}
+
 #ifndef NDEBUG
 #define TCP_UNREF(cl, tcp, reason) \
   tcp_unref((cl), (tcp), (reason), __FILE__, __LINE__)
@@ -228,36 +493,59 @@ static void call_read_cb(grpc_exec_ctx *exec_ctx, grpc_tcp *tcp,
 
   tcp->read_cb = NULL;
   tcp->incoming_buffer = NULL;
+  tcp->incoming_filled_count = 0;
+  tcp->incoming_filled_length = 0;
   GRPC_CLOSURE_RUN(exec_ctx, cb, error);
 }
 
+/* Hand whatever earlier reads of a drain loop gathered to the read callback,
+   returning the unused tail of incoming_buffer to last_read_buffer */
+static void finish_drain(grpc_exec_ctx *exec_ctx, grpc_tcp *tcp) {
+  grpc_slice_buffer_trim_end(
+      tcp->incoming_buffer,
+      tcp->incoming_buffer->length - tcp->incoming_filled_length,
+      &tcp->last_read_buffer);
+  call_read_cb(exec_ctx, tcp, GRPC_ERROR_NONE);
+  TCP_UNREF(exec_ctx, tcp, "read");
+}
+
+static void tcp_continue_read(grpc_exec_ctx *exec_ctx, grpc_tcp *tcp);
+
 #define MAX_READ_IOVEC 4
 static void tcp_do_read(grpc_exec_ctx *exec_ctx, grpc_tcp *tcp) {
   struct msghdr msg;
   struct iovec iov[MAX_READ_IOVEC];
+  msg_iovlen_type iov_len = 0;
+  size_t unfilled_length =
+      tcp->incoming_buffer->length - tcp->incoming_filled_length;
   ssize_t read_bytes;
   size_t i;
 
   GPR_ASSERT(!tcp->finished_edge);
-  GPR_ASSERT(tcp->iov_size <= MAX_READ_IOVEC);
-  GPR_ASSERT(tcp->incoming_buffer->count <= MAX_READ_IOVEC);
+  GPR_ASSERT(tcp->incoming_buffer->count - tcp->incoming_filled_count <=
+             MAX_READ_IOVEC);
   GPR_TIMER_BEGIN("tcp_continue_read", 0);
 
-  for (i = 0; i < tcp->incoming_buffer->count; i++) {
-    iov[i].iov_base = GRPC_SLICE_START_PTR(tcp->incoming_buffer->slices[i]);
-    iov[i].iov_len = GRPC_SLICE_LENGTH(tcp->incoming_buffer->slices[i]);
+  for (i = tcp->incoming_filled_count; i < tcp->incoming_buffer->count; i++) {
+    iov[iov_len].iov_base =
+        GRPC_SLICE_START_PTR(tcp->incoming_buffer->slices[i]);
+    iov[iov_len].iov_len = GRPC_SLICE_LENGTH(tcp->incoming_buffer->slices[i]);
+    iov_len++;
   }
 
   msg.msg_name = NULL;
   msg.msg_namelen = 0;
   msg.msg_iov = iov;
-  msg.msg_iovlen = tcp->iov_size;
+  msg.msg_iovlen = iov_len;
   msg.msg_control = NULL;
   msg.msg_controllen = 0;
   msg.msg_flags = 0;
 
+  GRPC_STATS_INC_TCP_READ_OFFER(exec_ctx, unfilled_length);
+
   GPR_TIMER_BEGIN("recvmsg", 0);
   do {
+    GRPC_STATS_INC_SYSCALL_READ(exec_ctx);
     read_bytes = recvmsg(tcp->fd, &msg, 0);
   } while (read_bytes < 0 && errno == EINTR);
   GPR_TIMER_END("recvmsg", read_bytes >= 0);
@@ -266,9 +554,17 @@ static void tcp_do_read(grpc_exec_ctx *exec_ctx, grpc_tcp *tcp) {
     /* NB: After calling call_read_cb a parallel call of the read handler may
      * be running. */
     if (errno == EAGAIN) {
-      finish_estimate(tcp);
-      /* We've consumed the edge, request a new one */
-      grpc_fd_notify_on_read(exec_ctx, tcp->em_fd, &tcp->read_closure);
+      if (tcp->incoming_filled_length > 0) {
+        /* The drain loop emptied the socket, consuming the edge: deliver what
+           was gathered, and wait for a new edge on the next read. Each of its
+           reads already updated the estimate. */
+        tcp->finished_edge = true;
+        finish_drain(exec_ctx, tcp);
+      } else {
+        finish_estimate(tcp);
+        /* We've consumed the edge, request a new one */
+        grpc_fd_notify_on_read(exec_ctx, tcp->em_fd, &tcp->read_closure);
+      }
     } else {
       grpc_slice_buffer_reset_and_unref_internal(exec_ctx,
                                                  tcp->incoming_buffer);
@@ -277,25 +573,45 @@ static void tcp_do_read(grpc_exec_ctx *exec_ctx, grpc_tcp *tcp) {
       TCP_UNREF(exec_ctx, tcp, "read");
     }
   } else if (read_bytes == 0) {
-    /* 0 read size ==> end of stream */
-    grpc_slice_buffer_reset_and_unref_internal(exec_ctx, tcp->incoming_buffer);
-    call_read_cb(
-        exec_ctx, tcp,
-        tcp_annotate_error(
-            GRPC_ERROR_CREATE_FROM_STATIC_STRING("Socket closed"), tcp));
-    TCP_UNREF(exec_ctx, tcp, "read");
+    if (tcp->incoming_filled_length > 0) {
+      /* Deliver the data preceding end of stream first: the next read will
+         see the socket close */
+      tcp->finished_edge = true;
+      finish_drain(exec_ctx, tcp);
+    } else {
+      /* 0 read size ==> end of stream */
+      grpc_slice_buffer_reset_and_unref_internal(exec_ctx,
+                                                 tcp->incoming_buffer);
+      call_read_cb(
+          exec_ctx, tcp,
+          tcp_annotate_error(
+              GRPC_ERROR_CREATE_FROM_STATIC_STRING("Socket closed"), tcp));
+      TCP_UNREF(exec_ctx, tcp, "read");
+    }
   } else {
+    GRPC_STATS_INC_TCP_READ_SIZE(exec_ctx, read_bytes);
     add_to_estimate(tcp, (size_t)read_bytes);
-    GPR_ASSERT((size_t)read_bytes <= tcp->incoming_buffer->length);
-    if ((size_t)read_bytes < tcp->incoming_buffer->length) {
-      grpc_slice_buffer_trim_end(
-          tcp->incoming_buffer,
-          tcp->incoming_buffer->length - (size_t)read_bytes,
-          &tcp->last_read_buffer);
+    GPR_ASSERT((size_t)read_bytes <= unfilled_length);
+    if ((size_t)read_bytes == unfilled_length &&
+        tcp->incoming_buffer->length < tcp->read_drain_budget) {
+      /* Filled everything we offered: there may be more waiting, so keep
+         reading into freshly allocated slices. Size them from this read
+         alone rather than from the whole burst. */
+      finish_estimate(tcp);
+      tcp->incoming_filled_count = tcp->incoming_buffer->count;
+      tcp->incoming_filled_length = tcp->incoming_buffer->length;
+      tcp_continue_read(exec_ctx, tcp);
+    } else {
+      if ((size_t)read_bytes < unfilled_length) {
+        grpc_slice_buffer_trim_end(tcp->incoming_buffer,
+                                   unfilled_length - (size_t)read_bytes,
+                                   &tcp->last_read_buffer);
+      }
+      GPR_ASSERT((size_t)read_bytes + tcp->incoming_filled_length ==
+                 tcp->incoming_buffer->length);
+      call_read_cb(exec_ctx, tcp, GRPC_ERROR_NONE);
+      TCP_UNREF(exec_ctx, tcp, "read");
     }
-    GPR_ASSERT((size_t)read_bytes == tcp->incoming_buffer->length);
-    call_read_cb(exec_ctx, tcp, GRPC_ERROR_NONE);
-    TCP_UNREF(exec_ctx, tcp, "read");
   }
 
   GPR_TIMER_END("tcp_continue_read", 0);
@@ -317,8 +633,10 @@ static void tcp_read_allocation_done(grpc_exec_ctx *exec_ctx, void *tcpp,
 
 static void tcp_continue_read(grpc_exec_ctx *exec_ctx, grpc_tcp *tcp) {
   size_t target_read_size = get_target_read_size(tcp);
-  if (tcp->incoming_buffer->length < target_read_size &&
-      tcp->incoming_buffer->count < MAX_READ_IOVEC) {
+  if (tcp->incoming_buffer->length - tcp->incoming_filled_length <
+          target_read_size &&
+      tcp->incoming_buffer->count - tcp->incoming_filled_count <
+          MAX_READ_IOVEC) {
     grpc_resource_user_alloc_slices(exec_ctx, &tcp->slice_allocator,
                                     target_read_size, 1, tcp->incoming_buffer);
   } else {
@@ -331,6 +649,11 @@ static void tcp_handle_read(grpc_exec_ctx *exec_ctx, void *arg /* grpc_tcp */,
   grpc_tcp *tcp = (grpc_tcp *)arg;
   GPR_ASSERT(!tcp->finished_edge);
 
+#ifdef GRPC_LINUX_ERRQUEUE
+  /* zero copy completions arrive as socket errors, which wake up reads */
+  process_zerocopy_completions(exec_ctx, tcp);
+#endif
+
   if (error != GRPC_ERROR_NONE) {
     grpc_slice_buffer_reset_and_unref_internal(exec_ctx, tcp->incoming_buffer);
     grpc_slice_buffer_reset_and_unref_internal(exec_ctx,
@@ -361,7 +684,8 @@ static void tcp_read(grpc_exec_ctx *exec_ctx, grpc_endpoint *ep,
 
 /* returns true if done, false if pending; if returning true, *error is set */
 #define MAX_WRITE_IOVEC 1000
-static bool tcp_flush(grpc_tcp *tcp, grpc_error **error) {
+static bool tcp_flush(grpc_exec_ctx *exec_ctx, grpc_tcp *tcp,
+                      grpc_error **error) {
   struct msghdr msg;
   struct iovec iov[MAX_WRITE_IOVEC];
   msg_iovlen_type iov_size;
@@ -370,6 +694,14 @@ static bool tcp_flush(grpc_tcp *tcp, grpc_error **error) {
   size_t trailing;
   size_t unwind_slice_idx;
   size_t unwind_byte_idx;
+  int flags;
+#ifdef GRPC_LINUX_ERRQUEUE
+  zerocopy_record *record;
+
+  /* release the slices of earlier sends, and learn whether zero copy is
+     still worthwhile, before deciding how to send this one */
+  process_zerocopy_completions(exec_ctx, tcp);
+#endif
 
   for (;;) {
     sending_length = 0;
@@ -400,13 +732,50 @@ static bool tcp_flush(grpc_tcp *tcp, grpc_error **error) {
     msg.msg_controllen = 0;
     msg.msg_flags = 0;
 
+    flags = SENDMSG_FLAGS;
+#ifdef GRPC_LINUX_ERRQUEUE
+    record = NULL;
+    if (sending_length >= tcp->zerocopy_threshold &&
+        gpr_atm_no_barrier_load(&tcp->zerocopy_enabled)) {
+      record = zerocopy_record_create(tcp, unwind_slice_idx, unwind_byte_idx,
+                                      iov, iov_size);
+      zerocopy_record_queue(tcp, record);
+      flags |= MSG_ZEROCOPY;
+    }
+#endif
+
+    GRPC_STATS_INC_TCP_WRITE_SIZE(exec_ctx, sending_length);
+    GRPC_STATS_INC_TCP_WRITE_IOV_SIZE(exec_ctx, iov_size);
+
     GPR_TIMER_BEGIN("sendmsg", 1);
     do {
       /* TODO(klempner): Cork if this is a partial write */
-      sent_length = sendmsg(tcp->fd, &msg, SENDMSG_FLAGS);
+      GRPC_STATS_INC_SYSCALL_WRITE(exec_ctx);
+      sent_length = sendmsg(tcp->fd, &msg, flags);
     } while (sent_length < 0 && errno == EINTR);
+#ifdef GRPC_LINUX_ERRQUEUE
+    if (sent_length < 0 && errno == ENOBUFS && (flags & MSG_ZEROCOPY)) {
+      /* no socket memory left to track another zero copy send: copy this
+         one, and go back to zero copy once earlier sends have completed */
+      flags &= ~MSG_ZEROCOPY;
+      do {
+        GRPC_STATS_INC_SYSCALL_WRITE(exec_ctx);
+        sent_length = sendmsg(tcp->fd, &msg, flags);
+      } while (sent_length < 0 && errno == EINTR);
+    }
+#endif
     GPR_TIMER_END("sendmsg", 0);
 
+#ifdef GRPC_LINUX_ERRQUEUE
+    if (record != NULL) {
+      bool sent = sent_length > 0 && (flags & MSG_ZEROCOPY);
+      if (sent) {
+        GRPC_STATS_INC_TCP_ZEROCOPY_SENDS(exec_ctx);
+      }
+      zerocopy_record_finish(exec_ctx, tcp, record, sent);
+    }
+#endif
+
     if (sent_length < 0) {
       if (errno == EAGAIN) {
         tcp->outgoing_slice_idx = unwind_slice_idx;
@@ -459,7 +828,7 @@ static void tcp_handle_write(grpc_exec_ctx *exec_ctx, void *arg /* grpc_tcp */,
     return;
   }
 
-  if (!tcp_flush(tcp, &error)) {
+  if (!tcp_flush(exec_ctx, tcp, &error)) {
     if (GRPC_TRACER_ON(grpc_tcp_trace)) {
       gpr_log(GPR_DEBUG, "write: delayed");
     }
@@ -510,7 +879,7 @@ static void tcp_write(grpc_exec_ctx *exec_ctx, grpc_endpoint *ep,
   tcp->outgoing_slice_idx = 0;
   tcp->outgoing_byte_idx = 0;
 
-  if (!tcp_flush(tcp, &error)) {
+  if (!tcp_flush(exec_ctx, tcp, &error)) {
     TCP_REF(tcp, "write");
     tcp->write_cb = cb;
     if (GRPC_TRACER_ON(grpc_tcp_trace)) {
@@ -568,6 +937,9 @@ grpc_endpoint *grpc_tcp_create(grpc_exec_ctx *exec_ctx, grpc_fd *em_fd,
   int tcp_read_chunk_size = GRPC_TCP_DEFAULT_READ_SLICE_SIZE;
   int tcp_max_read_chunk_size = 4 * 1024 * 1024;
   int tcp_min_read_chunk_size = 256;
+  int tcp_read_drain_budget = 0;
+  bool tcp_tx_zerocopy_enabled = false;
+  int tcp_tx_zerocopy_threshold = 16 * 1024;
   grpc_resource_quota *resource_quota = grpc_resource_quota_create(NULL);
   if (channel_args != NULL) {
     for (size_t i = 0; i < channel_args->num_args; i++) {
@@ -589,6 +961,21 @@ grpc_endpoint *grpc_tcp_create(grpc_exec_ctx *exec_ctx, grpc_fd *em_fd,
                                         MAX_CHUNK_SIZE};
         tcp_max_read_chunk_size =
             grpc_channel_arg_get_integer(&channel_args->args[i], options);
+      } else if (0 == strcmp(channel_args->args[i].key,
+                             GRPC_ARG_TCP_READ_DRAIN_BUDGET)) {
+        grpc_integer_options options = {0, 0, MAX_CHUNK_SIZE};
+        tcp_read_drain_budget =
+            grpc_channel_arg_get_integer(&channel_args->args[i], options);
+      } else if (0 == strcmp(channel_args->args[i].key,
+                             GRPC_ARG_TCP_TX_ZEROCOPY_ENABLED)) {
+        grpc_integer_options options = {0, 0, 1};
+        tcp_tx_zerocopy_enabled =
+            grpc_channel_arg_get_integer(&channel_args->args[i], options) != 0;
+      } else if (0 == strcmp(channel_args->args[i].key,
+                             GRPC_ARG_TCP_TX_ZEROCOPY_SEND_BYTES_THRESHOLD)) {
+        grpc_integer_options options = {tcp_tx_zerocopy_threshold, 0, INT_MAX};
+        tcp_tx_zerocopy_threshold =
+            grpc_channel_arg_get_integer(&channel_args->args[i], options);
       } else if (0 ==
                  strcmp(channel_args->args[i].key, GRPC_ARG_RESOURCE_QUOTA)) {
         grpc_resource_quota_unref_internal(exec_ctx, resource_quota);
@@ -616,9 +1003,34 @@ grpc_endpoint *grpc_tcp_create(grpc_exec_ctx *exec_ctx, grpc_fd *em_fd,
   tcp->target_length = (double)tcp_read_chunk_size;
   tcp->min_read_chunk_size = tcp_min_read_chunk_size;
   tcp->max_read_chunk_size = tcp_max_read_chunk_size;
+  tcp->read_drain_budget = (size_t)tcp_read_drain_budget;
+  tcp->incoming_filled_count = 0;
+  tcp->incoming_filled_length = 0;
   tcp->bytes_read_this_round = 0;
-  tcp->iov_size = 1;
   tcp->finished_edge = true;
+#ifdef GRPC_LINUX_ERRQUEUE
+  if (tcp_tx_zerocopy_enabled) {
+    const int enable = 1;
+    if (setsockopt(tcp->fd, SOL_SOCKET, SO_ZEROCOPY, &enable,
+                   sizeof(enable)) != 0) {
+      /* e.g. pre-4.14 kernels, or unix domain sockets */
+      if (GRPC_TRACER_ON(grpc_tcp_trace)) {
+        gpr_log(GPR_DEBUG, "TCP %p: SO_ZEROCOPY unavailable: %s", tcp,
+                strerror(errno));
+      }
+      tcp_tx_zerocopy_enabled = false;
+    }
+  }
+#else
+  tcp_tx_zerocopy_enabled = false;
+#endif
+  gpr_atm_no_barrier_store(&tcp->zerocopy_enabled, tcp_tx_zerocopy_enabled);
+  tcp->zerocopy_threshold = (size_t)tcp_tx_zerocopy_threshold;
+  tcp->zerocopy_next_seq = 0;
+  gpr_mu_init(&tcp->zerocopy_mu);
+  tcp->zerocopy_head = NULL;
+  tcp->zerocopy_tail = NULL;
+  gpr_atm_no_barrier_store(&tcp->zerocopy_outstanding, 0);
   /* paired with unref in grpc_tcp_destroy */
   gpr_ref_init(&tcp->refcount, 1);
   gpr_atm_no_barrier_store(&tcp->shutdown_count, 0);
@@ -53,16 +53,20 @@ static grpc_security_status ssl_create_security_connector(
   grpc_ssl_credentials *c = (grpc_ssl_credentials *)creds;
   grpc_security_status status = GRPC_SECURITY_OK;
   const char *overridden_target_name = NULL;
+  tsi_ssl_session_cache *ssl_session_cache = NULL;
   for (size_t i = 0; args && i < args->num_args; i++) {
     grpc_arg *arg = &args->args[i];
     if (strcmp(arg->key, GRPC_SSL_TARGET_NAME_OVERRIDE_ARG) == 0 &&
-        arg->type == GRPC_ARG_STRING) {
+        arg->type == GRPC_ARG_STRING && overridden_target_name == NULL) {
       overridden_target_name = arg->value.string;
-      break;
+    } else if (strcmp(arg->key, GRPC_SSL_SESSION_CACHE_ARG) == 0 &&
+               arg->type == GRPC_ARG_POINTER && ssl_session_cache == NULL) {
+      ssl_session_cache = arg->value.pointer.p;
     }
   }
   status = grpc_ssl_channel_security_connector_create(
-      exec_ctx, call_creds, &c->config, target, overridden_target_name, sc);
+      exec_ctx, call_creds, &c->config, target, overridden_target_name,
+      ssl_session_cache, sc);
   if (status != GRPC_SECURITY_OK) {
     return status;
   }
@@ -75,6 +79,40 @@ static grpc_security_status ssl_create_security_connector(
 static grpc_channel_credentials_vtable ssl_vtable = {
     ssl_destruct, ssl_create_security_connector, NULL};
 
+static void *ssl_session_cache_arg_copy(void *p) {
+  tsi_ssl_session_cache_ref(p);
+  return p;
+}
+
+static void ssl_session_cache_arg_destroy(grpc_exec_ctx *exec_ctx, void *p) {
+  tsi_ssl_session_cache_unref(p);
+}
+
+static int ssl_session_cache_arg_cmp(void *a, void *b) {
+  return GPR_ICMP(a, b);
+}
+
+static const grpc_arg_pointer_vtable ssl_session_cache_arg_vtable = {
+    ssl_session_cache_arg_copy, ssl_session_cache_arg_destroy,
+    ssl_session_cache_arg_cmp};
+
+grpc_ssl_session_cache *grpc_ssl_session_cache_create_lru(size_t capacity) {
+  GRPC_API_TRACE("grpc_ssl_session_cache_create_lru(capacity=%lu)", 1,
+                 ((unsigned long)capacity));
+  return (grpc_ssl_session_cache *)tsi_ssl_session_cache_create_lru(capacity);
+}
+
+void grpc_ssl_session_cache_destroy(grpc_ssl_session_cache *cache) {
+  GRPC_API_TRACE("grpc_ssl_session_cache_destroy(cache=%p)", 1, (cache));
+  tsi_ssl_session_cache_unref((tsi_ssl_session_cache *)cache);
+}
+
+grpc_arg grpc_ssl_session_cache_create_channel_arg(
+    grpc_ssl_session_cache *cache) {
+  return grpc_channel_arg_pointer_create(GRPC_SSL_SESSION_CACHE_ARG, cache,
+                                         &ssl_session_cache_arg_vtable);
+}
+
 static void ssl_build_config(const char *pem_root_certs,
                              grpc_ssl_pem_key_cert_pair *pem_key_cert_pair,
                              grpc_ssl_config *config) {
@@ -191,6 +191,8 @@ typedef struct {
      grpc_channel_security_connector_check_peer. This parameter may be NULL in
      which case the peer name will not be checked. Note that if this parameter
      is not NULL, then, pem_root_certs should not be NULL either.
+   - ssl_session_cache is the cache of the sessions the channel can resume.
+     This parameter may be NULL.
    - sc is a pointer on the connector to be created.
   This function returns GRPC_SECURITY_OK in case of success or a
   specific error code otherwise.
@@ -198,7 +200,9 @@ typedef struct {
 grpc_security_status grpc_ssl_channel_security_connector_create(
     grpc_exec_ctx *exec_ctx, grpc_call_credentials *request_metadata_creds,
     const grpc_ssl_config *config, const char *target_name,
-    const char *overridden_target_name, grpc_channel_security_connector **sc);
+    const char *overridden_target_name,
+    tsi_ssl_session_cache *ssl_session_cache,
+    grpc_channel_security_connector **sc);
 
 /* Gets the default ssl roots. Returns NULL if not found. */
 const char *grpc_get_default_ssl_roots(void);
@@ -18,9 +18,19 @@
 
 #include "src/core/lib/security/transport/security_handshaker.h"
 
+#include "src/core/lib/iomgr/port.h"
+
 #include <stdbool.h>
 #include <string.h>
 
+#ifdef GRPC_LINUX_KTLS
+#include <errno.h>
+#include <linux/tls.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#endif
+
 #include <grpc/slice_buffer.h>
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
@@ -32,9 +42,21 @@
 #include "src/core/lib/security/transport/secure_endpoint.h"
 #include "src/core/lib/security/transport/tsi_error.h"
 #include "src/core/lib/slice/slice_internal.h"
+#include "src/core/tsi/ssl_transport_security.h"
+#include "src/core/tsi/transport_security_grpc.h"
 
 #define GRPC_INITIAL_HANDSHAKE_BUFFER_SIZE 256
 
+#ifdef GRPC_LINUX_KTLS
+/* Older libc headers predate kernel TLS (Linux 4.13); the values are ABI */
+#ifndef SOL_TLS
+#define SOL_TLS 282
+#endif
+#ifndef TCP_ULP
+#define TCP_ULP 31
+#endif
+#endif
+
 typedef struct {
   grpc_handshaker base;
 
@@ -127,6 +149,101 @@ static void security_handshake_failed_locked(grpc_exec_ctx *exec_ctx,
   GRPC_CLOSURE_SCHED(exec_ctx, h->on_handshake_done, error);
 }
 
+#ifdef GRPC_LINUX_KTLS
+static bool set_kernel_tls_keys(int fd, int direction,
+                                const tsi_ssl_kernel_tls_keys *keys) {
+  if (keys->key_size == TLS_CIPHER_AES_GCM_128_KEY_SIZE) {
+    struct tls12_crypto_info_aes_gcm_128 info;
+    memset(&info, 0, sizeof(info));
+    info.info.version = TLS_1_2_VERSION;
+    info.info.cipher_type = TLS_CIPHER_AES_GCM_128;
+    memcpy(info.key, keys->key, sizeof(info.key));
+    memcpy(info.salt, keys->salt, sizeof(info.salt));
+    memcpy(info.iv, keys->iv, sizeof(info.iv));
+    memcpy(info.rec_seq, keys->rec_seq, sizeof(info.rec_seq));
+    return setsockopt(fd, SOL_TLS, direction, &info, sizeof(info)) == 0;
+  } else {
+    struct tls12_crypto_info_aes_gcm_256 info;
+    memset(&info, 0, sizeof(info));
+    info.info.version = TLS_1_2_VERSION;
+    info.info.cipher_type = TLS_CIPHER_AES_GCM_256;
+    memcpy(info.key, keys->key, sizeof(info.key));
+    memcpy(info.salt, keys->salt, sizeof(info.salt));
+    memcpy(info.iv, keys->iv, sizeof(info.iv));
+    memcpy(info.rec_seq, keys->rec_seq, sizeof(info.rec_seq));
+    return setsockopt(fd, SOL_TLS, direction, &info, sizeof(info)) == 0;
+  }
+}
+#endif
+
+static bool kernel_tls_offload_requested(const grpc_channel_args *args) {
+#ifdef GRPC_LINUX_KTLS
+  return grpc_channel_arg_get_bool(
+             grpc_channel_args_find(args, GRPC_ARG_TLS_KERNEL_OFFLOAD_ENABLED),
+             false) &&
+         // MSG_ZEROCOPY sends are refused by kernel TLS sockets.
+         !grpc_channel_arg_get_bool(
+             grpc_channel_args_find(args, GRPC_ARG_TCP_TX_ZEROCOPY_ENABLED),
+             false);
+#else
+  return false;
+#endif
+}
+
+// Hands the record layer of protector over to the kernel, if possible,
+// leaving the data already received in the read buffer. Returns false if the
+// connection has to go through a secure endpoint, or sets *error if it is left
+// unusable.
+static bool offload_to_kernel_locked(grpc_exec_ctx *exec_ctx,
+                                     security_handshaker *h,
+                                     tsi_frame_protector *protector,
+                                     unsigned char *unused_bytes,
+                                     size_t unused_bytes_size,
+                                     grpc_error **error) {
+#ifdef GRPC_LINUX_KTLS
+  const int fd = grpc_endpoint_get_fd(h->args->endpoint);
+  if (fd < 0 ||
+      setsockopt(fd, IPPROTO_TCP, TCP_ULP, "tls", sizeof("tls")) != 0) {
+    return false;
+  }
+  // The "tls" upper layer passes data through until keys are set.
+  tsi_ssl_kernel_tls_keys tx_keys;
+  tsi_ssl_kernel_tls_keys rx_keys;
+  unsigned char *unprotected_bytes;
+  size_t unprotected_bytes_size;
+  tsi_result result = tsi_ssl_frame_protector_export_kernel_tls_keys(
+      protector, unused_bytes, unused_bytes_size, &tx_keys, &rx_keys,
+      &unprotected_bytes, &unprotected_bytes_size);
+  if (result == TSI_UNIMPLEMENTED) return false;
+  if (result != TSI_OK) {
+    *error = grpc_set_tsi_error_result(
+        GRPC_ERROR_CREATE_FROM_STATIC_STRING("Kernel TLS key export failed"),
+        result);
+    return true;
+  }
+  const bool keys_set = set_kernel_tls_keys(fd, TLS_TX, &tx_keys) &&
+                        set_kernel_tls_keys(fd, TLS_RX, &rx_keys);
+  memset(&tx_keys, 0, sizeof(tx_keys));
+  memset(&rx_keys, 0, sizeof(rx_keys));
+  if (!keys_set) {
+    *error = GRPC_OS_ERROR(errno, "setsockopt(SOL_TLS)");
+    gpr_free(unprotected_bytes);
+    return true;
+  }
+  grpc_slice_buffer_reset_and_unref_internal(exec_ctx, h->args->read_buffer);
+  if (unprotected_bytes_size > 0) {
+    grpc_slice_buffer_add(
+        h->args->read_buffer,
+        grpc_slice_from_copied_buffer((const char *)unprotected_bytes,
+                                      unprotected_bytes_size));
+  }
+  gpr_free(unprotected_bytes);
+  return true;
+#else
+  return false;
+#endif
+}
+
 static void on_peer_checked(grpc_exec_ctx *exec_ctx, void *arg,
                             grpc_error *error) {
   security_handshaker *h = arg;
@@ -135,37 +252,68 @@ static void on_peer_checked(grpc_exec_ctx *exec_ctx, void *arg,
     security_handshake_failed_locked(exec_ctx, h, GRPC_ERROR_REF(error));
     goto done;
   }
-  // Create frame protector.
-  tsi_frame_protector *protector;
-  tsi_result result = tsi_handshaker_result_create_frame_protector(
-      h->handshaker_result, NULL, &protector);
-  if (result != TSI_OK) {
-    error = grpc_set_tsi_error_result(
-        GRPC_ERROR_CREATE_FROM_STATIC_STRING("Frame protector creation failed"),
-        result);
-    security_handshake_failed_locked(exec_ctx, h, error);
-    goto done;
+  // Create a zero-copy frame protector, if implemented, unless the kernel is
+  // to take over the record layer.
+  const bool offload_requested = kernel_tls_offload_requested(h->args->args);
+  tsi_zero_copy_grpc_protector *zero_copy_protector = NULL;
+  tsi_result result = TSI_UNIMPLEMENTED;
+  if (!offload_requested) {
+    result = tsi_handshaker_result_create_zero_copy_grpc_protector(
+        exec_ctx, h->handshaker_result, NULL, &zero_copy_protector);
+    if (result != TSI_OK && result != TSI_UNIMPLEMENTED) {
+      error = grpc_set_tsi_error_result(
+          GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+              "Zero-copy frame protector creation failed"),
+          result);
+      security_handshake_failed_locked(exec_ctx, h, error);
+      goto done;
+    }
+  }
+  // Create frame protector if zero-copy frame protector is NULL.
+  tsi_frame_protector *protector = NULL;
+  if (zero_copy_protector == NULL) {
+    result = tsi_handshaker_result_create_frame_protector(h->handshaker_result,
+                                                          NULL, &protector);
+    if (result != TSI_OK) {
+      error = grpc_set_tsi_error_result(
+          GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+              "Frame protector creation failed"),
+          result);
+      security_handshake_failed_locked(exec_ctx, h, error);
+      goto done;
+    }
   }
   // Get unused bytes.
   unsigned char *unused_bytes = NULL;
   size_t unused_bytes_size = 0;
   result = tsi_handshaker_result_get_unused_bytes(
       h->handshaker_result, &unused_bytes, &unused_bytes_size);
-  // Create secure endpoint.
-  if (unused_bytes_size > 0) {
-    grpc_slice slice =
-        grpc_slice_from_copied_buffer((char *)unused_bytes, unused_bytes_size);
-    h->args->endpoint =
-        grpc_secure_endpoint_create(protector, h->args->endpoint, &slice, 1);
-    grpc_slice_unref_internal(exec_ctx, slice);
+  if (offload_requested && protector != NULL &&
+      offload_to_kernel_locked(exec_ctx, h, protector, unused_bytes,
+                               unused_bytes_size, &error)) {
+    // The transport reads and writes the tcp endpoint directly.
+    tsi_frame_protector_destroy(protector);
+    if (error != GRPC_ERROR_NONE) {
+      security_handshake_failed_locked(exec_ctx, h, error);
+      goto done;
+    }
   } else {
-    h->args->endpoint =
-        grpc_secure_endpoint_create(protector, h->args->endpoint, NULL, 0);
+    // Create secure endpoint.
+    if (unused_bytes_size > 0) {
+      grpc_slice slice = grpc_slice_from_copied_buffer((char *)unused_bytes,
+                                                       unused_bytes_size);
+      h->args->endpoint = grpc_secure_endpoint_create(
+          protector, zero_copy_protector, h->args->endpoint, &slice, 1);
+      grpc_slice_unref_internal(exec_ctx, slice);
+    } else {
+      h->args->endpoint = grpc_secure_endpoint_create(
+          protector, zero_copy_protector, h->args->endpoint, NULL, 0);
+    }
+    // Clear out the read buffer before it gets passed to the transport.
+    grpc_slice_buffer_reset_and_unref_internal(exec_ctx, h->args->read_buffer);
   }
   tsi_handshaker_result_destroy(h->handshaker_result);
   h->handshaker_result = NULL;
-  // Clear out the read buffer before it gets passed to the transport.
-  grpc_slice_buffer_reset_and_unref_internal(exec_ctx, h->args->read_buffer);
   // Add auth context to channel args.
   grpc_arg auth_context_arg = grpc_auth_context_to_arg(h->auth_context);
   grpc_channel_args *tmp_args = h->args->args;
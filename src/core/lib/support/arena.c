@@ -20,7 +20,10 @@
 #include <grpc/support/alloc.h>
 #include <grpc/support/atm.h>
 #include <grpc/support/log.h>
+#include <grpc/support/sync.h>
 #include <grpc/support/useful.h>
+#include <stdbool.h>
+#include <string.h>
 
 #define ROUND_UP_TO_ALIGNMENT_SIZE(x) \
   (((x) + GPR_MAX_ALIGNMENT - 1u) & ~(GPR_MAX_ALIGNMENT - 1u))
@@ -33,9 +36,20 @@ typedef struct zone {
 
 struct gpr_arena {
   gpr_atm size_so_far;
+  // pool to return this arena to when it is destroyed, if any
+  gpr_arena_pool *pool;
+  // while cached by pool: the next cached arena
+  gpr_arena *next_cached;
   zone initial_zone;
 };
 
+struct gpr_arena_pool {
+  gpr_mu mu;
+  gpr_arena *cached;
+  size_t num_cached;
+  size_t max_cached;
+};
+
 gpr_arena *gpr_arena_create(size_t initial_size) {
   initial_size = ROUND_UP_TO_ALIGNMENT_SIZE(initial_size);
   gpr_arena *a = (gpr_arena *)gpr_zalloc(sizeof(gpr_arena) + initial_size);
@@ -46,7 +60,19 @@ gpr_arena *gpr_arena_create(size_t initial_size) {
 size_t gpr_arena_destroy(gpr_arena *arena) {
   gpr_atm size = gpr_atm_no_barrier_load(&arena->size_so_far);
   zone *z = (zone *)gpr_atm_no_barrier_load(&arena->initial_zone.next_atm);
-  gpr_free(arena);
+  gpr_arena_pool *pool = arena->pool;
+  bool cached = false;
+  if (pool != NULL) {
+    gpr_mu_lock(&pool->mu);
+    if (pool->num_cached < pool->max_cached) {
+      arena->next_cached = pool->cached;
+      pool->cached = arena;
+      pool->num_cached++;
+      cached = true;
+    }
+    gpr_mu_unlock(&pool->mu);
+  }
+  if (!cached) gpr_free(arena);
   while (z) {
     zone *next_z = (zone *)gpr_atm_no_barrier_load(&z->next_atm);
     gpr_free(z);
@@ -55,6 +81,56 @@ size_t gpr_arena_destroy(gpr_arena *arena) {
   return (size_t)size;
 }
 
+gpr_arena_pool *gpr_arena_pool_create(size_t max_cached) {
+  gpr_arena_pool *pool = (gpr_arena_pool *)gpr_malloc(sizeof(*pool));
+  gpr_mu_init(&pool->mu);
+  pool->cached = NULL;
+  pool->num_cached = 0;
+  pool->max_cached = max_cached;
+  return pool;
+}
+
+void gpr_arena_pool_destroy(gpr_arena_pool *pool) {
+  gpr_arena *a = pool->cached;
+  while (a != NULL) {
+    gpr_arena *next = a->next_cached;
+    gpr_free(a);
+    a = next;
+  }
+  gpr_mu_destroy(&pool->mu);
+  gpr_free(pool);
+}
+
+gpr_arena *gpr_arena_create_from_pool(gpr_arena_pool *pool,
+                                      size_t initial_size) {
+  initial_size = ROUND_UP_TO_ALIGNMENT_SIZE(initial_size);
+  gpr_mu_lock(&pool->mu);
+  gpr_arena *a = pool->cached;
+  if (a != NULL) {
+    pool->cached = a->next_cached;
+    pool->num_cached--;
+  }
+  gpr_mu_unlock(&pool->mu);
+  if (a != NULL && a->initial_zone.size_end < initial_size) {
+    // cached while the caller's size estimate was smaller: let it go, so that
+    // outdated buffers drain out of the pool
+    gpr_free(a);
+    a = NULL;
+  }
+  if (a == NULL) {
+    a = gpr_arena_create(initial_size);
+  } else {
+    // only the part of the buffer the last user allocated needs re-zeroing
+    size_t used = GPR_MIN((size_t)gpr_atm_no_barrier_load(&a->size_so_far),
+                          a->initial_zone.size_end);
+    memset(&a->initial_zone + 1, 0, used);
+    gpr_atm_no_barrier_store(&a->size_so_far, 0);
+    gpr_atm_no_barrier_store(&a->initial_zone.next_atm, (gpr_atm)NULL);
+  }
+  a->pool = pool;
+  return a;
+}
+
 void *gpr_arena_alloc(gpr_arena *arena, size_t size) {
   size = ROUND_UP_TO_ALIGNMENT_SIZE(size);
   size_t start =
@@ -36,4 +36,18 @@ void *gpr_arena_alloc(gpr_arena *arena, size_t size);
 // Destroy an arena, returning the total number of bytes allocated
 size_t gpr_arena_destroy(gpr_arena *arena);
 
+// A cache of arena initial buffers, so that a steady stream of similarly sized
+// arenas (one per call, say) does not malloc, zero and free each buffer anew
+typedef struct gpr_arena_pool gpr_arena_pool;
+
+// Create a pool holding at most \a max_cached idle buffers
+gpr_arena_pool *gpr_arena_pool_create(size_t max_cached);
+// Destroy a pool: all arenas created from it must have been destroyed
+void gpr_arena_pool_destroy(gpr_arena_pool *pool);
+// Create an arena like gpr_arena_create, reusing a buffer cached by \a pool if
+// one of at least \a initial_size bytes is available; destroying the arena
+// returns its initial buffer to \a pool
+gpr_arena *gpr_arena_create_from_pool(gpr_arena_pool *pool,
+                                      size_t initial_size);
+
 #endif /* GRPC_CORE_LIB_SUPPORT_ARENA_H */
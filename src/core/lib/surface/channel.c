@@ -35,6 +35,9 @@
 #include "src/core/lib/surface/channel_init.h"
 #include "src/core/lib/transport/static_metadata.h"
 
+/** Maximum number of idle call arenas a channel keeps for reuse */
+#define MAX_CACHED_CALL_ARENAS 4
+
 /** Cache grpc-status: X mdelems for X = 0..NUM_CACHED_STATUS_ELEMS.
  *  Avoids needing to take a metadata context lock for sending status
  *  if the status code is <= NUM_CACHED_STATUS_ELEMS.
@@ -54,6 +57,7 @@ struct grpc_channel {
   grpc_mdelem default_authority;
 
   gpr_atm call_size_estimate;
+  gpr_arena_pool *call_arena_pool;
 
   gpr_mu registered_call_mu;
   registered_call *registered_calls;
@@ -97,6 +101,7 @@ grpc_channel *grpc_channel_create_with_builder(
   gpr_atm_no_barrier_store(
       &channel->call_size_estimate,
       (gpr_atm)CHANNEL_STACK_FROM_CHANNEL(channel)->call_stack_size);
+  channel->call_arena_pool = gpr_arena_pool_create(MAX_CACHED_CALL_ARENAS);
 
   grpc_compression_options_init(&channel->compression_options);
   for (size_t i = 0; i < args->num_args; i++) {
@@ -212,6 +217,11 @@ void grpc_channel_update_call_size_estimate(grpc_channel *channel,
   }
 }
 
+gpr_arena *grpc_channel_create_call_arena(grpc_channel *channel) {
+  return gpr_arena_create_from_pool(
+      channel->call_arena_pool, grpc_channel_get_call_size_estimate(channel));
+}
+
 char *grpc_channel_get_target(grpc_channel *channel) {
   GRPC_API_TRACE("grpc_channel_get_target(channel=%p)", 1, (channel));
   return gpr_strdup(channel->target);
@@ -374,6 +384,7 @@ static void destroy_channel(grpc_exec_ctx *exec_ctx, void *arg,
   }
   GRPC_MDELEM_UNREF(exec_ctx, channel->default_authority);
   gpr_mu_destroy(&channel->registered_call_mu);
+  gpr_arena_pool_destroy(channel->call_arena_pool);
   gpr_free(channel->target);
   gpr_free(channel);
 }
@@ -59,6 +59,11 @@ grpc_mdelem grpc_channel_get_reffed_status_elem(grpc_exec_ctx *exec_ctx,
 size_t grpc_channel_get_call_size_estimate(grpc_channel *channel);
 void grpc_channel_update_call_size_estimate(grpc_channel *channel, size_t size);
 
+/** Create an arena for a new call on \a channel, sized from the channel's call
+    size estimate; destroying it hands its buffer back to the channel for reuse
+    by later calls */
+gpr_arena *grpc_channel_create_call_arena(grpc_channel *channel);
+
 #ifndef NDEBUG
 void grpc_channel_internal_ref(grpc_channel *channel, const char *reason);
 void grpc_channel_internal_unref(grpc_exec_ctx *exec_ctx, grpc_channel *channel,
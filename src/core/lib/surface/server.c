@@ -29,6 +29,7 @@
 
 #include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/channel/connected_channel.h"
+#include "src/core/lib/debug/stats.h"
 #include "src/core/lib/iomgr/executor.h"
 #include "src/core/lib/iomgr/iomgr.h"
 #include "src/core/lib/slice/slice_internal.h"
@@ -82,13 +83,22 @@ typedef struct requested_call {
   } data;
 } requested_call;
 
-typedef struct channel_registered_method {
+typedef struct registered_method_slot {
   registered_method *server_registered_method;
   uint32_t flags;
   bool has_host;
   grpc_slice method;
   grpc_slice host;
-} channel_registered_method;
+} registered_method_slot;
+
+/* open addressed hash table of registered methods, keyed by the interned
+   method (and host, if any) slices: built once by grpc_server_start and shared
+   by every channel on the server */
+typedef struct registered_method_table {
+  registered_method_slot *slots;
+  uint32_t num_slots;
+  uint32_t max_probes;
+} registered_method_table;
 
 struct channel_data {
   grpc_server *server;
@@ -98,9 +108,6 @@ struct channel_data {
   /* linked list of all channels on a server */
   channel_data *next;
   channel_data *prev;
-  channel_registered_method *registered_methods;
-  uint32_t registered_method_slots;
-  uint32_t registered_method_max_probes;
   grpc_closure finish_destroy_channel_closure;
   grpc_closure channel_connectivity_changed;
 };
@@ -157,10 +164,20 @@ struct call_data {
   call_data *pending_next;
 };
 
-struct request_matcher {
-  grpc_server *server;
+/* calls waiting for a request, queued against one completion queue */
+typedef struct pending_call_shard {
+  gpr_mu mu;
   call_data *pending_head;
   call_data *pending_tail;
+  char padding[GPR_CACHELINE_SIZE];
+} pending_call_shard;
+
+struct request_matcher {
+  grpc_server *server;
+  /* one shard per cq: a call that finds no request waiting is queued on the
+     shard of the cq its channel is affine to, so accepting calls on
+     different cqs does not serialize on a single lock */
+  pending_call_shard *pending_per_cq;
   gpr_stack_lockfree **requests_per_cq;
 };
 
@@ -188,15 +205,14 @@ struct grpc_server {
   size_t pollset_count;
   bool started;
 
-  /* The two following mutexes control access to server-state
-     mu_global controls access to non-call-related state (e.g., channel state)
-     mu_call controls access to call-related state (e.g., the call lists)
+  /* mu_global controls access to non-call-related state (e.g., channel
+     state); calls waiting to be matched are guarded by the per-cq shard locks
+     of their request_matcher.
 
      If they are ever required to be nested, you must lock mu_global
-     before mu_call. This is currently used in shutdown processing
+     before a shard lock. This is currently used in shutdown processing
      (grpc_server_shutdown_and_notify and maybe_finish_shutdown) */
   gpr_mu mu_global; /* mutex for server and channel state */
-  gpr_mu mu_call;   /* mutex for call-specific state */
 
   /* startup synchronization: flag is protected by mu_global, signals whether
      we are doing the listener start routine or not */
@@ -204,6 +220,10 @@ struct grpc_server {
   gpr_cv starting_cv;
 
   registered_method *registered_methods;
+  /** lookup tables for registered_methods, split by whether the registration
+      names a host: built by grpc_server_start */
+  registered_method_table host_registered_methods;
+  registered_method_table wildcard_registered_methods;
   /** one request matcher for unregistered methods */
   request_matcher unregistered_request_matcher;
   /** free list of available requested_calls_per_cq indices */
@@ -234,8 +254,8 @@ static void publish_new_rpc(grpc_exec_ctx *exec_ctx, void *calld,
                             grpc_error *error);
 static void fail_call(grpc_exec_ctx *exec_ctx, grpc_server *server,
                       size_t cq_idx, requested_call *rc, grpc_error *error);
-/* Before calling maybe_finish_shutdown, we must hold mu_global and not
-   hold mu_call */
+/* Before calling maybe_finish_shutdown, we must hold mu_global and no
+   request_matcher shard lock */
 static void maybe_finish_shutdown(grpc_exec_ctx *exec_ctx, grpc_server *server);
 
 /*
@@ -314,9 +334,12 @@ static void request_matcher_init(request_matcher *rm, size_t entries,
                                  grpc_server *server) {
   memset(rm, 0, sizeof(*rm));
   rm->server = server;
+  rm->pending_per_cq =
+      gpr_zalloc(sizeof(*rm->pending_per_cq) * server->cq_count);
   rm->requests_per_cq =
       gpr_malloc(sizeof(*rm->requests_per_cq) * server->cq_count);
   for (size_t i = 0; i < server->cq_count; i++) {
+    gpr_mu_init(&rm->pending_per_cq[i].mu);
     rm->requests_per_cq[i] = gpr_stack_lockfree_create(entries);
   }
 }
@@ -325,8 +348,24 @@ static void request_matcher_destroy(request_matcher *rm) {
   for (size_t i = 0; i < rm->server->cq_count; i++) {
     GPR_ASSERT(gpr_stack_lockfree_pop(rm->requests_per_cq[i]) == -1);
     gpr_stack_lockfree_destroy(rm->requests_per_cq[i]);
+    gpr_mu_destroy(&rm->pending_per_cq[i].mu);
   }
   gpr_free(rm->requests_per_cq);
+  gpr_free(rm->pending_per_cq);
+}
+
+/* pop a request from rm, trying the queue of cq start_cq_idx first and then
+   the other cqs in turn: returns -1 if no request is queued anywhere,
+   otherwise the request id, with its cq in *cq_idx */
+static int request_matcher_pop_request(request_matcher *rm,
+                                       size_t start_cq_idx, size_t *cq_idx) {
+  size_t cq_count = rm->server->cq_count;
+  for (size_t i = 0; i < cq_count; i++) {
+    *cq_idx = (start_cq_idx + i) % cq_count;
+    int request_id = gpr_stack_lockfree_pop(rm->requests_per_cq[*cq_idx]);
+    if (request_id != -1) return request_id;
+  }
+  return -1;
 }
 
 static void kill_zombie(grpc_exec_ctx *exec_ctx, void *elem,
@@ -336,17 +375,23 @@ static void kill_zombie(grpc_exec_ctx *exec_ctx, void *elem,
 
 static void request_matcher_zombify_all_pending_calls(grpc_exec_ctx *exec_ctx,
                                                       request_matcher *rm) {
-  while (rm->pending_head) {
-    call_data *calld = rm->pending_head;
-    rm->pending_head = calld->pending_next;
-    gpr_mu_lock(&calld->mu_state);
-    calld->state = ZOMBIED;
-    gpr_mu_unlock(&calld->mu_state);
-    GRPC_CLOSURE_INIT(
-        &calld->kill_zombie_closure, kill_zombie,
-        grpc_call_stack_element(grpc_call_get_call_stack(calld->call), 0),
-        grpc_schedule_on_exec_ctx);
-    GRPC_CLOSURE_SCHED(exec_ctx, &calld->kill_zombie_closure, GRPC_ERROR_NONE);
+  for (size_t i = 0; i < rm->server->cq_count; i++) {
+    pending_call_shard *shard = &rm->pending_per_cq[i];
+    gpr_mu_lock(&shard->mu);
+    while (shard->pending_head) {
+      call_data *calld = shard->pending_head;
+      shard->pending_head = calld->pending_next;
+      gpr_mu_lock(&calld->mu_state);
+      calld->state = ZOMBIED;
+      gpr_mu_unlock(&calld->mu_state);
+      GRPC_CLOSURE_INIT(
+          &calld->kill_zombie_closure, kill_zombie,
+          grpc_call_stack_element(grpc_call_get_call_stack(calld->call), 0),
+          grpc_schedule_on_exec_ctx);
+      GRPC_CLOSURE_SCHED(exec_ctx, &calld->kill_zombie_closure,
+                         GRPC_ERROR_NONE);
+    }
+    gpr_mu_unlock(&shard->mu);
   }
 }
 
@@ -366,6 +411,85 @@ static void request_matcher_kill_requests(grpc_exec_ctx *exec_ctx,
   GRPC_ERROR_UNREF(error);
 }
 
+/*
+ * registered_method_table
+ */
+
+static void registered_method_table_init(registered_method_table *table,
+                                         grpc_server *server, bool with_host) {
+  size_t num_registered_methods = 0;
+  for (registered_method *rm = server->registered_methods; rm; rm = rm->next) {
+    if ((rm->host != NULL) == with_host) num_registered_methods++;
+  }
+  memset(table, 0, sizeof(*table));
+  if (num_registered_methods == 0) return;
+  size_t slots = 2 * num_registered_methods;
+  GPR_ASSERT(slots <= UINT32_MAX);
+  table->slots = gpr_zalloc(sizeof(registered_method_slot) * slots);
+  table->num_slots = (uint32_t)slots;
+  for (registered_method *rm = server->registered_methods; rm; rm = rm->next) {
+    if ((rm->host != NULL) != with_host) continue;
+    grpc_slice method =
+        grpc_slice_intern(grpc_slice_from_static_string(rm->method));
+    uint32_t hash = grpc_slice_hash(method);
+    grpc_slice host;
+    if (with_host) {
+      host = grpc_slice_intern(grpc_slice_from_static_string(rm->host));
+      hash = GRPC_MDSTR_KV_HASH(grpc_slice_hash(host), hash);
+    }
+    uint32_t probes;
+    for (probes = 0;
+         table->slots[(hash + probes) % slots].server_registered_method != NULL;
+         probes++)
+      ;
+    if (probes > table->max_probes) table->max_probes = probes;
+    registered_method_slot *slot = &table->slots[(hash + probes) % slots];
+    slot->server_registered_method = rm;
+    slot->flags = rm->flags;
+    slot->has_host = with_host;
+    slot->method = method;
+    if (with_host) {
+      slot->host = host;
+    }
+  }
+}
+
+static void registered_method_table_destroy(grpc_exec_ctx *exec_ctx,
+                                            registered_method_table *table) {
+  for (uint32_t i = 0; i < table->num_slots; i++) {
+    registered_method_slot *slot = &table->slots[i];
+    if (slot->server_registered_method == NULL) continue;
+    grpc_slice_unref_internal(exec_ctx, slot->method);
+    if (slot->has_host) {
+      grpc_slice_unref_internal(exec_ctx, slot->host);
+    }
+  }
+  gpr_free(table->slots);
+}
+
+/* hash is the hash of path alone for the wildcard table, and of (host, path)
+   for the host table; host is ignored by the wildcard table */
+static registered_method *registered_method_table_lookup(
+    registered_method_table *table, uint32_t hash, grpc_slice host,
+    grpc_slice path, uint32_t recv_initial_metadata_flags) {
+  for (uint32_t i = 0; i <= table->max_probes; i++) {
+    registered_method_slot *slot =
+        &table->slots[(hash + i) % table->num_slots];
+    /* nothing was ever displaced past an empty slot */
+    if (slot->server_registered_method == NULL) return NULL;
+    /* interned paths compare by pointer here */
+    if (!grpc_slice_eq(slot->method, path)) continue;
+    if (slot->has_host && !grpc_slice_eq(slot->host, host)) continue;
+    if ((slot->flags & GRPC_INITIAL_METADATA_IDEMPOTENT_REQUEST) &&
+        0 == (recv_initial_metadata_flags &
+              GRPC_INITIAL_METADATA_IDEMPOTENT_REQUEST)) {
+      continue;
+    }
+    return slot->server_registered_method;
+  }
+  return NULL;
+}
+
 /*
  * server proper
  */
@@ -379,7 +503,6 @@ static void server_delete(grpc_exec_ctx *exec_ctx, grpc_server *server) {
   size_t i;
   grpc_channel_args_destroy(exec_ctx, server->channel_args);
   gpr_mu_destroy(&server->mu_global);
-  gpr_mu_destroy(&server->mu_call);
   gpr_cv_destroy(&server->starting_cv);
   while ((rm = server->registered_methods) != NULL) {
     server->registered_methods = rm->next;
@@ -392,6 +515,9 @@ static void server_delete(grpc_exec_ctx *exec_ctx, grpc_server *server) {
   }
   if (server->started) {
     request_matcher_destroy(&server->unregistered_request_matcher);
+    registered_method_table_destroy(exec_ctx, &server->host_registered_methods);
+    registered_method_table_destroy(exec_ctx,
+                                    &server->wildcard_registered_methods);
   }
   for (i = 0; i < server->cq_count; i++) {
     GRPC_CQ_INTERNAL_UNREF(exec_ctx, server->cqs[i], "server");
@@ -532,34 +658,47 @@ static void publish_new_rpc(grpc_exec_ctx *exec_ctx, void *arg,
     return;
   }
 
-  for (size_t i = 0; i < server->cq_count; i++) {
-    size_t cq_idx = (chand->cq_idx + i) % server->cq_count;
-    int request_id = gpr_stack_lockfree_pop(rm->requests_per_cq[cq_idx]);
-    if (request_id == -1) {
-      continue;
-    } else {
-      gpr_mu_lock(&calld->mu_state);
-      calld->state = ACTIVATED;
-      gpr_mu_unlock(&calld->mu_state);
-      publish_call(exec_ctx, server, calld, cq_idx,
-                   &server->requested_calls_per_cq[cq_idx][request_id]);
-      return; /* early out */
-    }
+  /* prefer a request on the cq this channel is affine to (the one polling
+     the pollset that accepted it), falling back to any other cq */
+  size_t cq_idx;
+  int request_id = request_matcher_pop_request(rm, chand->cq_idx, &cq_idx);
+  if (request_id != -1) {
+    gpr_mu_lock(&calld->mu_state);
+    calld->state = ACTIVATED;
+    gpr_mu_unlock(&calld->mu_state);
+    publish_call(exec_ctx, server, calld, cq_idx,
+                 &server->requested_calls_per_cq[cq_idx][request_id]);
+    return; /* early out */
+  }
+
+  /* no cq to take the request found: queue it on the slow list of our shard.
+     queue_call_request pushes a request before scanning the shards, so look
+     again under the shard lock: either we see that request here, or it sees
+     this call once we unlock */
+  GRPC_STATS_INC_SERVER_SLOWPATH_REQUESTS_QUEUED(exec_ctx);
+  pending_call_shard *shard = &rm->pending_per_cq[chand->cq_idx];
+  gpr_mu_lock(&shard->mu);
+  request_id = request_matcher_pop_request(rm, chand->cq_idx, &cq_idx);
+  if (request_id != -1) {
+    gpr_mu_unlock(&shard->mu);
+    gpr_mu_lock(&calld->mu_state);
+    calld->state = ACTIVATED;
+    gpr_mu_unlock(&calld->mu_state);
+    publish_call(exec_ctx, server, calld, cq_idx,
+                 &server->requested_calls_per_cq[cq_idx][request_id]);
+    return;
   }
-
-  /* no cq to take the request found: queue it on the slow list */
-  gpr_mu_lock(&server->mu_call);
   gpr_mu_lock(&calld->mu_state);
   calld->state = PENDING;
   gpr_mu_unlock(&calld->mu_state);
-  if (rm->pending_head == NULL) {
-    rm->pending_tail = rm->pending_head = calld;
+  if (shard->pending_head == NULL) {
+    shard->pending_tail = shard->pending_head = calld;
   } else {
-    rm->pending_tail->pending_next = calld;
-    rm->pending_tail = calld;
+    shard->pending_tail->pending_next = calld;
+    shard->pending_tail = calld;
   }
   calld->pending_next = NULL;
-  gpr_mu_unlock(&server->mu_call);
+  gpr_mu_unlock(&shard->mu);
 }
 
 static void finish_start_new_rpc(
@@ -602,48 +741,28 @@ static void start_new_rpc(grpc_exec_ctx *exec_ctx, grpc_call_element *elem) {
   channel_data *chand = elem->channel_data;
   call_data *calld = elem->call_data;
   grpc_server *server = chand->server;
-  uint32_t i;
-  uint32_t hash;
-  channel_registered_method *rm;
 
-  if (chand->registered_methods && calld->path_set && calld->host_set) {
-    /* TODO(ctiller): unify these two searches */
+  if (server->registered_methods != NULL && calld->path_set &&
+      calld->host_set) {
+    /* the path hash is cached on interned slices, so this is usually free */
+    uint32_t path_hash = grpc_slice_hash(calld->path);
+    registered_method *rm = NULL;
     /* check for an exact match with host */
-    hash = GRPC_MDSTR_KV_HASH(grpc_slice_hash(calld->host),
-                              grpc_slice_hash(calld->path));
-    for (i = 0; i <= chand->registered_method_max_probes; i++) {
-      rm = &chand->registered_methods[(hash + i) %
-                                      chand->registered_method_slots];
-      if (!rm) break;
-      if (!rm->has_host) continue;
-      if (!grpc_slice_eq(rm->host, calld->host)) continue;
-      if (!grpc_slice_eq(rm->method, calld->path)) continue;
-      if ((rm->flags & GRPC_INITIAL_METADATA_IDEMPOTENT_REQUEST) &&
-          0 == (calld->recv_initial_metadata_flags &
-                GRPC_INITIAL_METADATA_IDEMPOTENT_REQUEST)) {
-        continue;
-      }
-      finish_start_new_rpc(exec_ctx, server, elem,
-                           &rm->server_registered_method->request_matcher,
-                           rm->server_registered_method->payload_handling);
-      return;
+    if (server->host_registered_methods.num_slots != 0) {
+      rm = registered_method_table_lookup(
+          &server->host_registered_methods,
+          GRPC_MDSTR_KV_HASH(grpc_slice_hash(calld->host), path_hash),
+          calld->host, calld->path, calld->recv_initial_metadata_flags);
     }
     /* check for a wildcard method definition (no host set) */
-    hash = GRPC_MDSTR_KV_HASH(0, grpc_slice_hash(calld->path));
-    for (i = 0; i <= chand->registered_method_max_probes; i++) {
-      rm = &chand->registered_methods[(hash + i) %
-                                      chand->registered_method_slots];
-      if (!rm) break;
-      if (rm->has_host) continue;
-      if (!grpc_slice_eq(rm->method, calld->path)) continue;
-      if ((rm->flags & GRPC_INITIAL_METADATA_IDEMPOTENT_REQUEST) &&
-          0 == (calld->recv_initial_metadata_flags &
-                GRPC_INITIAL_METADATA_IDEMPOTENT_REQUEST)) {
-        continue;
-      }
-      finish_start_new_rpc(exec_ctx, server, elem,
-                           &rm->server_registered_method->request_matcher,
-                           rm->server_registered_method->payload_handling);
+    if (rm == NULL && server->wildcard_registered_methods.num_slots != 0) {
+      rm = registered_method_table_lookup(
+          &server->wildcard_registered_methods, path_hash, calld->host,
+          calld->path, calld->recv_initial_metadata_flags);
+    }
+    if (rm != NULL) {
+      finish_start_new_rpc(exec_ctx, server, elem, &rm->request_matcher,
+                           rm->payload_handling);
       return;
     }
   }
@@ -676,8 +795,8 @@ static int num_channels(grpc_server *server) {
   return n;
 }
 
-static void kill_pending_work_locked(grpc_exec_ctx *exec_ctx,
-                                     grpc_server *server, grpc_error *error) {
+static void kill_pending_work(grpc_exec_ctx *exec_ctx, grpc_server *server,
+                              grpc_error *error) {
   if (server->started) {
     request_matcher_kill_requests(exec_ctx, server,
                                   &server->unregistered_request_matcher,
@@ -701,9 +820,8 @@ static void maybe_finish_shutdown(grpc_exec_ctx *exec_ctx,
     return;
   }
 
-  kill_pending_work_locked(
-      exec_ctx, server,
-      GRPC_ERROR_CREATE_FROM_STATIC_STRING("Server Shutdown"));
+  kill_pending_work(exec_ctx, server,
+                    GRPC_ERROR_CREATE_FROM_STATIC_STRING("Server Shutdown"));
 
   if (server->root_channel_data.next != &server->root_channel_data ||
       server->listeners_destroyed < num_listeners(server)) {
@@ -920,7 +1038,6 @@ static grpc_error *init_channel_elem(grpc_exec_ctx *exec_ctx,
   chand->server = NULL;
   chand->channel = NULL;
   chand->next = chand->prev = chand;
-  chand->registered_methods = NULL;
   chand->connectivity_state = GRPC_CHANNEL_IDLE;
   GRPC_CLOSURE_INIT(&chand->channel_connectivity_changed,
                     channel_connectivity_changed, chand,
@@ -930,17 +1047,7 @@ static grpc_error *init_channel_elem(grpc_exec_ctx *exec_ctx,
 
 static void destroy_channel_elem(grpc_exec_ctx *exec_ctx,
                                  grpc_channel_element *elem) {
-  size_t i;
   channel_data *chand = elem->channel_data;
-  if (chand->registered_methods) {
-    for (i = 0; i < chand->registered_method_slots; i++) {
-      grpc_slice_unref_internal(exec_ctx, chand->registered_methods[i].method);
-      if (chand->registered_methods[i].has_host) {
-        grpc_slice_unref_internal(exec_ctx, chand->registered_methods[i].host);
-      }
-    }
-    gpr_free(chand->registered_methods);
-  }
   if (chand->server) {
     gpr_mu_lock(&chand->server->mu_global);
     chand->next->prev = chand->prev;
@@ -1007,7 +1114,6 @@ grpc_server *grpc_server_create(const grpc_channel_args *args, void *reserved) {
   grpc_server *server = gpr_zalloc(sizeof(grpc_server));
 
   gpr_mu_init(&server->mu_global);
-  gpr_mu_init(&server->mu_call);
   gpr_cv_init(&server->starting_cv);
 
   /* decremented by grpc_server_destroy */
@@ -1113,6 +1219,11 @@ void grpc_server_start(grpc_server *server) {
     request_matcher_init(&rm->request_matcher,
                          (size_t)server->max_requested_calls_per_cq, server);
   }
+  /* registrations are frozen from here on: build the method lookup tables once
+     rather than per channel */
+  registered_method_table_init(&server->host_registered_methods, server, true);
+  registered_method_table_init(&server->wildcard_registered_methods, server,
+                               false);
 
   server_ref(server);
   server->starting = true;
@@ -1133,16 +1244,8 @@ void grpc_server_setup_transport(grpc_exec_ctx *exec_ctx, grpc_server *s,
                                  grpc_transport *transport,
                                  grpc_pollset *accepting_pollset,
                                  const grpc_channel_args *args) {
-  size_t num_registered_methods;
-  size_t alloc;
-  registered_method *rm;
-  channel_registered_method *crm;
   grpc_channel *channel;
   channel_data *chand;
-  uint32_t hash;
-  size_t slots;
-  uint32_t probes;
-  uint32_t max_probes = 0;
   grpc_transport_op *op = NULL;
 
   channel =
@@ -1164,48 +1267,6 @@ void grpc_server_setup_transport(grpc_exec_ctx *exec_ctx, grpc_server *s,
   }
   chand->cq_idx = cq_idx;
 
-  num_registered_methods = 0;
-  for (rm = s->registered_methods; rm; rm = rm->next) {
-    num_registered_methods++;
-  }
-  /* build a lookup table phrased in terms of mdstr's in this channels context
-     to quickly find registered methods */
-  if (num_registered_methods > 0) {
-    slots = 2 * num_registered_methods;
-    alloc = sizeof(channel_registered_method) * slots;
-    chand->registered_methods = gpr_zalloc(alloc);
-    for (rm = s->registered_methods; rm; rm = rm->next) {
-      grpc_slice host;
-      bool has_host;
-      grpc_slice method;
-      if (rm->host != NULL) {
-        host = grpc_slice_intern(grpc_slice_from_static_string(rm->host));
-        has_host = true;
-      } else {
-        has_host = false;
-      }
-      method = grpc_slice_intern(grpc_slice_from_static_string(rm->method));
-      hash = GRPC_MDSTR_KV_HASH(has_host ? grpc_slice_hash(host) : 0,
-                                grpc_slice_hash(method));
-      for (probes = 0; chand->registered_methods[(hash + probes) % slots]
-                           .server_registered_method != NULL;
-           probes++)
-        ;
-      if (probes > max_probes) max_probes = probes;
-      crm = &chand->registered_methods[(hash + probes) % slots];
-      crm->server_registered_method = rm;
-      crm->flags = rm->flags;
-      crm->has_host = has_host;
-      if (has_host) {
-        crm->host = host;
-      }
-      crm->method = method;
-    }
-    GPR_ASSERT(slots <= UINT32_MAX);
-    chand->registered_method_slots = (uint32_t)slots;
-    chand->registered_method_max_probes = max_probes;
-  }
-
   gpr_mu_lock(&s->mu_global);
   chand->next = &s->root_channel_data;
   chand->prev = chand->next->prev;
@@ -1284,11 +1345,8 @@ void grpc_server_shutdown_and_notify(grpc_server *server,
   gpr_atm_rel_store(&server->shutdown_flag, 1);
 
   /* collect all unregistered then registered calls */
-  gpr_mu_lock(&server->mu_call);
-  kill_pending_work_locked(
-      &exec_ctx, server,
-      GRPC_ERROR_CREATE_FROM_STATIC_STRING("Server Shutdown"));
-  gpr_mu_unlock(&server->mu_call);
+  kill_pending_work(&exec_ctx, server,
+                    GRPC_ERROR_CREATE_FROM_STATIC_STRING("Server Shutdown"));
 
   maybe_finish_shutdown(&exec_ctx, server);
   gpr_mu_unlock(&server->mu_global);
@@ -1391,32 +1449,37 @@ static grpc_call_error queue_call_request(grpc_exec_ctx *exec_ctx,
   gpr_free(rc);
   if (gpr_stack_lockfree_push(rm->requests_per_cq[cq_idx], request_id)) {
     /* this was the first queued request: we need to lock and start
-       matching calls */
-    gpr_mu_lock(&server->mu_call);
-    while ((calld = rm->pending_head) != NULL) {
-      request_id = gpr_stack_lockfree_pop(rm->requests_per_cq[cq_idx]);
-      if (request_id == -1) break;
-      rm->pending_head = calld->pending_next;
-      gpr_mu_unlock(&server->mu_call);
-      gpr_mu_lock(&calld->mu_state);
-      if (calld->state == ZOMBIED) {
-        gpr_mu_unlock(&calld->mu_state);
-        GRPC_CLOSURE_INIT(
-            &calld->kill_zombie_closure, kill_zombie,
-            grpc_call_stack_element(grpc_call_get_call_stack(calld->call), 0),
-            grpc_schedule_on_exec_ctx);
-        GRPC_CLOSURE_SCHED(exec_ctx, &calld->kill_zombie_closure,
-                           GRPC_ERROR_NONE);
-      } else {
-        GPR_ASSERT(calld->state == PENDING);
-        calld->state = ACTIVATED;
-        gpr_mu_unlock(&calld->mu_state);
-        publish_call(exec_ctx, server, calld, cq_idx,
-                     &server->requested_calls_per_cq[cq_idx][request_id]);
+       matching calls, starting with the ones pending on this cq's shard */
+    for (size_t i = 0; i < server->cq_count && request_id != -1; i++) {
+      pending_call_shard *shard =
+          &rm->pending_per_cq[(cq_idx + i) % server->cq_count];
+      gpr_mu_lock(&shard->mu);
+      while ((calld = shard->pending_head) != NULL) {
+        request_id = gpr_stack_lockfree_pop(rm->requests_per_cq[cq_idx]);
+        if (request_id == -1) break;
+        shard->pending_head = calld->pending_next;
+        gpr_mu_unlock(&shard->mu);
+        gpr_mu_lock(&calld->mu_state);
+        if (calld->state == ZOMBIED) {
+          gpr_mu_unlock(&calld->mu_state);
+          GRPC_CLOSURE_INIT(
+              &calld->kill_zombie_closure, kill_zombie,
+              grpc_call_stack_element(grpc_call_get_call_stack(calld->call),
+                                      0),
+              grpc_schedule_on_exec_ctx);
+          GRPC_CLOSURE_SCHED(exec_ctx, &calld->kill_zombie_closure,
+                             GRPC_ERROR_NONE);
+        } else {
+          GPR_ASSERT(calld->state == PENDING);
+          calld->state = ACTIVATED;
+          gpr_mu_unlock(&calld->mu_state);
+          publish_call(exec_ctx, server, calld, cq_idx,
+                       &server->requested_calls_per_cq[cq_idx][request_id]);
+        }
+        gpr_mu_lock(&shard->mu);
       }
-      gpr_mu_lock(&server->mu_call);
+      gpr_mu_unlock(&shard->mu);
     }
-    gpr_mu_unlock(&server->mu_call);
   }
   return GRPC_CALL_OK;
 }
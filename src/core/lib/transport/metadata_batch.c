@@ -51,9 +51,14 @@ static void assert_valid_list(grpc_mdelem_list *list) {
 #endif /* NDEBUG */
 }
 
+static size_t custom_bucket_of(grpc_slice key) {
+  return grpc_slice_hash(key) & (GRPC_METADATA_BATCH_CUSTOM_BUCKETS - 1);
+}
+
 static void assert_valid_callouts(grpc_exec_ctx *exec_ctx,
                                   grpc_metadata_batch *batch) {
 #ifndef NDEBUG
+  size_t custom_count = 0;
   for (grpc_linked_mdelem *l = batch->list.head; l != NULL; l = l->next) {
     grpc_slice key_interned = grpc_slice_intern(GRPC_MDKEY(l->md));
     grpc_metadata_batch_callouts_index callout_idx =
@@ -62,7 +67,18 @@ static void assert_valid_callouts(grpc_exec_ctx *exec_ctx,
       GPR_ASSERT(batch->idx.array[callout_idx] == l);
     }
     grpc_slice_unref_internal(exec_ctx, key_interned);
+    if (GRPC_BATCH_INDEX_OF(GRPC_MDKEY(l->md)) == GRPC_BATCH_CALLOUTS_COUNT) {
+      custom_count++;
+    }
   }
+  for (size_t i = 0; i < GRPC_METADATA_BATCH_CUSTOM_BUCKETS; i++) {
+    for (grpc_linked_mdelem *l = batch->custom_idx[i]; l != NULL;
+         l = l->next_in_bucket) {
+      GPR_ASSERT(custom_bucket_of(GRPC_MDKEY(l->md)) == i);
+      custom_count--;
+    }
+  }
+  GPR_ASSERT(custom_count == 0);
 #endif
 }
 
@@ -93,15 +109,57 @@ grpc_error *grpc_attach_md_to_error(grpc_error *src, grpc_mdelem md) {
   return out;
 }
 
+/* Custom keys are chained in list order, so that find returns the first
+   element with a key. at_head says whether storage is being (or was) linked at
+   the head of the list rather than at the tail. */
+static void link_custom(grpc_metadata_batch *batch, grpc_linked_mdelem *storage,
+                        bool at_head) {
+  grpc_linked_mdelem **p =
+      &batch->custom_idx[custom_bucket_of(GRPC_MDKEY(storage->md))];
+  if (!at_head) {
+    while (*p != NULL) p = &(*p)->next_in_bucket;
+  }
+  storage->next_in_bucket = *p;
+  *p = storage;
+}
+
+static void unlink_custom(grpc_metadata_batch *batch,
+                          grpc_linked_mdelem *storage) {
+  grpc_linked_mdelem **p =
+      &batch->custom_idx[custom_bucket_of(GRPC_MDKEY(storage->md))];
+  while (*p != storage) {
+    GPR_ASSERT(*p != NULL);
+    p = &(*p)->next_in_bucket;
+  }
+  *p = storage->next_in_bucket;
+  storage->next_in_bucket = NULL;
+}
+
+/* Rechain a bucket in list order: only needed when an element changes key in
+   place, which is rare */
+static void reindex_custom_bucket(grpc_metadata_batch *batch, size_t bucket) {
+  grpc_linked_mdelem **p = &batch->custom_idx[bucket];
+  for (grpc_linked_mdelem *l = batch->list.head; l != NULL; l = l->next) {
+    if (GRPC_BATCH_INDEX_OF(GRPC_MDKEY(l->md)) == GRPC_BATCH_CALLOUTS_COUNT &&
+        custom_bucket_of(GRPC_MDKEY(l->md)) == bucket) {
+      *p = l;
+      p = &l->next_in_bucket;
+    }
+  }
+  *p = NULL;
+}
+
 static grpc_error *maybe_link_callout(grpc_metadata_batch *batch,
-                                      grpc_linked_mdelem *storage)
-    GRPC_MUST_USE_RESULT;
+                                      grpc_linked_mdelem *storage,
+                                      bool at_head) GRPC_MUST_USE_RESULT;
 
 static grpc_error *maybe_link_callout(grpc_metadata_batch *batch,
-                                      grpc_linked_mdelem *storage) {
+                                      grpc_linked_mdelem *storage,
+                                      bool at_head) {
   grpc_metadata_batch_callouts_index idx =
       GRPC_BATCH_INDEX_OF(GRPC_MDKEY(storage->md));
   if (idx == GRPC_BATCH_CALLOUTS_COUNT) {
+    link_custom(batch, storage, at_head);
     return GRPC_ERROR_NONE;
   }
   if (batch->idx.array[idx] == NULL) {
@@ -118,6 +176,7 @@ static void maybe_unlink_callout(grpc_metadata_batch *batch,
   grpc_metadata_batch_callouts_index idx =
       GRPC_BATCH_INDEX_OF(GRPC_MDKEY(storage->md));
   if (idx == GRPC_BATCH_CALLOUTS_COUNT) {
+    unlink_custom(batch, storage);
     return;
   }
   GPR_ASSERT(batch->idx.array[idx] != NULL);
@@ -152,7 +211,7 @@ grpc_error *grpc_metadata_batch_link_head(grpc_exec_ctx *exec_ctx,
                                           grpc_metadata_batch *batch,
                                           grpc_linked_mdelem *storage) {
   assert_valid_callouts(exec_ctx, batch);
-  grpc_error *err = maybe_link_callout(batch, storage);
+  grpc_error *err = maybe_link_callout(batch, storage, true);
   if (err != GRPC_ERROR_NONE) {
     assert_valid_callouts(exec_ctx, batch);
     return err;
@@ -176,7 +235,6 @@ static void link_tail(grpc_mdelem_list *list, grpc_linked_mdelem *storage) {
   GPR_ASSERT(!GRPC_MDISNULL(storage->md));
   storage->prev = list->tail;
   storage->next = NULL;
-  storage->reserved = NULL;
   if (list->tail != NULL) {
     list->tail->next = storage;
   } else {
@@ -191,7 +249,7 @@ grpc_error *grpc_metadata_batch_link_tail(grpc_exec_ctx *exec_ctx,
                                           grpc_metadata_batch *batch,
                                           grpc_linked_mdelem *storage) {
   assert_valid_callouts(exec_ctx, batch);
-  grpc_error *err = maybe_link_callout(batch, storage);
+  grpc_error *err = maybe_link_callout(batch, storage, false);
   if (err != GRPC_ERROR_NONE) {
     assert_valid_callouts(exec_ctx, batch);
     return err;
@@ -218,6 +276,26 @@ static void unlink_storage(grpc_mdelem_list *list,
   assert_valid_list(list);
 }
 
+grpc_linked_mdelem *grpc_metadata_batch_find(grpc_metadata_batch *batch,
+                                             grpc_slice key) {
+  /* an interned key is never equal to a static one it is not */
+  if (!grpc_slice_is_interned(key)) {
+    bool is_static = false;
+    key = grpc_slice_maybe_static_intern(key, &is_static);
+  }
+  grpc_metadata_batch_callouts_index idx = GRPC_BATCH_INDEX_OF(key);
+  if (idx != GRPC_BATCH_CALLOUTS_COUNT && batch->idx.array[idx] != NULL) {
+    return batch->idx.array[idx];
+  }
+  /* elements with a callout key that is not a static slice are kept with the
+     custom keys: this is also where a callout miss ends up */
+  for (grpc_linked_mdelem *l = batch->custom_idx[custom_bucket_of(key)];
+       l != NULL; l = l->next_in_bucket) {
+    if (grpc_slice_eq(GRPC_MDKEY(l->md), key)) return l;
+  }
+  return NULL;
+}
+
 void grpc_metadata_batch_remove(grpc_exec_ctx *exec_ctx,
                                 grpc_metadata_batch *batch,
                                 grpc_linked_mdelem *storage) {
@@ -245,13 +323,19 @@ grpc_error *grpc_metadata_batch_substitute(grpc_exec_ctx *exec_ctx,
   assert_valid_callouts(exec_ctx, batch);
   grpc_error *error = GRPC_ERROR_NONE;
   grpc_mdelem old = storage->md;
-  if (!grpc_slice_eq(GRPC_MDKEY(new), GRPC_MDKEY(old))) {
+  if (!grpc_slice_eq(GRPC_MDKEY(new), GRPC_MDKEY(old)) ||
+      GRPC_BATCH_INDEX_OF(GRPC_MDKEY(new)) !=
+          GRPC_BATCH_INDEX_OF(GRPC_MDKEY(old))) {
     maybe_unlink_callout(batch, storage);
     storage->md = new;
-    error = maybe_link_callout(batch, storage);
+    error = maybe_link_callout(batch, storage, false);
     if (error != GRPC_ERROR_NONE) {
       unlink_storage(&batch->list, storage);
       GRPC_MDELEM_UNREF(exec_ctx, storage->md);
+    } else if (GRPC_BATCH_INDEX_OF(GRPC_MDKEY(new)) ==
+               GRPC_BATCH_CALLOUTS_COUNT) {
+      /* linked at the bucket tail, but its list position is unchanged */
+      reindex_custom_bucket(batch, custom_bucket_of(GRPC_MDKEY(new)));
     }
   } else {
     storage->md = new;
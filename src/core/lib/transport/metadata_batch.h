@@ -36,7 +36,8 @@ typedef struct grpc_linked_mdelem {
   grpc_mdelem md;
   struct grpc_linked_mdelem *next;
   struct grpc_linked_mdelem *prev;
-  void *reserved;
+  /* next element (in list order) of the same custom key bucket */
+  struct grpc_linked_mdelem *next_in_bucket;
 } grpc_linked_mdelem;
 
 typedef struct grpc_mdelem_list {
@@ -45,10 +46,17 @@ typedef struct grpc_mdelem_list {
   grpc_linked_mdelem *tail;
 } grpc_mdelem_list;
 
+/* Number of hash buckets indexing the keys without a callout: a power of two */
+#define GRPC_METADATA_BATCH_CUSTOM_BUCKETS 16
+
 typedef struct grpc_metadata_batch {
   /** Metadata elements in this batch */
   grpc_mdelem_list list;
   grpc_metadata_batch_callouts idx;
+  /** Elements whose key has no callout, chained through next_in_bucket by
+      key hash. Kept inline (and free of self references) so that batches
+      remain copyable by value */
+  grpc_linked_mdelem *custom_idx[GRPC_METADATA_BATCH_CUSTOM_BUCKETS];
   /** Used to calculate grpc-timeout at the point of sending,
       or gpr_inf_future if this batch does not need to send a
       grpc-timeout */
@@ -65,6 +73,11 @@ bool grpc_metadata_batch_is_empty(grpc_metadata_batch *batch);
 /* Returns the transport size of the batch. */
 size_t grpc_metadata_batch_size(grpc_metadata_batch *batch);
 
+/** Return the first element of \a batch with key \a key, or NULL: constant
+    time for callout keys, a short bucket walk for any other key */
+grpc_linked_mdelem *grpc_metadata_batch_find(grpc_metadata_batch *batch,
+                                             grpc_slice key);
+
 /** Remove \a storage from the batch, unreffing the mdelem contained */
 void grpc_metadata_batch_remove(grpc_exec_ctx *exec_ctx,
                                 grpc_metadata_batch *batch,
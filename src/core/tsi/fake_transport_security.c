@@ -25,7 +25,8 @@
 #include <grpc/support/log.h>
 #include <grpc/support/port_platform.h>
 #include <grpc/support/useful.h>
-#include "src/core/tsi/transport_security.h"
+#include "src/core/lib/slice/slice_internal.h"
+#include "src/core/tsi/transport_security_grpc.h"
 
 /* --- Constants. ---*/
 #define TSI_FAKE_FRAME_HEADER_SIZE 4
@@ -74,6 +75,15 @@ typedef struct {
   size_t max_frame_size;
 } tsi_fake_frame_protector;
 
+typedef struct {
+  tsi_zero_copy_grpc_protector base;
+  /* Bytes received that do not make up a complete frame yet. */
+  grpc_slice_buffer protected_sb;
+  size_t max_frame_size;
+  /* Size of the frame whose header was parsed, or 0. */
+  size_t parsed_frame_size;
+} tsi_fake_zero_copy_grpc_protector;
+
 /* --- Utils. ---*/
 
 static const char *tsi_fake_handshake_message_strings[] = {
@@ -363,6 +373,74 @@ static const tsi_frame_protector_vtable frame_protector_vtable = {
     fake_protector_unprotect, fake_protector_destroy,
 };
 
+/* --- tsi_zero_copy_grpc_protector methods implementation. ---*/
+
+static tsi_result fake_zero_copy_grpc_protector_protect(
+    grpc_exec_ctx *exec_ctx, tsi_zero_copy_grpc_protector *self,
+    grpc_slice_buffer *unprotected_slices,
+    grpc_slice_buffer *protected_slices) {
+  tsi_fake_zero_copy_grpc_protector *impl =
+      (tsi_fake_zero_copy_grpc_protector *)self;
+  /* The payload is moved to the output after its header, without copies. */
+  while (unprotected_slices->length > 0) {
+    size_t frame_length =
+        GPR_MIN(impl->max_frame_size,
+                unprotected_slices->length + TSI_FAKE_FRAME_HEADER_SIZE);
+    grpc_slice header = GRPC_SLICE_MALLOC(TSI_FAKE_FRAME_HEADER_SIZE);
+    store32_little_endian((uint32_t)frame_length, GRPC_SLICE_START_PTR(header));
+    grpc_slice_buffer_add(protected_slices, header);
+    grpc_slice_buffer_move_first(unprotected_slices,
+                                 frame_length - TSI_FAKE_FRAME_HEADER_SIZE,
+                                 protected_slices);
+  }
+  return TSI_OK;
+}
+
+static tsi_result fake_zero_copy_grpc_protector_unprotect(
+    grpc_exec_ctx *exec_ctx, tsi_zero_copy_grpc_protector *self,
+    grpc_slice_buffer *protected_slices,
+    grpc_slice_buffer *unprotected_slices) {
+  tsi_fake_zero_copy_grpc_protector *impl =
+      (tsi_fake_zero_copy_grpc_protector *)self;
+  grpc_slice_buffer_move_into(protected_slices, &impl->protected_sb);
+  for (;;) {
+    if (impl->parsed_frame_size == 0) {
+      unsigned char frame_header[TSI_FAKE_FRAME_HEADER_SIZE];
+      if (impl->protected_sb.length < TSI_FAKE_FRAME_HEADER_SIZE) break;
+      grpc_slice_buffer_move_first_into_buffer(exec_ctx, &impl->protected_sb,
+                                               TSI_FAKE_FRAME_HEADER_SIZE,
+                                               frame_header);
+      impl->parsed_frame_size = load32_little_endian(frame_header);
+      if (impl->parsed_frame_size < TSI_FAKE_FRAME_HEADER_SIZE) {
+        gpr_log(GPR_ERROR, "Invalid frame size.");
+        return TSI_DATA_CORRUPTED;
+      }
+    }
+    const size_t payload_size =
+        impl->parsed_frame_size - TSI_FAKE_FRAME_HEADER_SIZE;
+    if (impl->protected_sb.length < payload_size) break;
+    grpc_slice_buffer_move_first(&impl->protected_sb, payload_size,
+                                 unprotected_slices);
+    impl->parsed_frame_size = 0;
+  }
+  return TSI_OK;
+}
+
+static void fake_zero_copy_grpc_protector_destroy(
+    grpc_exec_ctx *exec_ctx, tsi_zero_copy_grpc_protector *self) {
+  tsi_fake_zero_copy_grpc_protector *impl =
+      (tsi_fake_zero_copy_grpc_protector *)self;
+  grpc_slice_buffer_destroy_internal(exec_ctx, &impl->protected_sb);
+  gpr_free(impl);
+}
+
+static const tsi_zero_copy_grpc_protector_vtable
+    zero_copy_grpc_protector_vtable = {
+        fake_zero_copy_grpc_protector_protect,
+        fake_zero_copy_grpc_protector_unprotect,
+        fake_zero_copy_grpc_protector_destroy,
+};
+
 /* --- tsi_handshaker_result methods implementation. ---*/
 
 typedef struct {
@@ -390,6 +468,15 @@ static tsi_result fake_handshaker_result_create_frame_protector(
   return TSI_OK;
 }
 
+static tsi_result fake_handshaker_result_create_zero_copy_grpc_protector(
+    grpc_exec_ctx *exec_ctx, const tsi_handshaker_result *self,
+    size_t *max_output_protected_frame_size,
+    tsi_zero_copy_grpc_protector **protector) {
+  *protector =
+      tsi_create_fake_zero_copy_grpc_protector(max_output_protected_frame_size);
+  return TSI_OK;
+}
+
 static tsi_result fake_handshaker_result_get_unused_bytes(
     const tsi_handshaker_result *self, unsigned char **bytes,
     size_t *bytes_size) {
@@ -408,6 +495,7 @@ static void fake_handshaker_result_destroy(tsi_handshaker_result *self) {
 static const tsi_handshaker_result_vtable handshaker_result_vtable = {
     fake_handshaker_result_extract_peer,
     fake_handshaker_result_create_frame_protector,
+    fake_handshaker_result_create_zero_copy_grpc_protector,
     fake_handshaker_result_get_unused_bytes, fake_handshaker_result_destroy,
 };
 
@@ -600,6 +688,7 @@ static const tsi_handshaker_vtable handshaker_vtable = {
     NULL, /* create_frame_protector    -- deprecated */
     fake_handshaker_destroy,
     fake_handshaker_next,
+    NULL, /* create_zero_copy_grpc_protector -- use the handshaker result */
 };
 
 tsi_handshaker *tsi_create_fake_handshaker(int is_client) {
@@ -629,3 +718,14 @@ tsi_frame_protector *tsi_create_fake_frame_protector(
   impl->base.vtable = &frame_protector_vtable;
   return &impl->base;
 }
+
+tsi_zero_copy_grpc_protector *tsi_create_fake_zero_copy_grpc_protector(
+    size_t *max_protected_frame_size) {
+  tsi_fake_zero_copy_grpc_protector *impl = gpr_zalloc(sizeof(*impl));
+  grpc_slice_buffer_init(&impl->protected_sb);
+  impl->max_frame_size = (max_protected_frame_size == NULL)
+                             ? TSI_FAKE_DEFAULT_FRAME_SIZE
+                             : *max_protected_frame_size;
+  impl->base.vtable = &zero_copy_grpc_protector_vtable;
+  return &impl->base;
+}
@@ -34,7 +34,9 @@
 #endif
 
 #include <grpc/support/alloc.h>
+#include <grpc/support/avl.h>
 #include <grpc/support/log.h>
+#include <grpc/support/string_util.h>
 #include <grpc/support/sync.h>
 #include <grpc/support/thd.h>
 #include <grpc/support/useful.h>
@@ -42,12 +44,17 @@
 #include <openssl/bio.h>
 #include <openssl/crypto.h> /* For OPENSSL_free */
 #include <openssl/err.h>
+#include <openssl/rand.h>
 #include <openssl/ssl.h>
 #include <openssl/x509.h>
 #include <openssl/x509v3.h>
+#if !defined(OPENSSL_IS_BORINGSSL) && OPENSSL_VERSION_NUMBER >= 0x10101000L
+#include <openssl/kdf.h>
+#endif
 
+#include "src/core/lib/slice/slice_internal.h"
 #include "src/core/tsi/ssl_types.h"
-#include "src/core/tsi/transport_security.h"
+#include "src/core/tsi/transport_security_grpc.h"
 
 /* --- Constants. ---*/
 
@@ -65,12 +72,20 @@
    SSL structure. This is what we would ultimately want though... */
 #define TSI_SSL_MAX_PROTECTION_OVERHEAD 100
 
+/* OpenSSL refuses to resume the sessions of servers which verify the client
+   certificate unless their context has a session id context. */
+#define TSI_SSL_SESSION_ID_CONTEXT "grpc"
+
+/* Upper bound of the size of the keys encrypting session tickets. */
+#define TSI_SSL_MAX_TICKET_KEYS_SIZE 128
+
 /* --- Structure definitions. ---*/
 
 struct tsi_ssl_client_handshaker_factory {
   SSL_CTX *ssl_context;
   unsigned char *alpn_protocol_list;
   size_t alpn_protocol_list_length;
+  tsi_ssl_session_cache *session_cache;
 };
 
 struct tsi_ssl_server_handshaker_factory {
@@ -102,10 +117,48 @@ typedef struct {
   size_t buffer_offset;
 } tsi_ssl_frame_protector;
 
+typedef struct {
+  tsi_zero_copy_grpc_protector base;
+  SSL *ssl;
+  BIO *into_ssl;
+  BIO *from_ssl;
+  /* Serializes the SSL_write of protect with the SSL_read of unprotect. */
+  gpr_mu mu;
+  /* Gathers the data of records that spans several slices. */
+  unsigned char *buffer;
+  size_t buffer_size;
+} tsi_ssl_zero_copy_grpc_protector;
+
+/* Sessions are cached serialized: OpenSSL makes the sessions of the
+   connections freed without a shutdown unresumable, which is how the
+   connections of grpc end. */
+typedef struct tsi_ssl_session_cache_entry {
+  char *server_name;
+  unsigned char *session;
+  size_t session_size;
+  /* Neighbours in the list of the entries, from the most to the least recently
+     used. */
+  struct tsi_ssl_session_cache_entry *prev;
+  struct tsi_ssl_session_cache_entry *next;
+} tsi_ssl_session_cache_entry;
+
+struct tsi_ssl_session_cache {
+  gpr_refcount refs;
+  gpr_mu mu;
+  size_t capacity;
+  size_t size;
+  /* Maps server names to their entries, which the list below owns. */
+  gpr_avl entries_by_name;
+  tsi_ssl_session_cache_entry *most_recently_used;
+  tsi_ssl_session_cache_entry *least_recently_used;
+};
+
 /* --- Library Initialization. ---*/
 
 static gpr_once init_openssl_once = GPR_ONCE_INIT;
 static gpr_mu *openssl_mutexes = NULL;
+/* Index of the client handshaker factory in the ex data of its context. */
+static int ssl_ctx_ex_factory_index = -1;
 
 static void openssl_locking_cb(int mode, int type, const char *file, int line) {
   if (mode & CRYPTO_LOCK) {
@@ -133,6 +186,9 @@ static void init_openssl(void) {
   }
   CRYPTO_set_locking_callback(openssl_locking_cb);
   CRYPTO_set_id_callback(openssl_thread_id_cb);
+  ssl_ctx_ex_factory_index =
+      SSL_CTX_get_ex_new_index(0, NULL, NULL, NULL, NULL);
+  GPR_ASSERT(ssl_ctx_ex_factory_index != -1);
 }
 
 /* --- Ssl utils. ---*/
@@ -846,6 +902,138 @@ static const tsi_frame_protector_vtable frame_protector_vtable = {
     ssl_protector_destroy,
 };
 
+/* --- tsi_zero_copy_grpc_protector methods implementation. ---*/
+
+/* Moves the records sealed by SSL into a single slice of protected_slices. */
+static tsi_result ssl_zero_copy_grpc_protector_flush(
+    grpc_exec_ctx *exec_ctx, tsi_ssl_zero_copy_grpc_protector *impl,
+    grpc_slice_buffer *protected_slices) {
+  int pending = (int)BIO_pending(impl->from_ssl);
+  GPR_ASSERT(pending >= 0);
+  if (pending == 0) return TSI_OK;
+  grpc_slice frames = GRPC_SLICE_MALLOC((size_t)pending);
+  if (BIO_read(impl->from_ssl, GRPC_SLICE_START_PTR(frames), pending) !=
+      pending) {
+    gpr_log(GPR_ERROR, "Could not read from BIO after SSL_write.");
+    grpc_slice_unref_internal(exec_ctx, frames);
+    return TSI_INTERNAL_ERROR;
+  }
+  grpc_slice_buffer_add(protected_slices, frames);
+  return TSI_OK;
+}
+
+static tsi_result ssl_zero_copy_grpc_protector_protect(
+    grpc_exec_ctx *exec_ctx, tsi_zero_copy_grpc_protector *self,
+    grpc_slice_buffer *unprotected_slices,
+    grpc_slice_buffer *protected_slices) {
+  tsi_ssl_zero_copy_grpc_protector *impl =
+      (tsi_ssl_zero_copy_grpc_protector *)self;
+  tsi_result result = TSI_OK;
+  size_t buffer_offset = 0;
+  gpr_mu_lock(&impl->mu);
+  for (size_t i = 0; i < unprotected_slices->count && result == TSI_OK; i++) {
+    unsigned char *bytes = GRPC_SLICE_START_PTR(unprotected_slices->slices[i]);
+    size_t size = GRPC_SLICE_LENGTH(unprotected_slices->slices[i]);
+    while (size > 0) {
+      if (buffer_offset == 0 && size >= impl->buffer_size) {
+        /* SSL cuts full records straight out of large slices. */
+        result = do_ssl_write(impl->ssl, bytes, size);
+        size = 0;
+      } else {
+        size_t to_buffer = GPR_MIN(size, impl->buffer_size - buffer_offset);
+        memcpy(impl->buffer + buffer_offset, bytes, to_buffer);
+        buffer_offset += to_buffer;
+        bytes += to_buffer;
+        size -= to_buffer;
+        if (buffer_offset < impl->buffer_size) continue;
+        result = do_ssl_write(impl->ssl, impl->buffer, buffer_offset);
+        buffer_offset = 0;
+      }
+      if (result == TSI_OK) {
+        result = ssl_zero_copy_grpc_protector_flush(exec_ctx, impl,
+                                                   protected_slices);
+      }
+      if (result != TSI_OK) break;
+    }
+  }
+  if (result == TSI_OK && buffer_offset > 0) {
+    result = do_ssl_write(impl->ssl, impl->buffer, buffer_offset);
+    if (result == TSI_OK) {
+      result = ssl_zero_copy_grpc_protector_flush(exec_ctx, impl,
+                                                   protected_slices);
+    }
+  }
+  gpr_mu_unlock(&impl->mu);
+  grpc_slice_buffer_reset_and_unref_internal(exec_ctx, unprotected_slices);
+  return result;
+}
+
+static tsi_result ssl_zero_copy_grpc_protector_unprotect(
+    grpc_exec_ctx *exec_ctx, tsi_zero_copy_grpc_protector *self,
+    grpc_slice_buffer *protected_slices,
+    grpc_slice_buffer *unprotected_slices) {
+  tsi_ssl_zero_copy_grpc_protector *impl =
+      (tsi_ssl_zero_copy_grpc_protector *)self;
+  tsi_result result = TSI_OK;
+  gpr_mu_lock(&impl->mu);
+  for (size_t i = 0; i < protected_slices->count; i++) {
+    grpc_slice slice = protected_slices->slices[i];
+    GPR_ASSERT(GRPC_SLICE_LENGTH(slice) <= INT_MAX);
+    if (BIO_write(impl->into_ssl, GRPC_SLICE_START_PTR(slice),
+                  (int)GRPC_SLICE_LENGTH(slice)) !=
+        (int)GRPC_SLICE_LENGTH(slice)) {
+      gpr_log(GPR_ERROR, "Sending protected frame to ssl failed.");
+      result = TSI_INTERNAL_ERROR;
+      break;
+    }
+  }
+  /* The data of complete records is never larger than their protected bytes:
+     open them straight into a slice of that size. */
+  while (result == TSI_OK) {
+    const size_t available_size =
+        (size_t)BIO_pending(impl->into_ssl) + (size_t)SSL_pending(impl->ssl);
+    if (available_size == 0) break;
+    grpc_slice unprotected = GRPC_SLICE_MALLOC(available_size);
+    size_t unprotected_size = 0;
+    while (unprotected_size < available_size) {
+      size_t read_size = available_size - unprotected_size;
+      result = do_ssl_read(
+          impl->ssl, GRPC_SLICE_START_PTR(unprotected) + unprotected_size,
+          &read_size);
+      if (result != TSI_OK || read_size == 0) break;
+      unprotected_size += read_size;
+    }
+    if (unprotected_size > 0) {
+      grpc_slice_buffer_add(
+          unprotected_slices,
+          grpc_slice_split_head(&unprotected, unprotected_size));
+    }
+    grpc_slice_unref_internal(exec_ctx, unprotected);
+    /* Stop at a partially received record. */
+    if (unprotected_size < available_size) break;
+  }
+  gpr_mu_unlock(&impl->mu);
+  grpc_slice_buffer_reset_and_unref_internal(exec_ctx, protected_slices);
+  return result;
+}
+
+static void ssl_zero_copy_grpc_protector_destroy(
+    grpc_exec_ctx *exec_ctx, tsi_zero_copy_grpc_protector *self) {
+  tsi_ssl_zero_copy_grpc_protector *impl =
+      (tsi_ssl_zero_copy_grpc_protector *)self;
+  gpr_free(impl->buffer);
+  if (impl->ssl != NULL) SSL_free(impl->ssl);
+  gpr_mu_destroy(&impl->mu);
+  gpr_free(self);
+}
+
+static const tsi_zero_copy_grpc_protector_vtable
+    zero_copy_grpc_protector_vtable = {
+        ssl_zero_copy_grpc_protector_protect,
+        ssl_zero_copy_grpc_protector_unprotect,
+        ssl_zero_copy_grpc_protector_destroy,
+};
+
 /* --- tsi_handshaker methods implementation. ---*/
 
 static tsi_result ssl_handshaker_get_bytes_to_send_to_peer(tsi_handshaker *self,
@@ -927,11 +1115,35 @@ static tsi_result ssl_handshaker_process_bytes_from_peer(
   }
 }
 
+static tsi_result add_string_property_to_peer(const char *name,
+                                              const char *value,
+                                              size_t value_length,
+                                              tsi_peer *peer) {
+  size_t i;
+  tsi_result result;
+  tsi_peer_property *new_properties =
+      gpr_zalloc(sizeof(*new_properties) * (peer->property_count + 1));
+  for (i = 0; i < peer->property_count; i++) {
+    new_properties[i] = peer->properties[i];
+  }
+  result = tsi_construct_string_peer_property(
+      name, value, value_length, &new_properties[peer->property_count]);
+  if (result != TSI_OK) {
+    gpr_free(new_properties);
+    return result;
+  }
+  if (peer->properties != NULL) gpr_free(peer->properties);
+  peer->property_count++;
+  peer->properties = new_properties;
+  return TSI_OK;
+}
+
 static tsi_result ssl_handshaker_extract_peer(tsi_handshaker *self,
                                               tsi_peer *peer) {
   tsi_result result = TSI_OK;
   const unsigned char *alpn_selected = NULL;
   unsigned int alpn_selected_len;
+  const char *session_reused;
   tsi_ssl_handshaker *impl = (tsi_ssl_handshaker *)self;
   X509 *peer_cert = SSL_get_peer_certificate(impl->ssl);
   if (peer_cert != NULL) {
@@ -948,34 +1160,23 @@ static tsi_result ssl_handshaker_extract_peer(tsi_handshaker *self,
                                    &alpn_selected_len);
   }
   if (alpn_selected != NULL) {
-    size_t i;
-    tsi_peer_property *new_properties =
-        gpr_zalloc(sizeof(*new_properties) * (peer->property_count + 1));
-    for (i = 0; i < peer->property_count; i++) {
-      new_properties[i] = peer->properties[i];
-    }
-    result = tsi_construct_string_peer_property(
-        TSI_SSL_ALPN_SELECTED_PROTOCOL, (const char *)alpn_selected,
-        alpn_selected_len, &new_properties[peer->property_count]);
-    if (result != TSI_OK) {
-      gpr_free(new_properties);
-      return result;
-    }
-    if (peer->properties != NULL) gpr_free(peer->properties);
-    peer->property_count++;
-    peer->properties = new_properties;
+    result = add_string_property_to_peer(TSI_SSL_ALPN_SELECTED_PROTOCOL,
+                                         (const char *)alpn_selected,
+                                         alpn_selected_len, peer);
+    if (result != TSI_OK) return result;
   }
-  return result;
+  session_reused = SSL_session_reused(impl->ssl) ? "true" : "false";
+  return add_string_property_to_peer(TSI_SSL_SESSION_REUSED_PEER_PROPERTY,
+                                     session_reused, strlen(session_reused),
+                                     peer);
 }
 
-static tsi_result ssl_handshaker_create_frame_protector(
-    tsi_handshaker *self, size_t *max_output_protected_frame_size,
-    tsi_frame_protector **protector) {
+/* Clamps the requested frame size, and returns the size of the data it
+   holds. */
+static size_t ssl_protector_buffer_size(
+    size_t *max_output_protected_frame_size) {
   size_t actual_max_output_protected_frame_size =
       TSI_SSL_MAX_PROTECTED_FRAME_SIZE_UPPER_BOUND;
-  tsi_ssl_handshaker *impl = (tsi_ssl_handshaker *)self;
-  tsi_ssl_frame_protector *protector_impl = gpr_zalloc(sizeof(*protector_impl));
-
   if (max_output_protected_frame_size != NULL) {
     if (*max_output_protected_frame_size >
         TSI_SSL_MAX_PROTECTED_FRAME_SIZE_UPPER_BOUND) {
@@ -988,8 +1189,18 @@ static tsi_result ssl_handshaker_create_frame_protector(
     }
     actual_max_output_protected_frame_size = *max_output_protected_frame_size;
   }
+  return actual_max_output_protected_frame_size -
+         TSI_SSL_MAX_PROTECTION_OVERHEAD;
+}
+
+static tsi_result ssl_handshaker_create_frame_protector(
+    tsi_handshaker *self, size_t *max_output_protected_frame_size,
+    tsi_frame_protector **protector) {
+  tsi_ssl_handshaker *impl = (tsi_ssl_handshaker *)self;
+  tsi_ssl_frame_protector *protector_impl = gpr_zalloc(sizeof(*protector_impl));
+
   protector_impl->buffer_size =
-      actual_max_output_protected_frame_size - TSI_SSL_MAX_PROTECTION_OVERHEAD;
+      ssl_protector_buffer_size(max_output_protected_frame_size);
   protector_impl->buffer = gpr_malloc(protector_impl->buffer_size);
   if (protector_impl->buffer == NULL) {
     gpr_log(GPR_ERROR,
@@ -1010,6 +1221,29 @@ static tsi_result ssl_handshaker_create_frame_protector(
   return TSI_OK;
 }
 
+static tsi_result ssl_handshaker_create_zero_copy_grpc_protector(
+    grpc_exec_ctx *exec_ctx, tsi_handshaker *self,
+    size_t *max_output_protected_frame_size,
+    tsi_zero_copy_grpc_protector **protector) {
+  tsi_ssl_handshaker *impl = (tsi_ssl_handshaker *)self;
+  tsi_ssl_zero_copy_grpc_protector *protector_impl =
+      gpr_zalloc(sizeof(*protector_impl));
+  protector_impl->buffer_size =
+      ssl_protector_buffer_size(max_output_protected_frame_size);
+  protector_impl->buffer = gpr_malloc(protector_impl->buffer_size);
+  gpr_mu_init(&protector_impl->mu);
+
+  /* Transfer ownership of ssl to the protector, as for frame protectors. */
+  protector_impl->ssl = impl->ssl;
+  impl->ssl = NULL;
+  protector_impl->into_ssl = impl->into_ssl;
+  protector_impl->from_ssl = impl->from_ssl;
+
+  protector_impl->base.vtable = &zero_copy_grpc_protector_vtable;
+  *protector = &protector_impl->base;
+  return TSI_OK;
+}
+
 static void ssl_handshaker_destroy(tsi_handshaker *self) {
   tsi_ssl_handshaker *impl = (tsi_ssl_handshaker *)self;
   SSL_free(impl->ssl); /* The BIO objects are owned by ssl */
@@ -1024,13 +1258,156 @@ static const tsi_handshaker_vtable handshaker_vtable = {
     ssl_handshaker_create_frame_protector,
     ssl_handshaker_destroy,
     NULL,
+    ssl_handshaker_create_zero_copy_grpc_protector,
 };
 
+/* --- tsi_ssl_session_cache methods implementation. --- */
+
+static void session_cache_destroy_key(void *key) { gpr_free(key); }
+
+static void *session_cache_copy_key(void *key) { return gpr_strdup(key); }
+
+static long session_cache_compare_keys(void *key1, void *key2) {
+  return strcmp((const char *)key1, (const char *)key2);
+}
+
+static void session_cache_destroy_value(void *value) {}
+
+static void *session_cache_copy_value(void *value) { return value; }
+
+static const gpr_avl_vtable session_cache_avl_vtable = {
+    session_cache_destroy_key, session_cache_copy_key,
+    session_cache_compare_keys, session_cache_destroy_value,
+    session_cache_copy_value};
+
+static void session_cache_entry_destroy(tsi_ssl_session_cache_entry *entry) {
+  gpr_free(entry->session);
+  gpr_free(entry->server_name);
+  gpr_free(entry);
+}
+
+static void session_cache_unlink(tsi_ssl_session_cache *cache,
+                                 tsi_ssl_session_cache_entry *entry) {
+  if (entry->prev != NULL) {
+    entry->prev->next = entry->next;
+  } else {
+    cache->most_recently_used = entry->next;
+  }
+  if (entry->next != NULL) {
+    entry->next->prev = entry->prev;
+  } else {
+    cache->least_recently_used = entry->prev;
+  }
+  entry->prev = NULL;
+  entry->next = NULL;
+}
+
+static void session_cache_push_front(tsi_ssl_session_cache *cache,
+                                     tsi_ssl_session_cache_entry *entry) {
+  entry->next = cache->most_recently_used;
+  if (entry->next != NULL) {
+    entry->next->prev = entry;
+  } else {
+    cache->least_recently_used = entry;
+  }
+  cache->most_recently_used = entry;
+}
+
+/* Caches the session of server_name. */
+static void session_cache_put(tsi_ssl_session_cache *cache,
+                              const char *server_name, SSL_SESSION *session) {
+  tsi_ssl_session_cache_entry *entry;
+  unsigned char *session_bytes;
+  unsigned char *cur;
+  int session_size = i2d_SSL_SESSION(session, NULL);
+  if (session_size <= 0) {
+    gpr_log(GPR_ERROR, "Could not serialize the session of %s.", server_name);
+    return;
+  }
+  session_bytes = gpr_malloc((size_t)session_size);
+  cur = session_bytes;
+  i2d_SSL_SESSION(session, &cur);
+  gpr_mu_lock(&cache->mu);
+  entry = gpr_avl_get(cache->entries_by_name, (void *)server_name);
+  if (entry != NULL) {
+    gpr_free(entry->session);
+    entry->session = session_bytes;
+    entry->session_size = (size_t)session_size;
+    session_cache_unlink(cache, entry);
+  } else {
+    if (cache->size == cache->capacity) {
+      tsi_ssl_session_cache_entry *evicted = cache->least_recently_used;
+      session_cache_unlink(cache, evicted);
+      cache->entries_by_name =
+          gpr_avl_remove(cache->entries_by_name, evicted->server_name);
+      session_cache_entry_destroy(evicted);
+      cache->size--;
+    }
+    entry = gpr_zalloc(sizeof(*entry));
+    entry->server_name = gpr_strdup(server_name);
+    entry->session = session_bytes;
+    entry->session_size = (size_t)session_size;
+    cache->entries_by_name = gpr_avl_add(cache->entries_by_name,
+                                         gpr_strdup(server_name), entry);
+    cache->size++;
+  }
+  session_cache_push_front(cache, entry);
+  gpr_mu_unlock(&cache->mu);
+}
+
+/* Makes ssl resume the session cached for server_name, if any. */
+static void session_cache_resume(tsi_ssl_session_cache *cache,
+                                 const char *server_name, SSL *ssl) {
+  tsi_ssl_session_cache_entry *entry;
+  SSL_SESSION *session = NULL;
+  gpr_mu_lock(&cache->mu);
+  entry = gpr_avl_get(cache->entries_by_name, (void *)server_name);
+  if (entry != NULL) {
+    const unsigned char *cur = entry->session;
+    GPR_ASSERT(entry->session_size <= LONG_MAX);
+    session = d2i_SSL_SESSION(NULL, &cur, (long)entry->session_size);
+    session_cache_unlink(cache, entry);
+    session_cache_push_front(cache, entry);
+  }
+  gpr_mu_unlock(&cache->mu);
+  if (session != NULL) {
+    SSL_set_session(ssl, session);
+    SSL_SESSION_free(session);
+  }
+}
+
+tsi_ssl_session_cache *tsi_ssl_session_cache_create_lru(size_t capacity) {
+  tsi_ssl_session_cache *cache = gpr_zalloc(sizeof(*cache));
+  gpr_ref_init(&cache->refs, 1);
+  gpr_mu_init(&cache->mu);
+  cache->capacity = GPR_MAX(capacity, 1);
+  cache->entries_by_name = gpr_avl_create(&session_cache_avl_vtable);
+  return cache;
+}
+
+void tsi_ssl_session_cache_ref(tsi_ssl_session_cache *cache) {
+  gpr_ref(&cache->refs);
+}
+
+void tsi_ssl_session_cache_unref(tsi_ssl_session_cache *cache) {
+  tsi_ssl_session_cache_entry *entry;
+  if (!gpr_unref(&cache->refs)) return;
+  entry = cache->most_recently_used;
+  while (entry != NULL) {
+    tsi_ssl_session_cache_entry *next = entry->next;
+    session_cache_entry_destroy(entry);
+    entry = next;
+  }
+  gpr_avl_unref(cache->entries_by_name);
+  gpr_mu_destroy(&cache->mu);
+  gpr_free(cache);
+}
+
 /* --- tsi_ssl_handshaker_factory common methods. --- */
 
-static tsi_result create_tsi_ssl_handshaker(SSL_CTX *ctx, int is_client,
-                                            const char *server_name_indication,
-                                            tsi_handshaker **handshaker) {
+static tsi_result create_tsi_ssl_handshaker(
+    SSL_CTX *ctx, int is_client, const char *server_name_indication,
+    tsi_ssl_session_cache *session_cache, tsi_handshaker **handshaker) {
   SSL *ssl = SSL_new(ctx);
   BIO *into_ssl = NULL;
   BIO *from_ssl = NULL;
@@ -1065,6 +1442,9 @@ static tsi_result create_tsi_ssl_handshaker(SSL_CTX *ctx, int is_client,
         SSL_free(ssl);
         return TSI_INTERNAL_ERROR;
       }
+      if (session_cache != NULL) {
+        session_cache_resume(session_cache, server_name_indication, ssl);
+      }
     }
     ssl_result = SSL_do_handshake(ssl);
     ssl_result = SSL_get_error(ssl, ssl_result);
@@ -1121,16 +1501,33 @@ tsi_result tsi_ssl_client_handshaker_factory_create_handshaker(
     tsi_ssl_client_handshaker_factory *self, const char *server_name_indication,
     tsi_handshaker **handshaker) {
   return create_tsi_ssl_handshaker(self->ssl_context, 1, server_name_indication,
-                                   handshaker);
+                                   self->session_cache, handshaker);
 }
 
 void tsi_ssl_client_handshaker_factory_destroy(
     tsi_ssl_client_handshaker_factory *self) {
   if (self->ssl_context != NULL) SSL_CTX_free(self->ssl_context);
   if (self->alpn_protocol_list != NULL) gpr_free(self->alpn_protocol_list);
+  if (self->session_cache != NULL) {
+    tsi_ssl_session_cache_unref(self->session_cache);
+  }
   gpr_free(self);
 }
 
+static int client_handshaker_factory_new_session_callback(
+    SSL *ssl, SSL_SESSION *session) {
+  tsi_ssl_client_handshaker_factory *factory = SSL_CTX_get_ex_data(
+      SSL_get_SSL_CTX(ssl), ssl_ctx_ex_factory_index);
+  const char *server_name = SSL_get_servername(ssl, TLSEXT_NAMETYPE_host_name);
+  if (factory == NULL || factory->session_cache == NULL ||
+      server_name == NULL) {
+    return 0;
+  }
+  session_cache_put(factory->session_cache, server_name, session);
+  /* The cache keeps a copy of the session, not the reference to it. */
+  return 0;
+}
+
 static int client_handshaker_factory_npn_callback(SSL *ssl, unsigned char **out,
                                                   unsigned char *outlen,
                                                   const unsigned char *in,
@@ -1150,7 +1547,8 @@ tsi_result tsi_ssl_server_handshaker_factory_create_handshaker(
   if (self->ssl_context_count == 0) return TSI_INVALID_ARGUMENT;
   /* Create the handshaker with the first context. We will switch if needed
      because of SNI in ssl_server_handshaker_factory_servername_callback.  */
-  return create_tsi_ssl_handshaker(self->ssl_contexts[0], 0, NULL, handshaker);
+  return create_tsi_ssl_handshaker(self->ssl_contexts[0], 0, NULL, NULL,
+                                   handshaker);
 }
 
 void tsi_ssl_server_handshaker_factory_destroy(
@@ -1267,6 +1665,7 @@ tsi_result tsi_create_ssl_client_handshaker_factory(
     const tsi_ssl_pem_key_cert_pair *pem_key_cert_pair,
     const char *pem_root_certs, const char *cipher_suites,
     const char **alpn_protocols, uint16_t num_alpn_protocols,
+    tsi_ssl_session_cache *session_cache,
     tsi_ssl_client_handshaker_factory **factory) {
   SSL_CTX *ssl_context = NULL;
   tsi_ssl_client_handshaker_factory *impl = NULL;
@@ -1328,6 +1727,16 @@ tsi_result tsi_create_ssl_client_handshaker_factory(
   SSL_CTX_set_verify(ssl_context, SSL_VERIFY_PEER, NULL);
   /* TODO(jboeuf): Add revocation verification. */
 
+  if (session_cache != NULL) {
+    tsi_ssl_session_cache_ref(session_cache);
+    impl->session_cache = session_cache;
+    SSL_CTX_set_ex_data(ssl_context, ssl_ctx_ex_factory_index, impl);
+    SSL_CTX_set_session_cache_mode(
+        ssl_context, SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+    SSL_CTX_sess_set_new_cb(ssl_context,
+                            client_handshaker_factory_new_session_callback);
+  }
+
   *factory = impl;
   return TSI_OK;
 }
@@ -1353,6 +1762,8 @@ tsi_result tsi_create_ssl_server_handshaker_factory_ex(
     uint16_t num_alpn_protocols, tsi_ssl_server_handshaker_factory **factory) {
   tsi_ssl_server_handshaker_factory *impl = NULL;
   tsi_result result = TSI_OK;
+  unsigned char ticket_keys[TSI_SSL_MAX_TICKET_KEYS_SIZE];
+  size_t ticket_keys_size = 0;
   size_t i = 0;
 
   gpr_once_init(&init_openssl_once, init_openssl);
@@ -1396,6 +1807,31 @@ tsi_result tsi_create_ssl_server_handshaker_factory_ex(
                                     &pem_key_cert_pairs[i], cipher_suites);
       if (result != TSI_OK) break;
 
+      /* Sessions are only resumed from tickets, which all the contexts encrypt
+         with the same keys since SNI may switch the context of a handshake. */
+      if (i == 0) {
+        long size =
+            SSL_CTX_get_tlsext_ticket_keys(impl->ssl_contexts[i], NULL, 0);
+        if (size <= 0 || (size_t)size > sizeof(ticket_keys) ||
+            RAND_bytes(ticket_keys, (int)size) != 1) {
+          gpr_log(GPR_ERROR, "Could not draw session ticket keys.");
+          result = TSI_INTERNAL_ERROR;
+          break;
+        }
+        ticket_keys_size = (size_t)size;
+      }
+      SSL_CTX_set_session_cache_mode(impl->ssl_contexts[i], SSL_SESS_CACHE_OFF);
+      if (!SSL_CTX_set_session_id_context(
+              impl->ssl_contexts[i],
+              (const unsigned char *)TSI_SSL_SESSION_ID_CONTEXT,
+              (unsigned int)strlen(TSI_SSL_SESSION_ID_CONTEXT)) ||
+          !SSL_CTX_set_tlsext_ticket_keys(impl->ssl_contexts[i], ticket_keys,
+                                          (long)ticket_keys_size)) {
+        gpr_log(GPR_ERROR, "Could not set up session tickets.");
+        result = TSI_INTERNAL_ERROR;
+        break;
+      }
+
       if (pem_client_root_certs != NULL) {
         STACK_OF(X509_NAME) *root_names = NULL;
         result = ssl_ctx_load_verification_certs(
@@ -1451,10 +1887,12 @@ tsi_result tsi_create_ssl_server_handshaker_factory_ex(
     } while (0);
 
     if (result != TSI_OK) {
+      OPENSSL_cleanse(ticket_keys, sizeof(ticket_keys));
       tsi_ssl_server_handshaker_factory_destroy(impl);
       return result;
     }
   }
+  OPENSSL_cleanse(ticket_keys, sizeof(ticket_keys));
   *factory = impl;
   return TSI_OK;
 }
@@ -1501,3 +1939,216 @@ int tsi_ssl_peer_matches_name(const tsi_peer *peer, const char *name) {
 
   return 0; /* Not found. */
 }
+
+/* --- Kernel TLS offload. --- */
+
+#if defined(OPENSSL_IS_BORINGSSL) || OPENSSL_VERSION_NUMBER >= 0x10101000L
+#define TSI_SSL_KERNEL_TLS_SUPPORT 1
+#endif
+
+#ifdef TSI_SSL_KERNEL_TLS_SUPPORT
+
+#define TSI_SSL_RECORD_HEADER_SIZE 5
+#define TSI_SSL_RECORD_TYPE_APPLICATION_DATA 23
+#define TSI_SSL_KEY_EXPANSION_LABEL "key expansion"
+
+/* Returns the number of records in bytes if they are all complete application
+   data records, or -1. */
+static int count_application_data_records(const unsigned char *bytes,
+                                          size_t bytes_size) {
+  int count = 0;
+  size_t offset = 0;
+  while (offset < bytes_size) {
+    if (bytes_size - offset < TSI_SSL_RECORD_HEADER_SIZE ||
+        bytes[offset] != TSI_SSL_RECORD_TYPE_APPLICATION_DATA) {
+      return -1;
+    }
+    const size_t length =
+        ((size_t)bytes[offset + 3] << 8) | (size_t)bytes[offset + 4];
+    offset += TSI_SSL_RECORD_HEADER_SIZE;
+    if (bytes_size - offset < length) return -1;
+    offset += length;
+    count++;
+  }
+  return count;
+}
+
+/* Computes the TLS 1.2 key block (RFC 5246, section 6.3) of ssl. */
+static int generate_key_block(SSL *ssl, unsigned char *key_block,
+                              size_t key_block_size) {
+#ifdef OPENSSL_IS_BORINGSSL
+  return SSL_generate_key_block(ssl, key_block, key_block_size);
+#else
+  unsigned char master_key[SSL_MAX_MASTER_KEY_LENGTH];
+  unsigned char seed[2 * SSL3_RANDOM_SIZE];
+  const size_t master_key_size = SSL_SESSION_get_master_key(
+      SSL_get_session(ssl), master_key, sizeof(master_key));
+  SSL_get_server_random(ssl, seed, SSL3_RANDOM_SIZE);
+  SSL_get_client_random(ssl, seed + SSL3_RANDOM_SIZE, SSL3_RANDOM_SIZE);
+  EVP_PKEY_CTX *ctx = EVP_PKEY_CTX_new_id(EVP_PKEY_TLS1_PRF, NULL);
+  const int ok =
+      ctx != NULL && EVP_PKEY_derive_init(ctx) > 0 &&
+      EVP_PKEY_CTX_set_tls1_prf_md(
+          ctx, SSL_CIPHER_get_handshake_digest(SSL_get_current_cipher(ssl))) >
+          0 &&
+      EVP_PKEY_CTX_set1_tls1_prf_secret(ctx, master_key,
+                                        (int)master_key_size) > 0 &&
+      EVP_PKEY_CTX_add1_tls1_prf_seed(
+          ctx, (const unsigned char *)TSI_SSL_KEY_EXPANSION_LABEL,
+          (int)strlen(TSI_SSL_KEY_EXPANSION_LABEL)) > 0 &&
+      EVP_PKEY_CTX_add1_tls1_prf_seed(ctx, seed, (int)sizeof(seed)) > 0 &&
+      EVP_PKEY_derive(ctx, key_block, &key_block_size) > 0;
+  EVP_PKEY_CTX_free(ctx);
+  OPENSSL_cleanse(master_key, sizeof(master_key));
+  return ok;
+#endif
+}
+
+#ifndef OPENSSL_IS_BORINGSSL
+/* Returns the number of records the client (or the server, if from_client is
+   0) sent after its ChangeCipherSpec message during the handshake. */
+static uint64_t count_encrypted_handshake_records(SSL *ssl, int from_client) {
+  /* The Finished message, preceded by the NextProtocol message of the client
+     if NPN was negotiated. */
+  const unsigned char *npn_protocol = NULL;
+  unsigned int npn_protocol_size = 0;
+  SSL_get0_next_proto_negotiated(ssl, &npn_protocol, &npn_protocol_size);
+  return (from_client && npn_protocol != NULL) ? 2 : 1;
+}
+#endif
+
+static void set_record_sequence_number(tsi_ssl_kernel_tls_keys *keys,
+                                       uint64_t sequence_number) {
+  for (size_t i = sizeof(keys->rec_seq); i > 0; i--) {
+    keys->rec_seq[i - 1] = (unsigned char)(sequence_number & 0xff);
+    sequence_number >>= 8;
+  }
+  /* The explicit nonce only has to be unique: use the sequence number, as
+     OpenSSL does. */
+  memcpy(keys->iv, keys->rec_seq, sizeof(keys->iv));
+}
+
+tsi_result tsi_ssl_frame_protector_export_kernel_tls_keys(
+    tsi_frame_protector *protector, const unsigned char *unused_bytes,
+    size_t unused_bytes_size, tsi_ssl_kernel_tls_keys *tx_keys,
+    tsi_ssl_kernel_tls_keys *rx_keys, unsigned char **unprotected_bytes,
+    size_t *unprotected_bytes_size) {
+  tsi_ssl_frame_protector *impl = (tsi_ssl_frame_protector *)protector;
+  size_t key_size;
+  if (protector->vtable != &frame_protector_vtable ||
+      SSL_version(impl->ssl) != TLS1_2_VERSION) {
+    return TSI_UNIMPLEMENTED;
+  }
+  switch (SSL_CIPHER_get_cipher_nid(SSL_get_current_cipher(impl->ssl))) {
+    case NID_aes_128_gcm:
+      key_size = 16;
+      break;
+    case NID_aes_256_gcm:
+      key_size = 32;
+      break;
+    default:
+      return TSI_UNIMPLEMENTED;
+  }
+  if (impl->buffer_offset != 0 || BIO_pending(impl->from_ssl) != 0 ||
+      SSL_pending(impl->ssl) != 0) {
+    return TSI_UNIMPLEMENTED;
+  }
+
+  /* Whatever the peer sent after its Finished message has to be made of
+     complete records: the kernel will pick up from the next one. */
+  char *pending_bytes;
+  const size_t pending_bytes_size =
+      (size_t)BIO_get_mem_data(impl->into_ssl, &pending_bytes);
+  const size_t received_size = pending_bytes_size + unused_bytes_size;
+  unsigned char *received = gpr_malloc(GPR_MAX(received_size, 1));
+  if (pending_bytes_size > 0) {
+    memcpy(received, pending_bytes, pending_bytes_size);
+  }
+  if (unused_bytes_size > 0) {
+    memcpy(received + pending_bytes_size, unused_bytes, unused_bytes_size);
+  }
+  const int num_received_records =
+      count_application_data_records(received, received_size);
+  if (num_received_records < 0) {
+    gpr_free(received);
+    return TSI_UNIMPLEMENTED;
+  }
+
+  /* The key block holds the client write key, the server write key, the
+     client write IV and the server write IV. */
+  unsigned char key_block[2 * sizeof(tx_keys->key) + 2 * sizeof(tx_keys->salt)];
+  const size_t key_block_size = 2 * key_size + 2 * sizeof(tx_keys->salt);
+  if (!generate_key_block(impl->ssl, key_block, key_block_size)) {
+    gpr_log(GPR_ERROR, "Could not generate the TLS key block.");
+    log_ssl_error_stack();
+    gpr_free(received);
+    return TSI_INTERNAL_ERROR;
+  }
+  const int is_server = SSL_is_server(impl->ssl);
+  tsi_ssl_kernel_tls_keys *client_keys = is_server ? rx_keys : tx_keys;
+  tsi_ssl_kernel_tls_keys *server_keys = is_server ? tx_keys : rx_keys;
+  memset(client_keys, 0, sizeof(*client_keys));
+  memset(server_keys, 0, sizeof(*server_keys));
+  client_keys->key_size = server_keys->key_size = key_size;
+  memcpy(client_keys->key, key_block, key_size);
+  memcpy(server_keys->key, key_block + key_size, key_size);
+  memcpy(client_keys->salt, key_block + 2 * key_size,
+         sizeof(client_keys->salt));
+  memcpy(server_keys->salt,
+         key_block + 2 * key_size + sizeof(client_keys->salt),
+         sizeof(server_keys->salt));
+  OPENSSL_cleanse(key_block, sizeof(key_block));
+#ifdef OPENSSL_IS_BORINGSSL
+  set_record_sequence_number(tx_keys, SSL_get_write_sequence(impl->ssl));
+  set_record_sequence_number(
+      rx_keys,
+      SSL_get_read_sequence(impl->ssl) + (uint64_t)num_received_records);
+#else
+  set_record_sequence_number(
+      tx_keys, count_encrypted_handshake_records(impl->ssl, !is_server));
+  set_record_sequence_number(
+      rx_keys, count_encrypted_handshake_records(impl->ssl, is_server) +
+                   (uint64_t)num_received_records);
+#endif
+
+  /* Decrypt the records already received, reusing their buffer. */
+  if (unused_bytes_size > 0 &&
+      BIO_write(impl->into_ssl, unused_bytes, (int)unused_bytes_size) !=
+          (int)unused_bytes_size) {
+    gpr_log(GPR_ERROR, "Sending protected frame to ssl failed.");
+    gpr_free(received);
+    return TSI_INTERNAL_ERROR;
+  }
+  size_t unprotected_size = 0;
+  while (unprotected_size < received_size) {
+    size_t read_size = received_size - unprotected_size;
+    tsi_result result =
+        do_ssl_read(impl->ssl, received + unprotected_size, &read_size);
+    if (result != TSI_OK) {
+      gpr_free(received);
+      return result;
+    }
+    if (read_size == 0) break;
+    unprotected_size += read_size;
+  }
+  if (BIO_pending(impl->into_ssl) != 0) {
+    gpr_log(GPR_ERROR, "Could not unprotect the data received so far.");
+    gpr_free(received);
+    return TSI_INTERNAL_ERROR;
+  }
+  *unprotected_bytes = received;
+  *unprotected_bytes_size = unprotected_size;
+  return TSI_OK;
+}
+
+#else /* TSI_SSL_KERNEL_TLS_SUPPORT */
+
+tsi_result tsi_ssl_frame_protector_export_kernel_tls_keys(
+    tsi_frame_protector *protector, const unsigned char *unused_bytes,
+    size_t unused_bytes_size, tsi_ssl_kernel_tls_keys *tx_keys,
+    tsi_ssl_kernel_tls_keys *rx_keys, unsigned char **unprotected_bytes,
+    size_t *unprotected_bytes_size) {
+  return TSI_UNIMPLEMENTED;
+}
+
+#endif /* TSI_SSL_KERNEL_TLS_SUPPORT */
@@ -37,6 +37,30 @@ extern "C" {
 
 #define TSI_SSL_ALPN_SELECTED_PROTOCOL "ssl_alpn_selected_protocol"
 
+/* This property is of type TSI_PEER_PROPERTY_STRING. Its value is "true" if
+   the handshake resumed a previous session, "false" otherwise.  */
+#define TSI_SSL_SESSION_REUSED_PEER_PROPERTY "ssl_session_reused"
+
+/* --- tsi_ssl_session_cache object ---
+
+   Cache of the sessions established by client handshakers, keyed by the server
+   name indication of the handshakes. It lets later handshakes with the same
+   servers resume these sessions with a ticket instead of redoing the public
+   key operations. It is thread safe and may be shared by several client
+   handshaker factories, which should then use the same root certificates as
+   the peer is not verified again when a session is resumed.  */
+
+typedef struct tsi_ssl_session_cache tsi_ssl_session_cache;
+
+/* Creates a cache holding the sessions of at most capacity servers. When it is
+   full, the session of the least recently used server is evicted. The caller
+   owns a reference to the returned cache.  */
+tsi_ssl_session_cache *tsi_ssl_session_cache_create_lru(size_t capacity);
+
+/* Reference counting of the cache. It is destroyed with its last reference. */
+void tsi_ssl_session_cache_ref(tsi_ssl_session_cache *cache);
+void tsi_ssl_session_cache_unref(tsi_ssl_session_cache *cache);
+
 /* --- tsi_ssl_client_handshaker_factory object ---
 
    This object creates a client tsi_handshaker objects implemented in terms of
@@ -73,6 +97,10 @@ typedef struct {
      be NULL.
    - num_alpn_protocols is the number of alpn protocols and associated lengths
      specified. If this parameter is 0, the other alpn parameters must be NULL.
+   - session_cache is the cache in which the handshakers created with this
+     factory store and look up the sessions they can resume. The factory takes
+     its own reference to it. This parameter can be NULL, in which case every
+     handshake is a full handshake.
    - factory is the address of the factory pointer to be created.
 
    - This method returns TSI_OK on success or TSI_INVALID_PARAMETER in the case
@@ -81,6 +109,7 @@ tsi_result tsi_create_ssl_client_handshaker_factory(
     const tsi_ssl_pem_key_cert_pair *pem_key_cert_pair,
     const char *pem_root_certs, const char *cipher_suites,
     const char **alpn_protocols, uint16_t num_alpn_protocols,
+    tsi_ssl_session_cache *session_cache,
     tsi_ssl_client_handshaker_factory **factory);
 
 /* Creates a client handshaker.
@@ -127,6 +156,10 @@ typedef struct tsi_ssl_server_handshaker_factory
      specified. If this parameter is 0, the other alpn parameters must be NULL.
    - factory is the address of the factory pointer to be created.
 
+   The handshakers created with this factory issue session tickets, encrypted
+   with keys drawn when the factory is created, and resume the sessions of the
+   clients presenting them. The server keeps no per-session state.
+
    - This method returns TSI_OK on success or TSI_INVALID_PARAMETER in the case
      where a parameter is invalid.  */
 tsi_result tsi_create_ssl_server_handshaker_factory(
@@ -170,6 +203,40 @@ void tsi_ssl_server_handshaker_factory_destroy(
    - handle public suffix wildchar more strictly (e.g. *.co.uk) */
 int tsi_ssl_peer_matches_name(const tsi_peer *peer, const char *name);
 
+/* --- Kernel TLS offload. --- */
+
+/* Keys protecting one direction of a TLS 1.2 AES-GCM connection, as the record
+   layer of an operating system kernel needs them. */
+typedef struct {
+  /* 16 for AES-128-GCM, 32 for AES-256-GCM. */
+  size_t key_size;
+  unsigned char key[32];
+  /* Implicit part of the nonce. */
+  unsigned char salt[4];
+  /* Explicit part of the nonce of the next record. */
+  unsigned char iv[8];
+  /* Sequence number of the next record, big endian. */
+  unsigned char rec_seq[8];
+} tsi_ssl_kernel_tls_keys;
+
+/* Hands the record layer of a frame protector created by an SSL handshaker
+   over to the caller, who is expected to install its keys into the kernel.
+   - unused_bytes are the bytes received from the peer that the handshaker did
+     not consume, as returned by tsi_handshaker_result_get_unused_bytes.
+   - tx_keys and rx_keys receive the keys protecting the data sent and
+     received.
+   - unprotected_bytes receives the data that was already received, decrypted.
+     It must be freed with gpr_free.
+   This must be called before the protector is used. On success, the protector
+   may only be destroyed. TSI_UNIMPLEMENTED is returned, leaving the protector
+   untouched, if the negotiated cipher suite cannot be offloaded or if a
+   record was only partially received.  */
+tsi_result tsi_ssl_frame_protector_export_kernel_tls_keys(
+    tsi_frame_protector *protector, const unsigned char *unused_bytes,
+    size_t unused_bytes_size, tsi_ssl_kernel_tls_keys *tx_keys,
+    tsi_ssl_kernel_tls_keys *rx_keys, unsigned char **unprotected_bytes,
+    size_t *unprotected_bytes_size);
+
 #ifdef __cplusplus
 }
 #endif
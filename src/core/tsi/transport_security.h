@@ -22,6 +22,7 @@
 #include <stdbool.h>
 
 #include "src/core/lib/debug/trace.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
 #include "src/core/tsi/transport_security_interface.h"
 
 #ifdef __cplusplus
@@ -30,6 +31,9 @@ extern "C" {
 
 extern grpc_tracer_flag tsi_tracing_enabled;
 
+/* See transport_security_grpc.h. */
+typedef struct tsi_zero_copy_grpc_protector tsi_zero_copy_grpc_protector;
+
 /* Base for tsi_frame_protector implementations.
    See transport_security_interface.h for documentation. */
 typedef struct {
@@ -74,6 +78,10 @@ typedef struct {
                      size_t *bytes_to_send_size,
                      tsi_handshaker_result **handshaker_result,
                      tsi_handshaker_on_next_done_cb cb, void *user_data);
+  tsi_result (*create_zero_copy_grpc_protector)(
+      grpc_exec_ctx *exec_ctx, tsi_handshaker *self,
+      size_t *max_protected_frame_size,
+      tsi_zero_copy_grpc_protector **protector);
 } tsi_handshaker_vtable;
 
 struct tsi_handshaker {
@@ -89,6 +97,10 @@ typedef struct {
   tsi_result (*create_frame_protector)(const tsi_handshaker_result *self,
                                        size_t *max_output_protected_frame_size,
                                        tsi_frame_protector **protector);
+  tsi_result (*create_zero_copy_grpc_protector)(
+      grpc_exec_ctx *exec_ctx, const tsi_handshaker_result *self,
+      size_t *max_output_protected_frame_size,
+      tsi_zero_copy_grpc_protector **protector);
   tsi_result (*get_unused_bytes)(const tsi_handshaker_result *self,
                                  unsigned char **bytes, size_t *bytes_size);
   void (*destroy)(tsi_handshaker_result *self);
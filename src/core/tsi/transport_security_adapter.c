@@ -22,7 +22,7 @@
 
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
-#include "src/core/tsi/transport_security.h"
+#include "src/core/tsi/transport_security_grpc.h"
 
 #define TSI_ADAPTER_INITIAL_BUFFER_SIZE 256
 
@@ -49,6 +49,15 @@ static tsi_result adapter_result_create_frame_protector(
       impl->wrapped, max_output_protected_frame_size, protector);
 }
 
+static tsi_result adapter_result_create_zero_copy_grpc_protector(
+    grpc_exec_ctx *exec_ctx, const tsi_handshaker_result *self,
+    size_t *max_output_protected_frame_size,
+    tsi_zero_copy_grpc_protector **protector) {
+  tsi_adapter_handshaker_result *impl = (tsi_adapter_handshaker_result *)self;
+  return tsi_handshaker_create_zero_copy_grpc_protector(
+      exec_ctx, impl->wrapped, max_output_protected_frame_size, protector);
+}
+
 static tsi_result adapter_result_get_unused_bytes(
     const tsi_handshaker_result *self, unsigned char **bytes,
     size_t *byte_size) {
@@ -66,8 +75,11 @@ static void adapter_result_destroy(tsi_handshaker_result *self) {
 }
 
 static const tsi_handshaker_result_vtable result_vtable = {
-    adapter_result_extract_peer, adapter_result_create_frame_protector,
-    adapter_result_get_unused_bytes, adapter_result_destroy,
+    adapter_result_extract_peer,
+    adapter_result_create_frame_protector,
+    adapter_result_create_zero_copy_grpc_protector,
+    adapter_result_get_unused_bytes,
+    adapter_result_destroy,
 };
 
 /* Ownership of wrapped tsi_handshaker is transferred to the result object.  */
@@ -131,6 +143,15 @@ static tsi_result adapter_create_frame_protector(
       protector);
 }
 
+static tsi_result adapter_create_zero_copy_grpc_protector(
+    grpc_exec_ctx *exec_ctx, tsi_handshaker *self,
+    size_t *max_protected_frame_size,
+    tsi_zero_copy_grpc_protector **protector) {
+  return tsi_handshaker_create_zero_copy_grpc_protector(
+      exec_ctx, tsi_adapter_handshaker_get_wrapped(self),
+      max_protected_frame_size, protector);
+}
+
 static void adapter_destroy(tsi_handshaker *self) {
   tsi_adapter_handshaker *impl = (tsi_adapter_handshaker *)self;
   tsi_handshaker_destroy(impl->wrapped);
@@ -202,6 +223,7 @@ static const tsi_handshaker_vtable handshaker_vtable = {
     adapter_create_frame_protector,
     adapter_destroy,
     adapter_next,
+    adapter_create_zero_copy_grpc_protector,
 };
 
 tsi_handshaker *tsi_create_adapter_handshaker(tsi_handshaker *wrapped) {
@@ -39,6 +39,11 @@ grpc_linked_mdelem *MetadataBatch::AddMetadata(grpc_exec_ctx *exec_ctx,
   return storage;
 }
 
+grpc_linked_mdelem *MetadataBatch::FindMetadata(const string &key) const {
+  return grpc_metadata_batch_find(
+      batch_, grpc_slice_from_static_buffer(key.data(), key.size()));
+}
+
 // ChannelData
 
 void ChannelData::StartTransportOp(grpc_exec_ctx *exec_ctx,
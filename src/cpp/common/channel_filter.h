@@ -57,6 +57,9 @@ class MetadataBatch {
   grpc_linked_mdelem *AddMetadata(grpc_exec_ctx *exec_ctx, const string &key,
                                   const string &value);
 
+  /// Returns the first element with key \a key, or nullptr if there is none.
+  grpc_linked_mdelem *FindMetadata(const string &key) const;
+
   class const_iterator : public std::iterator<std::bidirectional_iterator_tag,
                                               const grpc_mdelem> {
    public:
@@ -114,6 +114,7 @@ class CompressionAlgorithm:
   none = GRPC_COMPRESS_NONE
   deflate = GRPC_COMPRESS_DEFLATE
   gzip = GRPC_COMPRESS_GZIP
+  lz4 = GRPC_COMPRESS_LZ4
 
 
 class CompressionLevel:
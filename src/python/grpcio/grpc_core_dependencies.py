@@ -70,8 +70,11 @@ CORE_SOURCE_FILES = [
   'src/core/lib/channel/handshaker_factory.c',
   'src/core/lib/channel/handshaker_registry.c',
   'src/core/lib/compression/compression.c',
+  'src/core/lib/compression/lz4.c',
   'src/core/lib/compression/message_compress.c',
   'src/core/lib/compression/stream_compression.c',
+  'src/core/lib/debug/stats.c',
+  'src/core/lib/debug/stats_data.c',
   'src/core/lib/http/format_request.c',
   'src/core/lib/http/httpcli.c',
   'src/core/lib/http/parser.c',
@@ -87,6 +90,7 @@ CORE_SOURCE_FILES = [
   'src/core/lib/iomgr/ev_epoll_thread_pool_linux.c',
   'src/core/lib/iomgr/ev_epollex_linux.c',
   'src/core/lib/iomgr/ev_epollsig_linux.c',
+  'src/core/lib/iomgr/ev_io_uring_linux.c',
   'src/core/lib/iomgr/ev_poll_posix.c',
   'src/core/lib/iomgr/ev_posix.c',
   'src/core/lib/iomgr/ev_windows.c',
@@ -244,6 +248,7 @@ CORE_SOURCE_FILES = [
   'src/core/tsi/ssl_transport_security.c',
   'src/core/tsi/transport_security.c',
   'src/core/tsi/transport_security_adapter.c',
+  'src/core/tsi/transport_security_grpc.c',
   'src/core/ext/transport/chttp2/server/chttp2_server.c',
   'src/core/ext/transport/chttp2/client/secure/secure_channel_create.c',
   'src/core/ext/filters/client_channel/channel_connectivity.c',
@@ -284,8 +289,12 @@ CORE_SOURCE_FILES = [
   'third_party/nanopb/pb_decode.c',
   'third_party/nanopb/pb_encode.c',
   'src/core/ext/filters/client_channel/resolver/fake/fake_resolver.c',
+  'src/core/ext/filters/client_channel/lb_policy/subchannel_list.c',
+  'src/core/ext/filters/client_channel/lb_policy/least_request/least_request.c',
   'src/core/ext/filters/client_channel/lb_policy/pick_first/pick_first.c',
+  'src/core/ext/filters/client_channel/lb_policy/ring_hash/ring_hash.c',
   'src/core/ext/filters/client_channel/lb_policy/round_robin/round_robin.c',
+  'src/core/ext/filters/client_channel/lb_policy/weighted_round_robin/weighted_round_robin.c',
   'src/core/ext/filters/client_channel/resolver/dns/c_ares/dns_resolver_ares.c',
   'src/core/ext/filters/client_channel/resolver/dns/c_ares/grpc_ares_ev_driver_posix.c',
   'src/core/ext/filters/client_channel/resolver/dns/c_ares/grpc_ares_wrapper.c',
@@ -0,0 +1,44 @@
+/*
+ *
+ * Copyright 2017 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "src/core/lib/iomgr/port.h"
+
+#ifdef GRPC_POSIX_SOCKET
+
+#include <string.h>
+
+#include <grpc/grpc.h>
+
+#include "src/core/lib/iomgr/ev_posix.h"
+#include "src/core/lib/support/env.h"
+
+/* Exits with 0 if the io_uring polling engine can be used on this kernel */
+int main(int argc, char **argv) {
+  /* fall back to poll rather than aborting when io_uring is unavailable */
+  gpr_setenv("GRPC_POLL_STRATEGY", "io_uring,poll");
+  grpc_init();
+  int available = 0 == strcmp(grpc_get_poll_strategy_name(), "io_uring");
+  grpc_shutdown();
+  return available ? 0 : 1;
+}
+
+#else /* defined(GRPC_POSIX_SOCKET) */
+
+int main(int argc, char **argv) { return 1; }
+
+#endif /* !defined(GRPC_POSIX_SOCKET) */
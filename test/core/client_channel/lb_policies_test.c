@@ -20,6 +20,7 @@
 #include <string.h>
 
 #include <grpc/grpc.h>
+#include <grpc/load_reporting.h>
 #include <grpc/support/alloc.h>
 #include <grpc/support/host_port.h>
 #include <grpc/support/log.h>
@@ -30,6 +31,7 @@
 #include "src/core/ext/filters/client_channel/lb_policy_registry.h"
 #include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/channel/channel_stack.h"
+#include "src/core/lib/iomgr/port.h"
 #include "src/core/lib/support/string.h"
 #include "src/core/lib/surface/channel.h"
 #include "src/core/lib/surface/server.h"
@@ -37,6 +39,12 @@
 #include "test/core/util/port.h"
 #include "test/core/util/test_config.h"
 
+#ifdef GRPC_POSIX_SOCKET
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
 #define RETRY_TIMEOUT 300
 
 typedef struct servers_fixture {
@@ -68,6 +76,9 @@ typedef struct test_spec {
   int **revive_at;
 
   const char *description;
+  const char *lb_policy_name;
+  /* cost each server reports in its trailing metadata, if not NULL */
+  const char **backend_costs;
 
   verifier_fn verifier;
 
@@ -98,6 +109,8 @@ static test_spec *test_spec_create(size_t num_iters, size_t num_servers) {
     spec->revive_at[i] = gpr_malloc(sizeof(int) * num_servers);
   }
 
+  spec->lb_policy_name = "round_robin";
+  spec->backend_costs = NULL;
   test_spec_reset(spec);
   return spec;
 }
@@ -341,6 +354,8 @@ static request_sequences perform_request(servers_fixture *f,
     }
 
     if (s_idx >= 0) {
+      grpc_metadata backend_cost;
+      memset(&backend_cost, 0, sizeof(backend_cost));
       memset(ops, 0, sizeof(ops));
       op = ops;
       op->op = GRPC_OP_SEND_INITIAL_METADATA;
@@ -350,6 +365,14 @@ static request_sequences perform_request(servers_fixture *f,
       op++;
       op->op = GRPC_OP_SEND_STATUS_FROM_SERVER;
       op->data.send_status_from_server.trailing_metadata_count = 0;
+      if (spec->backend_costs != NULL) {
+        backend_cost.key =
+            grpc_slice_from_static_string(GRPC_LB_BACKEND_COST_MD_KEY);
+        backend_cost.value =
+            grpc_slice_from_static_string(spec->backend_costs[s_idx]);
+        op->data.send_status_from_server.trailing_metadata_count = 1;
+        op->data.send_status_from_server.trailing_metadata = &backend_cost;
+      }
       op->data.send_status_from_server.status = GRPC_STATUS_UNIMPLEMENTED;
       grpc_slice status_details = grpc_slice_from_static_string("xyz");
       op->data.send_status_from_server.status_details = &status_details;
@@ -479,7 +502,7 @@ void run_spec(const test_spec *spec) {
   arg_array[0].value.integer = RETRY_TIMEOUT;
   arg_array[1].type = GRPC_ARG_STRING;
   arg_array[1].key = GRPC_ARG_LB_POLICY_NAME;
-  arg_array[1].value.string = "round_robin";
+  arg_array[1].value.string = (char *)spec->lb_policy_name;
   args.num_args = 2;
   args.args = arg_array;
 
@@ -501,7 +524,8 @@ void run_spec(const test_spec *spec) {
   teardown_servers(f);
 }
 
-static grpc_channel *create_client(const servers_fixture *f) {
+static grpc_channel *create_client(const servers_fixture *f,
+                                   const char *lb_policy_name) {
   grpc_channel *client;
   char *client_hostport;
   char *servers_hostports_str;
@@ -517,7 +541,7 @@ static grpc_channel *create_client(const servers_fixture *f) {
   arg_array[0].value.integer = RETRY_TIMEOUT;
   arg_array[1].type = GRPC_ARG_STRING;
   arg_array[1].key = GRPC_ARG_LB_POLICY_NAME;
-  arg_array[1].value.string = "ROUND_ROBIN";
+  arg_array[1].value.string = (char *)lb_policy_name;
   arg_array[2].type = GRPC_ARG_INTEGER;
   arg_array[2].key = GRPC_ARG_HTTP2_MIN_TIME_BETWEEN_PINGS_MS;
   arg_array[2].value.integer = 0;
@@ -544,7 +568,7 @@ static void test_ping() {
   f = setup_servers("127.0.0.1", &rdata, num_servers);
   cqv = cq_verifier_create(f->cq);
 
-  client = create_client(f);
+  client = create_client(f, "ROUND_ROBIN");
 
   grpc_channel_ping(client, f->cq, tag(0), NULL);
   CQ_EXPECT_COMPLETION(cqv, tag(0), 0);
@@ -589,7 +613,7 @@ static void test_pending_calls(size_t concurrent_calls) {
       gpr_malloc(sizeof(grpc_call_details) * spec->num_servers);
   f = setup_servers("127.0.0.1", &rdata, spec->num_servers);
 
-  client = create_client(f);
+  client = create_client(f, "ROUND_ROBIN");
   calls = perform_multirequest(f, client, concurrent_calls);
   grpc_call_cancel(
       calls[0],
@@ -608,6 +632,176 @@ static void test_pending_calls(size_t concurrent_calls) {
   test_spec_destroy(spec);
 }
 
+/* A call of test_least_request_busy_backend(), as seen by both ends */
+typedef struct lr_call {
+  int id;
+  grpc_call *call;
+  grpc_metadata_array initial_metadata_recv;
+  grpc_metadata_array trailing_metadata_recv;
+  grpc_status_code status;
+  grpc_slice details;
+  size_t server; /* index of the server the call landed on */
+  grpc_call *server_call;
+  int was_cancelled;
+} lr_call;
+
+static void lr_call_start(servers_fixture *f, grpc_channel *client,
+                          lr_call *call, int id) {
+  grpc_op ops[4];
+  grpc_op *op;
+  memset(call, 0, sizeof(*call));
+  call->id = id;
+  grpc_metadata_array_init(&call->initial_metadata_recv);
+  grpc_metadata_array_init(&call->trailing_metadata_recv);
+  call->call = grpc_channel_create_call(
+      client, NULL, GRPC_PROPAGATE_DEFAULTS, f->cq,
+      grpc_slice_from_static_string("/foo"), NULL,
+      grpc_timeout_seconds_to_deadline(10), NULL);
+  GPR_ASSERT(call->call);
+  memset(ops, 0, sizeof(ops));
+  op = ops;
+  op->op = GRPC_OP_SEND_INITIAL_METADATA;
+  op++;
+  op->op = GRPC_OP_SEND_CLOSE_FROM_CLIENT;
+  op++;
+  op->op = GRPC_OP_RECV_INITIAL_METADATA;
+  op->data.recv_initial_metadata.recv_initial_metadata =
+      &call->initial_metadata_recv;
+  op++;
+  op->op = GRPC_OP_RECV_STATUS_ON_CLIENT;
+  op->data.recv_status_on_client.trailing_metadata =
+      &call->trailing_metadata_recv;
+  op->data.recv_status_on_client.status = &call->status;
+  op->data.recv_status_on_client.status_details = &call->details;
+  op++;
+  GPR_ASSERT(GRPC_CALL_OK == grpc_call_start_batch(call->call, ops,
+                                                   (size_t)(op - ops),
+                                                   tag(200 + id), NULL));
+}
+
+/* Waits for \a call to reach a server, and has that server ask for its next
+   call */
+static void lr_call_wait_for_server(servers_fixture *f, request_data *rdata,
+                                    lr_call *call) {
+  grpc_event ev = grpc_completion_queue_next(
+      f->cq, grpc_timeout_seconds_to_deadline(5), NULL);
+  GPR_ASSERT(ev.type == GRPC_OP_COMPLETE && ev.success);
+  const int read_tag = (int)(intptr_t)ev.tag;
+  GPR_ASSERT(read_tag >= 1000 && read_tag < 1000 + (int)f->num_servers);
+  const size_t i = (size_t)(read_tag - 1000);
+  call->server = i;
+  call->server_call = f->server_calls[i];
+  gpr_log(GPR_DEBUG, "least_request call %d landed on server %" PRIuPTR,
+          call->id, i);
+  grpc_call_details_destroy(&rdata->call_details[i]);
+  grpc_call_details_init(&rdata->call_details[i]);
+  GPR_ASSERT(GRPC_CALL_OK ==
+             grpc_server_request_call(f->servers[i], &f->server_calls[i],
+                                      &rdata->call_details[i],
+                                      &f->request_metadata_recv[i], f->cq,
+                                      f->cq, tag(1000 + (int)i)));
+}
+
+/* Has the server answer \a call, and waits for the client to get the status */
+static void lr_call_finish(servers_fixture *f, lr_call *call) {
+  grpc_op ops[3];
+  grpc_op *op;
+  grpc_slice status_details = grpc_slice_from_static_string("xyz");
+  cq_verifier *cqv = cq_verifier_create(f->cq);
+  memset(ops, 0, sizeof(ops));
+  op = ops;
+  op->op = GRPC_OP_SEND_INITIAL_METADATA;
+  op++;
+  op->op = GRPC_OP_SEND_STATUS_FROM_SERVER;
+  op->data.send_status_from_server.status = GRPC_STATUS_OK;
+  op->data.send_status_from_server.status_details = &status_details;
+  op++;
+  op->op = GRPC_OP_RECV_CLOSE_ON_SERVER;
+  op->data.recv_close_on_server.cancelled = &call->was_cancelled;
+  op++;
+  GPR_ASSERT(GRPC_CALL_OK == grpc_call_start_batch(call->server_call, ops,
+                                                   (size_t)(op - ops),
+                                                   tag(300 + call->id), NULL));
+  CQ_EXPECT_COMPLETION(cqv, tag(300 + call->id), 1);
+  CQ_EXPECT_COMPLETION(cqv, tag(200 + call->id), 1);
+  cq_verify(cqv);
+  cq_verifier_destroy(cqv);
+  GPR_ASSERT(call->status == GRPC_STATUS_OK);
+}
+
+static void lr_call_destroy(lr_call *call) {
+  grpc_call_unref(call->call);
+  grpc_call_unref(call->server_call);
+  grpc_metadata_array_destroy(&call->initial_metadata_recv);
+  grpc_metadata_array_destroy(&call->trailing_metadata_recv);
+  grpc_slice_unref(call->details);
+}
+
+/* Sends a call to completion, returning the server it landed on */
+static size_t lr_perform_call(servers_fixture *f, grpc_channel *client,
+                              request_data *rdata, int id) {
+  lr_call call;
+  lr_call_start(f, client, &call, id);
+  lr_call_wait_for_server(f, rdata, &call);
+  lr_call_finish(f, &call);
+  lr_call_destroy(&call);
+  return call.server;
+}
+
+/* least_request with two backends, one of which is kept busy by a call in
+   flight: new picks avoid it for as long as the call is waiting for its status,
+   but not a moment longer */
+static void test_least_request_busy_backend() {
+  const size_t num_servers = 2;
+  const int num_calls = 10;
+  request_data rdata;
+  rdata.call_details = gpr_malloc(sizeof(grpc_call_details) * num_servers);
+  for (size_t i = 0; i < num_servers; i++) {
+    grpc_call_details_init(&rdata.call_details[i]);
+  }
+  servers_fixture *f = setup_servers("127.0.0.1", &rdata, num_servers);
+  grpc_channel *client = create_client(f, "least_request");
+  gpr_log(GPR_INFO, "Testing least_request with a busy backend");
+
+  /* wait for both backends to be connected, so that picks choose between
+     them */
+  bool served[2] = {false, false};
+  for (int n = 0; n < 100 && !(served[0] && served[1]); n++) {
+    served[lr_perform_call(f, client, &rdata, 0)] = true;
+  }
+  GPR_ASSERT(served[0] && served[1]);
+
+  /* keep a call in flight on one backend: all the others go to the other */
+  lr_call busy;
+  lr_call_start(f, client, &busy, 1);
+  lr_call_wait_for_server(f, &rdata, &busy);
+  const size_t idle_server = 1 - busy.server;
+  for (int n = 0; n < num_calls; n++) {
+    GPR_ASSERT(lr_perform_call(f, client, &rdata, 0) == idle_server);
+  }
+
+  /* once both backends have a call in flight, finishing the first call frees
+     its backend up, even though the application has yet to destroy the call */
+  lr_call other;
+  lr_call_start(f, client, &other, 2);
+  lr_call_wait_for_server(f, &rdata, &other);
+  GPR_ASSERT(other.server == idle_server);
+  lr_call_finish(f, &busy);
+  for (int n = 0; n < num_calls; n++) {
+    GPR_ASSERT(lr_perform_call(f, client, &rdata, 0) == busy.server);
+  }
+
+  lr_call_finish(f, &other);
+  lr_call_destroy(&other);
+  lr_call_destroy(&busy);
+  grpc_channel_destroy(client);
+  teardown_servers(f);
+  for (size_t i = 0; i < num_servers; i++) {
+    grpc_call_details_destroy(&rdata.call_details[i]);
+  }
+  gpr_free(rdata.call_details);
+}
+
 static void test_get_channel_info() {
   grpc_channel *channel =
       grpc_insecure_channel_create("ipv4:127.0.0.1:1234", NULL, NULL);
@@ -650,10 +844,319 @@ static void test_get_channel_info() {
   GPR_ASSERT(service_config_json != NULL);
   GPR_ASSERT(strcmp(service_config_json, arg.value.string) == 0);
   gpr_free(service_config_json);
+  // The LB policy comes from the service config.
+  memset(&channel_info, 0, sizeof(channel_info));
+  channel_info.lb_policy_name = &lb_policy_name;
+  grpc_channel_get_info(channel, &channel_info);
+  GPR_ASSERT(lb_policy_name != NULL);
+  GPR_ASSERT(strcmp(lb_policy_name, "ROUND_ROBIN") == 0);
+  gpr_free(lb_policy_name);
   // Clean up.
   grpc_channel_destroy(channel);
 }
 
+/* State of the call a server of test_hedged_requests() is answering */
+typedef struct hedging_server_call {
+  grpc_call *call;
+  gpr_timespec reply_at; /* when to answer, or inf_future once answered */
+  grpc_byte_buffer *request;
+  bool closed; /* whether RECV_CLOSE_ON_SERVER completed */
+  int cancelled;
+} hedging_server_call;
+
+#define HEDGING_SLOW_SERVER_DELAY_MS 500
+
+/* Sends num_calls unary calls on client, one after the other, to servers of
+   which the first answers HEDGING_SLOW_SERVER_DELAY_MS late and the others
+   right away. Returns the slowest call's latency, in milliseconds. */
+static int64_t perform_hedged_requests(servers_fixture *f, grpc_channel *client,
+                                       request_data *rdata, size_t num_calls) {
+  hedging_server_call *server_calls =
+      gpr_zalloc(sizeof(*server_calls) * f->num_servers);
+  grpc_slice request_payload = grpc_slice_from_static_string("request");
+  grpc_slice response_payload = grpc_slice_from_static_string("response");
+  grpc_slice status_details = grpc_slice_from_static_string("xyz");
+  int64_t max_latency_ms = 0;
+  for (size_t n = 0; n < num_calls; n++) {
+    grpc_metadata_array initial_metadata_recv;
+    grpc_metadata_array trailing_metadata_recv;
+    grpc_byte_buffer *request = grpc_raw_byte_buffer_create(&request_payload, 1);
+    grpc_byte_buffer *response = NULL;
+    grpc_status_code status;
+    grpc_slice details;
+    grpc_op ops[6];
+    grpc_op *op;
+    grpc_metadata_array_init(&initial_metadata_recv);
+    grpc_metadata_array_init(&trailing_metadata_recv);
+    const gpr_timespec start = gpr_now(GPR_CLOCK_MONOTONIC);
+    grpc_call *c = grpc_channel_create_call(
+        client, NULL, GRPC_PROPAGATE_DEFAULTS, f->cq,
+        grpc_slice_from_static_string("/svc/Method"), NULL,
+        grpc_timeout_seconds_to_deadline(10), NULL);
+    GPR_ASSERT(c);
+    memset(ops, 0, sizeof(ops));
+    op = ops;
+    op->op = GRPC_OP_SEND_INITIAL_METADATA;
+    op++;
+    op->op = GRPC_OP_SEND_MESSAGE;
+    op->data.send_message.send_message = request;
+    op++;
+    op->op = GRPC_OP_SEND_CLOSE_FROM_CLIENT;
+    op++;
+    op->op = GRPC_OP_RECV_INITIAL_METADATA;
+    op->data.recv_initial_metadata.recv_initial_metadata =
+        &initial_metadata_recv;
+    op++;
+    op->op = GRPC_OP_RECV_MESSAGE;
+    op->data.recv_message.recv_message = &response;
+    op++;
+    op->op = GRPC_OP_RECV_STATUS_ON_CLIENT;
+    op->data.recv_status_on_client.trailing_metadata = &trailing_metadata_recv;
+    op->data.recv_status_on_client.status = &status;
+    op->data.recv_status_on_client.status_details = &details;
+    op++;
+    GPR_ASSERT(GRPC_CALL_OK ==
+               grpc_call_start_batch(c, ops, (size_t)(op - ops), tag(1), NULL));
+
+    bool client_done = false;
+    size_t num_server_calls = 0;
+    while (!client_done || num_server_calls > 0) {
+      /* wake up in time for the next delayed reply */
+      gpr_timespec deadline = grpc_timeout_milliseconds_to_deadline(5000);
+      for (size_t i = 0; i < f->num_servers; i++) {
+        if (server_calls[i].call != NULL &&
+            gpr_time_cmp(server_calls[i].reply_at, deadline) < 0) {
+          deadline = server_calls[i].reply_at;
+        }
+      }
+      grpc_event ev = grpc_completion_queue_next(f->cq, deadline, NULL);
+      if (ev.type == GRPC_OP_COMPLETE) {
+        const int read_tag = (int)(intptr_t)ev.tag;
+        if (read_tag == 1) {
+          GPR_ASSERT(ev.success);
+          client_done = true;
+          const int64_t latency_ms = gpr_time_to_millis(
+              gpr_time_sub(gpr_now(GPR_CLOCK_MONOTONIC), start));
+          if (latency_ms > max_latency_ms) max_latency_ms = latency_ms;
+        } else if (read_tag >= 1000 && read_tag < 2000) {
+          /* server got a call: read it, and watch for its cancellation */
+          GPR_ASSERT(ev.success);
+          hedging_server_call *sc = &server_calls[read_tag - 1000];
+          sc->call = f->server_calls[read_tag - 1000];
+          sc->closed = false;
+          sc->reply_at = gpr_time_add(
+              gpr_now(GPR_CLOCK_MONOTONIC),
+              gpr_time_from_millis(
+                  read_tag == 1000 ? HEDGING_SLOW_SERVER_DELAY_MS : 0,
+                  GPR_TIMESPAN));
+          num_server_calls++;
+          memset(ops, 0, sizeof(ops));
+          ops[0].op = GRPC_OP_RECV_MESSAGE;
+          ops[0].data.recv_message.recv_message = &sc->request;
+          ops[1].op = GRPC_OP_RECV_CLOSE_ON_SERVER;
+          ops[1].data.recv_close_on_server.cancelled = &sc->cancelled;
+          GPR_ASSERT(GRPC_CALL_OK ==
+                     grpc_call_start_batch(sc->call, ops, 2,
+                                           tag(3000 + read_tag - 1000), NULL));
+        } else if (read_tag >= 3000) {
+          hedging_server_call *sc = &server_calls[read_tag - 3000];
+          sc->closed = true;
+          sc->reply_at = gpr_inf_future(GPR_CLOCK_MONOTONIC);
+        } else {
+          GPR_ASSERT(read_tag >= 2000);
+        }
+      } else {
+        GPR_ASSERT(ev.type == GRPC_QUEUE_TIMEOUT);
+      }
+      const gpr_timespec now = gpr_now(GPR_CLOCK_MONOTONIC);
+      for (size_t i = 0; i < f->num_servers; i++) {
+        hedging_server_call *sc = &server_calls[i];
+        if (sc->call == NULL) continue;
+        if (gpr_time_cmp(sc->reply_at, now) <= 0) {
+          grpc_byte_buffer *reply =
+              grpc_raw_byte_buffer_create(&response_payload, 1);
+          memset(ops, 0, sizeof(ops));
+          op = ops;
+          op->op = GRPC_OP_SEND_INITIAL_METADATA;
+          op++;
+          op->op = GRPC_OP_SEND_MESSAGE;
+          op->data.send_message.send_message = reply;
+          op++;
+          op->op = GRPC_OP_SEND_STATUS_FROM_SERVER;
+          op->data.send_status_from_server.status = GRPC_STATUS_OK;
+          op->data.send_status_from_server.status_details = &status_details;
+          op++;
+          GPR_ASSERT(GRPC_CALL_OK ==
+                     grpc_call_start_batch(sc->call, ops, (size_t)(op - ops),
+                                           tag(2000 + (int)i), NULL));
+          grpc_byte_buffer_destroy(reply);
+          sc->reply_at = gpr_inf_future(GPR_CLOCK_MONOTONIC);
+        } else if (sc->closed) {
+          /* done with this call: ask for the next one */
+          if (sc->request != NULL) {
+            grpc_byte_buffer_destroy(sc->request);
+            sc->request = NULL;
+          }
+          grpc_call_unref(sc->call);
+          sc->call = NULL;
+          num_server_calls--;
+          grpc_call_details_destroy(&rdata->call_details[i]);
+          grpc_call_details_init(&rdata->call_details[i]);
+          GPR_ASSERT(GRPC_CALL_OK ==
+                     grpc_server_request_call(
+                         f->servers[i], &f->server_calls[i],
+                         &rdata->call_details[i], &f->request_metadata_recv[i],
+                         f->cq, f->cq, tag(1000 + (int)i)));
+        }
+      }
+    }
+    GPR_ASSERT(status == GRPC_STATUS_OK);
+    GPR_ASSERT(response != NULL);
+    grpc_byte_buffer_destroy(response);
+    grpc_byte_buffer_destroy(request);
+    grpc_slice_unref(details);
+    grpc_metadata_array_destroy(&initial_metadata_recv);
+    grpc_metadata_array_destroy(&trailing_metadata_recv);
+    grpc_call_unref(c);
+  }
+  gpr_free(server_calls);
+  return max_latency_ms;
+}
+
+/* Returns the slowest latency of NUM_CALLS unary calls to two servers, the
+   first of which is slow, with or without hedging */
+static int64_t run_hedging_test(bool hedging) {
+  const size_t num_servers = 2;
+  const size_t num_calls = 10;
+  request_data rdata;
+  rdata.call_details = gpr_malloc(sizeof(grpc_call_details) * num_servers);
+  for (size_t i = 0; i < num_servers; i++) {
+    grpc_call_details_init(&rdata.call_details[i]);
+  }
+  servers_fixture *f = setup_servers("127.0.0.1", &rdata, num_servers);
+
+  char *servers_hostports_str = gpr_strjoin_sep(
+      (const char **)f->servers_hostports, f->num_servers, ",", NULL);
+  char *client_hostport;
+  gpr_asprintf(&client_hostport, "ipv4:%s", servers_hostports_str);
+  char *service_config;
+  gpr_asprintf(&service_config,
+               "{\"loadBalancingPolicy\": \"round_robin\","
+               " \"methodConfig\": [{\"name\": [{\"service\": \"svc\"}]%s}]}",
+               hedging ? ", \"hedgingPolicy\": {\"maxAttempts\": 2,"
+                         " \"hedgingDelay\": \"0.100s\"}"
+                       : "");
+  grpc_arg arg;
+  arg.type = GRPC_ARG_STRING;
+  arg.key = GRPC_ARG_SERVICE_CONFIG;
+  arg.value.string = service_config;
+  grpc_channel_args args = {1, &arg};
+  grpc_channel *client =
+      grpc_insecure_channel_create(client_hostport, &args, NULL);
+  gpr_log(GPR_INFO, "Testing hedging=%d with servers=%s client=%s", hedging,
+          servers_hostports_str, client_hostport);
+
+  /* wait for both backends to be connected, so that round_robin can spread
+     the calls (and their hedges) over both */
+  for (size_t i = 0; i < num_servers; i++) {
+    perform_hedged_requests(f, client, &rdata, 1);
+  }
+  const int64_t max_latency_ms =
+      perform_hedged_requests(f, client, &rdata, num_calls);
+  gpr_log(GPR_INFO, "hedging=%d: slowest of %" PRIuPTR " calls took %" PRId64
+                    "ms",
+          hedging, num_calls, max_latency_ms);
+
+  gpr_free(service_config);
+  gpr_free(client_hostport);
+  gpr_free(servers_hostports_str);
+  grpc_channel_destroy(client);
+  teardown_servers(f);
+  for (size_t i = 0; i < num_servers; i++) {
+    grpc_call_details_destroy(&rdata.call_details[i]);
+  }
+  gpr_free(rdata.call_details);
+  return max_latency_ms;
+}
+
+static void test_hedged_requests() {
+  /* without hedging, the calls round_robin sends to the slow server wait for
+     it */
+  GPR_ASSERT(run_hedging_test(false) >= HEDGING_SLOW_SERVER_DELAY_MS);
+  /* with hedging, the fast server answers them after the hedging delay */
+  GPR_ASSERT(run_hedging_test(true) < HEDGING_SLOW_SERVER_DELAY_MS);
+}
+
+#ifdef GRPC_POSIX_SOCKET
+/* Returns a loopback listener whose accept queue is kept full by the
+   connection returned in \a filler_fd, so that connection attempts to its
+   port go unanswered */
+static int create_blackhole_listener(int *port, int *filler_fd) {
+  struct sockaddr_in addr;
+  socklen_t addr_len = sizeof(addr);
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  const int listener_fd = socket(AF_INET, SOCK_STREAM, 0);
+  GPR_ASSERT(listener_fd >= 0);
+  GPR_ASSERT(bind(listener_fd, (struct sockaddr *)&addr, sizeof(addr)) == 0);
+  GPR_ASSERT(listen(listener_fd, 0) == 0);
+  GPR_ASSERT(getsockname(listener_fd, (struct sockaddr *)&addr, &addr_len) ==
+             0);
+  *filler_fd = socket(AF_INET, SOCK_STREAM, 0);
+  GPR_ASSERT(*filler_fd >= 0);
+  GPR_ASSERT(connect(*filler_fd, (struct sockaddr *)&addr, sizeof(addr)) == 0);
+  *port = ntohs(addr.sin_port);
+  return listener_fd;
+}
+
+/* pick_first over a blackholed address followed by a working one: the
+   connection attempt to the blackhole would only time out after 20s, but the
+   working address gets raced against it and picked */
+static void test_pick_first_blackholed_address() {
+  request_data rdata;
+  rdata.call_details = gpr_malloc(sizeof(grpc_call_details));
+  grpc_call_details_init(&rdata.call_details[0]);
+  servers_fixture *f = setup_servers("127.0.0.1", &rdata, 1);
+  cq_verifier *cqv = cq_verifier_create(f->cq);
+  int blackhole_port;
+  int filler_fd;
+  const int blackhole_fd = create_blackhole_listener(&blackhole_port, &filler_fd);
+
+  char *client_hostport;
+  gpr_asprintf(&client_hostport, "ipv4:127.0.0.1:%d,%s", blackhole_port,
+               f->servers_hostports[0]);
+  grpc_channel *client =
+      grpc_insecure_channel_create(client_hostport, NULL, NULL);
+  gpr_log(GPR_INFO, "Testing pick_first with client=%s", client_hostport);
+
+  const gpr_timespec start = gpr_now(GPR_CLOCK_MONOTONIC);
+  const gpr_timespec deadline = grpc_timeout_seconds_to_deadline(5);
+  grpc_connectivity_state state =
+      grpc_channel_check_connectivity_state(client, 1);
+  while (state != GRPC_CHANNEL_READY) {
+    grpc_channel_watch_connectivity_state(client, state, deadline, f->cq,
+                                          tag(99));
+    /* fails once the deadline is reached */
+    CQ_EXPECT_COMPLETION(cqv, tag(99), 1);
+    cq_verify(cqv);
+    state = grpc_channel_check_connectivity_state(client, 0);
+  }
+  const int64_t connect_ms =
+      gpr_time_to_millis(gpr_time_sub(gpr_now(GPR_CLOCK_MONOTONIC), start));
+  gpr_log(GPR_INFO, "pick_first connected in %" PRId64 "ms", connect_ms);
+
+  grpc_channel_destroy(client);
+  gpr_free(client_hostport);
+  close(filler_fd);
+  close(blackhole_fd);
+  cq_verifier_destroy(cqv);
+  teardown_servers(f);
+  grpc_call_details_destroy(&rdata.call_details[0]);
+  gpr_free(rdata.call_details);
+}
+#endif
+
 static void print_failed_expectations(const int *expected_connection_sequence,
                                       const int *actual_connection_sequence,
                                       const size_t expected_seq_length,
@@ -765,6 +1268,108 @@ static void verify_vanishing_floor_round_robin(
   gpr_free(expected_connection_sequence);
 }
 
+/* All servers stay up: every request gets served, wherever it lands */
+static void verify_all_served_least_request(const servers_fixture *f,
+                                            grpc_channel *client,
+                                            const request_sequences *sequences,
+                                            const size_t num_iters) {
+  for (size_t i = 0; i < num_iters; i++) {
+    const int actual = sequences->connections[i];
+    if (actual < 0 || (size_t)actual >= f->num_servers) {
+      gpr_log(GPR_ERROR,
+              "CONNECTION SEQUENCE FAILURE: got %d at iteration #%d", actual,
+              (int)i);
+      abort();
+    }
+  }
+
+  for (size_t i = 0; i < sequences->n; i++) {
+    const grpc_connectivity_state actual = sequences->connectivity_states[i];
+    const grpc_connectivity_state expected = GRPC_CHANNEL_READY;
+    if (actual != expected) {
+      gpr_log(GPR_ERROR,
+              "CONNECTIVITY STATUS SEQUENCE FAILURE: expected '%s', got '%s' "
+              "at iteration #%d",
+              grpc_connectivity_state_name(expected),
+              grpc_connectivity_state_name(actual), (int)i);
+      abort();
+    }
+  }
+}
+
+/* All servers stay up and all requests have the same :path: once all the
+ * subchannels are connected, they all go to the same server */
+static void verify_affinity_ring_hash(const servers_fixture *f,
+                                      grpc_channel *client,
+                                      const request_sequences *sequences,
+                                      const size_t num_iters) {
+  const int expected = sequences->connections[num_iters - 1];
+  if (expected < 0 || (size_t)expected >= f->num_servers) {
+    gpr_log(GPR_ERROR, "CONNECTION SEQUENCE FAILURE: last request got %d",
+            expected);
+    abort();
+  }
+  for (size_t i = num_iters / 2; i < num_iters; i++) {
+    const int actual = sequences->connections[i];
+    if (actual != expected) {
+      gpr_log(
+          GPR_ERROR,
+          "CONNECTION SEQUENCE FAILURE: expected %d, got %d at iteration #%d",
+          expected, actual, (int)i);
+      abort();
+    }
+  }
+
+  for (size_t i = 0; i < sequences->n; i++) {
+    const grpc_connectivity_state actual = sequences->connectivity_states[i];
+    const grpc_connectivity_state expected_state = GRPC_CHANNEL_READY;
+    if (actual != expected_state) {
+      gpr_log(GPR_ERROR,
+              "CONNECTIVITY STATUS SEQUENCE FAILURE: expected '%s', got '%s' "
+              "at iteration #%d",
+              grpc_connectivity_state_name(expected_state),
+              grpc_connectivity_state_name(actual), (int)i);
+      abort();
+    }
+  }
+}
+
+/* All servers stay up, server 0 reporting a third of the cost of server 1:
+ * once both have reported, server 0 gets about three times as many calls */
+static void verify_weighted_round_robin(const servers_fixture *f,
+                                        grpc_channel *client,
+                                        const request_sequences *sequences,
+                                        const size_t num_iters) {
+  size_t num_served[2] = {0, 0};
+  for (size_t i = num_iters / 2; i < num_iters; i++) {
+    const int actual = sequences->connections[i];
+    if (actual < 0 || (size_t)actual >= f->num_servers) {
+      gpr_log(GPR_ERROR,
+              "CONNECTION SEQUENCE FAILURE: got %d at iteration #%d", actual,
+              (int)i);
+      abort();
+    }
+    ++num_served[actual];
+  }
+  gpr_log(GPR_INFO, "served %" PRIuPTR " vs %" PRIuPTR " calls",
+          num_served[0], num_served[1]);
+  GPR_ASSERT(num_served[1] > 0);
+  GPR_ASSERT(num_served[0] >= 2 * num_served[1]);
+
+  for (size_t i = 0; i < sequences->n; i++) {
+    const grpc_connectivity_state actual = sequences->connectivity_states[i];
+    const grpc_connectivity_state expected = GRPC_CHANNEL_READY;
+    if (actual != expected) {
+      gpr_log(GPR_ERROR,
+              "CONNECTIVITY STATUS SEQUENCE FAILURE: expected '%s', got '%s' "
+              "at iteration #%d",
+              grpc_connectivity_state_name(expected),
+              grpc_connectivity_state_name(actual), (int)i);
+      abort();
+    }
+  }
+}
+
 static void verify_total_carnage_round_robin(const servers_fixture *f,
                                              grpc_channel *client,
                                              const request_sequences *sequences,
@@ -997,9 +1602,54 @@ int main(int argc, char **argv) {
     spec->revive_at[3][i] = 1;
   }
   run_spec(spec);
+
+  /* least_request: all servers up, then all down */
+  test_spec_reset(spec);
+  spec->lb_policy_name = "least_request";
+  spec->verifier = verify_all_served_least_request;
+  spec->description = "test_all_server_up_least_request";
+  run_spec(spec);
+
+  test_spec_reset(spec);
+  spec->verifier = verify_total_carnage_round_robin;
+  spec->description = "test_kill_all_server_least_request";
+  for (i = 0; i < NUM_SERVERS; i++) {
+    spec->kill_at[0][i] = 1;
+  }
+  run_spec(spec);
+
+  /* ring_hash: all servers up, then all down */
+  test_spec_reset(spec);
+  spec->lb_policy_name = "ring_hash";
+  spec->verifier = verify_affinity_ring_hash;
+  spec->description = "test_all_server_up_ring_hash";
+  run_spec(spec);
+
+  test_spec_reset(spec);
+  spec->verifier = verify_total_carnage_round_robin;
+  spec->description = "test_kill_all_server_ring_hash";
+  for (i = 0; i < NUM_SERVERS; i++) {
+    spec->kill_at[0][i] = 1;
+  }
+  run_spec(spec);
+  test_spec_destroy(spec);
+
+  /* weighted_round_robin: two servers reporting different costs */
+  static const char *backend_costs[] = {"1.5", "4.5"};
+  spec = test_spec_create(3 * NUM_ITERS, GPR_ARRAY_SIZE(backend_costs));
+  spec->lb_policy_name = "weighted_round_robin";
+  spec->backend_costs = backend_costs;
+  spec->verifier = verify_weighted_round_robin;
+  spec->description = "test_backend_costs_weighted_round_robin";
+  run_spec(spec);
   test_spec_destroy(spec);
 
   test_pending_calls(4);
+  test_least_request_busy_backend();
+  test_hedged_requests();
+#ifdef GRPC_POSIX_SOCKET
+  test_pick_first_blackholed_address();
+#endif
   test_ping();
   test_get_channel_info();
 
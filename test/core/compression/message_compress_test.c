@@ -30,7 +30,13 @@
 #include "test/core/util/slice_splitter.h"
 #include "test/core/util/test_config.h"
 
-typedef enum { ONE_A = 0, ONE_KB_A, ONE_MB_A, TEST_VALUE_COUNT } test_value;
+typedef enum {
+  ONE_A = 0,
+  ONE_KB_A,
+  ONE_MB_A,
+  ONE_MB_WORDS,
+  TEST_VALUE_COUNT
+} test_value;
 
 typedef enum {
   SHOULD_NOT_COMPRESS,
@@ -114,6 +120,26 @@ static grpc_slice repeated(char c, size_t length) {
   return out;
 }
 
+/* words picked at random from a small vocabulary, so that matches are found at
+   all kinds of offsets */
+static grpc_slice random_words(size_t length) {
+  static const char *const words[] = {"grpc ", "lz4 ", "deflate ", "gzip ",
+                                      "message ", "compression ", "a ", "\n"};
+  grpc_slice out = grpc_slice_malloc(length);
+  uint8_t *p = GRPC_SLICE_START_PTR(out);
+  uint32_t seed = 1;
+  size_t i;
+  for (i = 0; i < length;) {
+    const char *word;
+    seed = seed * 1103515245 + 12345;
+    word = words[(seed >> 16) % GPR_ARRAY_SIZE(words)];
+    for (; *word != 0 && i < length; word++) {
+      p[i++] = (uint8_t)*word;
+    }
+  }
+  return out;
+}
+
 static compressability get_compressability(
     test_value id, grpc_compression_algorithm algorithm) {
   if (algorithm == GRPC_COMPRESS_NONE) return SHOULD_NOT_COMPRESS;
@@ -122,6 +148,7 @@ static compressability get_compressability(
       return SHOULD_NOT_COMPRESS;
     case ONE_KB_A:
     case ONE_MB_A:
+    case ONE_MB_WORDS:
       return SHOULD_COMPRESS;
     case TEST_VALUE_COUNT:
       abort();
@@ -138,6 +165,8 @@ static grpc_slice create_test_value(test_value id) {
       return repeated('a', 1024);
     case ONE_MB_A:
       return repeated('a', 1024 * 1024);
+    case ONE_MB_WORDS:
+      return random_words(1024 * 1024);
     case TEST_VALUE_COUNT:
       abort();
       break;
@@ -170,6 +199,7 @@ static void test_bad_decompression_data_crc(void) {
   grpc_slice_buffer input;
   grpc_slice_buffer corrupted;
   grpc_slice_buffer output;
+  grpc_slice last;
   size_t idx;
   const uint32_t bad = 0xdeadbeef;
 
@@ -181,11 +211,12 @@ static void test_bad_decompression_data_crc(void) {
   grpc_exec_ctx exec_ctx = GRPC_EXEC_CTX_INIT;
   /* compress it */
   grpc_msg_compress(&exec_ctx, GRPC_COMPRESS_GZIP, &input, &corrupted);
-  /* corrupt the output by smashing the CRC */
-  GPR_ASSERT(corrupted.count > 1);
-  GPR_ASSERT(GRPC_SLICE_LENGTH(corrupted.slices[1]) > 8);
-  idx = GRPC_SLICE_LENGTH(corrupted.slices[1]) - 8;
-  memcpy(GRPC_SLICE_START_PTR(corrupted.slices[1]) + idx, &bad, 4);
+  /* corrupt the output by smashing the CRC, in the trailer of the last slice */
+  GPR_ASSERT(corrupted.count > 0);
+  last = corrupted.slices[corrupted.count - 1];
+  GPR_ASSERT(GRPC_SLICE_LENGTH(last) > 8);
+  idx = GRPC_SLICE_LENGTH(last) - 8;
+  memcpy(GRPC_SLICE_START_PTR(last) + idx, &bad, 4);
 
   /* try (and fail) to decompress the corrupted compresed buffer */
   GPR_ASSERT(0 == grpc_msg_decompress(&exec_ctx, GRPC_COMPRESS_GZIP, &corrupted,
@@ -197,6 +228,75 @@ static void test_bad_decompression_data_crc(void) {
   grpc_slice_buffer_destroy(&output);
 }
 
+/* "gRPC lz4 " repeated 5 times, ending with "!" instead of a space, as
+   compressed by the lz4 command line tool with block checksums, content size
+   and content checksum */
+static const uint8_t lz4_reference_frame[] = {
+    0x04, 0x22, 0x4d, 0x18, 0x7c, 0x40, 0x2d, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x63, 0x13, 0x00, 0x00, 0x00, 0x9f, 0x67, 0x52, 0x50, 0x43,
+    0x20, 0x6c, 0x7a, 0x34, 0x20, 0x09, 0x00, 0x0c, 0x50, 0x20, 0x6c, 0x7a,
+    0x34, 0x21, 0x40, 0xe5, 0x5a, 0xa7, 0x00, 0x00, 0x00, 0x00, 0x3c, 0x86,
+    0x46, 0xee};
+
+static void test_lz4_reference_frame(void) {
+  grpc_slice_buffer input;
+  grpc_slice_buffer output;
+  grpc_slice final;
+
+  grpc_slice_buffer_init(&input);
+  grpc_slice_buffer_init(&output);
+  grpc_slice_buffer_add(
+      &input, grpc_slice_from_copied_buffer((const char *)lz4_reference_frame,
+                                            sizeof(lz4_reference_frame)));
+
+  grpc_exec_ctx exec_ctx = GRPC_EXEC_CTX_INIT;
+  GPR_ASSERT(
+      grpc_msg_decompress(&exec_ctx, GRPC_COMPRESS_LZ4, &input, &output));
+  grpc_exec_ctx_finish(&exec_ctx);
+  final = grpc_slice_merge(output.slices, output.count);
+  GPR_ASSERT(0 == grpc_slice_str_cmp(
+                      final, "gRPC lz4 gRPC lz4 gRPC lz4 gRPC lz4 gRPC lz4!"));
+
+  grpc_slice_unref(final);
+  grpc_slice_buffer_destroy(&input);
+  grpc_slice_buffer_destroy(&output);
+}
+
+static void test_bad_decompression_data_lz4(void) {
+  grpc_slice_buffer input;
+  grpc_slice_buffer output;
+  uint8_t frame[sizeof(lz4_reference_frame)];
+  size_t i;
+  /* header checksum, a literal, block checksum and content checksum */
+  const size_t smashed[] = {14, 24, 40, 47};
+
+  grpc_slice_buffer_init(&input);
+  grpc_slice_buffer_init(&output);
+
+  grpc_exec_ctx exec_ctx = GRPC_EXEC_CTX_INIT;
+  for (i = 0; i < GPR_ARRAY_SIZE(smashed); i++) {
+    memcpy(frame, lz4_reference_frame, sizeof(frame));
+    frame[smashed[i]] ^= 0x01;
+    grpc_slice_buffer_add(&input, grpc_slice_from_copied_buffer(
+                                      (const char *)frame, sizeof(frame)));
+    GPR_ASSERT(0 == grpc_msg_decompress(&exec_ctx, GRPC_COMPRESS_LZ4, &input,
+                                        &output));
+    GPR_ASSERT(0 == output.length);
+    grpc_slice_buffer_reset_and_unref(&input);
+  }
+  /* truncated before the end mark and the content checksum */
+  grpc_slice_buffer_add(&input, grpc_slice_from_copied_buffer(
+                                    (const char *)lz4_reference_frame,
+                                    sizeof(lz4_reference_frame) - 8));
+  GPR_ASSERT(0 == grpc_msg_decompress(&exec_ctx, GRPC_COMPRESS_LZ4, &input,
+                                      &output));
+  GPR_ASSERT(0 == output.length);
+  grpc_exec_ctx_finish(&exec_ctx);
+
+  grpc_slice_buffer_destroy(&input);
+  grpc_slice_buffer_destroy(&output);
+}
+
 static void test_bad_decompression_data_trailing_garbage(void) {
   grpc_slice_buffer input;
   grpc_slice_buffer output;
@@ -312,6 +412,8 @@ int main(int argc, char **argv) {
   test_bad_decompression_data_crc();
   test_bad_decompression_data_stream();
   test_bad_decompression_data_trailing_garbage();
+  test_lz4_reference_frame();
+  test_bad_decompression_data_lz4();
   test_bad_compression_algorithm();
   test_bad_decompression_algorithm();
   grpc_shutdown();
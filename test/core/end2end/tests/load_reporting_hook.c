@@ -244,6 +244,15 @@ static void request_response_with_payload(
   cq_verify(cqv);
 
   GPR_ASSERT(status == GRPC_STATUS_OK);
+  /* the server reports the cost of the call to the client */
+  bool found_backend_cost = false;
+  for (size_t i = 0; i < trailing_metadata_recv.count; i++) {
+    if (grpc_slice_str_cmp(trailing_metadata_recv.metadata[i].key,
+                           GRPC_LB_BACKEND_COST_MD_KEY) == 0) {
+      found_backend_cost = true;
+    }
+  }
+  GPR_ASSERT(found_backend_cost);
 
   grpc_slice_unref(details);
   grpc_metadata_array_destroy(&initial_metadata_recv);
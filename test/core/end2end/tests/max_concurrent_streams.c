@@ -822,10 +822,288 @@ static void test_max_concurrent_streams_with_timeout_on_second(
   config.tear_down_data(&f);
 }
 
+typedef struct {
+  grpc_call *call;
+  grpc_metadata_array initial_metadata_recv;
+  grpc_metadata_array trailing_metadata_recv;
+  grpc_status_code status;
+  grpc_slice details;
+} pooled_client_call;
+
+/* starts a call to \a method: its stream is up once tag(base_tag + 1)
+   completes, and it is done once tag(base_tag + 2) completes */
+static void start_pooled_client_call(grpc_end2end_test_config config,
+                                     grpc_end2end_test_fixture f,
+                                     pooled_client_call *pc,
+                                     const char *method, int base_tag) {
+  grpc_op ops[6];
+  grpc_op *op;
+  grpc_call_error error;
+
+  pc->call = grpc_channel_create_call(
+      f.client, NULL, GRPC_PROPAGATE_DEFAULTS, f.cq,
+      grpc_slice_from_static_string(method),
+      get_host_override_slice("foo.test.google.fr:1234", config),
+      n_seconds_from_now(1000), NULL);
+  GPR_ASSERT(pc->call);
+  grpc_metadata_array_init(&pc->initial_metadata_recv);
+  grpc_metadata_array_init(&pc->trailing_metadata_recv);
+
+  memset(ops, 0, sizeof(ops));
+  op = ops;
+  op->op = GRPC_OP_SEND_INITIAL_METADATA;
+  op->data.send_initial_metadata.count = 0;
+  op->flags = 0;
+  op->reserved = NULL;
+  op++;
+  op->op = GRPC_OP_SEND_CLOSE_FROM_CLIENT;
+  op->flags = 0;
+  op->reserved = NULL;
+  op++;
+  error = grpc_call_start_batch(pc->call, ops, (size_t)(op - ops),
+                                tag(base_tag + 1), NULL);
+  GPR_ASSERT(GRPC_CALL_OK == error);
+
+  memset(ops, 0, sizeof(ops));
+  op = ops;
+  op->op = GRPC_OP_RECV_STATUS_ON_CLIENT;
+  op->data.recv_status_on_client.trailing_metadata =
+      &pc->trailing_metadata_recv;
+  op->data.recv_status_on_client.status = &pc->status;
+  op->data.recv_status_on_client.status_details = &pc->details;
+  op->flags = 0;
+  op->reserved = NULL;
+  op++;
+  op->op = GRPC_OP_RECV_INITIAL_METADATA;
+  op->data.recv_initial_metadata.recv_initial_metadata =
+      &pc->initial_metadata_recv;
+  op->flags = 0;
+  op->reserved = NULL;
+  op++;
+  error = grpc_call_start_batch(pc->call, ops, (size_t)(op - ops),
+                                tag(base_tag + 2), NULL);
+  GPR_ASSERT(GRPC_CALL_OK == error);
+}
+
+static void destroy_pooled_client_call(pooled_client_call *pc) {
+  GPR_ASSERT(pc->status == GRPC_STATUS_UNIMPLEMENTED);
+  grpc_slice_unref(pc->details);
+  grpc_metadata_array_destroy(&pc->initial_metadata_recv);
+  grpc_metadata_array_destroy(&pc->trailing_metadata_recv);
+  grpc_call_unref(pc->call);
+}
+
+static void finish_pooled_server_call(grpc_call *s, int *was_cancelled,
+                                      int t) {
+  grpc_op ops[6];
+  grpc_op *op;
+  grpc_slice status_details = grpc_slice_from_static_string("xyz");
+
+  memset(ops, 0, sizeof(ops));
+  op = ops;
+  op->op = GRPC_OP_SEND_INITIAL_METADATA;
+  op->data.send_initial_metadata.count = 0;
+  op->flags = 0;
+  op->reserved = NULL;
+  op++;
+  op->op = GRPC_OP_RECV_CLOSE_ON_SERVER;
+  op->data.recv_close_on_server.cancelled = was_cancelled;
+  op->flags = 0;
+  op->reserved = NULL;
+  op++;
+  op->op = GRPC_OP_SEND_STATUS_FROM_SERVER;
+  op->data.send_status_from_server.trailing_metadata_count = 0;
+  op->data.send_status_from_server.status = GRPC_STATUS_UNIMPLEMENTED;
+  op->data.send_status_from_server.status_details = &status_details;
+  op->flags = 0;
+  op->reserved = NULL;
+  op++;
+  GPR_ASSERT(GRPC_CALL_OK ==
+             grpc_call_start_batch(s, ops, (size_t)(op - ops), tag(t), NULL));
+}
+
+/* with a single stream allowed per connection, a subchannel allowed two
+   connections opens a second one once the first is busy, and serves new calls
+   on it while calls queued on the first one wait */
+static void run_pooled_calls(grpc_end2end_test_config config,
+                             grpc_end2end_test_fixture f, cq_verifier *cqv) {
+  pooled_client_call c1;
+  pooled_client_call c2;
+  pooled_client_call c3;
+  grpc_call *s1;
+  grpc_call *s2;
+  grpc_call *s3;
+  grpc_call_details call_details;
+  grpc_metadata_array request_metadata_recv;
+  int was_cancelled;
+
+  grpc_metadata_array_init(&request_metadata_recv);
+  grpc_call_details_init(&call_details);
+
+  /* perform a ping-pong to ensure that settings have had a chance to round
+     trip, and let its stream be released, lest it counts as a call of the
+     first connection */
+  simple_request_body(config, f);
+  cq_verify_empty_timeout(cqv, 1);
+
+  /* the first call takes the only stream of the first connection */
+  start_pooled_client_call(config, f, &c1, "/alpha", 300);
+  GPR_ASSERT(GRPC_CALL_OK == grpc_server_request_call(
+                                 f.server, &s1, &call_details,
+                                 &request_metadata_recv, f.cq, f.cq, tag(101)));
+  CQ_EXPECT_COMPLETION(cqv, tag(101), 1);
+  CQ_EXPECT_COMPLETION(cqv, tag(301), 1);
+  cq_verify(cqv);
+  GPR_ASSERT(0 == grpc_slice_str_cmp(call_details.method, "/alpha"));
+  grpc_call_details_destroy(&call_details);
+  grpc_call_details_init(&call_details);
+
+  /* the second one has to wait for it, but gets a connection opened */
+  start_pooled_client_call(config, f, &c2, "/beta", 400);
+  cq_verify_empty_timeout(cqv, 2);
+
+  /* so that the third one goes through while the second is still waiting */
+  start_pooled_client_call(config, f, &c3, "/gamma", 500);
+  GPR_ASSERT(GRPC_CALL_OK == grpc_server_request_call(
+                                 f.server, &s2, &call_details,
+                                 &request_metadata_recv, f.cq, f.cq, tag(201)));
+  CQ_EXPECT_COMPLETION(cqv, tag(201), 1);
+  CQ_EXPECT_COMPLETION(cqv, tag(501), 1);
+  cq_verify(cqv);
+  GPR_ASSERT(0 == grpc_slice_str_cmp(call_details.method, "/gamma"));
+  grpc_call_details_destroy(&call_details);
+  grpc_call_details_init(&call_details);
+
+  /* the second call starts once the first one is done */
+  finish_pooled_server_call(s1, &was_cancelled, 102);
+  CQ_EXPECT_COMPLETION(cqv, tag(102), 1);
+  CQ_EXPECT_COMPLETION(cqv, tag(302), 1);
+  CQ_EXPECT_COMPLETION(cqv, tag(401), 1);
+  cq_verify(cqv);
+  GPR_ASSERT(GRPC_CALL_OK == grpc_server_request_call(
+                                 f.server, &s3, &call_details,
+                                 &request_metadata_recv, f.cq, f.cq, tag(601)));
+  CQ_EXPECT_COMPLETION(cqv, tag(601), 1);
+  cq_verify(cqv);
+  GPR_ASSERT(0 == grpc_slice_str_cmp(call_details.method, "/beta"));
+
+  finish_pooled_server_call(s2, &was_cancelled, 202);
+  finish_pooled_server_call(s3, &was_cancelled, 602);
+  CQ_EXPECT_COMPLETION(cqv, tag(202), 1);
+  CQ_EXPECT_COMPLETION(cqv, tag(502), 1);
+  CQ_EXPECT_COMPLETION(cqv, tag(602), 1);
+  CQ_EXPECT_COMPLETION(cqv, tag(402), 1);
+  cq_verify(cqv);
+
+
+  destroy_pooled_client_call(&c1);
+  destroy_pooled_client_call(&c2);
+  destroy_pooled_client_call(&c3);
+  grpc_call_unref(s1);
+  grpc_call_unref(s2);
+  grpc_call_unref(s3);
+
+  grpc_metadata_array_destroy(&request_metadata_recv);
+  grpc_call_details_destroy(&call_details);
+}
+
+static grpc_end2end_test_fixture begin_pooled_test(
+    grpc_end2end_test_config config, const char *test_name) {
+  grpc_arg server_arg;
+  grpc_channel_args server_args;
+  grpc_arg client_arg[2];
+  grpc_channel_args client_args;
+
+  server_arg.key = GRPC_ARG_MAX_CONCURRENT_STREAMS;
+  server_arg.type = GRPC_ARG_INTEGER;
+  server_arg.value.integer = 1;
+
+  server_args.num_args = 1;
+  server_args.args = &server_arg;
+
+  client_arg[0].key = GRPC_ARG_MAX_CONNECTIONS_PER_SUBCHANNEL;
+  client_arg[0].type = GRPC_ARG_INTEGER;
+  client_arg[0].value.integer = 2;
+  client_arg[1].key = GRPC_ARG_SUBCHANNEL_CONNECTION_STREAM_THRESHOLD;
+  client_arg[1].type = GRPC_ARG_INTEGER;
+  client_arg[1].value.integer = 1;
+
+  client_args.num_args = 2;
+  client_args.args = client_arg;
+
+  return begin_test(config, test_name, &client_args, &server_args);
+}
+
+static void test_max_concurrent_streams_pooled(
+    grpc_end2end_test_config config) {
+  grpc_end2end_test_fixture f =
+      begin_pooled_test(config, "test_max_concurrent_streams_pooled");
+  cq_verifier *cqv = cq_verifier_create(f.cq);
+
+  run_pooled_calls(config, f, cqv);
+
+  cq_verifier_destroy(cqv);
+  end_test(&f);
+  config.tear_down_data(&f);
+}
+
+/* once the connections went away with the server, the client connects to its
+   next incarnation and opens extra connections to it again */
+static void test_max_concurrent_streams_pooled_after_restart(
+    grpc_end2end_test_config config) {
+  grpc_arg server_arg;
+  grpc_channel_args server_args;
+  grpc_connectivity_state state;
+
+  grpc_end2end_test_fixture f = begin_pooled_test(
+      config, "test_max_concurrent_streams_pooled_after_restart");
+  cq_verifier *cqv = cq_verifier_create(f.cq);
+
+  run_pooled_calls(config, f, cqv);
+
+  server_arg.key = GRPC_ARG_MAX_CONCURRENT_STREAMS;
+  server_arg.type = GRPC_ARG_INTEGER;
+  server_arg.value.integer = 1;
+
+  server_args.num_args = 1;
+  server_args.args = &server_arg;
+
+  /* wait for the client to see the connections go */
+  shutdown_server(&f);
+  state = grpc_channel_check_connectivity_state(f.client, 0);
+  if (state == GRPC_CHANNEL_READY) {
+    grpc_channel_watch_connectivity_state(f.client, state,
+                                          five_seconds_from_now(), f.cq,
+                                          tag(900));
+    CQ_EXPECT_COMPLETION(cqv, tag(900), 1);
+    cq_verify(cqv);
+  }
+
+  config.init_server(&f, &server_args);
+  while ((state = grpc_channel_check_connectivity_state(f.client, 1)) !=
+         GRPC_CHANNEL_READY) {
+    grpc_channel_watch_connectivity_state(f.client, state,
+                                          five_seconds_from_now(), f.cq,
+                                          tag(900));
+    CQ_EXPECT_COMPLETION(cqv, tag(900), 1);
+    cq_verify(cqv);
+  }
+
+  run_pooled_calls(config, f, cqv);
+
+  cq_verifier_destroy(cqv);
+  end_test(&f);
+  config.tear_down_data(&f);
+}
+
 void max_concurrent_streams(grpc_end2end_test_config config) {
   test_max_concurrent_streams_with_timeout_on_first(config);
   test_max_concurrent_streams_with_timeout_on_second(config);
   test_max_concurrent_streams(config);
+  if (config.feature_mask & FEATURE_MASK_SUPPORTS_CLIENT_CHANNEL) {
+    test_max_concurrent_streams_pooled(config);
+    test_max_concurrent_streams_pooled_after_restart(config);
+  }
 }
 
 void max_concurrent_streams_pre_init(void) {}
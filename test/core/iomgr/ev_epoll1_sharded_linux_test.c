@@ -0,0 +1,215 @@
+/*
+ *
+ * Copyright 2017 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#include "src/core/lib/iomgr/port.h"
+
+/* This test only relevant on linux systems where epoll() is available */
+#ifdef GRPC_LINUX_EPOLL
+#include "src/core/lib/iomgr/ev_epoll1_linux.h"
+#include "src/core/lib/iomgr/ev_posix.h"
+
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <grpc/support/alloc.h>
+#include <grpc/support/log.h>
+#include <grpc/support/sync.h>
+#include <grpc/support/thd.h>
+#include <grpc/support/time.h>
+
+#include "src/core/lib/iomgr/iomgr.h"
+#include "src/core/lib/support/env.h"
+#include "test/core/util/test_config.h"
+
+/* The sets fds and pollsets created by a thread join, whatever cpu it runs
+   on: with a single cpu, sharded mode would otherwise use a single set */
+#define NUM_SHARDS 4
+
+static __thread size_t g_thread_shard;
+
+static size_t thread_shard(void) { return g_thread_shard; }
+
+typedef struct test_fd {
+  int fds[2]; /* a pipe: the grpc_fd wraps the read end */
+  grpc_fd *fd;
+  grpc_closure on_read;
+  gpr_event readable;
+} test_fd;
+
+static void on_readable(grpc_exec_ctx *exec_ctx, void *arg,
+                        grpc_error *error) {
+  test_fd *tfd = arg;
+  gpr_event_set(&tfd->readable, (void *)1);
+}
+
+static void test_fd_init(grpc_exec_ctx *exec_ctx, test_fd *tfd,
+                         const char *name) {
+  GPR_ASSERT(pipe(tfd->fds) == 0);
+  GPR_ASSERT(fcntl(tfd->fds[0], F_SETFL, O_NONBLOCK) == 0);
+  tfd->fd = grpc_fd_create(tfd->fds[0], name);
+  gpr_event_init(&tfd->readable);
+  grpc_fd_notify_on_read(exec_ctx, tfd->fd,
+                         GRPC_CLOSURE_INIT(&tfd->on_read, on_readable, tfd,
+                                           grpc_schedule_on_exec_ctx));
+}
+
+static void test_fd_cleanup(grpc_exec_ctx *exec_ctx, test_fd *tfd) {
+  grpc_fd_orphan(exec_ctx, tfd->fd, NULL, NULL, "test_fd_cleanup");
+  close(tfd->fds[1]);
+}
+
+typedef struct test_pollset {
+  grpc_pollset *pollset;
+  gpr_mu *mu;
+} test_pollset;
+
+static void test_pollset_init(test_pollset *tps) {
+  tps->pollset = gpr_zalloc(grpc_pollset_size());
+  grpc_pollset_init(tps->pollset, &tps->mu);
+}
+
+static void destroy_pollset(grpc_exec_ctx *exec_ctx, void *p,
+                            grpc_error *error) {
+  grpc_pollset_destroy(exec_ctx, p);
+}
+
+static void test_pollset_cleanup(grpc_exec_ctx *exec_ctx, test_pollset *tps) {
+  grpc_closure destroyed;
+  gpr_mu_lock(tps->mu);
+  grpc_pollset_shutdown(exec_ctx, tps->pollset,
+                        GRPC_CLOSURE_INIT(&destroyed, destroy_pollset,
+                                          tps->pollset,
+                                          grpc_schedule_on_exec_ctx));
+  gpr_mu_unlock(tps->mu);
+  grpc_exec_ctx_flush(exec_ctx);
+  gpr_free(tps->pollset);
+}
+
+static void poll_once(grpc_exec_ctx *exec_ctx, test_pollset *tps,
+                      gpr_timespec deadline) {
+  grpc_pollset_worker *worker = NULL;
+  gpr_mu_lock(tps->mu);
+  GPR_ASSERT(GRPC_LOG_IF_ERROR(
+      "pollset_work",
+      grpc_pollset_work(exec_ctx, tps->pollset, &worker,
+                        gpr_now(GPR_CLOCK_MONOTONIC), deadline)));
+  gpr_mu_unlock(tps->mu);
+  grpc_exec_ctx_flush(exec_ctx);
+}
+
+/* An fd whose set has never had a designated poller is still polled */
+static void test_unpolled_set(void) {
+  grpc_exec_ctx exec_ctx = GRPC_EXEC_CTX_INIT;
+  test_pollset tps;
+  test_fd tfd;
+
+  g_thread_shard = 2;
+  test_fd_init(&exec_ctx, &tfd, "test_unpolled_set");
+  g_thread_shard = 0;
+  test_pollset_init(&tps);
+
+  GPR_ASSERT(write(tfd.fds[1], "x", 1) == 1);
+  gpr_timespec deadline = grpc_timeout_seconds_to_deadline(10);
+  while (gpr_event_get(&tfd.readable) == NULL) {
+    GPR_ASSERT(gpr_time_cmp(gpr_now(GPR_CLOCK_MONOTONIC), deadline) < 0);
+    poll_once(&exec_ctx, &tps, deadline);
+  }
+
+  test_fd_cleanup(&exec_ctx, &tfd);
+  test_pollset_cleanup(&exec_ctx, &tps);
+  grpc_exec_ctx_finish(&exec_ctx);
+}
+
+typedef struct background_poller {
+  test_pollset tps;
+  gpr_atm stop;
+} background_poller;
+
+static void background_poll(void *arg) {
+  background_poller *bp = arg;
+  grpc_exec_ctx exec_ctx = GRPC_EXEC_CTX_INIT;
+  g_thread_shard = 0;
+  /* let the main thread become the designated poller of its set first */
+  gpr_sleep_until(grpc_timeout_milliseconds_to_deadline(100));
+  while (!gpr_atm_acq_load(&bp->stop)) {
+    poll_once(&exec_ctx, &bp->tps, gpr_inf_future(GPR_CLOCK_MONOTONIC));
+  }
+  grpc_exec_ctx_finish(&exec_ctx);
+}
+
+/* A set whose designated poller leaves, while the only other poller is
+   blocked on its own set, is still polled */
+static void test_abandoned_set(void) {
+  grpc_exec_ctx exec_ctx = GRPC_EXEC_CTX_INIT;
+  background_poller bp;
+  test_pollset tps;
+  test_fd tfd;
+
+  g_thread_shard = 0;
+  test_pollset_init(&bp.tps);
+  gpr_atm_rel_store(&bp.stop, 0);
+  g_thread_shard = 1;
+  test_pollset_init(&tps);
+  test_fd_init(&exec_ctx, &tfd, "test_abandoned_set");
+
+  gpr_thd_id thd;
+  gpr_thd_options opt = gpr_thd_options_default();
+  gpr_thd_options_set_joinable(&opt);
+  GPR_ASSERT(gpr_thd_new(&thd, background_poll, &bp, &opt));
+
+  /* poll set 1 for a while, then leave it to the background poller */
+  poll_once(&exec_ctx, &tps, grpc_timeout_milliseconds_to_deadline(500));
+  GPR_ASSERT(write(tfd.fds[1], "x", 1) == 1);
+  GPR_ASSERT(gpr_event_wait(&tfd.readable,
+                            grpc_timeout_seconds_to_deadline(10)) != NULL);
+
+  gpr_atm_rel_store(&bp.stop, 1);
+  gpr_mu_lock(bp.tps.mu);
+  GPR_ASSERT(GRPC_LOG_IF_ERROR("pollset_kick",
+                               grpc_pollset_kick(bp.tps.pollset, NULL)));
+  gpr_mu_unlock(bp.tps.mu);
+  gpr_thd_join(thd);
+
+  test_fd_cleanup(&exec_ctx, &tfd);
+  test_pollset_cleanup(&exec_ctx, &tps);
+  test_pollset_cleanup(&exec_ctx, &bp.tps);
+  grpc_exec_ctx_finish(&exec_ctx);
+}
+
+int main(int argc, char **argv) {
+  const char *poll_strategy = NULL;
+  grpc_test_init(argc, argv);
+  gpr_setenv("GRPC_POLL_STRATEGY", "epoll1-sharded");
+  grpc_epoll1_set_shards_for_testing(NUM_SHARDS, thread_shard);
+  grpc_exec_ctx exec_ctx = GRPC_EXEC_CTX_INIT;
+  grpc_iomgr_init(&exec_ctx);
+  grpc_iomgr_start(&exec_ctx);
+
+  poll_strategy = grpc_get_poll_strategy_name();
+  GPR_ASSERT(poll_strategy != NULL &&
+             strcmp(poll_strategy, "epoll1-sharded") == 0);
+  test_unpolled_set();
+  test_abandoned_set();
+
+  grpc_iomgr_shutdown(&exec_ctx);
+  grpc_exec_ctx_finish(&exec_ctx);
+  return 0;
+}
+#else /* defined(GRPC_LINUX_EPOLL) */
+int main(int argc, char **argv) { return 0; }
+#endif /* !defined(GRPC_LINUX_EPOLL) */
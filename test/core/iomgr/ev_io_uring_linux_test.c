@@ -0,0 +1,238 @@
+/*
+ *
+ * Copyright 2017 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#include "src/core/lib/iomgr/port.h"
+
+/* This test only relevant on linux systems where io_uring may be available */
+#ifdef GRPC_LINUX_EPOLL
+#include "src/core/lib/iomgr/ev_io_uring_linux.h"
+#include "src/core/lib/iomgr/ev_posix.h"
+
+#include <fcntl.h>
+#include <string.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <grpc/support/alloc.h>
+#include <grpc/support/log.h>
+#include <grpc/support/time.h>
+
+#include "src/core/lib/iomgr/iomgr.h"
+#include "src/core/lib/support/env.h"
+#include "test/core/util/test_config.h"
+
+typedef struct test_fd {
+  int fds[2]; /* a pipe: the grpc_fd wraps the read end */
+  grpc_fd *fd;
+  grpc_closure on_read;
+  int reads;
+} test_fd;
+
+static gpr_mu *g_mu;
+static grpc_pollset *g_pollset;
+
+static void test_fd_init(test_fd *tfd, const char *name) {
+  GPR_ASSERT(pipe(tfd->fds) == 0);
+  GPR_ASSERT(fcntl(tfd->fds[0], F_SETFL, O_NONBLOCK) == 0);
+  GPR_ASSERT(fcntl(tfd->fds[1], F_SETFL, O_NONBLOCK) == 0);
+  tfd->fd = grpc_fd_create(tfd->fds[0], name);
+  tfd->reads = 0;
+}
+
+static void test_fd_cleanup(grpc_exec_ctx *exec_ctx, test_fd *tfd) {
+  grpc_fd_shutdown(exec_ctx, tfd->fd,
+                   GRPC_ERROR_CREATE_FROM_STATIC_STRING("test_fd_cleanup"));
+  grpc_fd_orphan(exec_ctx, tfd->fd, NULL, NULL, "test_fd_cleanup");
+  close(tfd->fds[1]);
+}
+
+static void drain(int fd) {
+  char buf[1024];
+  while (read(fd, buf, sizeof(buf)) > 0) {
+  }
+}
+
+/* Polls until *count reaches target, failing after 10 seconds */
+static void poll_until(grpc_exec_ctx *exec_ctx, const int *count, int target) {
+  gpr_timespec deadline = grpc_timeout_seconds_to_deadline(10);
+  gpr_mu_lock(g_mu);
+  while (*count < target) {
+    GPR_ASSERT(gpr_time_cmp(gpr_now(GPR_CLOCK_MONOTONIC), deadline) < 0);
+    grpc_pollset_worker *worker = NULL;
+    GPR_ASSERT(GRPC_LOG_IF_ERROR(
+        "pollset_work",
+        grpc_pollset_work(exec_ctx, g_pollset, &worker,
+                          gpr_now(GPR_CLOCK_MONOTONIC), deadline)));
+    gpr_mu_unlock(g_mu);
+    grpc_exec_ctx_flush(exec_ctx);
+    gpr_mu_lock(g_mu);
+  }
+  gpr_mu_unlock(g_mu);
+}
+
+static void on_readable(grpc_exec_ctx *exec_ctx, void *arg,
+                        grpc_error *error) {
+  test_fd *tfd = arg;
+  if (error != GRPC_ERROR_NONE) return;
+  drain(tfd->fds[0]);
+  tfd->reads++;
+}
+
+/* The basic readiness notification: a write to the pipe wakes up a poller */
+static void test_fd_readable(void) {
+  grpc_exec_ctx exec_ctx = GRPC_EXEC_CTX_INIT;
+  test_fd tfd;
+  test_fd_init(&tfd, "test_fd_readable");
+  grpc_pollset_add_fd(&exec_ctx, g_pollset, tfd.fd);
+  grpc_fd_notify_on_read(&exec_ctx, tfd.fd,
+                         GRPC_CLOSURE_INIT(&tfd.on_read, on_readable, &tfd,
+                                           grpc_schedule_on_exec_ctx));
+  grpc_exec_ctx_flush(&exec_ctx);
+  GPR_ASSERT(write(tfd.fds[1], "x", 1) == 1);
+  poll_until(&exec_ctx, &tfd.reads, 1);
+  test_fd_cleanup(&exec_ctx, &tfd);
+  grpc_exec_ctx_finish(&exec_ctx);
+}
+
+/* An eventfd that signals itself again whenever it is read: its poll request
+   has a completion waiting every time a poller comes back */
+typedef struct busy_fd {
+  int efd;
+  grpc_fd *fd;
+  grpc_closure on_read;
+  int reads;
+  bool stop;
+} busy_fd;
+
+static void busy_on_readable(grpc_exec_ctx *exec_ctx, void *arg,
+                             grpc_error *error) {
+  busy_fd *busy = arg;
+  if (error != GRPC_ERROR_NONE) return;
+  eventfd_t value;
+  eventfd_read(busy->efd, &value);
+  busy->reads++;
+  if (busy->stop) return;
+  grpc_fd_notify_on_read(exec_ctx, busy->fd, &busy->on_read);
+  GPR_ASSERT(eventfd_write(busy->efd, 1) == 0);
+}
+
+/* An fd created while another fd keeps posting completions must still get
+   its poll request to the kernel, even though pollers then always find
+   completions waiting and never block */
+static void test_new_fd_under_load(void) {
+  grpc_exec_ctx exec_ctx = GRPC_EXEC_CTX_INIT;
+  busy_fd busy;
+  busy.efd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  GPR_ASSERT(busy.efd >= 0);
+  busy.fd = grpc_fd_create(busy.efd, "busy");
+  busy.reads = 0;
+  busy.stop = false;
+  grpc_pollset_add_fd(&exec_ctx, g_pollset, busy.fd);
+  grpc_fd_notify_on_read(&exec_ctx, busy.fd,
+                         GRPC_CLOSURE_INIT(&busy.on_read, busy_on_readable,
+                                           &busy, grpc_schedule_on_exec_ctx));
+  grpc_exec_ctx_flush(&exec_ctx);
+  GPR_ASSERT(eventfd_write(busy.efd, 1) == 0);
+  poll_until(&exec_ctx, &busy.reads, 100);
+
+  test_fd tfd;
+  test_fd_init(&tfd, "test_new_fd_under_load");
+  grpc_pollset_add_fd(&exec_ctx, g_pollset, tfd.fd);
+  grpc_fd_notify_on_read(&exec_ctx, tfd.fd,
+                         GRPC_CLOSURE_INIT(&tfd.on_read, on_readable, &tfd,
+                                           grpc_schedule_on_exec_ctx));
+  grpc_exec_ctx_flush(&exec_ctx);
+  GPR_ASSERT(write(tfd.fds[1], "x", 1) == 1);
+  poll_until(&exec_ctx, &tfd.reads, 1);
+
+  busy.stop = true;
+  test_fd_cleanup(&exec_ctx, &tfd);
+  grpc_fd_shutdown(&exec_ctx, busy.fd,
+                   GRPC_ERROR_CREATE_FROM_STATIC_STRING("busy_cleanup"));
+  grpc_fd_orphan(&exec_ctx, busy.fd, NULL, NULL, "busy_cleanup");
+  grpc_exec_ctx_finish(&exec_ctx);
+}
+
+static void on_released(grpc_exec_ctx *exec_ctx, void *arg,
+                        grpc_error *error) {
+  *(int *)arg = 1;
+}
+
+/* Orphaning an fd waits for its poll request to be removed before handing
+   the fd back */
+static void test_orphan_release_fd(void) {
+  grpc_exec_ctx exec_ctx = GRPC_EXEC_CTX_INIT;
+  test_fd tfd;
+  test_fd_init(&tfd, "test_orphan_release_fd");
+  grpc_pollset_add_fd(&exec_ctx, g_pollset, tfd.fd);
+  int released = 0;
+  int release_fd = -1;
+  grpc_closure on_done;
+  grpc_fd_orphan(&exec_ctx, tfd.fd,
+                 GRPC_CLOSURE_INIT(&on_done, on_released, &released,
+                                   grpc_schedule_on_exec_ctx),
+                 &release_fd, "test_orphan_release_fd");
+  grpc_exec_ctx_flush(&exec_ctx);
+  poll_until(&exec_ctx, &released, 1);
+  GPR_ASSERT(release_fd == tfd.fds[0]);
+  close(tfd.fds[0]);
+  close(tfd.fds[1]);
+  grpc_exec_ctx_finish(&exec_ctx);
+}
+
+static void destroy_pollset(grpc_exec_ctx *exec_ctx, void *p,
+                            grpc_error *error) {
+  grpc_pollset_destroy(exec_ctx, p);
+}
+
+int main(int argc, char **argv) {
+  const char *poll_strategy = NULL;
+  grpc_test_init(argc, argv);
+  /* fall back to poll rather than aborting when io_uring is unavailable */
+  gpr_setenv("GRPC_POLL_STRATEGY", "io_uring,poll");
+  grpc_exec_ctx exec_ctx = GRPC_EXEC_CTX_INIT;
+  grpc_iomgr_init(&exec_ctx);
+  grpc_iomgr_start(&exec_ctx);
+
+  poll_strategy = grpc_get_poll_strategy_name();
+  if (poll_strategy != NULL && strcmp(poll_strategy, "io_uring") == 0) {
+    g_pollset = gpr_zalloc(grpc_pollset_size());
+    grpc_pollset_init(g_pollset, &g_mu);
+    test_fd_readable();
+    test_new_fd_under_load();
+    test_orphan_release_fd();
+    grpc_closure destroyed;
+    grpc_pollset_shutdown(&exec_ctx, g_pollset,
+                          GRPC_CLOSURE_INIT(&destroyed, destroy_pollset,
+                                            g_pollset,
+                                            grpc_schedule_on_exec_ctx));
+    grpc_exec_ctx_flush(&exec_ctx);
+    gpr_free(g_pollset);
+  } else {
+    gpr_log(GPR_INFO,
+            "Skipping the test. io_uring is not available on this kernel, and "
+            "the current strategy is: '%s'",
+            poll_strategy);
+  }
+
+  grpc_iomgr_shutdown(&exec_ctx);
+  grpc_exec_ctx_finish(&exec_ctx);
+  return 0;
+}
+#else /* defined(GRPC_LINUX_EPOLL) */
+int main(int argc, char **argv) { return 0; }
+#endif /* !defined(GRPC_LINUX_EPOLL) */
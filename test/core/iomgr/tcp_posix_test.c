@@ -25,6 +25,8 @@
 
 #include <errno.h>
 #include <fcntl.h>
+#include <netinet/in.h>
+#include <stdbool.h>
 #include <string.h>
 #include <sys/socket.h>
 #include <sys/types.h>
@@ -68,6 +70,32 @@ static void create_sockets(int sv[2]) {
   GPR_ASSERT(fcntl(sv[1], F_SETFL, flags | O_NONBLOCK) == 0);
 }
 
+/* Like create_sockets, but a connected pair of loopback TCP sockets: unix
+   domain sockets do not support everything tcp_posix can do (zero copy) */
+static void create_loopback_sockets(int sv[2]) {
+  struct sockaddr_in addr;
+  socklen_t addr_len = sizeof(addr);
+  int flags;
+  int listener = socket(AF_INET, SOCK_STREAM, 0);
+  GPR_ASSERT(listener >= 0);
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  GPR_ASSERT(bind(listener, (struct sockaddr *)&addr, addr_len) == 0);
+  GPR_ASSERT(listen(listener, 1) == 0);
+  GPR_ASSERT(getsockname(listener, (struct sockaddr *)&addr, &addr_len) == 0);
+  sv[1] = socket(AF_INET, SOCK_STREAM, 0);
+  GPR_ASSERT(sv[1] >= 0);
+  GPR_ASSERT(connect(sv[1], (struct sockaddr *)&addr, addr_len) == 0);
+  sv[0] = accept(listener, NULL, NULL);
+  GPR_ASSERT(sv[0] >= 0);
+  close(listener);
+  flags = fcntl(sv[0], F_GETFL, 0);
+  GPR_ASSERT(fcntl(sv[0], F_SETFL, flags | O_NONBLOCK) == 0);
+  flags = fcntl(sv[1], F_GETFL, 0);
+  GPR_ASSERT(fcntl(sv[1], F_SETFL, flags | O_NONBLOCK) == 0);
+}
+
 static ssize_t fill_socket(int fd) {
   ssize_t write_bytes;
   ssize_t total_bytes = 0;
@@ -109,6 +137,7 @@ static size_t fill_socket_partial(int fd, size_t bytes) {
 
 struct read_socket_state {
   grpc_endpoint *ep;
+  size_t read_calls;
   size_t read_bytes;
   size_t target_read_bytes;
   grpc_slice_buffer incoming;
@@ -144,6 +173,7 @@ static void read_cb(grpc_exec_ctx *exec_ctx, void *user_data,
   read_bytes = count_slices(state->incoming.slices, state->incoming.count,
                             &current_data);
   state->read_bytes += read_bytes;
+  state->read_calls++;
   gpr_log(GPR_INFO, "Read %" PRIuPTR " bytes of %" PRIuPTR, read_bytes,
           state->target_read_bytes);
   if (state->read_bytes >= state->target_read_bytes) {
@@ -155,8 +185,9 @@ static void read_cb(grpc_exec_ctx *exec_ctx, void *user_data,
   }
 }
 
-/* Write to a socket, then read from it using the grpc_tcp API. */
-static void read_test(size_t num_bytes, size_t slice_size) {
+/* Write to a socket, then read from it using the grpc_tcp API. If drain_budget
+   covers all the data, it must arrive in a single read. */
+static void read_test(size_t num_bytes, size_t slice_size, int drain_budget) {
   int sv[2];
   grpc_endpoint *ep;
   struct read_socket_state state;
@@ -164,14 +195,18 @@ static void read_test(size_t num_bytes, size_t slice_size) {
   gpr_timespec deadline = grpc_timeout_seconds_to_deadline(20);
   grpc_exec_ctx exec_ctx = GRPC_EXEC_CTX_INIT;
 
-  gpr_log(GPR_INFO, "Read test of size %" PRIuPTR ", slice size %" PRIuPTR,
-          num_bytes, slice_size);
+  gpr_log(GPR_INFO, "Read test of size %" PRIuPTR ", slice size %" PRIuPTR
+                    ", drain budget %d",
+          num_bytes, slice_size, drain_budget);
 
   create_sockets(sv);
 
   grpc_arg a[] = {{.key = GRPC_ARG_TCP_READ_CHUNK_SIZE,
                    .type = GRPC_ARG_INTEGER,
-                   .value.integer = (int)slice_size}};
+                   .value.integer = (int)slice_size},
+                  {.key = GRPC_ARG_TCP_READ_DRAIN_BUDGET,
+                   .type = GRPC_ARG_INTEGER,
+                   .value.integer = drain_budget}};
   grpc_channel_args args = {.num_args = GPR_ARRAY_SIZE(a), .args = a};
   ep = grpc_tcp_create(&exec_ctx, grpc_fd_create(sv[1], "read_test"), &args,
                        "test");
@@ -181,6 +216,7 @@ static void read_test(size_t num_bytes, size_t slice_size) {
   gpr_log(GPR_INFO, "Wrote %" PRIuPTR " bytes", written_bytes);
 
   state.ep = ep;
+  state.read_calls = 0;
   state.read_bytes = 0;
   state.target_read_bytes = written_bytes;
   grpc_slice_buffer_init(&state.incoming);
@@ -200,6 +236,9 @@ static void read_test(size_t num_bytes, size_t slice_size) {
     gpr_mu_lock(g_mu);
   }
   GPR_ASSERT(state.read_bytes == state.target_read_bytes);
+  if ((size_t)drain_budget >= num_bytes) {
+    GPR_ASSERT(state.read_calls == 1);
+  }
   gpr_mu_unlock(g_mu);
 
   grpc_slice_buffer_destroy_internal(&exec_ctx, &state.incoming);
@@ -233,6 +272,7 @@ static void large_read_test(size_t slice_size) {
   gpr_log(GPR_INFO, "Wrote %" PRIuPTR " bytes", written_bytes);
 
   state.ep = ep;
+  state.read_calls = 0;
   state.read_bytes = 0;
   state.target_read_bytes = (size_t)written_bytes;
   grpc_slice_buffer_init(&state.incoming);
@@ -342,8 +382,9 @@ void drain_socket_blocking(int fd, size_t num_bytes, size_t read_size) {
 
 /* Write to a socket using the grpc_tcp API, then drain it directly.
    Note that if the write does not complete immediately we need to drain the
-   socket in parallel with the read. */
-static void write_test(size_t num_bytes, size_t slice_size) {
+   socket in parallel with the read. If zerocopy is set, the endpoint is asked
+   to send zero copy over loopback TCP. */
+static void write_test(size_t num_bytes, size_t slice_size, bool zerocopy) {
   int sv[2];
   grpc_endpoint *ep;
   struct write_socket_state state;
@@ -356,14 +397,25 @@ static void write_test(size_t num_bytes, size_t slice_size) {
   grpc_exec_ctx exec_ctx = GRPC_EXEC_CTX_INIT;
 
   gpr_log(GPR_INFO,
-          "Start write test with %" PRIuPTR " bytes, slice size %" PRIuPTR,
-          num_bytes, slice_size);
+          "Start write test with %" PRIuPTR " bytes, slice size %" PRIuPTR
+          ", zerocopy %d",
+          num_bytes, slice_size, zerocopy);
 
-  create_sockets(sv);
+  if (zerocopy) {
+    create_loopback_sockets(sv);
+  } else {
+    create_sockets(sv);
+  }
 
   grpc_arg a[] = {{.key = GRPC_ARG_TCP_READ_CHUNK_SIZE,
                    .type = GRPC_ARG_INTEGER,
-                   .value.integer = (int)slice_size}};
+                   .value.integer = (int)slice_size},
+                  {.key = GRPC_ARG_TCP_TX_ZEROCOPY_ENABLED,
+                   .type = GRPC_ARG_INTEGER,
+                   .value.integer = zerocopy},
+                  {.key = GRPC_ARG_TCP_TX_ZEROCOPY_SEND_BYTES_THRESHOLD,
+                   .type = GRPC_ARG_INTEGER,
+                   .value.integer = 0}};
   grpc_channel_args args = {.num_args = GPR_ARRAY_SIZE(a), .args = a};
   ep = grpc_tcp_create(&exec_ctx, grpc_fd_create(sv[1], "write_test"), &args,
                        "test");
@@ -381,6 +433,9 @@ static void write_test(size_t num_bytes, size_t slice_size) {
 
   grpc_endpoint_write(&exec_ctx, ep, &outgoing, &write_done_closure);
   drain_socket_blocking(sv[0], num_bytes, num_bytes);
+  /* a write that completed inline scheduled write_done here: run it rather
+     than wait for a poller event that a TCP socket may not generate */
+  grpc_exec_ctx_flush(&exec_ctx);
   gpr_mu_lock(g_mu);
   for (;;) {
     grpc_pollset_worker *worker = NULL;
@@ -410,6 +465,99 @@ void on_fd_released(grpc_exec_ctx *exec_ctx, void *arg, grpc_error *errors) {
       GRPC_LOG_IF_ERROR("pollset_kick", grpc_pollset_kick(g_pollset, NULL)));
 }
 
+/* Unlike on_fd_released, may run on another thread than the test's */
+static void zerocopy_on_fd_released(grpc_exec_ctx *exec_ctx, void *arg,
+                                    grpc_error *errors) {
+  int *done = arg;
+  gpr_mu_lock(g_mu);
+  *done = 1;
+  GPR_ASSERT(
+      GRPC_LOG_IF_ERROR("pollset_kick", grpc_pollset_kick(g_pollset, NULL)));
+  gpr_mu_unlock(g_mu);
+}
+
+/* Send zero copy, then release the endpoint's fd before the peer has read
+   anything. The kernel may not have reported the send complete yet: the fd
+   must still be handed back, once it has. */
+static void zerocopy_release_fd_test(size_t num_bytes) {
+  int sv[2];
+  int fd;
+  grpc_endpoint *ep;
+  struct write_socket_state state;
+  size_t num_blocks;
+  grpc_slice *slices;
+  uint8_t current_data = 0;
+  grpc_slice_buffer outgoing;
+  grpc_closure write_done_closure;
+  grpc_closure fd_released_cb;
+  int fd_released_done = 0;
+  gpr_timespec deadline = grpc_timeout_seconds_to_deadline(20);
+  grpc_exec_ctx exec_ctx = GRPC_EXEC_CTX_INIT;
+
+  gpr_log(GPR_INFO, "Start zerocopy release fd test with %" PRIuPTR " bytes",
+          num_bytes);
+
+  create_loopback_sockets(sv);
+  grpc_arg a[] = {{.key = GRPC_ARG_TCP_TX_ZEROCOPY_ENABLED,
+                   .type = GRPC_ARG_INTEGER,
+                   .value.integer = 1},
+                  {.key = GRPC_ARG_TCP_TX_ZEROCOPY_SEND_BYTES_THRESHOLD,
+                   .type = GRPC_ARG_INTEGER,
+                   .value.integer = 0}};
+  grpc_channel_args args = {.num_args = GPR_ARRAY_SIZE(a), .args = a};
+  ep = grpc_tcp_create(&exec_ctx, grpc_fd_create(sv[1], "zerocopy_release"),
+                       &args, "test");
+  grpc_endpoint_add_to_pollset(&exec_ctx, ep, g_pollset);
+
+  state.ep = ep;
+  state.write_done = 0;
+  slices = allocate_blocks(num_bytes, num_bytes, &num_blocks, &current_data);
+  grpc_slice_buffer_init(&outgoing);
+  grpc_slice_buffer_addn(&outgoing, slices, num_blocks);
+  GRPC_CLOSURE_INIT(&write_done_closure, write_done, &state,
+                    grpc_schedule_on_exec_ctx);
+  grpc_endpoint_write(&exec_ctx, ep, &outgoing, &write_done_closure);
+  grpc_exec_ctx_flush(&exec_ctx);
+  gpr_mu_lock(g_mu);
+  while (!state.write_done) {
+    grpc_pollset_worker *worker = NULL;
+    GPR_ASSERT(GRPC_LOG_IF_ERROR(
+        "pollset_work",
+        grpc_pollset_work(&exec_ctx, g_pollset, &worker,
+                          gpr_now(GPR_CLOCK_MONOTONIC), deadline)));
+    gpr_mu_unlock(g_mu);
+    grpc_exec_ctx_finish(&exec_ctx);
+    gpr_mu_lock(g_mu);
+  }
+  gpr_mu_unlock(g_mu);
+  grpc_slice_buffer_destroy_internal(&exec_ctx, &outgoing);
+  gpr_free(slices);
+
+  GRPC_CLOSURE_INIT(&fd_released_cb, zerocopy_on_fd_released,
+                    &fd_released_done, grpc_schedule_on_exec_ctx);
+  grpc_tcp_destroy_and_release_fd(&exec_ctx, ep, &fd, &fd_released_cb);
+  grpc_exec_ctx_flush(&exec_ctx);
+  drain_socket_blocking(sv[0], num_bytes, num_bytes);
+  gpr_mu_lock(g_mu);
+  while (!fd_released_done) {
+    grpc_pollset_worker *worker = NULL;
+    GPR_ASSERT(gpr_time_cmp(gpr_now(GPR_CLOCK_MONOTONIC), deadline) < 0);
+    GPR_ASSERT(GRPC_LOG_IF_ERROR(
+        "pollset_work",
+        grpc_pollset_work(&exec_ctx, g_pollset, &worker,
+                          gpr_now(GPR_CLOCK_MONOTONIC),
+                          grpc_timeout_milliseconds_to_deadline(100))));
+    gpr_mu_unlock(g_mu);
+    grpc_exec_ctx_finish(&exec_ctx);
+    gpr_mu_lock(g_mu);
+  }
+  gpr_mu_unlock(g_mu);
+  GPR_ASSERT(fd == sv[1]);
+  grpc_exec_ctx_finish(&exec_ctx);
+  close(fd);
+  close(sv[0]);
+}
+
 /* Do a read_test, then release fd and try to read/write again. Verify that
    grpc_tcp_fd() is available before the fd is released. */
 static void release_fd_test(size_t num_bytes, size_t slice_size) {
@@ -444,6 +592,7 @@ static void release_fd_test(size_t num_bytes, size_t slice_size) {
   gpr_log(GPR_INFO, "Wrote %" PRIuPTR " bytes", written_bytes);
 
   state.ep = ep;
+  state.read_calls = 0;
   state.read_bytes = 0;
   state.target_read_bytes = written_bytes;
   grpc_slice_buffer_init(&state.incoming);
@@ -494,23 +643,32 @@ static void release_fd_test(size_t num_bytes, size_t slice_size) {
 void run_tests(void) {
   size_t i = 0;
 
-  read_test(100, 8192);
-  read_test(10000, 8192);
-  read_test(10000, 137);
-  read_test(10000, 1);
+  read_test(100, 8192, 0);
+  read_test(10000, 8192, 0);
+  read_test(10000, 137, 0);
+  read_test(10000, 1, 0);
+  read_test(10000, 137, 1024 * 1024);
+  read_test(100000, 1, 1024 * 1024);
+  read_test(100000, 8192, 4096);
   large_read_test(8192);
   large_read_test(1);
 
-  write_test(100, 8192);
-  write_test(100, 1);
-  write_test(100000, 8192);
-  write_test(100000, 1);
-  write_test(100000, 137);
+  write_test(100, 8192, false);
+  write_test(100, 1, false);
+  write_test(100000, 8192, false);
+  write_test(100000, 1, false);
+  write_test(100000, 137, false);
 
   for (i = 1; i < 1000; i = GPR_MAX(i + 1, i * 5 / 4)) {
-    write_test(40320, i);
+    write_test(40320, i, false);
   }
 
+  write_test(100, 8192, true);
+  write_test(100000, 8192, true);
+  write_test(100000, 1, true);
+  write_test(10000000, 1024 * 1024, true);
+  zerocopy_release_fd_test(64 * 1024);
+
   release_fd_test(100, 8192);
 }
 
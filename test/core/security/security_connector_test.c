@@ -66,14 +66,16 @@ static int check_peer_property(const tsi_peer *peer,
 
 static int check_ssl_peer_equivalence(const tsi_peer *original,
                                       const tsi_peer *reconstructed) {
-  /* The reconstructed peer only has CN, SAN and pem cert properties. */
+  /* The reconstructed peer only has CN, SAN, pem cert and session reuse
+     properties. */
   size_t i;
   for (i = 0; i < original->property_count; i++) {
     const tsi_peer_property *prop = &original->properties[i];
     if ((strcmp(prop->name, TSI_X509_SUBJECT_COMMON_NAME_PEER_PROPERTY) == 0) ||
         (strcmp(prop->name, TSI_X509_SUBJECT_ALTERNATIVE_NAME_PEER_PROPERTY) ==
          0) ||
-        (strcmp(prop->name, TSI_X509_PEM_CERT_PROPERTY) == 0)) {
+        (strcmp(prop->name, TSI_X509_PEM_CERT_PROPERTY) == 0) ||
+        (strcmp(prop->name, TSI_SSL_SESSION_REUSED_PEER_PROPERTY) == 0)) {
       if (!check_peer_property(reconstructed, prop)) return 0;
     }
   }
@@ -172,6 +174,27 @@ static int check_x509_pem_cert(const grpc_auth_context *ctx,
   return 1;
 }
 
+static int check_ssl_session_reused(const grpc_auth_context *ctx,
+                                    const char *expected_session_reused) {
+  grpc_auth_property_iterator it = grpc_auth_context_find_properties_by_name(
+      ctx, GRPC_SSL_SESSION_REUSED_PROPERTY);
+  const grpc_auth_property *prop = grpc_auth_property_iterator_next(&it);
+  if (prop == NULL) {
+    gpr_log(GPR_ERROR, "Session reused property not found.");
+    return 0;
+  }
+  if (strncmp(prop->value, expected_session_reused, prop->value_length) != 0) {
+    gpr_log(GPR_ERROR, "Expected session reused %s and got %s",
+            expected_session_reused, prop->value);
+    return 0;
+  }
+  if (grpc_auth_property_iterator_next(&it) != NULL) {
+    gpr_log(GPR_ERROR, "Expected only one property for session reused.");
+    return 0;
+  }
+  return 1;
+}
+
 static void test_cn_only_ssl_peer_to_auth_context(void) {
   tsi_peer peer;
   tsi_peer rpeer;
@@ -341,6 +364,37 @@ static grpc_ssl_roots_override_result override_roots_permanent_failure(
   return GRPC_SSL_ROOTS_OVERRIDE_FAIL_PERMANENTLY;
 }
 
+static void test_session_reused_ssl_peer_to_auth_context(void) {
+  tsi_peer peer;
+  tsi_peer rpeer;
+  grpc_auth_context *ctx;
+  const char *expected_cn = "cn1";
+  GPR_ASSERT(tsi_construct_peer(3, &peer) == TSI_OK);
+  GPR_ASSERT(tsi_construct_string_peer_property_from_cstring(
+                 TSI_CERTIFICATE_TYPE_PEER_PROPERTY, TSI_X509_CERTIFICATE_TYPE,
+                 &peer.properties[0]) == TSI_OK);
+  GPR_ASSERT(tsi_construct_string_peer_property_from_cstring(
+                 TSI_X509_SUBJECT_COMMON_NAME_PEER_PROPERTY, expected_cn,
+                 &peer.properties[1]) == TSI_OK);
+  GPR_ASSERT(tsi_construct_string_peer_property_from_cstring(
+                 TSI_SSL_SESSION_REUSED_PEER_PROPERTY, "true",
+                 &peer.properties[2]) == TSI_OK);
+  ctx = tsi_ssl_peer_to_auth_context(&peer);
+  GPR_ASSERT(ctx != NULL);
+  GPR_ASSERT(grpc_auth_context_peer_is_authenticated(ctx));
+  GPR_ASSERT(check_identity(ctx, GRPC_X509_CN_PROPERTY_NAME, &expected_cn, 1));
+  GPR_ASSERT(check_transport_security_type(ctx));
+  GPR_ASSERT(check_x509_cn(ctx, expected_cn));
+  GPR_ASSERT(check_ssl_session_reused(ctx, "true"));
+
+  rpeer = tsi_shallow_peer_from_ssl_auth_context(ctx);
+  GPR_ASSERT(check_ssl_peer_equivalence(&peer, &rpeer));
+
+  tsi_shallow_peer_destruct(&rpeer);
+  tsi_peer_destruct(&peer);
+  GRPC_AUTH_CONTEXT_UNREF(ctx, "test");
+}
+
 static void test_default_ssl_roots(void) {
   const char *roots_for_env_var = "roots for env var";
 
@@ -398,6 +452,7 @@ int main(int argc, char **argv) {
   test_cn_and_one_san_ssl_peer_to_auth_context();
   test_cn_and_multiple_sans_ssl_peer_to_auth_context();
   test_cn_and_multiple_sans_and_others_ssl_peer_to_auth_context();
+  test_session_reused_ssl_peer_to_auth_context();
   test_default_ssl_roots();
 
   grpc_shutdown();
@@ -25,6 +25,7 @@
 #include <grpc/support/thd.h>
 #include <grpc/support/useful.h>
 #include <inttypes.h>
+#include <stdbool.h>
 #include <string.h>
 
 #include "src/core/lib/support/string.h"
@@ -112,6 +113,40 @@ static void concurrent_test(void) {
   gpr_arena_destroy(args.arena);
 }
 
+static bool is_zeroed(const char *p, size_t n) {
+  for (size_t i = 0; i < n; i++) {
+    if (p[i] != 0) return false;
+  }
+  return true;
+}
+
+static void pool_test(void) {
+  gpr_log(GPR_DEBUG, "pool_test");
+
+  gpr_arena_pool *pool = gpr_arena_pool_create(1);
+  // a released arena's buffer is reused, and handed out zeroed again
+  gpr_arena *a = gpr_arena_create_from_pool(pool, 256);
+  char *p = gpr_arena_alloc(a, 128);
+  memset(p, 1, 128);
+  memset(gpr_arena_alloc(a, 1024), 1, 1024);
+  GPR_ASSERT(gpr_arena_destroy(a) >= 128 + 1024);
+  gpr_arena *b = gpr_arena_create_from_pool(pool, 256);
+  GPR_ASSERT(b == a);
+  char *q = gpr_arena_alloc(b, 256);
+  GPR_ASSERT(q == p);
+  GPR_ASSERT(is_zeroed(q, 256));
+  // the pool is full while b is cached: c must be freed on release
+  gpr_arena *c = gpr_arena_create_from_pool(pool, 256);
+  GPR_ASSERT(c != b);
+  gpr_arena_destroy(b);
+  gpr_arena_destroy(c);
+  // a cached buffer too small for the request is not reused
+  gpr_arena *d = gpr_arena_create_from_pool(pool, 4096);
+  memset(gpr_arena_alloc(d, 4096), 1, 4096);
+  gpr_arena_destroy(d);
+  gpr_arena_pool_destroy(pool);
+}
+
 int main(int argc, char *argv[]) {
   grpc_test_init(argc, argv);
 
@@ -123,6 +158,7 @@ int main(int argc, char *argv[]) {
   TEST(1_inc, 1, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11);
   TEST(6_123, 6, 1, 2, 3);
   concurrent_test();
+  pool_test();
 
   return 0;
 }
@@ -182,10 +182,83 @@ static void test_mt_multipop(void) {
   gpr_mpscq_destroy(&q);
 }
 
+typedef struct {
+  gpr_locked_mpscq *q;
+  gpr_event *start;
+} locked_push_args;
+
+static void locked_push_thread(void *arg) {
+  locked_push_args *a = arg;
+  gpr_event_wait(a->start, gpr_inf_future(GPR_CLOCK_REALTIME));
+  for (size_t i = 1; i <= THREAD_ITERATIONS; i++) {
+    gpr_locked_mpscq_push(a->q, &new_node(i, NULL)->node);
+  }
+}
+
+typedef struct {
+  size_t num_nodes;
+  gpr_atm num_popped;
+  gpr_atm spins;
+  gpr_locked_mpscq *q;
+  gpr_event *start;
+} locked_pull_args;
+
+static void locked_pull_thread(void *arg) {
+  locked_pull_args *pa = arg;
+  gpr_event_wait(pa->start, gpr_inf_future(GPR_CLOCK_REALTIME));
+  while ((size_t)gpr_atm_acq_load(&pa->num_popped) != pa->num_nodes) {
+    gpr_mpscq_node *n = gpr_locked_mpscq_try_pop(pa->q);
+    if (n == NULL) {
+      gpr_atm_no_barrier_fetch_add(&pa->spins, 1);
+      continue;
+    }
+    gpr_free(n);
+    gpr_atm_full_fetch_add(&pa->num_popped, 1);
+  }
+}
+
+static void test_locked_mt_multipop(void) {
+  gpr_log(GPR_DEBUG, "test_locked_mt_multipop");
+  gpr_event start;
+  gpr_event_init(&start);
+  gpr_thd_id thds[50];
+  gpr_thd_id pull_thds[50];
+  gpr_locked_mpscq q;
+  gpr_locked_mpscq_init(&q);
+  locked_push_args ta = {&q, &start};
+  for (size_t i = 0; i < GPR_ARRAY_SIZE(thds); i++) {
+    gpr_thd_options options = gpr_thd_options_default();
+    gpr_thd_options_set_joinable(&options);
+    GPR_ASSERT(gpr_thd_new(&thds[i], locked_push_thread, &ta, &options));
+  }
+  locked_pull_args pa;
+  pa.num_nodes = GPR_ARRAY_SIZE(thds) * THREAD_ITERATIONS;
+  gpr_atm_no_barrier_store(&pa.num_popped, 0);
+  gpr_atm_no_barrier_store(&pa.spins, 0);
+  pa.q = &q;
+  pa.start = &start;
+  for (size_t i = 0; i < GPR_ARRAY_SIZE(pull_thds); i++) {
+    gpr_thd_options options = gpr_thd_options_default();
+    gpr_thd_options_set_joinable(&options);
+    GPR_ASSERT(gpr_thd_new(&pull_thds[i], locked_pull_thread, &pa, &options));
+  }
+  gpr_event_set(&start, (void *)1);
+  for (size_t i = 0; i < GPR_ARRAY_SIZE(pull_thds); i++) {
+    gpr_thd_join(pull_thds[i]);
+  }
+  gpr_log(GPR_DEBUG, "spins: %" PRIdPTR, gpr_atm_no_barrier_load(&pa.spins));
+  for (size_t i = 0; i < GPR_ARRAY_SIZE(thds); i++) {
+    gpr_thd_join(thds[i]);
+  }
+  GPR_ASSERT(gpr_locked_mpscq_pop(&q) == NULL);
+  gpr_locked_mpscq_destroy(&q);
+}
+
 int main(int argc, char **argv) {
   grpc_test_init(argc, argv);
   test_serial();
   test_mt();
   test_mt_multipop();
+  test_locked_mt_multipop();
   return 0;
 }
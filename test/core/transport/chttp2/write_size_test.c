@@ -0,0 +1,85 @@
+/*
+ *
+ * Copyright 2015 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "src/core/ext/transport/chttp2/transport/internal.h"
+
+#include <grpc/support/log.h>
+
+#include "test/core/util/test_config.h"
+
+static void test_slow_writes_track_drain_rate(void) {
+  gpr_log(GPR_INFO, "test_slow_writes_track_drain_rate");
+  double bw_est = 0;
+  /* 1MB took 10ms: 100MB/s drains 10KB per 100us, below the minimum */
+  uint32_t target = grpc_chttp2_adapt_target_write_size(
+      GRPC_CHTTP2_MAX_TARGET_WRITE_SIZE, &bw_est, 1024 * 1024, 10e-3, 0);
+  GPR_ASSERT(bw_est > 104.8e6 && bw_est < 104.9e6);
+  GPR_ASSERT(target == GRPC_CHTTP2_MIN_TARGET_WRITE_SIZE);
+  /* 100KB took 200us: 512MB/s, averaged with the previous estimate */
+  target = grpc_chttp2_adapt_target_write_size(target, &bw_est, 100 * 1024,
+                                               200e-6, 0);
+  GPR_ASSERT(bw_est > 308.4e6 && bw_est < 308.5e6);
+  GPR_ASSERT(target == 30842);
+}
+
+static void test_prompt_writes_grow_target(void) {
+  gpr_log(GPR_INFO, "test_prompt_writes_grow_target");
+  double bw_est = 0;
+  uint32_t target = GRPC_CHTTP2_MIN_TARGET_WRITE_SIZE;
+  /* a full batch that went out promptly doubles the target... */
+  target = grpc_chttp2_adapt_target_write_size(target, &bw_est, target,
+                                               50e-6, 0);
+  GPR_ASSERT(target == 2 * GRPC_CHTTP2_MIN_TARGET_WRITE_SIZE);
+  /* ... a short one tells us nothing ... */
+  double prev_bw_est = bw_est;
+  GPR_ASSERT(grpc_chttp2_adapt_target_write_size(target, &bw_est, 100, 50e-6,
+                                                 0) == target);
+  GPR_ASSERT(bw_est == prev_bw_est);
+  /* ... and the target never exceeds the maximum */
+  while (target < GRPC_CHTTP2_MAX_TARGET_WRITE_SIZE) {
+    uint32_t next = grpc_chttp2_adapt_target_write_size(target, &bw_est,
+                                                        target, 50e-6, 0);
+    GPR_ASSERT(next > target);
+    target = next;
+  }
+  GPR_ASSERT(target == GRPC_CHTTP2_MAX_TARGET_WRITE_SIZE);
+  GPR_ASSERT(grpc_chttp2_adapt_target_write_size(target, &bw_est, target,
+                                                 50e-6, 0) == target);
+}
+
+static void test_bdp_bandwidth_is_a_floor(void) {
+  gpr_log(GPR_INFO, "test_bdp_bandwidth_is_a_floor");
+  double bw_est = 0;
+  /* the endpoint drained at 100MB/s, but the link is known to carry 5GB/s */
+  uint32_t target = grpc_chttp2_adapt_target_write_size(
+      GRPC_CHTTP2_MAX_TARGET_WRITE_SIZE, &bw_est, 1000 * 1000, 10e-3, 5e9);
+  GPR_ASSERT(target == 500000);
+  /* the floor does not leak into the drain rate estimate */
+  GPR_ASSERT(bw_est == 1e8);
+  target = grpc_chttp2_adapt_target_write_size(target, &bw_est, 1000 * 1000,
+                                               10e-3, 0);
+  GPR_ASSERT(target == GRPC_CHTTP2_MIN_TARGET_WRITE_SIZE);
+}
+
+int main(int argc, char **argv) {
+  grpc_test_init(argc, argv);
+  test_slow_writes_track_drain_rate();
+  test_prompt_writes_grow_target();
+  test_bdp_bandwidth_is_a_floor();
+  return 0;
+}
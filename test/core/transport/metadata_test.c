@@ -18,6 +18,7 @@
 
 #include "src/core/lib/transport/metadata.h"
 
+#include <inttypes.h>
 #include <stdio.h>
 #include <string.h>
 
@@ -29,6 +30,7 @@
 #include "src/core/ext/transport/chttp2/transport/bin_encoder.h"
 #include "src/core/lib/slice/slice_internal.h"
 #include "src/core/lib/support/string.h"
+#include "src/core/lib/transport/metadata_batch.h"
 #include "src/core/lib/transport/static_metadata.h"
 #include "test/core/util/test_config.h"
 
@@ -382,6 +384,78 @@ static void test_copied_static_metadata(bool dup_key, bool dup_value) {
   grpc_shutdown();
 }
 
+static void test_metadata_batch_find(bool intern_keys) {
+  gpr_log(GPR_INFO, "test_metadata_batch_find: intern_keys=%d", intern_keys);
+  grpc_init();
+  grpc_exec_ctx exec_ctx = GRPC_EXEC_CTX_INIT;
+
+  /* enough custom keys to share buckets, each present twice, plus a callout */
+  grpc_linked_mdelem storage[2 * 40 + 1];
+  grpc_metadata_batch batch;
+  grpc_metadata_batch_init(&batch);
+  for (size_t i = 0; i < 2 * 40; i++) {
+    char *key;
+    gpr_asprintf(&key, "x-custom-%" PRIuPTR, i % 40);
+    GRPC_LOG_IF_ERROR(
+        "add_tail",
+        grpc_metadata_batch_add_tail(
+            &exec_ctx, &batch, &storage[i],
+            grpc_mdelem_from_slices(
+                &exec_ctx,
+                maybe_intern(grpc_slice_from_copied_string(key), intern_keys),
+                grpc_slice_from_copied_string(i < 40 ? "first" : "second"))));
+    gpr_free(key);
+  }
+  GRPC_LOG_IF_ERROR("add_head",
+                    grpc_metadata_batch_add_head(
+                        &exec_ctx, &batch, &storage[2 * 40],
+                        grpc_mdelem_from_slices(
+                            &exec_ctx, GRPC_MDSTR_PATH,
+                            grpc_slice_from_static_string("/foo"))));
+
+  /* callout keys are found whether or not the key passed is static */
+  GPR_ASSERT(grpc_metadata_batch_find(&batch, GRPC_MDSTR_PATH) ==
+             &storage[2 * 40]);
+  GPR_ASSERT(grpc_metadata_batch_find(
+                 &batch, grpc_slice_from_static_string(":path")) ==
+             &storage[2 * 40]);
+  GPR_ASSERT(grpc_metadata_batch_find(
+                 &batch, grpc_slice_from_static_string("x-missing")) == NULL);
+  /* the first element with a key wins, and removing it exposes the second */
+  for (size_t i = 0; i < 40; i++) {
+    char *key;
+    gpr_asprintf(&key, "x-custom-%" PRIuPTR, i);
+    grpc_slice key_slice = grpc_slice_from_copied_string(key);
+    GPR_ASSERT(grpc_metadata_batch_find(&batch, key_slice) == &storage[i]);
+    grpc_metadata_batch_remove(&exec_ctx, &batch, &storage[i]);
+    GPR_ASSERT(grpc_metadata_batch_find(&batch, key_slice) ==
+               &storage[i + 40]);
+    grpc_slice_unref_internal(&exec_ctx, key_slice);
+    gpr_free(key);
+  }
+  /* a key substituted in place keeps its list position in its bucket */
+  grpc_slice key0 = grpc_slice_from_static_string("x-custom-0");
+  GPR_ASSERT(GRPC_LOG_IF_ERROR(
+      "substitute",
+      grpc_metadata_batch_substitute(
+          &exec_ctx, &batch, &storage[79],
+          grpc_mdelem_from_slices(&exec_ctx, grpc_slice_intern(key0),
+                                  grpc_slice_from_static_string("third")))));
+  GPR_ASSERT(grpc_metadata_batch_find(&batch, key0) == &storage[40]);
+  grpc_metadata_batch_remove(&exec_ctx, &batch, &storage[40]);
+  GPR_ASSERT(grpc_metadata_batch_find(&batch, key0) == &storage[79]);
+
+  /* batches move by value */
+  grpc_metadata_batch moved = batch;
+  grpc_metadata_batch_init(&batch);
+  GPR_ASSERT(grpc_metadata_batch_find(&moved, key0) == &storage[79]);
+  GPR_ASSERT(grpc_metadata_batch_find(&batch, key0) == NULL);
+
+  grpc_metadata_batch_destroy(&exec_ctx, &moved);
+  grpc_exec_ctx_finish(&exec_ctx);
+  grpc_shutdown();
+}
+
 int main(int argc, char **argv) {
   grpc_test_init(argc, argv);
   test_no_op();
@@ -398,5 +472,7 @@ int main(int argc, char **argv) {
   test_create_many_persistant_metadata();
   test_things_stick_around();
   test_user_data_works();
+  test_metadata_batch_find(false);
+  test_metadata_batch_find(true);
   return 0;
 }
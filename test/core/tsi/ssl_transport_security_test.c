@@ -0,0 +1,707 @@
+/*
+ *
+ * Copyright 2017 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "src/core/tsi/ssl_transport_security.h"
+
+#include <string.h>
+
+#include <grpc/support/alloc.h>
+#include <grpc/support/log.h>
+#include <grpc/support/useful.h>
+
+#include <openssl/bio.h>
+#include <openssl/evp.h>
+#include <openssl/ec.h>
+#include <openssl/pem.h>
+#include <openssl/ssl.h>
+#include <openssl/x509v3.h>
+
+#include "src/core/tsi/transport_security_adapter.h"
+#include "test/core/util/test_config.h"
+
+/* Mirrors the condition under which the kernel TLS keys can be exported. */
+#if defined(OPENSSL_IS_BORINGSSL) || OPENSSL_VERSION_NUMBER >= 0x10101000L
+#define TEST_KERNEL_TLS_KEYS 1
+#endif
+
+/* Mirrors the default of ssl_transport_security.c: without ALPN support, TSI
+   only negotiates protocols with NPN. */
+#ifndef TSI_OPENSSL_ALPN_SUPPORT
+#define TSI_OPENSSL_ALPN_SUPPORT 1
+#endif
+
+#define SERVER_NAME "server.test.example"
+/* The certificate is valid for all the subdomains of this domain. */
+#define SERVER_DOMAIN "test.example"
+
+#define AES_128_GCM_SUITE "ECDHE-ECDSA-AES128-GCM-SHA256"
+#define AES_256_GCM_SUITE "ECDHE-ECDSA-AES256-GCM-SHA384"
+
+static const char *g_alpn_protocols[] = {"grpc-exp", "h2"};
+/* The same protocols, in the wire format of ALPN and NPN. */
+static const unsigned char g_protocol_list[] = "\x08grpc-exp\x02h2";
+#define PROTOCOL_LIST_SIZE (sizeof(g_protocol_list) - 1)
+
+/* --- Server credentials. ---
+
+   A P-256 key and a self-signed certificate for it, which is also the root
+   the clients trust. They are generated by the test: current OpenSSL
+   configurations reject the 1024 bit RSA keys of the test credentials. */
+
+static EVP_PKEY *g_server_key;
+static X509 *g_server_cert;
+static char *g_server_key_pem;
+static char *g_server_cert_pem;
+
+static char *bio_to_string(BIO *bio) {
+  char *data;
+  const long size = BIO_get_mem_data(bio, &data);
+  GPR_ASSERT(size > 0);
+  char *string = gpr_malloc((size_t)size + 1);
+  memcpy(string, data, (size_t)size);
+  string[size] = '\0';
+  BIO_free(bio);
+  return string;
+}
+
+static void server_credentials_init(void) {
+  EVP_PKEY_CTX *ctx = EVP_PKEY_CTX_new_id(EVP_PKEY_EC, NULL);
+  GPR_ASSERT(ctx != NULL && EVP_PKEY_keygen_init(ctx) == 1);
+  GPR_ASSERT(EVP_PKEY_CTX_set_ec_paramgen_curve_nid(
+                 ctx, NID_X9_62_prime256v1) == 1);
+  g_server_key = NULL;
+  GPR_ASSERT(EVP_PKEY_keygen(ctx, &g_server_key) == 1);
+  EVP_PKEY_CTX_free(ctx);
+
+  g_server_cert = X509_new();
+  GPR_ASSERT(X509_set_version(g_server_cert, 2));
+  GPR_ASSERT(ASN1_INTEGER_set(X509_get_serialNumber(g_server_cert), 1));
+  GPR_ASSERT(X509_gmtime_adj(X509_get_notBefore(g_server_cert), -3600));
+  GPR_ASSERT(X509_gmtime_adj(X509_get_notAfter(g_server_cert), 24 * 3600));
+  X509_NAME *name = X509_get_subject_name(g_server_cert);
+  GPR_ASSERT(X509_NAME_add_entry_by_txt(name, "CN", MBSTRING_ASC,
+                                        (const unsigned char *)SERVER_NAME,
+                                        -1, -1, 0));
+  GPR_ASSERT(X509_set_issuer_name(g_server_cert, name));
+  static char subject_alt_name[] = "DNS:*." SERVER_DOMAIN;
+  X509_EXTENSION *extension = X509V3_EXT_conf_nid(
+      NULL, NULL, NID_subject_alt_name, subject_alt_name);
+  GPR_ASSERT(extension != NULL);
+  GPR_ASSERT(X509_add_ext(g_server_cert, extension, -1));
+  X509_EXTENSION_free(extension);
+  GPR_ASSERT(X509_set_pubkey(g_server_cert, g_server_key));
+  GPR_ASSERT(X509_sign(g_server_cert, g_server_key, EVP_sha256()) > 0);
+
+  BIO *bio = BIO_new(BIO_s_mem());
+  GPR_ASSERT(PEM_write_bio_PrivateKey(bio, g_server_key, NULL, NULL, 0, NULL,
+                                      NULL));
+  g_server_key_pem = bio_to_string(bio);
+  bio = BIO_new(BIO_s_mem());
+  GPR_ASSERT(PEM_write_bio_X509(bio, g_server_cert));
+  g_server_cert_pem = bio_to_string(bio);
+}
+
+static void server_credentials_destroy(void) {
+  EVP_PKEY_free(g_server_key);
+  X509_free(g_server_cert);
+  gpr_free(g_server_key_pem);
+  gpr_free(g_server_cert_pem);
+}
+
+/* --- Byte buffers. --- */
+
+typedef struct {
+  unsigned char *data;
+  size_t size;
+} buffer;
+
+static void buffer_append(buffer *b, const unsigned char *data, size_t size) {
+  if (size == 0) return;
+  b->data = gpr_realloc(b->data, b->size + size);
+  memcpy(b->data + b->size, data, size);
+  b->size += size;
+}
+
+static void buffer_consume(buffer *b, size_t size) {
+  GPR_ASSERT(size <= b->size);
+  memmove(b->data, b->data + size, b->size - size);
+  b->size -= size;
+}
+
+static void buffer_destroy(buffer *b) {
+  gpr_free(b->data);
+  b->data = NULL;
+  b->size = 0;
+}
+
+/* --- TSI handshakes. --- */
+
+static tsi_ssl_client_handshaker_factory *client_factory_create(
+    const char *cipher_suites, tsi_ssl_session_cache *session_cache) {
+  tsi_ssl_client_handshaker_factory *factory = NULL;
+  GPR_ASSERT(tsi_create_ssl_client_handshaker_factory(
+                 NULL, g_server_cert_pem, cipher_suites, g_alpn_protocols,
+                 (uint16_t)GPR_ARRAY_SIZE(g_alpn_protocols), session_cache,
+                 &factory) == TSI_OK);
+  return factory;
+}
+
+static tsi_ssl_server_handshaker_factory *server_factory_create(
+    const char *cipher_suites) {
+  tsi_ssl_pem_key_cert_pair key_cert_pair = {g_server_key_pem,
+                                             g_server_cert_pem};
+  tsi_ssl_server_handshaker_factory *factory = NULL;
+  GPR_ASSERT(tsi_create_ssl_server_handshaker_factory(
+                 &key_cert_pair, 1, NULL, 0, cipher_suites, g_alpn_protocols,
+                 (uint16_t)GPR_ARRAY_SIZE(g_alpn_protocols),
+                 &factory) == TSI_OK);
+  return factory;
+}
+
+static tsi_handshaker *client_handshaker_create(
+    tsi_ssl_client_handshaker_factory *factory, const char *server_name) {
+  tsi_handshaker *handshaker = NULL;
+  GPR_ASSERT(tsi_ssl_client_handshaker_factory_create_handshaker(
+                 factory, server_name, &handshaker) == TSI_OK);
+  return tsi_create_adapter_handshaker(handshaker);
+}
+
+static tsi_handshaker *server_handshaker_create(
+    tsi_ssl_server_handshaker_factory *factory) {
+  tsi_handshaker *handshaker = NULL;
+  GPR_ASSERT(tsi_ssl_server_handshaker_factory_create_handshaker(
+                 factory, &handshaker) == TSI_OK);
+  return tsi_create_adapter_handshaker(handshaker);
+}
+
+/* Feeds all of *in to handshaker, appending what it sends back to *out.
+   Returns the result of the handshake once it is done, NULL before. */
+static tsi_handshaker_result *handshaker_step(tsi_handshaker *handshaker,
+                                              buffer *in, buffer *out) {
+  unsigned char *bytes_to_send = NULL;
+  size_t bytes_to_send_size = 0;
+  tsi_handshaker_result *result = NULL;
+  GPR_ASSERT(tsi_handshaker_next(handshaker, in->data, in->size,
+                                 &bytes_to_send, &bytes_to_send_size, &result,
+                                 NULL, NULL) == TSI_OK);
+  buffer_consume(in, in->size);
+  buffer_append(out, bytes_to_send, bytes_to_send_size);
+  return result;
+}
+
+/* Runs a handshake between two TSI handshakers. */
+static void do_tsi_handshake(tsi_handshaker *client, tsi_handshaker *server,
+                             tsi_handshaker_result **client_result,
+                             tsi_handshaker_result **server_result) {
+  buffer to_client = {NULL, 0};
+  buffer to_server = {NULL, 0};
+  *client_result = *server_result = NULL;
+  for (int i = 0; i < 10 && (*client_result == NULL || *server_result == NULL);
+       i++) {
+    if (*client_result == NULL) {
+      *client_result = handshaker_step(client, &to_client, &to_server);
+    }
+    if (*server_result == NULL && to_server.size > 0) {
+      *server_result = handshaker_step(server, &to_server, &to_client);
+    }
+  }
+  GPR_ASSERT(*client_result != NULL && *server_result != NULL);
+  GPR_ASSERT(to_client.size == 0 && to_server.size == 0);
+  buffer_destroy(&to_client);
+  buffer_destroy(&to_server);
+}
+
+/* Returns whether the handshake of result resumed a session. */
+static int session_reused(const tsi_handshaker_result *result) {
+  tsi_peer peer;
+  GPR_ASSERT(tsi_handshaker_result_extract_peer(result, &peer) == TSI_OK);
+  const tsi_peer_property *property = NULL;
+  for (size_t i = 0; i < peer.property_count; i++) {
+    if (strcmp(peer.properties[i].name,
+               TSI_SSL_SESSION_REUSED_PEER_PROPERTY) == 0) {
+      property = &peer.properties[i];
+    }
+  }
+  GPR_ASSERT(property != NULL);
+  const int reused = property->value.length == 4 &&
+                     memcmp(property->value.data, "true", 4) == 0;
+  tsi_peer_destruct(&peer);
+  return reused;
+}
+
+#ifdef TEST_KERNEL_TLS_KEYS
+
+/* --- A peer using OpenSSL directly, over memory BIOs. --- */
+
+typedef struct {
+  SSL *ssl;
+  BIO *in;  /* what the peer receives */
+  BIO *out; /* what the peer sends */
+} openssl_peer;
+
+static int openssl_alpn_select(SSL *ssl, const unsigned char **out,
+                               unsigned char *outlen, const unsigned char *in,
+                               unsigned int inlen, void *arg) {
+  return SSL_select_next_proto((unsigned char **)out, outlen, g_protocol_list,
+                               PROTOCOL_LIST_SIZE, in,
+                               inlen) == OPENSSL_NPN_NEGOTIATED
+             ? SSL_TLSEXT_ERR_OK
+             : SSL_TLSEXT_ERR_NOACK;
+}
+
+static int openssl_npn_advertise(SSL *ssl, const unsigned char **out,
+                                 unsigned int *outlen, void *arg) {
+  *out = g_protocol_list;
+  *outlen = PROTOCOL_LIST_SIZE;
+  return SSL_TLSEXT_ERR_OK;
+}
+
+static int openssl_npn_select(SSL *ssl, unsigned char **out,
+                              unsigned char *outlen, const unsigned char *in,
+                              unsigned int inlen, void *arg) {
+  return SSL_select_next_proto(out, outlen, in, inlen, g_protocol_list,
+                               PROTOCOL_LIST_SIZE) == OPENSSL_NPN_NEGOTIATED
+             ? SSL_TLSEXT_ERR_OK
+             : SSL_TLSEXT_ERR_NOACK;
+}
+
+/* Creates the context of an OpenSSL peer negotiating the application protocol
+   with NPN if npn is set, with ALPN otherwise. */
+static SSL_CTX *openssl_context_create(int is_server, int npn) {
+  SSL_CTX *ctx = SSL_CTX_new(TLS_method());
+  GPR_ASSERT(ctx != NULL);
+  GPR_ASSERT(SSL_CTX_set_max_proto_version(ctx, TLS1_2_VERSION));
+  GPR_ASSERT(SSL_CTX_set_cipher_list(ctx, AES_128_GCM_SUITE));
+  if (is_server) {
+    GPR_ASSERT(SSL_CTX_use_certificate(ctx, g_server_cert));
+    GPR_ASSERT(SSL_CTX_use_PrivateKey(ctx, g_server_key));
+    if (npn) {
+      SSL_CTX_set_next_protos_advertised_cb(ctx, openssl_npn_advertise, NULL);
+    } else {
+      SSL_CTX_set_alpn_select_cb(ctx, openssl_alpn_select, NULL);
+    }
+  } else {
+    if (npn) {
+      SSL_CTX_set_next_proto_select_cb(ctx, openssl_npn_select, NULL);
+    } else {
+      GPR_ASSERT(SSL_CTX_set_alpn_protos(ctx, g_protocol_list,
+                                         PROTOCOL_LIST_SIZE) == 0);
+    }
+  }
+  return ctx;
+}
+
+static void openssl_peer_init(openssl_peer *peer, SSL_CTX *ctx, int is_server,
+                              SSL_SESSION *session) {
+  peer->ssl = SSL_new(ctx);
+  GPR_ASSERT(peer->ssl != NULL);
+  peer->in = BIO_new(BIO_s_mem());
+  peer->out = BIO_new(BIO_s_mem());
+  SSL_set_bio(peer->ssl, peer->in, peer->out);
+  if (is_server) {
+    SSL_set_accept_state(peer->ssl);
+  } else {
+    SSL_set_connect_state(peer->ssl);
+    GPR_ASSERT(SSL_set_tlsext_host_name(peer->ssl, SERVER_NAME));
+    if (session != NULL) GPR_ASSERT(SSL_set_session(peer->ssl, session));
+  }
+}
+
+/* Shuts the connection down cleanly: OpenSSL does not resume the session of a
+   connection freed in the middle of it. */
+static void openssl_peer_destroy(openssl_peer *peer) {
+  SSL_shutdown(peer->ssl);
+  SSL_free(peer->ssl);
+}
+
+static void openssl_peer_receive(openssl_peer *peer, buffer *in) {
+  if (in->size == 0) return;
+  GPR_ASSERT(BIO_write(peer->in, in->data, (int)in->size) == (int)in->size);
+  buffer_consume(in, in->size);
+}
+
+static void openssl_peer_send(openssl_peer *peer, buffer *out) {
+  unsigned char bytes[4096];
+  int size;
+  while ((size = BIO_read(peer->out, bytes, sizeof(bytes))) > 0) {
+    buffer_append(out, bytes, (size_t)size);
+  }
+}
+
+static void openssl_peer_write(openssl_peer *peer, const char *data) {
+  GPR_ASSERT(SSL_write(peer->ssl, data, (int)strlen(data)) ==
+             (int)strlen(data));
+}
+
+static void openssl_peer_check_read(openssl_peer *peer, const char *data) {
+  char bytes[64];
+  GPR_ASSERT(SSL_read(peer->ssl, bytes, sizeof(bytes)) == (int)strlen(data));
+  GPR_ASSERT(memcmp(bytes, data, strlen(data)) == 0);
+}
+
+/* Runs a handshake between a TSI handshaker and an OpenSSL peer. The peer
+   writes "early" as soon as its side of the handshake is done: this record
+   either reaches the handshaker with the end of the handshake, or is left in
+   *from_peer. */
+static tsi_handshaker_result *do_handshake_with_openssl_peer(
+    tsi_handshaker *handshaker, int tsi_is_client, openssl_peer *peer,
+    buffer *from_peer) {
+  buffer to_peer = {NULL, 0};
+  tsi_handshaker_result *result = NULL;
+  int peer_done = 0;
+  for (int i = 0; i < 10 && (result == NULL || !peer_done); i++) {
+    if (result == NULL && (from_peer->size > 0 || (tsi_is_client && i == 0))) {
+      result = handshaker_step(handshaker, from_peer, &to_peer);
+      openssl_peer_receive(peer, &to_peer);
+    }
+    if (!peer_done) {
+      int ret = SSL_do_handshake(peer->ssl);
+      if (ret == 1) {
+        peer_done = 1;
+        openssl_peer_write(peer, "early");
+      } else {
+        GPR_ASSERT(SSL_get_error(peer->ssl, ret) == SSL_ERROR_WANT_READ);
+      }
+    }
+    openssl_peer_send(peer, from_peer);
+  }
+  GPR_ASSERT(result != NULL && peer_done);
+  GPR_ASSERT(to_peer.size == 0);
+  buffer_destroy(&to_peer);
+  return result;
+}
+
+/* --- The TLS 1.2 AES-GCM record layer, as the kernel runs it. --- */
+
+#define RECORD_HEADER_SIZE 5
+#define RECORD_EXPLICIT_NONCE_SIZE 8
+#define RECORD_TAG_SIZE 16
+#define RECORD_MAX_DATA_SIZE 64
+#define RECORD_AAD_SIZE 13
+
+static const EVP_CIPHER *keys_cipher(const tsi_ssl_kernel_tls_keys *keys) {
+  GPR_ASSERT(keys->key_size == 16 || keys->key_size == 32);
+  return keys->key_size == 16 ? EVP_aes_128_gcm() : EVP_aes_256_gcm();
+}
+
+static void keys_next_record(tsi_ssl_kernel_tls_keys *keys) {
+  for (size_t i = sizeof(keys->rec_seq); i > 0 && ++keys->rec_seq[i - 1] == 0;
+       i--) {
+  }
+  memcpy(keys->iv, keys->rec_seq, sizeof(keys->iv));
+}
+
+static void record_aad(const tsi_ssl_kernel_tls_keys *keys, size_t data_size,
+                       unsigned char *aad) {
+  memcpy(aad, keys->rec_seq, sizeof(keys->rec_seq));
+  aad[8] = 0x17; /* application data */
+  aad[9] = 3;    /* TLS 1.2 */
+  aad[10] = 3;
+  aad[11] = (unsigned char)(data_size >> 8);
+  aad[12] = (unsigned char)data_size;
+}
+
+/* Seals data into the next record protected by keys, appended to *out. */
+static void seal_record(tsi_ssl_kernel_tls_keys *keys, const char *data,
+                        buffer *out) {
+  const size_t data_size = strlen(data);
+  GPR_ASSERT(data_size <= RECORD_MAX_DATA_SIZE);
+  unsigned char record[RECORD_HEADER_SIZE + RECORD_EXPLICIT_NONCE_SIZE +
+                       RECORD_MAX_DATA_SIZE + RECORD_TAG_SIZE];
+  const size_t length =
+      RECORD_EXPLICIT_NONCE_SIZE + data_size + RECORD_TAG_SIZE;
+  record[0] = 0x17;
+  record[1] = 3;
+  record[2] = 3;
+  record[3] = (unsigned char)(length >> 8);
+  record[4] = (unsigned char)length;
+  memcpy(record + RECORD_HEADER_SIZE, keys->iv, RECORD_EXPLICIT_NONCE_SIZE);
+  unsigned char nonce[sizeof(keys->salt) + RECORD_EXPLICIT_NONCE_SIZE];
+  memcpy(nonce, keys->salt, sizeof(keys->salt));
+  memcpy(nonce + sizeof(keys->salt), keys->iv, RECORD_EXPLICIT_NONCE_SIZE);
+  unsigned char aad[RECORD_AAD_SIZE];
+  record_aad(keys, data_size, aad);
+  unsigned char *ciphertext =
+      record + RECORD_HEADER_SIZE + RECORD_EXPLICIT_NONCE_SIZE;
+  EVP_CIPHER_CTX *ctx = EVP_CIPHER_CTX_new();
+  int size;
+  GPR_ASSERT(EVP_EncryptInit_ex(ctx, keys_cipher(keys), NULL, keys->key,
+                                nonce) == 1);
+  GPR_ASSERT(EVP_EncryptUpdate(ctx, NULL, &size, aad, sizeof(aad)) == 1);
+  GPR_ASSERT(EVP_EncryptUpdate(ctx, ciphertext, &size,
+                               (const unsigned char *)data,
+                               (int)data_size) == 1);
+  GPR_ASSERT(EVP_EncryptFinal_ex(ctx, ciphertext + size, &size) == 1);
+  GPR_ASSERT(EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_GCM_GET_TAG, RECORD_TAG_SIZE,
+                                 ciphertext + data_size) == 1);
+  EVP_CIPHER_CTX_free(ctx);
+  buffer_append(out, record, RECORD_HEADER_SIZE + length);
+  keys_next_record(keys);
+}
+
+/* Opens the first record of *in, which must hold data, with keys. */
+static void check_open_record(tsi_ssl_kernel_tls_keys *keys, buffer *in,
+                              const char *data) {
+  GPR_ASSERT(in->size >= RECORD_HEADER_SIZE);
+  GPR_ASSERT(in->data[0] == 0x17 && in->data[1] == 3 && in->data[2] == 3);
+  const size_t length = ((size_t)in->data[3] << 8) | in->data[4];
+  GPR_ASSERT(in->size >= RECORD_HEADER_SIZE + length);
+  GPR_ASSERT(length == RECORD_EXPLICIT_NONCE_SIZE + strlen(data) +
+                           RECORD_TAG_SIZE);
+  const size_t data_size = strlen(data);
+  const unsigned char *explicit_nonce = in->data + RECORD_HEADER_SIZE;
+  const unsigned char *ciphertext = explicit_nonce + RECORD_EXPLICIT_NONCE_SIZE;
+  unsigned char nonce[sizeof(keys->salt) + RECORD_EXPLICIT_NONCE_SIZE];
+  memcpy(nonce, keys->salt, sizeof(keys->salt));
+  memcpy(nonce + sizeof(keys->salt), explicit_nonce,
+         RECORD_EXPLICIT_NONCE_SIZE);
+  unsigned char aad[RECORD_AAD_SIZE];
+  record_aad(keys, data_size, aad);
+  unsigned char plaintext[RECORD_MAX_DATA_SIZE];
+  unsigned char tag[RECORD_TAG_SIZE];
+  memcpy(tag, ciphertext + data_size, sizeof(tag));
+  EVP_CIPHER_CTX *ctx = EVP_CIPHER_CTX_new();
+  int size;
+  GPR_ASSERT(EVP_DecryptInit_ex(ctx, keys_cipher(keys), NULL, keys->key,
+                                nonce) == 1);
+  GPR_ASSERT(EVP_DecryptUpdate(ctx, NULL, &size, aad, sizeof(aad)) == 1);
+  GPR_ASSERT(EVP_DecryptUpdate(ctx, plaintext, &size, ciphertext,
+                               (int)data_size) == 1);
+  GPR_ASSERT(EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_GCM_SET_TAG, sizeof(tag),
+                                 tag) == 1);
+  /* fails if the key, the salt or the sequence number are wrong */
+  GPR_ASSERT(EVP_DecryptFinal_ex(ctx, plaintext + size, &size) == 1);
+  EVP_CIPHER_CTX_free(ctx);
+  GPR_ASSERT(memcmp(plaintext, data, data_size) == 0);
+  buffer_consume(in, RECORD_HEADER_SIZE + length);
+  keys_next_record(keys);
+}
+
+/* --- Kernel TLS key export tests. --- */
+
+static void export_keys(const tsi_handshaker_result *result,
+                        tsi_ssl_kernel_tls_keys *tx_keys,
+                        tsi_ssl_kernel_tls_keys *rx_keys,
+                        buffer *unprotected) {
+  tsi_frame_protector *protector = NULL;
+  unsigned char *unused_bytes = NULL;
+  size_t unused_bytes_size = 0;
+  unsigned char *unprotected_bytes = NULL;
+  size_t unprotected_bytes_size = 0;
+  GPR_ASSERT(tsi_handshaker_result_create_frame_protector(result, NULL,
+                                                         &protector) == TSI_OK);
+  GPR_ASSERT(tsi_handshaker_result_get_unused_bytes(
+                 result, &unused_bytes, &unused_bytes_size) == TSI_OK);
+  GPR_ASSERT(tsi_ssl_frame_protector_export_kernel_tls_keys(
+                 protector, unused_bytes, unused_bytes_size, tx_keys, rx_keys,
+                 &unprotected_bytes, &unprotected_bytes_size) == TSI_OK);
+  buffer_append(unprotected, unprotected_bytes, unprotected_bytes_size);
+  gpr_free(unprotected_bytes);
+  tsi_frame_protector_destroy(protector);
+}
+
+/* Exports the keys of both protectors of a TSI handshake, and checks that
+   each side receives with the keys the other side sends with. */
+static void test_kernel_tls_keys_between_tsi_peers(const char *cipher_suites,
+                                                   size_t key_size) {
+  tsi_ssl_session_cache *session_cache = tsi_ssl_session_cache_create_lru(1);
+  tsi_ssl_client_handshaker_factory *client_factory =
+      client_factory_create(cipher_suites, session_cache);
+  tsi_ssl_server_handshaker_factory *server_factory =
+      server_factory_create(cipher_suites);
+  for (int resumed = 0; resumed <= 1; resumed++) {
+    tsi_handshaker *client =
+        client_handshaker_create(client_factory, SERVER_NAME);
+    tsi_handshaker *server = server_handshaker_create(server_factory);
+    tsi_handshaker_result *client_result;
+    tsi_handshaker_result *server_result;
+    do_tsi_handshake(client, server, &client_result, &server_result);
+    GPR_ASSERT(session_reused(client_result) == resumed);
+
+    tsi_ssl_kernel_tls_keys client_tx, client_rx, server_tx, server_rx;
+    buffer unprotected = {NULL, 0};
+    export_keys(client_result, &client_tx, &client_rx, &unprotected);
+    export_keys(server_result, &server_tx, &server_rx, &unprotected);
+    GPR_ASSERT(unprotected.size == 0);
+    GPR_ASSERT(client_tx.key_size == key_size);
+    GPR_ASSERT(memcmp(&client_tx, &server_rx, sizeof(client_tx)) == 0);
+    GPR_ASSERT(memcmp(&server_tx, &client_rx, sizeof(server_tx)) == 0);
+    GPR_ASSERT(memcmp(client_tx.key, server_tx.key, key_size) != 0);
+
+    buffer records = {NULL, 0};
+    seal_record(&client_tx, "ping", &records);
+    check_open_record(&server_rx, &records, "ping");
+    seal_record(&server_tx, "pong", &records);
+    check_open_record(&client_rx, &records, "pong");
+
+    tsi_handshaker_result_destroy(client_result);
+    tsi_handshaker_result_destroy(server_result);
+    tsi_handshaker_destroy(client);
+    tsi_handshaker_destroy(server);
+  }
+  tsi_ssl_client_handshaker_factory_destroy(client_factory);
+  tsi_ssl_server_handshaker_factory_destroy(server_factory);
+  tsi_ssl_session_cache_unref(session_cache);
+}
+
+/* Exports the keys of a TSI handshake with an OpenSSL peer, and checks that
+   records sealed with them open in the peer's record layer, and the other way
+   around. The sequence numbers depend on the records of the handshake, which
+   differ with NPN and when a session is resumed. */
+static void test_kernel_tls_keys_with_openssl_peer(int tsi_is_client,
+                                                   int npn) {
+  gpr_log(GPR_INFO, "test_kernel_tls_keys_with_openssl_peer(%s, npn=%d)",
+          tsi_is_client ? "client" : "server", npn);
+  SSL_CTX *ctx = openssl_context_create(tsi_is_client, npn);
+  tsi_ssl_session_cache *session_cache = tsi_ssl_session_cache_create_lru(1);
+  tsi_ssl_client_handshaker_factory *client_factory =
+      client_factory_create(AES_128_GCM_SUITE, session_cache);
+  tsi_ssl_server_handshaker_factory *server_factory =
+      server_factory_create(AES_128_GCM_SUITE);
+  SSL_SESSION *session = NULL;
+  for (int resumed = 0; resumed <= 1; resumed++) {
+    tsi_handshaker *handshaker =
+        tsi_is_client ? client_handshaker_create(client_factory, SERVER_NAME)
+                      : server_handshaker_create(server_factory);
+    openssl_peer peer;
+    openssl_peer_init(&peer, ctx, tsi_is_client, session);
+    buffer from_peer = {NULL, 0};
+    tsi_handshaker_result *result = do_handshake_with_openssl_peer(
+        handshaker, tsi_is_client, &peer, &from_peer);
+    GPR_ASSERT(SSL_session_reused(peer.ssl) == resumed);
+    const unsigned char *protocol = NULL;
+    unsigned int protocol_size = 0;
+    SSL_get0_next_proto_negotiated(peer.ssl, &protocol, &protocol_size);
+    GPR_ASSERT((protocol != NULL) == npn);
+#if TSI_OPENSSL_ALPN_SUPPORT
+    if (!npn) {
+      SSL_get0_alpn_selected(peer.ssl, &protocol, &protocol_size);
+      GPR_ASSERT(protocol != NULL);
+    }
+#endif
+
+    tsi_ssl_kernel_tls_keys tx_keys, rx_keys;
+    buffer unprotected = {NULL, 0};
+    export_keys(result, &tx_keys, &rx_keys, &unprotected);
+    if (from_peer.size > 0) {
+      GPR_ASSERT(unprotected.size == 0);
+      check_open_record(&rx_keys, &from_peer, "early");
+    } else {
+      GPR_ASSERT(unprotected.size == 5 &&
+                 memcmp(unprotected.data, "early", 5) == 0);
+    }
+    buffer records = {NULL, 0};
+    for (int i = 0; i < 2; i++) {
+      seal_record(&tx_keys, "ping", &records);
+      openssl_peer_receive(&peer, &records);
+      openssl_peer_check_read(&peer, "ping");
+      openssl_peer_write(&peer, "pong");
+      openssl_peer_send(&peer, &records);
+      check_open_record(&rx_keys, &records, "pong");
+    }
+    GPR_ASSERT(records.size == 0);
+
+    if (session == NULL && !tsi_is_client) {
+      session = SSL_get1_session(peer.ssl);
+    }
+    buffer_destroy(&unprotected);
+    buffer_destroy(&from_peer);
+    tsi_handshaker_result_destroy(result);
+    tsi_handshaker_destroy(handshaker);
+    openssl_peer_destroy(&peer);
+  }
+  SSL_SESSION_free(session);
+  tsi_ssl_client_handshaker_factory_destroy(client_factory);
+  tsi_ssl_server_handshaker_factory_destroy(server_factory);
+  tsi_ssl_session_cache_unref(session_cache);
+  SSL_CTX_free(ctx);
+}
+
+#endif /* TEST_KERNEL_TLS_KEYS */
+
+/* Runs a handshake for server_name with a client of client_factory, and
+   returns whether it resumed a session. */
+static int handshake_reuses_session(
+    tsi_ssl_client_handshaker_factory *client_factory,
+    tsi_ssl_server_handshaker_factory *server_factory,
+    const char *server_name) {
+  tsi_handshaker *client =
+      client_handshaker_create(client_factory, server_name);
+  tsi_handshaker *server = server_handshaker_create(server_factory);
+  tsi_handshaker_result *client_result;
+  tsi_handshaker_result *server_result;
+  do_tsi_handshake(client, server, &client_result, &server_result);
+  const int reused = session_reused(client_result);
+  GPR_ASSERT(session_reused(server_result) == reused);
+  tsi_handshaker_result_destroy(client_result);
+  tsi_handshaker_result_destroy(server_result);
+  tsi_handshaker_destroy(client);
+  tsi_handshaker_destroy(server);
+  return reused;
+}
+
+/* Client factories sharing a session cache resume each other's sessions, by
+   server name, and the cache evicts the least recently used one. */
+static void test_shared_session_cache(void) {
+  tsi_ssl_session_cache *session_cache = tsi_ssl_session_cache_create_lru(1);
+  tsi_ssl_client_handshaker_factory *first_factory =
+      client_factory_create(AES_128_GCM_SUITE, session_cache);
+  tsi_ssl_client_handshaker_factory *second_factory =
+      client_factory_create(AES_128_GCM_SUITE, session_cache);
+  tsi_ssl_server_handshaker_factory *server_factory =
+      server_factory_create(AES_128_GCM_SUITE);
+  const char *first_name = "first." SERVER_DOMAIN;
+  const char *second_name = "second." SERVER_DOMAIN;
+
+  GPR_ASSERT(
+      !handshake_reuses_session(first_factory, server_factory, first_name));
+  GPR_ASSERT(
+      handshake_reuses_session(second_factory, server_factory, first_name));
+  GPR_ASSERT(
+      handshake_reuses_session(first_factory, server_factory, first_name));
+  /* With a capacity of 1, the session of second_name evicts the one of
+     first_name. */
+  GPR_ASSERT(
+      !handshake_reuses_session(first_factory, server_factory, second_name));
+  GPR_ASSERT(
+      handshake_reuses_session(second_factory, server_factory, second_name));
+  GPR_ASSERT(
+      !handshake_reuses_session(second_factory, server_factory, first_name));
+
+  tsi_ssl_client_handshaker_factory_destroy(first_factory);
+  tsi_ssl_client_handshaker_factory_destroy(second_factory);
+  tsi_ssl_server_handshaker_factory_destroy(server_factory);
+  tsi_ssl_session_cache_unref(session_cache);
+}
+
+int main(int argc, char **argv) {
+  grpc_test_init(argc, argv);
+  server_credentials_init();
+  test_shared_session_cache();
+#ifdef TEST_KERNEL_TLS_KEYS
+  test_kernel_tls_keys_between_tsi_peers(AES_128_GCM_SUITE, 16);
+  test_kernel_tls_keys_between_tsi_peers(AES_256_GCM_SUITE, 32);
+  for (int tsi_is_client = 0; tsi_is_client <= 1; tsi_is_client++) {
+    for (int npn = 0; npn <= 1; npn++) {
+      test_kernel_tls_keys_with_openssl_peer(tsi_is_client, npn);
+    }
+  }
+#endif
+  server_credentials_destroy();
+  return 0;
+}
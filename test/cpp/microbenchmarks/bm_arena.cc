@@ -24,13 +24,28 @@ extern "C" {
 #include "test/cpp/microbenchmarks/helpers.h"
 #include "third_party/benchmark/include/benchmark/benchmark.h"
 
+auto& force_library_initialization = Library::get();
+
 static void BM_Arena_NoOp(benchmark::State& state) {
+  TrackCounters track_counters;
   while (state.KeepRunning()) {
     gpr_arena_destroy(gpr_arena_create(state.range(0)));
   }
+  track_counters.Finish(state);
 }
 BENCHMARK(BM_Arena_NoOp)->Range(1, 1024 * 1024);
 
+static void BM_Arena_NoOp_Pooled(benchmark::State& state) {
+  TrackCounters track_counters;
+  gpr_arena_pool* pool = gpr_arena_pool_create(1);
+  while (state.KeepRunning()) {
+    gpr_arena_destroy(gpr_arena_create_from_pool(pool, state.range(0)));
+  }
+  gpr_arena_pool_destroy(pool);
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_Arena_NoOp_Pooled)->Range(1, 1024 * 1024);
+
 static void BM_Arena_ManyAlloc(benchmark::State& state) {
   gpr_arena* a = gpr_arena_create(state.range(0));
   const size_t realloc_after =
@@ -48,6 +63,7 @@ static void BM_Arena_ManyAlloc(benchmark::State& state) {
 BENCHMARK(BM_Arena_ManyAlloc)->Ranges({{1, 1024 * 1024}, {1, 32 * 1024}});
 
 static void BM_Arena_Batch(benchmark::State& state) {
+  TrackCounters track_counters;
   while (state.KeepRunning()) {
     gpr_arena* a = gpr_arena_create(state.range(0));
     for (int i = 0; i < state.range(1); i++) {
@@ -55,7 +71,24 @@ static void BM_Arena_Batch(benchmark::State& state) {
     }
     gpr_arena_destroy(a);
   }
+  track_counters.Finish(state);
 }
 BENCHMARK(BM_Arena_Batch)->Ranges({{1, 64 * 1024}, {1, 64}, {1, 1024}});
 
+static void BM_Arena_Batch_Pooled(benchmark::State& state) {
+  TrackCounters track_counters;
+  gpr_arena_pool* pool = gpr_arena_pool_create(1);
+  while (state.KeepRunning()) {
+    gpr_arena* a = gpr_arena_create_from_pool(pool, state.range(0));
+    for (int i = 0; i < state.range(1); i++) {
+      gpr_arena_alloc(a, state.range(2));
+    }
+    gpr_arena_destroy(a);
+  }
+  gpr_arena_pool_destroy(pool);
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_Arena_Batch_Pooled)
+    ->Ranges({{1, 64 * 1024}, {1, 64}, {1, 1024}});
+
 BENCHMARK_MAIN();
@@ -22,21 +22,28 @@
 #include <benchmark/benchmark.h>
 #include <string.h>
 #include <sstream>
+#include <thread>
+#include <vector>
 
 #include <grpc++/channel.h>
 #include <grpc++/support/channel_arguments.h>
 #include <grpc/grpc.h>
 #include <grpc/support/alloc.h>
+#include <grpc/support/host_port.h>
 #include <grpc/support/string_util.h>
 
 extern "C" {
 #include "src/core/ext/filters/client_channel/client_channel.h"
+#include "src/core/ext/filters/client_channel/lb_policy/ring_hash/ring_hash.h"
+#include "src/core/ext/filters/client_channel/parse_address.h"
+#include "src/core/ext/filters/client_channel/subchannel.h"
 #include "src/core/ext/filters/deadline/deadline_filter.h"
 #include "src/core/ext/filters/http/client/http_client_filter.h"
 #include "src/core/ext/filters/http/message_compress/message_compress_filter.h"
 #include "src/core/ext/filters/http/server/http_server_filter.h"
 #include "src/core/ext/filters/load_reporting/load_reporting_filter.h"
 #include "src/core/ext/filters/message_size/message_size_filter.h"
+#include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/channel/channel_stack.h"
 #include "src/core/lib/channel/connected_channel.h"
 #include "src/core/lib/profiling/timers.h"
@@ -46,6 +53,7 @@ extern "C" {
 
 #include "src/cpp/client/create_channel_internal.h"
 #include "src/proto/grpc/testing/echo.grpc.pb.h"
+#include "test/core/util/port.h"
 #include "test/cpp/microbenchmarks/helpers.h"
 
 auto &force_library_initialization = Library::get();
@@ -122,6 +130,40 @@ static void BM_CallCreateDestroy(benchmark::State &state) {
 BENCHMARK_TEMPLATE(BM_CallCreateDestroy, InsecureChannel);
 BENCHMARK_TEMPLATE(BM_CallCreateDestroy, LameChannel);
 
+// Like BM_CallCreateDestroy, but with state.range(0) calls alive at once: each
+// iteration creates one call and releases the oldest, so allocs/iter is the
+// allocation count per call once more calls overlap than the channel caches
+// arenas for
+template <class Fixture>
+static void BM_CallCreateDestroyOverlapped(benchmark::State &state) {
+  TrackCounters track_counters;
+  Fixture fixture;
+  grpc_completion_queue *cq = grpc_completion_queue_create_for_next(NULL);
+  gpr_timespec deadline = gpr_inf_future(GPR_CLOCK_MONOTONIC);
+  void *method_hdl =
+      grpc_channel_register_call(fixture.channel(), "/foo/bar", NULL, NULL);
+  std::vector<grpc_call *> calls(state.range(0), nullptr);
+  size_t next = 0;
+  while (state.KeepRunning()) {
+    if (calls[next] != nullptr) grpc_call_unref(calls[next]);
+    calls[next] = grpc_channel_create_registered_call(
+        fixture.channel(), NULL, GRPC_PROPAGATE_DEFAULTS, cq, method_hdl,
+        deadline, NULL);
+    next = (next + 1) % calls.size();
+  }
+  for (grpc_call *call : calls) {
+    if (call != nullptr) grpc_call_unref(call);
+  }
+  grpc_completion_queue_destroy(cq);
+  track_counters.Finish(state);
+}
+
+BENCHMARK_TEMPLATE(BM_CallCreateDestroyOverlapped, InsecureChannel)
+    ->Arg(1)
+    ->Arg(4)
+    ->Arg(16)
+    ->Arg(64);
+
 ////////////////////////////////////////////////////////////////////////////////
 // Benchmarks isolating individual filters
 
@@ -841,4 +883,344 @@ static void BM_IsolatedCall_StreamingSend(benchmark::State &state) {
 }
 BENCHMARK(BM_IsolatedCall_StreamingSend);
 
+////////////////////////////////////////////////////////////////////////////////
+// Benchmarks picking subchannels from many threads sharing one channel
+
+namespace contended_pick {
+
+class PickFirst {
+ public:
+  static const char *Name() { return "pick_first"; }
+};
+
+class RoundRobin {
+ public:
+  static const char *Name() { return "round_robin"; }
+};
+
+static grpc_server *g_server;
+static grpc_completion_queue *g_server_cq;
+static std::thread *g_server_thread;
+static grpc_channel *g_channel;
+static void *g_method;
+
+// Accepts calls and cancels them right away, so that they don't pile up on
+// the server
+static void ServeCalls() {
+  for (;;) {
+    grpc_call *call;
+    grpc_call_details details;
+    grpc_metadata_array request_metadata;
+    grpc_call_details_init(&details);
+    grpc_metadata_array_init(&request_metadata);
+    GPR_ASSERT(GRPC_CALL_OK ==
+               grpc_server_request_call(g_server, &call, &details,
+                                        &request_metadata, g_server_cq,
+                                        g_server_cq, tag(1)));
+    grpc_event ev = grpc_completion_queue_next(
+        g_server_cq, gpr_inf_future(GPR_CLOCK_MONOTONIC), NULL);
+    grpc_call_details_destroy(&details);
+    grpc_metadata_array_destroy(&request_metadata);
+    if (ev.type != GRPC_OP_COMPLETE || ev.tag != tag(1) || !ev.success) break;
+    grpc_call_unref(call);
+  }
+}
+
+static void WaitForReady(grpc_channel *channel) {
+  grpc_completion_queue *cq = grpc_completion_queue_create_for_next(NULL);
+  grpc_connectivity_state state;
+  while ((state = grpc_channel_check_connectivity_state(channel, 1)) !=
+         GRPC_CHANNEL_READY) {
+    grpc_channel_watch_connectivity_state(
+        channel, state, gpr_inf_future(GPR_CLOCK_MONOTONIC), cq, tag(0));
+    GPR_ASSERT(grpc_completion_queue_next(
+                   cq, gpr_inf_future(GPR_CLOCK_MONOTONIC), NULL)
+                   .type == GRPC_OP_COMPLETE);
+  }
+  grpc_completion_queue_shutdown(cq);
+  while (grpc_completion_queue_next(cq, gpr_inf_future(GPR_CLOCK_MONOTONIC),
+                                    NULL)
+             .type != GRPC_QUEUE_SHUTDOWN)
+    ;
+  grpc_completion_queue_destroy(cq);
+}
+
+static void Setup(const char *lb_policy_name) {
+  char *addr = NULL;
+  gpr_join_host_port(&addr, "127.0.0.1", grpc_pick_unused_port_or_die());
+  g_server_cq = grpc_completion_queue_create_for_next(NULL);
+  g_server = grpc_server_create(NULL, NULL);
+  grpc_server_register_completion_queue(g_server, g_server_cq, NULL);
+  GPR_ASSERT(grpc_server_add_insecure_http2_port(g_server, addr));
+  grpc_server_start(g_server);
+  g_server_thread = new std::thread(ServeCalls);
+
+  grpc_arg arg = StringArg(GRPC_ARG_LB_POLICY_NAME, lb_policy_name);
+  grpc_channel_args args = {1, &arg};
+  g_channel = grpc_insecure_channel_create(addr, &args, NULL);
+  g_method = grpc_channel_register_call(g_channel, "/foo/bar", NULL, NULL);
+  WaitForReady(g_channel);
+  gpr_free(addr);
+}
+
+static void Teardown() {
+  grpc_channel_destroy(g_channel);
+  grpc_server_shutdown_and_notify(g_server, g_server_cq, tag(2));
+  grpc_server_cancel_all_calls(g_server);
+  g_server_thread->join();
+  delete g_server_thread;
+  grpc_server_destroy(g_server);
+  grpc_completion_queue_shutdown(g_server_cq);
+  while (grpc_completion_queue_next(
+             g_server_cq, gpr_inf_future(GPR_CLOCK_MONOTONIC), NULL)
+             .type != GRPC_QUEUE_SHUTDOWN)
+    ;
+  grpc_completion_queue_destroy(g_server_cq);
+}
+
+}  // namespace contended_pick
+
+// Each call picks a subchannel as its initial metadata goes out, and is
+// cancelled right after: most of the cost left is that of the pick, and of
+// whatever the threads contend on to make it
+template <class LbPolicy>
+static void BM_ContendedPick(benchmark::State &state) {
+  TrackCounters track_counters;
+  if (state.thread_index == 0) {
+    contended_pick::Setup(LbPolicy::Name());
+  }
+  grpc_completion_queue *cq = grpc_completion_queue_create_for_next(NULL);
+  gpr_timespec deadline = gpr_inf_future(GPR_CLOCK_MONOTONIC);
+  grpc_metadata_array recv_trailing_metadata;
+  grpc_metadata_array_init(&recv_trailing_metadata);
+  grpc_status_code status_code;
+  grpc_slice status_details = grpc_empty_slice();
+  grpc_op ops[2];
+  memset(ops, 0, sizeof(ops));
+  ops[0].op = GRPC_OP_SEND_INITIAL_METADATA;
+  ops[1].op = GRPC_OP_RECV_STATUS_ON_CLIENT;
+  ops[1].data.recv_status_on_client.status = &status_code;
+  ops[1].data.recv_status_on_client.status_details = &status_details;
+  ops[1].data.recv_status_on_client.trailing_metadata = &recv_trailing_metadata;
+  while (state.KeepRunning()) {
+    GPR_TIMER_SCOPE("BenchmarkCycle", 0);
+    grpc_call *call = grpc_channel_create_registered_call(
+        contended_pick::g_channel, nullptr, GRPC_PROPAGATE_DEFAULTS, cq,
+        contended_pick::g_method, deadline, NULL);
+    GPR_ASSERT(GRPC_CALL_OK == grpc_call_start_batch(call, ops, 2, tag(1),
+                                                     NULL));
+    grpc_call_cancel(call, NULL);
+    GPR_ASSERT(grpc_completion_queue_next(cq, deadline, NULL).type ==
+               GRPC_OP_COMPLETE);
+    grpc_call_unref(call);
+    grpc_slice_unref(status_details);
+    status_details = grpc_empty_slice();
+    grpc_metadata_array_destroy(&recv_trailing_metadata);
+    grpc_metadata_array_init(&recv_trailing_metadata);
+  }
+  state.SetItemsProcessed(state.iterations());
+  grpc_metadata_array_destroy(&recv_trailing_metadata);
+  grpc_completion_queue_shutdown(cq);
+  while (grpc_completion_queue_next(cq, deadline, NULL).type !=
+         GRPC_QUEUE_SHUTDOWN)
+    ;
+  grpc_completion_queue_destroy(cq);
+  if (state.thread_index == 0) {
+    contended_pick::Teardown();
+  }
+  track_counters.Finish(state);
+}
+BENCHMARK_TEMPLATE(BM_ContendedPick, contended_pick::PickFirst)
+    ->ThreadRange(1, 16)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_ContendedPick, contended_pick::RoundRobin)
+    ->ThreadRange(1, 16)
+    ->UseRealTime();
+
+////////////////////////////////////////////////////////////////////////////////
+// Benchmarks ring_hash picks over large backend sets
+
+namespace ring_hash_pick {
+
+// Returns \a num_backends distinct backend addresses
+static grpc_lb_addresses *CreateAddresses(size_t num_backends) {
+  grpc_lb_addresses *addresses = grpc_lb_addresses_create(num_backends, NULL);
+  for (size_t i = 0; i < num_backends; i++) {
+    char *hostport;
+    gpr_asprintf(&hostport, "10.%d.%d.%d:443", (int)(i >> 16) & 0xff,
+                 (int)(i >> 8) & 0xff, (int)i & 0xff);
+    grpc_resolved_address address;
+    GPR_ASSERT(grpc_parse_ipv4_hostport(hostport, &address, true));
+    grpc_lb_addresses_set_address(addresses, i, address.addr, address.len,
+                                  false, NULL, NULL);
+    gpr_free(hostport);
+  }
+  return addresses;
+}
+
+}  // namespace ring_hash_pick
+
+// Cost of building the ring on each address update
+static void BM_RingHashRingCreate(benchmark::State &state) {
+  TrackCounters track_counters;
+  grpc_exec_ctx exec_ctx = GRPC_EXEC_CTX_INIT;
+  grpc_lb_addresses *addresses =
+      ring_hash_pick::CreateAddresses((size_t)state.range(0));
+  while (state.KeepRunning()) {
+    grpc_ring_hash_ring_unref(grpc_ring_hash_ring_create(
+        addresses, GRPC_RING_HASH_DEFAULT_POINTS_PER_BACKEND));
+  }
+  grpc_lb_addresses_destroy(&exec_ctx, addresses);
+  grpc_exec_ctx_finish(&exec_ctx);
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_RingHashRingCreate)->Range(8, 4096);
+
+// Cost of a pick: hashing the call's key and finding its backend on the ring
+static void BM_RingHashPick(benchmark::State &state) {
+  TrackCounters track_counters;
+  grpc_exec_ctx exec_ctx = GRPC_EXEC_CTX_INIT;
+  grpc_lb_addresses *addresses =
+      ring_hash_pick::CreateAddresses((size_t)state.range(0));
+  grpc_ring_hash_ring *ring = grpc_ring_hash_ring_create(
+      addresses, GRPC_RING_HASH_DEFAULT_POINTS_PER_BACKEND);
+  grpc_slice hash_key =
+      grpc_slice_intern(grpc_slice_from_static_string("user-id"));
+  const size_t kNumKeys = 1024;
+  std::vector<grpc_linked_mdelem> storage(2 * kNumKeys);
+  std::vector<grpc_metadata_batch> batches(kNumKeys);
+  for (size_t i = 0; i < kNumKeys; i++) {
+    char *user_id;
+    gpr_asprintf(&user_id, "user-%d", (int)i);
+    grpc_metadata_batch_init(&batches[i]);
+    GPR_ASSERT(GRPC_ERROR_NONE ==
+               grpc_metadata_batch_add_tail(
+                   &exec_ctx, &batches[i], &storage[2 * i],
+                   grpc_mdelem_from_slices(
+                       &exec_ctx, GRPC_MDSTR_PATH,
+                       grpc_slice_from_static_string("/foo/bar"))));
+    GPR_ASSERT(GRPC_ERROR_NONE ==
+               grpc_metadata_batch_add_tail(
+                   &exec_ctx, &batches[i], &storage[2 * i + 1],
+                   grpc_mdelem_from_slices(
+                       &exec_ctx, grpc_slice_ref(hash_key),
+                       grpc_slice_from_copied_string(user_id))));
+    gpr_free(user_id);
+  }
+  size_t next_key = 0;
+  size_t sum = 0;
+  while (state.KeepRunning()) {
+    const uint32_t hash =
+        grpc_ring_hash_key_hash(&batches[next_key++ % kNumKeys], hash_key);
+    sum += grpc_ring_hash_ring_backend(ring,
+                                       grpc_ring_hash_ring_find(ring, hash));
+  }
+  benchmark::DoNotOptimize(sum);
+  for (size_t j = 0; j < kNumKeys; j++) {
+    grpc_metadata_batch_destroy(&exec_ctx, &batches[j]);
+  }
+  grpc_slice_unref(hash_key);
+  grpc_ring_hash_ring_unref(ring);
+  grpc_lb_addresses_destroy(&exec_ctx, addresses);
+  grpc_exec_ctx_finish(&exec_ctx);
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_RingHashPick)->Range(8, 4096);
+
+////////////////////////////////////////////////////////////////////////////////
+// Benchmarks subchannel sharing when many channels come up at once
+
+namespace subchannel_sharing {
+
+static void ConnectorRef(grpc_connector *connector) {}
+static void ConnectorUnref(grpc_exec_ctx *exec_ctx,
+                           grpc_connector *connector) {}
+static void ConnectorShutdown(grpc_exec_ctx *exec_ctx,
+                              grpc_connector *connector, grpc_error *why) {
+  GRPC_ERROR_UNREF(why);
+}
+static void ConnectorConnect(grpc_exec_ctx *exec_ctx,
+                             grpc_connector *connector,
+                             const grpc_connect_in_args *in_args,
+                             grpc_connect_out_args *out_args,
+                             grpc_closure *notify) {
+  abort();
+}
+
+static const grpc_connector_vtable connector_vtable = {
+    ConnectorRef, ConnectorUnref, ConnectorShutdown, ConnectorConnect};
+static grpc_connector g_connector = {&connector_vtable};
+
+// Every channel to the same target asks for the same subchannel
+class SameTarget {
+ public:
+  static int Port(int thread_index, int channel_index) { return 443; }
+};
+
+// Every channel has a target of its own
+class DistinctTargets {
+ public:
+  static int Port(int thread_index, int channel_index) {
+    return 1 + thread_index * 4096 + channel_index;
+  }
+};
+
+static grpc_channel_args *CreateSubchannelArgs(int port) {
+  char *hostport;
+  gpr_join_host_port(&hostport, "127.0.0.1", port);
+  grpc_resolved_address address;
+  GPR_ASSERT(grpc_parse_ipv4_hostport(hostport, &address, true));
+  gpr_free(hostport);
+  grpc_arg arg = grpc_create_subchannel_address_arg(&address);
+  grpc_channel_args *args = grpc_channel_args_copy_and_add(NULL, &arg, 1);
+  gpr_free(arg.value.string);
+  return args;
+}
+
+}  // namespace subchannel_sharing
+
+// Each thread brings up kChannels channels, each of them asking for the
+// subchannel to its target the way its LB policy would, then shuts them all
+// down: the threads only contend on the subchannel index
+template <class Target>
+static void BM_ConcurrentSubchannelCreate(benchmark::State &state) {
+  TrackCounters track_counters;
+  const int kChannels = 2048;
+  std::vector<grpc_channel_args *> args(kChannels);
+  for (int i = 0; i < kChannels; i++) {
+    args[i] = subchannel_sharing::CreateSubchannelArgs(
+        Target::Port(state.thread_index, i));
+  }
+  std::vector<grpc_subchannel *> subchannels(kChannels);
+  while (state.KeepRunning()) {
+    grpc_exec_ctx exec_ctx = GRPC_EXEC_CTX_INIT;
+    for (int i = 0; i < kChannels; i++) {
+      grpc_subchannel_args sc_args;
+      memset(&sc_args, 0, sizeof(sc_args));
+      sc_args.args = args[i];
+      subchannels[i] = grpc_subchannel_create(
+          &exec_ctx, &subchannel_sharing::g_connector, NULL, &sc_args);
+    }
+    for (int i = 0; i < kChannels; i++) {
+      GRPC_SUBCHANNEL_UNREF(&exec_ctx, subchannels[i], "bm");
+    }
+    grpc_exec_ctx_finish(&exec_ctx);
+  }
+  state.SetItemsProcessed(state.iterations() * kChannels);
+  grpc_exec_ctx exec_ctx = GRPC_EXEC_CTX_INIT;
+  for (int i = 0; i < kChannels; i++) {
+    grpc_channel_args_destroy(&exec_ctx, args[i]);
+  }
+  grpc_exec_ctx_finish(&exec_ctx);
+  track_counters.Finish(state);
+}
+BENCHMARK_TEMPLATE(BM_ConcurrentSubchannelCreate,
+                   subchannel_sharing::SameTarget)
+    ->ThreadRange(1, 16)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_ConcurrentSubchannelCreate,
+                   subchannel_sharing::DistinctTargets)
+    ->ThreadRange(1, 16)
+    ->UseRealTime();
+
 BENCHMARK_MAIN();
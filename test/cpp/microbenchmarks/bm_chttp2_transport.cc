@@ -22,14 +22,21 @@
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 #include <grpc/support/string_util.h>
+#include <fcntl.h>
 #include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
 #include <memory>
 #include <queue>
 #include <sstream>
 extern "C" {
 #include "src/core/ext/transport/chttp2/transport/chttp2_transport.h"
 #include "src/core/ext/transport/chttp2/transport/internal.h"
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/iomgr/ev_posix.h"
+#include "src/core/lib/iomgr/pollset.h"
 #include "src/core/lib/iomgr/resource_quota.h"
+#include "src/core/lib/iomgr/tcp_posix.h"
 #include "src/core/lib/slice/slice_internal.h"
 #include "src/core/lib/transport/static_metadata.h"
 }
@@ -601,4 +608,100 @@ static void BM_TransportStreamRecv(benchmark::State &state) {
 }
 BENCHMARK(BM_TransportStreamRecv)->Range(0, 128 * 1024 * 1024);
 
+////////////////////////////////////////////////////////////////////////////////
+// Endpoint reads feeding the transport
+//
+
+static void ShutdownPollset(grpc_exec_ctx *exec_ctx, void *ps,
+                            grpc_error *error) {
+  grpc_pollset_destroy(exec_ctx, static_cast<grpc_pollset *>(ps));
+}
+
+// Each iteration writes state.range(0) bytes into a socket as 1KB chunks (as
+// a burst of small frames would arrive), then reads them back through a tcp
+// endpoint configured with a read drain budget of state.range(1)
+static void BM_TcpEndpointRead(benchmark::State &state) {
+  TrackCounters track_counters;
+  grpc_exec_ctx exec_ctx = GRPC_EXEC_CTX_INIT;
+  const size_t bytes_per_iteration = static_cast<size_t>(state.range(0));
+  int sv[2];
+  GPR_ASSERT(socketpair(AF_UNIX, SOCK_STREAM, 0, sv) == 0);
+  GPR_ASSERT(fcntl(sv[1], F_SETFL, fcntl(sv[1], F_GETFL, 0) | O_NONBLOCK) ==
+             0);
+  grpc_arg arg = grpc_channel_arg_integer_create(
+      const_cast<char *>(GRPC_ARG_TCP_READ_DRAIN_BUDGET),
+      static_cast<int>(state.range(1)));
+  grpc_channel_args args = {1, &arg};
+  grpc_endpoint *ep = grpc_tcp_create(
+      &exec_ctx, grpc_fd_create(sv[1], "bm_tcp_read"), &args, "bm_tcp_read");
+  grpc_pollset *ps =
+      static_cast<grpc_pollset *>(gpr_zalloc(grpc_pollset_size()));
+  gpr_mu *mu;
+  grpc_pollset_init(ps, &mu);
+  grpc_endpoint_add_to_pollset(&exec_ctx, ep, ps);
+
+  std::vector<char> chunk(1024, 'a');
+  grpc_slice_buffer incoming;
+  grpc_slice_buffer_init(&incoming);
+  size_t bytes_read = 0;
+  size_t reads = 0;
+  std::unique_ptr<Closure> read_done =
+      MakeClosure([&](grpc_exec_ctx *exec_ctx, grpc_error *error) {
+        GPR_ASSERT(error == GRPC_ERROR_NONE);
+        reads++;
+        bytes_read += incoming.length;
+        grpc_slice_buffer_reset_and_unref_internal(exec_ctx, &incoming);
+        if (bytes_read < bytes_per_iteration) {
+          grpc_endpoint_read(exec_ctx, ep, &incoming, read_done.get());
+        }
+      });
+
+  while (state.KeepRunning()) {
+    for (size_t written = 0; written < bytes_per_iteration;) {
+      ssize_t n = write(sv[0], chunk.data(),
+                        std::min(chunk.size(), bytes_per_iteration - written));
+      GPR_ASSERT(n > 0);
+      written += static_cast<size_t>(n);
+    }
+    bytes_read = 0;
+    grpc_endpoint_read(&exec_ctx, ep, &incoming, read_done.get());
+    grpc_exec_ctx_flush(&exec_ctx);
+    while (bytes_read < bytes_per_iteration) {
+      gpr_mu_lock(mu);
+      GPR_ASSERT(GRPC_LOG_IF_ERROR(
+          "pollset_work",
+          grpc_pollset_work(&exec_ctx, ps, NULL, gpr_now(GPR_CLOCK_MONOTONIC),
+                            gpr_inf_future(GPR_CLOCK_MONOTONIC))));
+      gpr_mu_unlock(mu);
+      grpc_exec_ctx_flush(&exec_ctx);
+    }
+  }
+
+  grpc_endpoint_destroy(&exec_ctx, ep);
+  close(sv[0]);
+  grpc_slice_buffer_destroy_internal(&exec_ctx, &incoming);
+  grpc_closure shutdown_ps_closure;
+  GRPC_CLOSURE_INIT(&shutdown_ps_closure, ShutdownPollset, ps,
+                    grpc_schedule_on_exec_ctx);
+  gpr_mu_lock(mu);
+  grpc_pollset_shutdown(&exec_ctx, ps, &shutdown_ps_closure);
+  gpr_mu_unlock(mu);
+  grpc_exec_ctx_finish(&exec_ctx);
+  gpr_free(ps);
+
+  std::ostringstream label;
+  label << "reads/iter:"
+        << (static_cast<double>(reads) /
+            static_cast<double>(state.iterations()));
+  track_counters.AddToLabel(label, state);
+  state.SetLabel(label.str());
+}
+BENCHMARK(BM_TcpEndpointRead)
+    ->Args({1024, 0})
+    ->Args({16 * 1024, 0})
+    ->Args({64 * 1024, 0})
+    ->Args({1024, 256 * 1024})
+    ->Args({16 * 1024, 256 * 1024})
+    ->Args({64 * 1024, 256 * 1024});
+
 BENCHMARK_MAIN();
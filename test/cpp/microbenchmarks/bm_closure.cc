@@ -20,12 +20,15 @@
 
 #include <benchmark/benchmark.h>
 #include <grpc/grpc.h>
+#include <grpc/support/sync.h>
 #include <sstream>
+#include <vector>
 
 extern "C" {
 #include "src/core/lib/iomgr/closure.h"
 #include "src/core/lib/iomgr/combiner.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/iomgr/executor.h"
 #include "src/core/lib/support/spinlock.h"
 }
 
@@ -415,4 +418,74 @@ static void BM_ClosureReschedOnCombinerFinally(benchmark::State& state) {
 }
 BENCHMARK(BM_ClosureReschedOnCombinerFinally);
 
+// A closure for the executor that records how long it waited to run, then
+// stays busy for a while to build up a backlog behind it
+struct ExecutorJob {
+  grpc_closure closure;
+  gpr_timespec pushed;
+  gpr_timespec busy_for;
+  gpr_atm* total_delay_ns;
+  gpr_atm* remaining;
+  gpr_event* done;
+
+  static void Run(grpc_exec_ctx* exec_ctx, void* arg, grpc_error* error) {
+    ExecutorJob* job = static_cast<ExecutorJob*>(arg);
+    gpr_timespec now = gpr_now(GPR_CLOCK_MONOTONIC);
+    gpr_timespec delay = gpr_time_sub(now, job->pushed);
+    gpr_atm_no_barrier_fetch_add(
+        job->total_delay_ns,
+        (gpr_atm)(delay.tv_sec * GPR_NS_PER_SEC + delay.tv_nsec));
+    gpr_timespec busy_until = gpr_time_add(now, job->busy_for);
+    while (gpr_time_cmp(gpr_now(GPR_CLOCK_MONOTONIC), busy_until) < 0) {
+    }
+    if (gpr_atm_full_fetch_add(job->remaining, -1) == 1) {
+      gpr_event_set(job->done, (void*)1);
+    }
+  }
+};
+
+// Each iteration pushes state.range(0) closures busy for state.range(1)ns
+// each from one exec_ctx: they all land on the same executor thread, so this
+// measures how well the executor spreads a skewed load
+static void BM_ClosureSchedOnExecutor(benchmark::State& state) {
+  TrackCounters track_counters;
+  const size_t batch = static_cast<size_t>(state.range(0));
+  std::vector<ExecutorJob> jobs(batch);
+  gpr_atm total_delay_ns = 0;
+  gpr_atm remaining;
+  gpr_event done;
+  for (auto& job : jobs) {
+    GRPC_CLOSURE_INIT(&job.closure, ExecutorJob::Run, &job,
+                      grpc_executor_scheduler);
+    job.busy_for = gpr_time_from_nanos(state.range(1), GPR_TIMESPAN);
+    job.total_delay_ns = &total_delay_ns;
+    job.remaining = &remaining;
+    job.done = &done;
+  }
+  grpc_exec_ctx exec_ctx = GRPC_EXEC_CTX_INIT;
+  while (state.KeepRunning()) {
+    gpr_event_init(&done);
+    gpr_atm_no_barrier_store(&remaining, static_cast<gpr_atm>(batch));
+    for (auto& job : jobs) {
+      job.pushed = gpr_now(GPR_CLOCK_MONOTONIC);
+      GRPC_CLOSURE_SCHED(&exec_ctx, &job.closure, GRPC_ERROR_NONE);
+    }
+    grpc_exec_ctx_flush(&exec_ctx);
+    gpr_event_wait(&done, gpr_inf_future(GPR_CLOCK_REALTIME));
+  }
+  grpc_exec_ctx_finish(&exec_ctx);
+  std::ostringstream label;
+  label << "delay_us/closure:"
+        << (static_cast<double>(gpr_atm_no_barrier_load(&total_delay_ns)) /
+            1000.0 / static_cast<double>(batch * state.iterations()));
+  track_counters.AddToLabel(label, state);
+  state.SetLabel(label.str());
+}
+BENCHMARK(BM_ClosureSchedOnExecutor)
+    ->Args({1, 0})
+    ->Args({16, 0})
+    ->Args({256, 0})
+    ->Args({16, 10000})
+    ->Args({256, 10000});
+
 BENCHMARK_MAIN();
@@ -0,0 +1,161 @@
+/*
+ *
+ * Copyright 2017 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark message compression */
+
+#include <benchmark/benchmark.h>
+#include <grpc/support/log.h>
+#include <string.h>
+#include <ostream>
+#include <string>
+
+extern "C" {
+#include "src/core/lib/compression/message_compress.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/slice/slice_internal.h"
+}
+
+#include "test/cpp/microbenchmarks/helpers.h"
+
+auto& force_library_initialization = Library::get();
+
+static void AppendVarint(std::string* out, uint64_t value) {
+  while (value >= 0x80) {
+    out->push_back(static_cast<char>((value & 0x7f) | 0x80));
+    value >>= 7;
+  }
+  out->push_back(static_cast<char>(value));
+}
+
+// Bytes that look like a serialized protobuf message: repeated records of
+// integer ids, short strings from a small vocabulary and doubles, which
+// compress about as well as typical RPC payloads
+static std::string MakePayload(size_t length) {
+  static const char* const kWords[] = {
+      "user",   "account", "request", "status", "region",  "us-east1",
+      "active", "pending", "created", "name",   "payload", "timestamp"};
+  const size_t kNumWords = sizeof(kWords) / sizeof(*kWords);
+  std::string out;
+  uint64_t seed = 12345;
+  while (out.size() < length) {
+    seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+    const char* word = kWords[(seed >> 33) % kNumWords];
+    out.push_back(0x08);  // field 1, varint
+    AppendVarint(&out, (seed >> 40) & 0xfffff);
+    out.push_back(0x12);  // field 2, length delimited
+    AppendVarint(&out, strlen(word));
+    out.append(word);
+    out.push_back(0x19);  // field 3, 64 bit
+    for (int i = 0; i < 8; i++) {
+      out.push_back(static_cast<char>(seed >> (8 * i)));
+    }
+  }
+  out.resize(length);
+  return out;
+}
+
+static void AddPayload(grpc_slice_buffer* buffer, const std::string& payload) {
+  grpc_slice_buffer_add(
+      buffer, grpc_slice_from_copied_buffer(payload.data(), payload.size()));
+}
+
+// Adds the compression ratio of the payload to the label
+class CompressionCounters : public TrackCounters {
+ public:
+  void AddToLabel(std::ostream& out, benchmark::State& state) override {
+    TrackCounters::AddToLabel(out, state);
+    out << " ratio:" << ratio_;
+  }
+
+  void SetRatio(double ratio) { ratio_ = ratio; }
+
+ private:
+  double ratio_ = 0;
+};
+
+template <grpc_compression_algorithm kAlgorithm>
+static void BM_MessageCompress(benchmark::State& state) {
+  CompressionCounters track_counters;
+  grpc_exec_ctx exec_ctx = GRPC_EXEC_CTX_INIT;
+  grpc_slice_buffer input;
+  grpc_slice_buffer output;
+  grpc_slice_buffer_init(&input);
+  grpc_slice_buffer_init(&output);
+  AddPayload(&input, MakePayload(state.range(0)));
+  size_t compressed_length = 0;
+  while (state.KeepRunning()) {
+    grpc_msg_compress(&exec_ctx, kAlgorithm, &input, &output);
+    compressed_length = output.length;
+    grpc_slice_buffer_reset_and_unref_internal(&exec_ctx, &output);
+    grpc_exec_ctx_flush(&exec_ctx);
+  }
+  track_counters.SetRatio((double)state.range(0) / compressed_length);
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+  grpc_slice_buffer_destroy_internal(&exec_ctx, &input);
+  grpc_slice_buffer_destroy_internal(&exec_ctx, &output);
+  grpc_exec_ctx_finish(&exec_ctx);
+  track_counters.Finish(state);
+}
+
+template <grpc_compression_algorithm kAlgorithm>
+static void BM_MessageDecompress(benchmark::State& state) {
+  TrackCounters track_counters;
+  grpc_exec_ctx exec_ctx = GRPC_EXEC_CTX_INIT;
+  grpc_slice_buffer raw;
+  grpc_slice_buffer input;
+  grpc_slice_buffer output;
+  grpc_slice_buffer_init(&raw);
+  grpc_slice_buffer_init(&input);
+  grpc_slice_buffer_init(&output);
+  AddPayload(&raw, MakePayload(state.range(0)));
+  if (!grpc_msg_compress(&exec_ctx, kAlgorithm, &raw, &input)) {
+    state.SkipWithError("payload does not compress");
+  }
+  while (state.KeepRunning()) {
+    GPR_ASSERT(grpc_msg_decompress(&exec_ctx, kAlgorithm, &input, &output));
+    grpc_slice_buffer_reset_and_unref_internal(&exec_ctx, &output);
+    grpc_exec_ctx_flush(&exec_ctx);
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+  grpc_slice_buffer_destroy_internal(&exec_ctx, &raw);
+  grpc_slice_buffer_destroy_internal(&exec_ctx, &input);
+  grpc_slice_buffer_destroy_internal(&exec_ctx, &output);
+  grpc_exec_ctx_finish(&exec_ctx);
+  track_counters.Finish(state);
+}
+
+static void MessageSizes(benchmark::internal::Benchmark* b) {
+  for (int size = 512; size <= 4 * 1024 * 1024; size *= 8) {
+    b->Arg(size);
+  }
+}
+
+BENCHMARK_TEMPLATE(BM_MessageCompress, GRPC_COMPRESS_DEFLATE)
+    ->Apply(MessageSizes);
+BENCHMARK_TEMPLATE(BM_MessageCompress, GRPC_COMPRESS_GZIP)
+    ->Apply(MessageSizes);
+BENCHMARK_TEMPLATE(BM_MessageCompress, GRPC_COMPRESS_LZ4)
+    ->Apply(MessageSizes);
+BENCHMARK_TEMPLATE(BM_MessageDecompress, GRPC_COMPRESS_DEFLATE)
+    ->Apply(MessageSizes);
+BENCHMARK_TEMPLATE(BM_MessageDecompress, GRPC_COMPRESS_GZIP)
+    ->Apply(MessageSizes);
+BENCHMARK_TEMPLATE(BM_MessageDecompress, GRPC_COMPRESS_LZ4)
+    ->Apply(MessageSizes);
+
+BENCHMARK_MAIN();
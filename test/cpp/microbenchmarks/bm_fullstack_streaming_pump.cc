@@ -19,7 +19,11 @@
 /* Benchmark gRPC end2end in various configurations */
 
 #include <benchmark/benchmark.h>
+#include <atomic>
+#include <chrono>
 #include <sstream>
+#include <thread>
+#include <vector>
 #include "src/core/lib/profiling/timers.h"
 #include "src/cpp/client/create_channel_internal.h"
 #include "src/proto/grpc/testing/echo.grpc.pb.h"
@@ -165,6 +169,178 @@ static void BM_PumpStreamServerToClient(benchmark::State& state) {
   state.SetBytesProcessed(state.range(0) * state.iterations());
 }
 
+/*******************************************************************************
+ * MULTI-THREADED KERNELS
+ */
+
+namespace pump_many {
+
+// Server side of one stream: its tag is the stream itself, and it has at most
+// one operation pending at a time
+struct ServerStream {
+  ServerStream() : response_rw(&svr_ctx) {}
+  ServerContext svr_ctx;
+  ServerAsyncReaderWriter<EchoResponse, EchoRequest> response_rw;
+  EchoRequest recv_request;
+  bool accepted = false;
+  bool finishing = false;
+};
+
+// Drains whatever reaches the server until told to stop
+static void ServerLoop(ServerCompletionQueue* cq, std::atomic<bool>* stop) {
+  while (!stop->load()) {
+    void* t;
+    bool ok;
+    auto deadline =
+        std::chrono::system_clock::now() + std::chrono::milliseconds(100);
+    switch (cq->AsyncNext(&t, &ok, deadline)) {
+      case CompletionQueue::TIMEOUT:
+        break;
+      case CompletionQueue::SHUTDOWN:
+        return;
+      case CompletionQueue::GOT_EVENT: {
+        ServerStream* s = static_cast<ServerStream*>(t);
+        if (!s->accepted) {
+          GPR_ASSERT(ok);
+          s->accepted = true;
+          s->response_rw.Read(&s->recv_request, s);
+        } else if (s->finishing) {
+          // done with this stream
+        } else if (ok) {
+          s->response_rw.Read(&s->recv_request, s);
+        } else {
+          s->finishing = true;
+          s->response_rw.Finish(Status::OK, s);
+        }
+        break;
+      }
+    }
+  }
+}
+
+// Opens a stream on \a cq, waiting for it to be up
+static std::unique_ptr<ClientAsyncReaderWriter<EchoRequest, EchoResponse>>
+OpenStream(EchoTestService::Stub* stub, ClientContext* cli_ctx,
+           CompletionQueue* cq) {
+  auto request_rw = stub->AsyncBidiStream(cli_ctx, cq, tag(0));
+  void* t;
+  bool ok;
+  GPR_ASSERT(cq->Next(&t, &ok));
+  GPR_ASSERT(ok && t == tag(0));
+  return request_rw;
+}
+
+// Half-closes and finishes a stream opened by OpenStream, and drains \a cq
+static void CloseStream(
+    ClientAsyncReaderWriter<EchoRequest, EchoResponse>* request_rw,
+    CompletionQueue* cq) {
+  void* t;
+  bool ok;
+  request_rw->WritesDone(tag(0));
+  GPR_ASSERT(cq->Next(&t, &ok));
+  Status final_status;
+  request_rw->Finish(&final_status, tag(0));
+  GPR_ASSERT(cq->Next(&t, &ok));
+  GPR_ASSERT(final_status.ok());
+  cq->Shutdown();
+  while (cq->Next(&t, &ok)) {
+  }
+}
+
+}  // namespace pump_many
+
+// Each thread pumps messages over a stream of its own, all streams sharing one
+// channel. Before the threads start, as many streams are opened one after the
+// other and closed again, so that fixtures pooling connections get to open
+// theirs.
+template <class Fixture>
+static void BM_PumpManyStreamsClientToServer(benchmark::State& state) {
+  static std::unique_ptr<EchoTestService::AsyncService> service;
+  static std::unique_ptr<Fixture> fixture;
+  static std::vector<std::unique_ptr<pump_many::ServerStream>> server_streams;
+  static std::vector<std::thread> server_threads;
+  static std::atomic<bool> stop;
+  static std::atomic<int> streams_done;
+  if (state.thread_index == 0) {
+    service.reset(new EchoTestService::AsyncService);
+    fixture.reset(new Fixture(service.get()));
+    stop.store(false);
+    streams_done.store(0);
+    for (int i = 0; i < 2 * state.threads; i++) {
+      server_streams.emplace_back(new pump_many::ServerStream);
+      pump_many::ServerStream* s = server_streams.back().get();
+      service->RequestBidiStream(&s->svr_ctx, &s->response_rw, fixture->cq(),
+                                 fixture->cq(), s);
+    }
+    for (int i = 0; i < state.threads; i++) {
+      server_threads.emplace_back(pump_many::ServerLoop, fixture->cq(), &stop);
+    }
+    std::unique_ptr<EchoTestService::Stub> stub(
+        EchoTestService::NewStub(fixture->channel()));
+    std::vector<std::unique_ptr<ClientContext>> warmup_ctxs;
+    std::vector<std::unique_ptr<CompletionQueue>> warmup_cqs;
+    std::vector<
+        std::unique_ptr<ClientAsyncReaderWriter<EchoRequest, EchoResponse>>>
+        warmup_streams;
+    for (int i = 0; i < state.threads; i++) {
+      warmup_ctxs.emplace_back(new ClientContext);
+      warmup_cqs.emplace_back(new CompletionQueue);
+      warmup_streams.push_back(pump_many::OpenStream(
+          stub.get(), warmup_ctxs.back().get(), warmup_cqs.back().get()));
+      std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+    for (int i = 0; i < state.threads; i++) {
+      pump_many::CloseStream(warmup_streams[i].get(), warmup_cqs[i].get());
+    }
+  }
+  {
+    EchoRequest send_request;
+    if (state.range(0) > 0) {
+      send_request.set_message(std::string(state.range(0), 'a'));
+    }
+    CompletionQueue cq;
+    ClientContext cli_ctx;
+    std::unique_ptr<EchoTestService::Stub> stub;
+    std::unique_ptr<ClientAsyncReaderWriter<EchoRequest, EchoResponse>>
+        request_rw;
+    void* t;
+    bool ok;
+    while (state.KeepRunning()) {
+      GPR_TIMER_SCOPE("BenchmarkCycle", 0);
+      if (request_rw == nullptr) {
+        stub = EchoTestService::NewStub(fixture->channel());
+        request_rw = pump_many::OpenStream(stub.get(), &cli_ctx, &cq);
+      }
+      request_rw->Write(send_request, tag(1));
+      GPR_ASSERT(cq.Next(&t, &ok));
+      GPR_ASSERT(ok && t == tag(1));
+    }
+    if (request_rw != nullptr) {
+      pump_many::CloseStream(request_rw.get(), &cq);
+    } else {
+      cq.Shutdown();
+      while (cq.Next(&t, &ok)) {
+      }
+    }
+  }
+  state.SetBytesProcessed(state.range(0) * state.iterations());
+  streams_done++;
+  if (state.thread_index == 0) {
+    while (streams_done.load() < state.threads) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    stop.store(true);
+    for (auto& th : server_threads) {
+      th.join();
+    }
+    server_threads.clear();
+    fixture->Finish(state);
+    fixture.reset();
+    server_streams.clear();
+    service.reset();
+  }
+}
+
 /*******************************************************************************
  * CONFIGURATIONS
  */
@@ -189,6 +365,24 @@ BENCHMARK_TEMPLATE(BM_PumpStreamServerToClient, SockPair)
     ->Range(0, 128 * 1024 * 1024);
 BENCHMARK_TEMPLATE(BM_PumpStreamServerToClient, InProcessCHTTP2)
     ->Range(0, 128 * 1024 * 1024);
+BENCHMARK_TEMPLATE(BM_PumpStreamClientToServer, ZeroCopyTCP)
+    ->Range(0, 128 * 1024 * 1024);
+BENCHMARK_TEMPLATE(BM_PumpStreamServerToClient, ZeroCopyTCP)
+    ->Range(0, 128 * 1024 * 1024);
+BENCHMARK_TEMPLATE(BM_PumpStreamClientToServer, SslTCP)
+    ->Range(0, 128 * 1024 * 1024);
+BENCHMARK_TEMPLATE(BM_PumpStreamServerToClient, SslTCP)
+    ->Range(0, 128 * 1024 * 1024);
+BENCHMARK_TEMPLATE(BM_PumpStreamClientToServer, SslTCP)
+    ->RangeMultiplier(2)
+    ->Range(64 * 1024, 4 * 1024 * 1024);
+BENCHMARK_TEMPLATE(BM_PumpStreamServerToClient, SslTCP)
+    ->RangeMultiplier(2)
+    ->Range(64 * 1024, 4 * 1024 * 1024);
+BENCHMARK_TEMPLATE(BM_PumpStreamClientToServer, KernelTlsTCP)
+    ->Range(0, 128 * 1024 * 1024);
+BENCHMARK_TEMPLATE(BM_PumpStreamServerToClient, KernelTlsTCP)
+    ->Range(0, 128 * 1024 * 1024);
 BENCHMARK_TEMPLATE(BM_PumpStreamClientToServer, MinTCP)->Arg(0);
 BENCHMARK_TEMPLATE(BM_PumpStreamClientToServer, MinUDS)->Arg(0);
 BENCHMARK_TEMPLATE(BM_PumpStreamClientToServer, MinInProcess)->Arg(0);
@@ -199,6 +393,14 @@ BENCHMARK_TEMPLATE(BM_PumpStreamServerToClient, MinUDS)->Arg(0);
 BENCHMARK_TEMPLATE(BM_PumpStreamServerToClient, MinInProcess)->Arg(0);
 BENCHMARK_TEMPLATE(BM_PumpStreamServerToClient, MinSockPair)->Arg(0);
 BENCHMARK_TEMPLATE(BM_PumpStreamServerToClient, MinInProcessCHTTP2)->Arg(0);
+BENCHMARK_TEMPLATE(BM_PumpManyStreamsClientToServer, TCP)
+    ->Arg(16 * 1024)
+    ->ThreadRange(1, 64)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_PumpManyStreamsClientToServer, PooledTCP)
+    ->Arg(16 * 1024)
+    ->ThreadRange(1, 64)
+    ->UseRealTime();
 
 }  // namespace testing
 }  // namespace grpc
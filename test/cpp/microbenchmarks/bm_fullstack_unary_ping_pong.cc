@@ -19,6 +19,7 @@
 /* Benchmark gRPC end2end in various configurations */
 
 #include <benchmark/benchmark.h>
+#include <chrono>
 #include <sstream>
 #include "src/core/lib/profiling/timers.h"
 #include "src/cpp/client/create_channel_internal.h"
@@ -74,6 +75,8 @@ static void BM_UnaryPingPong(benchmark::State& state) {
       EchoTestService::NewStub(fixture->channel()));
   while (state.KeepRunning()) {
     GPR_TIMER_SCOPE("BenchmarkCycle", 0);
+    // std::chrono rather than gpr_now, which low level counters track
+    auto rpc_start = std::chrono::steady_clock::now();
     recv_response.Clear();
     ClientContext cli_ctx;
     ClientContextMutator cli_ctx_mut(&cli_ctx);
@@ -97,6 +100,10 @@ static void BM_UnaryPingPong(benchmark::State& state) {
       i -= 1 << tagnum;
     }
     GPR_ASSERT(recv_status.ok());
+    fixture->AddLatencySample(
+        std::chrono::duration<double, std::nano>(
+            std::chrono::steady_clock::now() - rpc_start)
+            .count());
 
     senv->~ServerEnv();
     senv = new (senv) ServerEnv();
@@ -111,6 +118,64 @@ static void BM_UnaryPingPong(benchmark::State& state) {
                           state.range(1) * state.iterations());
 }
 
+// Each iteration opens a new channel, and so a new connection, for one unary
+// call: this measures the cost of reconnecting, dominated by the handshake
+template <class Fixture>
+static void BM_UnaryReconnect(benchmark::State& state) {
+  EchoTestService::AsyncService service;
+  std::unique_ptr<Fixture> fixture(new Fixture(&service));
+  EchoRequest send_request;
+  EchoResponse send_response;
+  EchoResponse recv_response;
+  Status recv_status;
+  struct ServerEnv {
+    ServerContext ctx;
+    EchoRequest recv_request;
+    grpc::ServerAsyncResponseWriter<EchoResponse> response_writer;
+    ServerEnv() : response_writer(&ctx) {}
+  };
+  std::unique_ptr<ServerEnv> senv(new ServerEnv);
+  service.RequestEcho(&senv->ctx, &senv->recv_request, &senv->response_writer,
+                      fixture->cq(), fixture->cq(), tag(0));
+  while (state.KeepRunning()) {
+    GPR_TIMER_SCOPE("BenchmarkCycle", 0);
+    auto rpc_start = std::chrono::steady_clock::now();
+    std::unique_ptr<EchoTestService::Stub> stub(
+        EchoTestService::NewStub(fixture->NewChannel()));
+    recv_response.Clear();
+    ClientContext cli_ctx;
+    std::unique_ptr<ClientAsyncResponseReader<EchoResponse>> response_reader(
+        stub->AsyncEcho(&cli_ctx, send_request, fixture->cq()));
+    void* t;
+    bool ok;
+    GPR_ASSERT(fixture->cq()->Next(&t, &ok));
+    GPR_ASSERT(ok);
+    GPR_ASSERT(t == tag(0));
+    senv->response_writer.Finish(send_response, Status::OK, tag(3));
+    response_reader->Finish(&recv_response, &recv_status, tag(4));
+    for (int i = (1 << 3) | (1 << 4); i != 0;) {
+      GPR_ASSERT(fixture->cq()->Next(&t, &ok));
+      GPR_ASSERT(ok);
+      int tagnum = (int)reinterpret_cast<intptr_t>(t);
+      GPR_ASSERT(i & (1 << tagnum));
+      i -= 1 << tagnum;
+    }
+    GPR_ASSERT(recv_status.ok());
+    fixture->AddLatencySample(
+        std::chrono::duration<double, std::nano>(
+            std::chrono::steady_clock::now() - rpc_start)
+            .count());
+
+    senv.reset(new ServerEnv);
+    service.RequestEcho(&senv->ctx, &senv->recv_request,
+                        &senv->response_writer, fixture->cq(), fixture->cq(),
+                        tag(0));
+  }
+  fixture->Finish(state);
+  fixture.reset();
+  senv.reset();
+}
+
 /*******************************************************************************
  * CONFIGURATIONS
  */
@@ -126,6 +191,11 @@ static void SweepSizesArgs(benchmark::internal::Benchmark* b) {
 
 BENCHMARK_TEMPLATE(BM_UnaryPingPong, TCP, NoOpMutator, NoOpMutator)
     ->Apply(SweepSizesArgs);
+BENCHMARK_TEMPLATE(BM_UnaryPingPong, SslTCP, NoOpMutator, NoOpMutator)
+    ->Args({0, 0});
+BENCHMARK_TEMPLATE(BM_UnaryPingPong, SslSessionCacheTCP, NoOpMutator,
+                   NoOpMutator)
+    ->Args({0, 0});
 BENCHMARK_TEMPLATE(BM_UnaryPingPong, MinTCP, NoOpMutator, NoOpMutator)
     ->Apply(SweepSizesArgs);
 BENCHMARK_TEMPLATE(BM_UnaryPingPong, UDS, NoOpMutator, NoOpMutator)
@@ -145,6 +215,13 @@ BENCHMARK_TEMPLATE(BM_UnaryPingPong, InProcessCHTTP2, NoOpMutator, NoOpMutator)
 BENCHMARK_TEMPLATE(BM_UnaryPingPong, MinInProcessCHTTP2, NoOpMutator,
                    NoOpMutator)
     ->Apply(SweepSizesArgs);
+BENCHMARK_TEMPLATE(BM_UnaryPingPong, ManyCQTCP, NoOpMutator, NoOpMutator)
+    ->Args({0, 0});
+BENCHMARK_TEMPLATE(BM_UnaryPingPong, ManyCQSockPair, NoOpMutator, NoOpMutator)
+    ->Args({0, 0});
+BENCHMARK_TEMPLATE(BM_UnaryPingPong, ManyCQInProcessCHTTP2, NoOpMutator,
+                   NoOpMutator)
+    ->Args({0, 0});
 BENCHMARK_TEMPLATE(BM_UnaryPingPong, InProcessCHTTP2,
                    Client_AddMetadata<RandomBinaryMetadata<10>, 1>, NoOpMutator)
     ->Args({0, 0});
@@ -245,6 +322,9 @@ BENCHMARK_TEMPLATE(BM_UnaryPingPong, InProcess, NoOpMutator,
 BENCHMARK_TEMPLATE(BM_UnaryPingPong, InProcess, NoOpMutator,
                    Server_AddInitialMetadata<RandomAsciiMetadata<10>, 100>)
     ->Args({0, 0});
+BENCHMARK_TEMPLATE(BM_UnaryReconnect, TCP);
+BENCHMARK_TEMPLATE(BM_UnaryReconnect, SslTCP);
+BENCHMARK_TEMPLATE(BM_UnaryReconnect, SslSessionCacheTCP);
 
 }  // namespace testing
 }  // namespace grpc
@@ -19,12 +19,15 @@
 #ifndef TEST_CPP_MICROBENCHMARKS_FULLSTACK_FIXTURES_H
 #define TEST_CPP_MICROBENCHMARKS_FULLSTACK_FIXTURES_H
 
+#include <vector>
+
 #include <grpc++/channel.h>
 #include <grpc++/create_channel.h>
 #include <grpc++/security/credentials.h>
 #include <grpc++/security/server_credentials.h>
 #include <grpc++/server.h>
 #include <grpc++/server_builder.h>
+#include <grpc/grpc_security.h>
 #include <grpc/support/log.h>
 
 extern "C" {
@@ -37,6 +40,7 @@ extern "C" {
 #include "src/core/lib/surface/channel.h"
 #include "src/core/lib/surface/completion_queue.h"
 #include "src/core/lib/surface/server.h"
+#include "test/core/end2end/data/ssl_test_data.h"
 #include "test/core/util/passthru_endpoint.h"
 #include "test/core/util/port.h"
 }
@@ -57,6 +61,42 @@ class FixtureConfiguration {
     b->SetMaxReceiveMessageSize(INT_MAX);
     b->SetMaxSendMessageSize(INT_MAX);
   }
+
+  // Server completion queues beyond the one returned by cq(): they are never
+  // polled, but calls may be accepted on them and requests matched across
+  virtual int ExtraServerCompletionQueues() const { return 0; }
+
+  // Credentials of the listening port and channel of fullstack fixtures
+  virtual std::shared_ptr<ServerCredentials> MakeServerCredentials() const {
+    return InsecureServerCredentials();
+  }
+
+  virtual std::shared_ptr<ChannelCredentials> MakeChannelCredentials() const {
+    return InsecureChannelCredentials();
+  }
+};
+
+// Owns the extra server completion queues asked for by a FixtureConfiguration
+class ExtraServerCompletionQueues {
+ public:
+  void Add(ServerBuilder* b, const FixtureConfiguration& config) {
+    for (int i = 0; i < config.ExtraServerCompletionQueues(); i++) {
+      cqs_.emplace_back(b->AddCompletionQueue(true));
+    }
+  }
+
+  void ShutdownAndDrain() {
+    for (auto& cq : cqs_) {
+      cq->Shutdown();
+      void* tag;
+      bool ok;
+      while (cq->Next(&tag, &ok)) {
+      }
+    }
+  }
+
+ private:
+  std::vector<std::unique_ptr<ServerCompletionQueue>> cqs_;
 };
 
 class BaseFixture : public TrackCounters {};
@@ -67,20 +107,19 @@ class FullstackFixture : public BaseFixture {
                    const grpc::string& address) {
     ServerBuilder b;
     if (address.length() > 0) {
-      b.AddListeningPort(address, InsecureServerCredentials());
+      b.AddListeningPort(address, config.MakeServerCredentials());
     }
     cq_ = b.AddCompletionQueue(true);
+    extra_cqs_.Add(&b, config);
     b.RegisterService(service);
     config.ApplyCommonServerBuilderConfig(&b);
     server_ = b.BuildAndStart();
-    ChannelArguments args;
-    config.ApplyCommonChannelArguments(&args);
+    config.ApplyCommonChannelArguments(&channel_args_);
     if (address.length() > 0) {
-      channel_ =
-          CreateCustomChannel(address, InsecureChannelCredentials(), args);
-    } else {
-      channel_ = server_->InProcessChannel(args);
+      address_ = address;
+      channel_creds_ = config.MakeChannelCredentials();
     }
+    channel_ = NewChannel();
   }
 
   virtual ~FullstackFixture() {
@@ -90,6 +129,7 @@ class FullstackFixture : public BaseFixture {
     bool ok;
     while (cq_->Next(&tag, &ok)) {
     }
+    extra_cqs_.ShutdownAndDrain();
   }
 
   void AddToLabel(std::ostream& out, benchmark::State& state) {
@@ -101,9 +141,21 @@ class FullstackFixture : public BaseFixture {
   ServerCompletionQueue* cq() { return cq_.get(); }
   std::shared_ptr<Channel> channel() { return channel_; }
 
+  // A channel to the same server that does not share channel()'s connection
+  std::shared_ptr<Channel> NewChannel() {
+    if (address_.length() > 0) {
+      return CreateCustomChannel(address_, channel_creds_, channel_args_);
+    }
+    return server_->InProcessChannel(channel_args_);
+  }
+
  private:
   std::unique_ptr<Server> server_;
   std::unique_ptr<ServerCompletionQueue> cq_;
+  ExtraServerCompletionQueues extra_cqs_;
+  grpc::string address_;
+  std::shared_ptr<ChannelCredentials> channel_creds_;
+  ChannelArguments channel_args_;
   std::shared_ptr<Channel> channel_;
 };
 
@@ -162,6 +214,7 @@ class EndpointPairFixture : public BaseFixture {
       : endpoint_pair_(endpoints) {
     ServerBuilder b;
     cq_ = b.AddCompletionQueue(true);
+    extra_cqs_.Add(&b, fixture_configuration);
     b.RegisterService(service);
     fixture_configuration.ApplyCommonServerBuilderConfig(&b);
     server_ = b.BuildAndStart();
@@ -217,6 +270,7 @@ class EndpointPairFixture : public BaseFixture {
     bool ok;
     while (cq_->Next(&tag, &ok)) {
     }
+    extra_cqs_.ShutdownAndDrain();
   }
 
   void AddToLabel(std::ostream& out, benchmark::State& state) {
@@ -236,6 +290,7 @@ class EndpointPairFixture : public BaseFixture {
  private:
   std::unique_ptr<Server> server_;
   std::unique_ptr<ServerCompletionQueue> cq_;
+  ExtraServerCompletionQueues extra_cqs_;
   std::shared_ptr<Channel> channel_;
 };
 
@@ -299,6 +354,145 @@ typedef MinStackize<InProcess> MinInProcess;
 typedef MinStackize<SockPair> MinSockPair;
 typedef MinStackize<InProcessCHTTP2> MinInProcessCHTTP2;
 
+////////////////////////////////////////////////////////////////////////////////
+// Zero copy send fixtures
+
+class ZeroCopyConfiguration : public FixtureConfiguration {
+  void ApplyCommonChannelArguments(ChannelArguments* a) const override {
+    a->SetInt(GRPC_ARG_TCP_TX_ZEROCOPY_ENABLED, 1);
+    FixtureConfiguration::ApplyCommonChannelArguments(a);
+  }
+
+  void ApplyCommonServerBuilderConfig(ServerBuilder* b) const override {
+    b->AddChannelArgument(GRPC_ARG_TCP_TX_ZEROCOPY_ENABLED, 1);
+    FixtureConfiguration::ApplyCommonServerBuilderConfig(b);
+  }
+};
+
+template <class Base>
+class ZeroCopyize : public Base {
+ public:
+  ZeroCopyize(Service* service) : Base(service, ZeroCopyConfiguration()) {}
+};
+
+typedef ZeroCopyize<TCP> ZeroCopyTCP;
+
+////////////////////////////////////////////////////////////////////////////////
+// TLS fixtures
+
+class SslConfiguration : public FixtureConfiguration {
+ protected:
+  void ApplyCommonChannelArguments(ChannelArguments* a) const override {
+    a->SetSslTargetNameOverride("foo.test.google.fr");
+    FixtureConfiguration::ApplyCommonChannelArguments(a);
+  }
+
+  std::shared_ptr<ServerCredentials> MakeServerCredentials() const override {
+    SslServerCredentialsOptions::PemKeyCertPair key_cert_pair = {
+        test_server1_key, test_server1_cert};
+    SslServerCredentialsOptions options;
+    options.pem_key_cert_pairs.push_back(key_cert_pair);
+    return SslServerCredentials(options);
+  }
+
+  std::shared_ptr<ChannelCredentials> MakeChannelCredentials() const override {
+    SslCredentialsOptions options;
+    options.pem_root_certs = test_root_cert;
+    return SslCredentials(options);
+  }
+};
+
+class KernelTlsConfiguration : public SslConfiguration {
+  void ApplyCommonChannelArguments(ChannelArguments* a) const override {
+    a->SetInt(GRPC_ARG_TLS_KERNEL_OFFLOAD_ENABLED, 1);
+    SslConfiguration::ApplyCommonChannelArguments(a);
+  }
+
+  void ApplyCommonServerBuilderConfig(ServerBuilder* b) const override {
+    b->AddChannelArgument(GRPC_ARG_TLS_KERNEL_OFFLOAD_ENABLED, 1);
+    SslConfiguration::ApplyCommonServerBuilderConfig(b);
+  }
+};
+
+// Client channels share a session cache, so that their handshakes after the
+// first one resume the session
+class SslSessionCacheConfiguration : public SslConfiguration {
+ public:
+  SslSessionCacheConfiguration()
+      : cache_(grpc_ssl_session_cache_create_lru(16)) {}
+  ~SslSessionCacheConfiguration() { grpc_ssl_session_cache_destroy(cache_); }
+
+ private:
+  grpc_ssl_session_cache* cache_;
+
+  void ApplyCommonChannelArguments(ChannelArguments* a) const override {
+    grpc_arg arg = grpc_ssl_session_cache_create_channel_arg(cache_);
+    a->SetPointerWithVtable(arg.key, arg.value.pointer.p,
+                            arg.value.pointer.vtable);
+    SslConfiguration::ApplyCommonChannelArguments(a);
+  }
+};
+
+template <class Base>
+class Sslize : public Base {
+ public:
+  Sslize(Service* service) : Base(service, SslConfiguration()) {}
+};
+
+template <class Base>
+class KernelTlsize : public Base {
+ public:
+  KernelTlsize(Service* service) : Base(service, KernelTlsConfiguration()) {}
+};
+
+template <class Base>
+class SslSessionCacheize : public Base {
+ public:
+  SslSessionCacheize(Service* service)
+      : Base(service, SslSessionCacheConfiguration()) {}
+};
+
+typedef Sslize<TCP> SslTCP;
+typedef SslSessionCacheize<TCP> SslSessionCacheTCP;
+typedef KernelTlsize<TCP> KernelTlsTCP;
+
+////////////////////////////////////////////////////////////////////////////////
+// Connection pooling fixtures
+
+class ConnectionPoolConfiguration : public FixtureConfiguration {
+  void ApplyCommonChannelArguments(ChannelArguments* a) const override {
+    a->SetInt(GRPC_ARG_MAX_CONNECTIONS_PER_SUBCHANNEL, 8);
+    a->SetInt(GRPC_ARG_SUBCHANNEL_CONNECTION_STREAM_THRESHOLD, 1);
+    FixtureConfiguration::ApplyCommonChannelArguments(a);
+  }
+};
+
+template <class Base>
+class ConnectionPoolize : public Base {
+ public:
+  ConnectionPoolize(Service* service)
+      : Base(service, ConnectionPoolConfiguration()) {}
+};
+
+typedef ConnectionPoolize<TCP> PooledTCP;
+
+////////////////////////////////////////////////////////////////////////////////
+// Many server completion queue fixtures
+
+class ManyCQConfiguration : public FixtureConfiguration {
+  int ExtraServerCompletionQueues() const override { return 31; }
+};
+
+template <class Base>
+class ManyCQize : public Base {
+ public:
+  ManyCQize(Service* service) : Base(service, ManyCQConfiguration()) {}
+};
+
+typedef ManyCQize<TCP> ManyCQTCP;
+typedef ManyCQize<SockPair> ManyCQSockPair;
+typedef ManyCQize<InProcessCHTTP2> ManyCQInProcessCHTTP2;
+
 }  // namespace testing
 }  // namespace grpc
 
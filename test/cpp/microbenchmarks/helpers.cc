@@ -18,6 +18,15 @@
 
 #include "test/cpp/microbenchmarks/helpers.h"
 
+TrackCounters::~TrackCounters() {
+  if (latency_ != nullptr) gpr_histogram_destroy(latency_);
+}
+
+void TrackCounters::AddLatencySample(double nanos) {
+  if (latency_ == nullptr) latency_ = gpr_histogram_create(0.01, 60e9);
+  gpr_histogram_add(latency_, nanos);
+}
+
 void TrackCounters::Finish(benchmark::State &state) {
   std::ostringstream out;
   AddToLabel(out, state);
@@ -29,6 +38,27 @@ void TrackCounters::Finish(benchmark::State &state) {
 }
 
 void TrackCounters::AddToLabel(std::ostream &out, benchmark::State &state) {
+  grpc_stats_data stats_end;
+  grpc_stats_collect(&stats_end);
+  grpc_stats_data stats;
+  grpc_stats_diff(&stats_end, &stats_begin_, &stats);
+  for (int i = 0; i < GRPC_STATS_COUNTER_COUNT; i++) {
+    if (stats.counters[i] == 0) continue;
+    out << " " << grpc_stats_counter_name[i]
+        << "/iter:" << ((double)stats.counters[i] / (double)state.iterations());
+  }
+  for (int i = 0; i < GRPC_STATS_HISTOGRAM_COUNT; i++) {
+    grpc_stats_histograms h = static_cast<grpc_stats_histograms>(i);
+    if (grpc_stats_histo_count(&stats, h) == 0) continue;
+    out << " " << grpc_stats_histogram_name[i] << "-median:"
+        << grpc_stats_histo_percentile(&stats, h, 50.0) << " "
+        << grpc_stats_histogram_name[i] << "-99p:"
+        << grpc_stats_histo_percentile(&stats, h, 99.0);
+  }
+  if (latency_ != nullptr) {
+    out << " latency_ns-median:" << gpr_histogram_percentile(latency_, 50.0)
+        << " latency_ns-99p:" << gpr_histogram_percentile(latency_, 99.0);
+  }
 #ifdef GPR_LOW_LEVEL_COUNTERS
   grpc_memory_counters counters_at_end = grpc_memory_counters_snapshot();
   out << " locks/iter:" << ((double)(gpr_atm_no_barrier_load(&gpr_mu_locks) -
@@ -22,7 +22,9 @@
 #include <sstream>
 
 extern "C" {
+#include <grpc/support/histogram.h>
 #include <grpc/support/port_platform.h>
+#include "src/core/lib/debug/stats.h"
 #include "test/core/util/memory_counters.h"
 }
 
@@ -62,10 +64,17 @@ extern "C" gpr_atm gpr_now_call_count;
 
 class TrackCounters {
  public:
+  TrackCounters() { grpc_stats_collect(&stats_begin_); }
+  virtual ~TrackCounters();
   virtual void Finish(benchmark::State& state);
   virtual void AddToLabel(std::ostream& out, benchmark::State& state);
+  // Record how long one operation of the benchmark (eg. an rpc) took: the
+  // median and 99th percentile get added to the label
+  void AddLatencySample(double nanos);
 
  private:
+  grpc_stats_data stats_begin_;
+  gpr_histogram* latency_ = nullptr;
 #ifdef GPR_LOW_LEVEL_COUNTERS
   const size_t mu_locks_at_start_ = gpr_atm_no_barrier_load(&gpr_mu_locks);
   const size_t atm_cas_at_start_ =
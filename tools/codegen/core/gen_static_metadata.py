@@ -59,6 +59,7 @@ CONFIG = [
     ('grpc-encoding', 'identity'),
     ('grpc-encoding', 'gzip'),
     ('grpc-encoding', 'deflate'),
+    ('grpc-encoding', 'lz4'),
     ('te', 'trailers'),
     ('content-type', 'application/grpc'),
     (':method', 'POST'),
@@ -155,6 +156,7 @@ COMPRESSION_ALGORITHMS = [
     'identity',
     'deflate',
     'gzip',
+    'lz4',
 ]
 
 
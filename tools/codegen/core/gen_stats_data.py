@@ -0,0 +1,221 @@
+#!/usr/bin/env python2.7
+
+# Copyright 2017 gRPC authors.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+from __future__ import print_function
+
+import collections
+import math
+import sys
+import yaml
+
+with open('src/core/lib/debug/stats_data.yaml') as f:
+  attrs = yaml.load(f.read(), Loader=yaml.SafeLoader)
+
+types = (
+  (collections.namedtuple('Counter', 'name doc'), []),
+  (collections.namedtuple('Histogram', 'name max buckets doc'), []),
+)
+
+inst_map = dict((t[0].__name__, t[1]) for t in types)
+
+for attr in attrs:
+  found = False
+  for t, lst in types:
+    t_name = t.__name__.lower()
+    if t_name in attr:
+      name = attr[t_name]
+      del attr[t_name]
+      lst.append(t(name=name, **attr))
+      found = True
+      break
+  assert found, "Bad decl: %s" % attr
+
+# lower bound of each bucket: the first bucket takes everything below 1, the
+# last everything from histogram.max up, and the ones between grow
+# geometrically
+def gen_bucket_boundaries(histogram):
+  assert histogram.buckets >= 2
+  bounds = [0, 1]
+  while len(bounds) < histogram.buckets:
+    remaining = histogram.buckets - len(bounds)
+    mul = math.pow(float(histogram.max) / bounds[-1], 1.0 / remaining)
+    nextb = int(math.ceil(bounds[-1] * mul))
+    if nextb <= bounds[-1]:
+      nextb = bounds[-1] + 1
+    bounds.append(nextb)
+  return bounds
+
+# format an initializer list, wrapping it to fit in 80 columns
+def c_initializer(decl, values):
+  items = ['%s,' % v for v in values]
+  items[-1] = items[-1][:-1] + '};'
+  one_line = '%s = {%s' % (decl, ' '.join(items))
+  if len(one_line) <= 80:
+    return one_line
+  lines = ['%s = {' % decl]
+  line = '   '
+  for item in items:
+    if len(line) + 1 + len(item) > 80:
+      lines.append(line)
+      line = '   '
+    line += ' ' + item
+  lines.append(line)
+  return '\n'.join(lines)
+
+def put_banner(files, banner):
+  for f in files:
+    print('/*', file=f)
+    for line in banner:
+      print(' * %s' % line, file=f)
+    print(' */', file=f)
+    print(file=f)
+
+# copy-paste copyright notice from this file
+with open(sys.argv[0]) as my_source:
+  copyright = []
+  for line in my_source:
+    if line[0] != '#': break
+  for line in my_source:
+    if line[0] == '#':
+      copyright.append(line)
+      break
+  for line in my_source:
+    if line[0] != '#':
+      break
+    copyright.append(line)
+
+# bucket lower bounds: histograms with the same shape share a table
+static_tables = []
+histo_start = []
+histo_buckets = []
+histo_bucket_boundaries = []
+
+first_slot = 0
+for histogram in inst_map['Histogram']:
+  histo_start.append(first_slot)
+  histo_buckets.append(histogram.buckets)
+  table = ('int', gen_bucket_boundaries(histogram))
+  if table not in static_tables:
+    static_tables.append(table)
+  histo_bucket_boundaries.append(static_tables.index(table))
+  first_slot += histogram.buckets
+
+with open('src/core/lib/debug/stats_data.h', 'w') as H:
+  put_banner([H], [line[2:].rstrip() for line in copyright])
+
+  put_banner([H], ["Automatically generated by tools/codegen/core/gen_stats_data.py"])
+
+  print("#ifndef GRPC_CORE_LIB_DEBUG_STATS_DATA_H", file=H)
+  print("#define GRPC_CORE_LIB_DEBUG_STATS_DATA_H", file=H)
+  print(file=H)
+  print("#include <inttypes.h>", file=H)
+  print("#include \"src/core/lib/iomgr/exec_ctx.h\"", file=H)
+  print(file=H)
+
+  for typename, instances in sorted(inst_map.items()):
+    print("typedef enum {", file=H)
+    for inst in instances:
+      print("  GRPC_STATS_%s_%s," % (typename.upper(), inst.name.upper()), file=H)
+    print("  GRPC_STATS_%s_COUNT" % (typename.upper()), file=H)
+    print("} grpc_stats_%ss;" % (typename.lower()), file=H)
+    print("extern const char *grpc_stats_%s_name[GRPC_STATS_%s_COUNT];" % (
+        typename.lower(), typename.upper()), file=H)
+    print("extern const char *grpc_stats_%s_doc[GRPC_STATS_%s_COUNT];" % (
+        typename.lower(), typename.upper()), file=H)
+
+  print("typedef enum {", file=H)
+  for i, histogram in enumerate(inst_map['Histogram']):
+    print("  GRPC_STATS_HISTOGRAM_%s_FIRST_SLOT = %d," % (
+        histogram.name.upper(), histo_start[i]), file=H)
+    print("  GRPC_STATS_HISTOGRAM_%s_BUCKETS = %d," % (
+        histogram.name.upper(), histogram.buckets), file=H)
+  print("  GRPC_STATS_HISTOGRAM_BUCKETS = %d" % first_slot, file=H)
+  print("} grpc_stats_histogram_constants;", file=H)
+
+  for ctr in inst_map['Counter']:
+    print("#define GRPC_STATS_INC_%s(exec_ctx) \\" % ctr.name.upper(), file=H)
+    print("  GRPC_STATS_INC_COUNTER((exec_ctx), GRPC_STATS_COUNTER_%s)" %
+          ctr.name.upper(), file=H)
+  for histogram in inst_map['Histogram']:
+    print("#define GRPC_STATS_INC_%s(exec_ctx, value) \\" %
+          histogram.name.upper(), file=H)
+    print("  grpc_stats_inc_%s((exec_ctx), (int)(value))" %
+          histogram.name.lower(), file=H)
+    print("void grpc_stats_inc_%s(grpc_exec_ctx *exec_ctx, int x);" %
+          histogram.name.lower(), file=H)
+
+  for i, tbl in enumerate(static_tables):
+    print("extern const %s grpc_stats_table_%d[%d];" % (
+        tbl[0], i, len(tbl[1])), file=H)
+
+  n = len(inst_map['Histogram'])
+  print("extern const int grpc_stats_histo_buckets[%d];" % n, file=H)
+  print("extern const int grpc_stats_histo_start[%d];" % n, file=H)
+  print("extern const int *const grpc_stats_histo_bucket_boundaries[%d];" % n,
+        file=H)
+
+  print(file=H)
+  print("#endif /* GRPC_CORE_LIB_DEBUG_STATS_DATA_H */", file=H)
+
+with open('src/core/lib/debug/stats_data.c', 'w') as C:
+  put_banner([C], [line[2:].rstrip() for line in copyright])
+
+  put_banner([C], ["Automatically generated by tools/codegen/core/gen_stats_data.py"])
+
+  print("#include \"src/core/lib/debug/stats_data.h\"", file=C)
+  print("#include \"src/core/lib/debug/stats.h\"", file=C)
+  print("#include \"src/core/lib/iomgr/exec_ctx.h\"", file=C)
+  print(file=C)
+
+  histo_code = []
+  for i, histogram in enumerate(inst_map['Histogram']):
+    histo_code.append(
+        "void grpc_stats_inc_%s(grpc_exec_ctx *exec_ctx, int value) {" %
+        histogram.name.lower())
+    histo_code.append(
+        "  GRPC_STATS_INC_HISTOGRAM((exec_ctx), GRPC_STATS_HISTOGRAM_%s," %
+        histogram.name.upper())
+    histo_code.append(
+        "                           grpc_stats_histo_find_bucket(\n"
+        "                               grpc_stats_table_%d, %d, value));" % (
+            histo_bucket_boundaries[i], histogram.buckets))
+    histo_code.append("}")
+
+  for typename, instances in sorted(inst_map.items()):
+    print("const char *grpc_stats_%s_name[GRPC_STATS_%s_COUNT] = {" % (
+        typename.lower(), typename.upper()), file=C)
+    for inst in instances: print("  \"%s\"," % inst.name, file=C)
+    print("};", file=C)
+    print("const char *grpc_stats_%s_doc[GRPC_STATS_%s_COUNT] = {" % (
+        typename.lower(), typename.upper()), file=C)
+    for inst in instances: print("  \"%s\"," % inst.doc, file=C)
+    print("};", file=C)
+
+  for i, tbl in enumerate(static_tables):
+    print(c_initializer("const %s grpc_stats_table_%d[%d]" % (
+        tbl[0], i, len(tbl[1])), tbl[1]), file=C)
+
+  for line in histo_code:
+    print(line, file=C)
+
+  print(c_initializer("const int grpc_stats_histo_buckets[%d]" %
+                      len(inst_map['Histogram']), histo_buckets), file=C)
+  print(c_initializer("const int grpc_stats_histo_start[%d]" %
+                      len(inst_map['Histogram']), histo_start), file=C)
+  print(c_initializer(
+      "const int *const grpc_stats_histo_bucket_boundaries[%d]" %
+      len(inst_map['Histogram']),
+      ['grpc_stats_table_%d' % x for x in histo_bucket_boundaries]), file=C)
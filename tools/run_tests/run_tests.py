@@ -63,7 +63,8 @@ _FORCE_ENVIRON_FOR_WRAPPERS = {
 }
 
 _POLLING_STRATEGIES = {
-  'linux': ['epollsig', 'poll', 'poll-cv'],
+  'linux': ['epollsig', 'poll', 'poll-cv', 'io_uring',
+            'epoll1-sharded'],
 # TODO(ctiller, sreecha): enable epoll1, epollex, epoll-thread-pool
   'mac': ['poll'],
 }
@@ -361,7 +362,7 @@ class CLanguage(object):
       # don't build tools on windows just yet
       return ['buildtests_%s' % self.make_target]
     return ['buildtests_%s' % self.make_target, 'tools_%s' % self.make_target,
-            'check_epollexclusive']
+            'check_epollexclusive', 'check_io_uring']
 
   def make_options(self):
     return self._make_options;
@@ -1474,6 +1475,17 @@ def _has_epollexclusive():
     return False
 
 
+def _has_io_uring():
+  try:
+    subprocess.check_call('bins/%s/check_io_uring' % args.config)
+    return True
+  except subprocess.CalledProcessError, e:
+    return False
+  except OSError, e:
+    # For languages other than C and Windows the binary won't exist
+    return False
+
+
 # returns a list of things that failed (or an empty list on success)
 def _build_and_run(
     check_cancelled, newline_on_success, xml_report=None, build_only=False):
@@ -1495,6 +1507,10 @@ def _build_and_run(
     print('\n\nOmitting EPOLLEXCLUSIVE tests\n\n')
     _POLLING_STRATEGIES[platform_string()].remove('epollex')
 
+  if not args.travis and not _has_io_uring() and platform_string() in _POLLING_STRATEGIES and 'io_uring' in _POLLING_STRATEGIES[platform_string()]:
+    print('\n\nOmitting io_uring tests\n\n')
+    _POLLING_STRATEGIES[platform_string()].remove('io_uring')
+
   # start antagonists
   antagonists = [subprocess.Popen(['tools/run_tests/python_utils/antagonist.py'])
                  for _ in range(0, args.antagonists)]